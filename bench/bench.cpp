@@ -0,0 +1,177 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#include "bench.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+
+namespace psimpl {
+    namespace bench
+{
+    namespace
+    {
+        // each allocation is prefixed by its size; the prefix preserves the alignment
+        const std::size_t HEADER = 16;
+
+        std::atomic <std::size_t> current (0);
+        std::atomic <std::size_t> peak (0);
+
+        void* Allocate (std::size_t size) {
+            void* block = std::malloc (size + HEADER);
+            if (!block) {
+                return 0;
+            }
+            *static_cast <std::size_t*> (block) = size;
+            std::size_t now = current += size;
+            std::size_t max = peak;
+            while (now > max && !peak.compare_exchange_weak (max, now)) {}
+            return static_cast <char*> (block) + HEADER;
+        }
+
+        void Deallocate (void* ptr) {
+            if (ptr) {
+                void* block = static_cast <char*> (ptr) - HEADER;
+                current -= *static_cast <std::size_t*> (block);
+                std::free (block);
+            }
+        }
+
+        void WriteResult (std::ostream& os, const Result& r) {
+            os << "{\"algorithm\": \"" << r.algorithm << "\""
+               << ", \"generator\": \"" << r.generator << "\""
+               << ", \"type\": \"" << r.type << "\""
+               << ", \"container\": \"" << r.container << "\""
+               << ", \"dim\": " << r.dim
+               << ", \"size\": " << r.size
+               << ", \"output\": " << r.output
+               << ", \"repeat\": " << r.repeat
+               << ", \"ns_per_point\": " << r.best / r.size
+               << ", \"mean_ns_per_point\": " << r.mean / r.size
+               << ", \"points_per_second\": " << (r.best > 0 ? 1e9 * r.size / r.best : 0.0)
+               << ", \"peak_heap_bytes\": " << r.peakHeap << "}";
+        }
+    }
+
+    std::size_t Heap::Current () {
+        return current;
+    }
+
+    std::size_t Heap::Peak () {
+        return peak;
+    }
+
+    void Heap::ResetPeak () {
+        peak = current.load ();
+    }
+
+    void Report::Write (std::ostream& os, const std::string& compiler) const {
+        os << "{\n";
+        os << "  \"benchmark\": \"psimpl\",\n";
+        os << "  \"compiler\": \"" << compiler << "\",\n";
+        os << "  \"threads\": " << std::thread::hardware_concurrency () << ",\n";
+        os << "  \"results\": [";
+        for (std::size_t i=0; i<mResults.size (); ++i) {
+            os << (i ? ",\n    " : "\n    ");
+            WriteResult (os, mResults [i]);
+        }
+        os << "\n  ],\n";
+        os << "  \"comparisons\": [";
+        bool first = true;
+        for (std::size_t c=0; c<mResults.size (); ++c) {
+            const Result& classic = mResults [c];
+            if (classic.algorithm != "dp_classic") {
+                continue;
+            }
+            for (std::size_t i=0; i<mResults.size (); ++i) {
+                const Result& dp = mResults [i];
+                if (dp.algorithm != "dp" || dp.generator != classic.generator ||
+                    dp.type != classic.type || dp.container != classic.container ||
+                    dp.dim != classic.dim || dp.size != classic.size)
+                {
+                    continue;
+                }
+                os << (first ? "\n    " : ",\n    ");
+                os << "{\"generator\": \"" << dp.generator << "\""
+                   << ", \"size\": " << dp.size
+                   << ", \"psimpl_ns_per_point\": " << dp.best / dp.size
+                   << ", \"classic_ns_per_point\": " << classic.best / classic.size
+                   << ", \"speedup\": " << (dp.best > 0 ? classic.best / dp.best : 0.0)
+                   << ", \"psimpl_output\": " << dp.output
+                   << ", \"classic_output\": " << classic.output << "}";
+                first = false;
+            }
+        }
+        os << (first ? "]\n" : "\n  ]\n");
+        os << "}\n";
+    }
+}}
+
+
+void* operator new (std::size_t size) {
+    void* ptr = psimpl::bench::Allocate (size);
+    if (!ptr) {
+        throw std::bad_alloc ();
+    }
+    return ptr;
+}
+
+void* operator new [] (std::size_t size) {
+    return operator new (size);
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) throw () {
+    return psimpl::bench::Allocate (size);
+}
+
+void* operator new [] (std::size_t size, const std::nothrow_t&) throw () {
+    return psimpl::bench::Allocate (size);
+}
+
+void operator delete (void* ptr) throw () {
+    psimpl::bench::Deallocate (ptr);
+}
+
+void operator delete [] (void* ptr) throw () {
+    psimpl::bench::Deallocate (ptr);
+}
+
+void operator delete (void* ptr, const std::nothrow_t&) throw () {
+    psimpl::bench::Deallocate (ptr);
+}
+
+void operator delete [] (void* ptr, const std::nothrow_t&) throw () {
+    psimpl::bench::Deallocate (ptr);
+}
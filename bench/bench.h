@@ -0,0 +1,123 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#ifndef PSIMPL_BENCH
+#define PSIMPL_BENCH
+
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+namespace psimpl {
+    namespace bench
+{
+    /*!
+        \brief Keeps track of the heap memory that is allocated through operator new.
+    */
+    class Heap
+    {
+    public:
+        //! \brief Returns the number of currently allocated bytes.
+        static std::size_t Current ();
+
+        //! \brief Returns the peak number of allocated bytes since the last call to ResetPeak.
+        static std::size_t Peak ();
+
+        //! \brief Resets the peak number of allocated bytes to the current number.
+        static void ResetPeak ();
+    };
+
+    /*!
+        \brief Measures the elapsed wall clock time.
+    */
+    class Timer
+    {
+    public:
+        Timer () :
+            mStart (std::chrono::steady_clock::now ())
+        {}
+
+        //! \brief Returns the elapsed time in nano seconds.
+        double Elapsed () const {
+            return static_cast <double> (std::chrono::duration_cast <std::chrono::nanoseconds> (
+                std::chrono::steady_clock::now () - mStart).count ());
+        }
+
+    private:
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+    /*!
+        \brief The measurements of a single benchmark.
+    */
+    struct Result
+    {
+        std::string algorithm;
+        std::string generator;
+        std::string type;
+        std::string container;
+        unsigned dim;
+        std::size_t size;           //! number of input points
+        std::size_t output;         //! number of output points (or indices)
+        unsigned repeat;            //! number of measured runs
+        double best;                //! fastest run in nano seconds
+        double mean;                //! mean run in nano seconds
+        std::size_t peakHeap;       //! peak heap memory in bytes during a run, input excluded
+    };
+
+    /*!
+        \brief Collects benchmark results, and writes them as JSON.
+
+        Each DouglasPeucker result that has a matching classic::poly_simplify result is also
+        written as a comparison.
+    */
+    class Report
+    {
+    public:
+        void Add (const Result& result) {
+            mResults.push_back (result);
+        }
+
+        void Write (std::ostream& os, const std::string& compiler) const;
+
+    private:
+        std::vector <Result> mResults;
+    };
+}}
+
+
+#endif // PSIMPL_BENCH
@@ -0,0 +1,176 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#include "generator.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+
+namespace psimpl {
+    namespace bench
+{
+    namespace
+    {
+        const double PI = std::atan (1.0) * 4;
+    }
+
+    const char* Generator::Name (Kind kind) {
+        switch (kind) {
+        case CURVE:     return "curve";
+        case GPS:       return "gps";
+        case SPIRAL:    return "spiral";
+        case ZIGZAG:    return "zigzag";
+        }
+        return "";
+    }
+
+    bool Generator::Parse (const std::string& name, Kind& kind) {
+        for (unsigned k=0; k<KIND_COUNT; ++k) {
+            if (name == Name (static_cast <Kind> (k))) {
+                kind = static_cast <Kind> (k);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Generator::Generator (unsigned seed) :
+        mSeed (seed)
+    {}
+
+    void Generator::Generate (Kind kind, std::size_t count, unsigned dim, std::vector <double>& coords) {
+        coords.assign (count * dim, 0.0);
+        switch (kind) {
+        case CURVE:     Curve (count, dim, coords); break;
+        case GPS:       Gps (count, dim, coords); break;
+        case SPIRAL:    Spiral (count, dim, coords); break;
+        case ZIGZAG:    Zigzag (count, dim, coords); break;
+        }
+    }
+
+    // same curve as DPWorker::Generate; extra dimensions use the same construction
+    void Generator::Curve (std::size_t count, unsigned dim, std::vector <double>& coords) {
+        std::mt19937 random (mSeed);
+        double step = 2 * PI / count;
+
+        for (unsigned d=1; d<dim; ++d) {
+            int a = 1 + (random () % 2);    // [1, 3]
+            int b = 2 + (random () % 3);    // [2, 5]
+            int c = 3 + (random () % 7);    // [3, 10]
+
+            double miny = static_cast <double> (count);
+            double maxy = -miny;
+            for (std::size_t i=0; i<count; ++i) {
+                double tmp1 = std::cos (step * i * a) / 3;
+                double tmp2 = std::sin (step * i * b) / 5;
+                double tmp3 = std::sin (step * i * c) / 10;
+                double y = tmp1 + tmp2 + tmp3;
+                coords [i*dim+d] = y;
+                miny = std::min (miny, y);
+                maxy = std::max (maxy, y);
+            }
+            // translate the line to (0,0) and scale the line to (count, count/2)
+            double scaley = (count-1) / (maxy-miny);
+            for (std::size_t i=0; i<count; ++i) {
+                coords [i*dim+d] = (coords [i*dim+d] - miny) * 0.5 * scaley;
+            }
+        }
+        for (std::size_t i=0; i<count; ++i) {
+            coords [i*dim] = static_cast <double> (i);
+        }
+    }
+
+    // walks at a roughly constant speed and heading, with the occasional turn and measurement
+    // noise on each coordinate
+    void Generator::Gps (std::size_t count, unsigned dim, std::vector <double>& coords) {
+        std::mt19937 random (mSeed);
+        std::normal_distribution <double> drift (0.0, 0.05);
+        std::normal_distribution <double> speed (5.0, 0.5);
+        std::normal_distribution <double> noise (0.0, 1.5);
+        std::normal_distribution <double> climb (0.0, 0.2);
+        std::uniform_real_distribution <double> turn (-PI / 2, PI / 2);
+        std::uniform_real_distribution <double> chance (0.0, 1.0);
+
+        std::vector <double> position (dim, 0.0);
+        double heading = 0.0;
+        for (std::size_t i=0; i<count; ++i) {
+            heading += drift (random);
+            if (chance (random) < 0.01) {
+                heading += turn (random);
+            }
+            double distance = std::max (0.0, speed (random));
+            position [0] += distance * std::cos (heading);
+            if (dim > 1) {
+                position [1] += distance * std::sin (heading);
+            }
+            for (unsigned d=2; d<dim; ++d) {
+                position [d] += climb (random);
+            }
+            for (unsigned d=0; d<dim; ++d) {
+                coords [i*dim+d] = position [d] + noise (random);
+            }
+        }
+    }
+
+    // spiral with a point spacing of 5 and a distance of 20 between successive windings
+    void Generator::Spiral (std::size_t count, unsigned dim, std::vector <double>& coords) {
+        const double spacing = 5.0;
+        const double k = 20.0 / (2 * PI);
+
+        double theta = 2 * PI;
+        for (std::size_t i=0; i<count; ++i) {
+            double r = k * theta;
+            coords [i*dim] = r * std::cos (theta);
+            if (dim > 1) {
+                coords [i*dim+1] = r * std::sin (theta);
+            }
+            for (unsigned d=2; d<dim; ++d) {
+                coords [i*dim+d] = 0.1 * i;
+            }
+            theta += spacing / r;
+        }
+    }
+
+    // each point is 20 units away from the line through its neighbours
+    void Generator::Zigzag (std::size_t count, unsigned dim, std::vector <double>& coords) {
+        const double amplitude = 20.0;
+
+        for (std::size_t i=0; i<count; ++i) {
+            coords [i*dim] = 5.0 * i;
+            for (unsigned d=1; d<dim; ++d) {
+                coords [i*dim+d] = ((i >> (d-1)) & 1) ? amplitude : -amplitude;
+            }
+        }
+    }
+}}
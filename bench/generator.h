@@ -0,0 +1,84 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#ifndef PSIMPL_BENCH_GENERATOR
+#define PSIMPL_BENCH_GENERATOR
+
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace psimpl {
+    namespace bench
+{
+    /*!
+        \brief Generates pseudo random polylines of any dimension.
+
+        Each generated polyline has a point spacing of roughly 1 to 5 units, which makes a
+        distance tolerance in the order of 5 units a sensible choice. The same seed always
+        results in the same polyline.
+    */
+    class Generator
+    {
+    public:
+        enum Kind {
+            CURVE,      //! smooth curve, as generated by the demo application
+            GPS,        //! noisy random walk, as recorded by a GPS receiver
+            SPIRAL,     //! archimedean spiral (helix for higher dimensions)
+            ZIGZAG      //! zig-zag that exceeds any sensible tolerance, nothing is removed
+        };
+
+        static const unsigned KIND_COUNT = 4;
+
+        static const char* Name (Kind kind);
+        static bool Parse (const std::string& name, Kind& kind);
+
+        Generator (unsigned seed);
+
+        void Generate (Kind kind, std::size_t count, unsigned dim, std::vector <double>& coords);
+
+    private:
+        void Curve (std::size_t count, unsigned dim, std::vector <double>& coords);
+        void Gps (std::size_t count, unsigned dim, std::vector <double>& coords);
+        void Spiral (std::size_t count, unsigned dim, std::vector <double>& coords);
+        void Zigzag (std::size_t count, unsigned dim, std::vector <double>& coords);
+
+    private:
+        unsigned mSeed;
+    };
+}}
+
+
+#endif // PSIMPL_BENCH_GENERATOR
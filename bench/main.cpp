@@ -0,0 +1,454 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#include "bench.h"
+#include "generator.h"
+#include "../lib/psimpl.h"
+#include "../demo/psimpl_reference.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace psimpl {
+    namespace bench
+{
+    const char* ALGORITHMS [] = {
+        "np", "rd", "pd", "rw", "op", "la", "dp", "dp_parallel", "dp_chunked", "dp_hull",
+        "dpn", "dp_indices", "dpn_indices", "dp_errors", "dpn_errors", "dp_levels",
+        "dp_boxes", "dpn_boxes", "vw", "vw_n", "dp_classic"
+    };
+
+    /*!
+        \brief Benchmark selection and settings, as given on the command line.
+    */
+    struct Options
+    {
+        std::vector <std::string> algorithms;
+        std::vector <std::string> generators;
+        std::vector <std::string> types;
+        std::vector <std::string> containers;
+        std::vector <unsigned> dims;
+        std::size_t minSize;
+        std::size_t maxSize;
+        unsigned repeat;        //! minimum number of measured runs
+        double minTime;         //! minimum total measured time in seconds
+        double tol;
+        unsigned seed;
+        std::string output;
+
+        Options () :
+            minSize (1000),
+            maxSize (1000000),
+            repeat (3),
+            minTime (0.1),
+            tol (5.0),
+            seed (1),
+            output ()
+        {
+            algorithms.assign (ALGORITHMS, ALGORITHMS + sizeof (ALGORITHMS) / sizeof (ALGORITHMS [0]));
+            for (unsigned k=0; k<Generator::KIND_COUNT; ++k) {
+                generators.push_back (Generator::Name (static_cast <Generator::Kind> (k)));
+            }
+            types.push_back ("float");
+            types.push_back ("double");
+            types.push_back ("long long");
+            containers.push_back ("vector");
+            containers.push_back ("list");
+            dims.push_back (2);
+            dims.push_back (3);
+        }
+
+        bool Selected (const std::vector <std::string>& selection, const std::string& name) const {
+            return std::find (selection.begin (), selection.end (), name) != selection.end ();
+        }
+    };
+
+    template <class T> const char* TypeName ();
+    template <> const char* TypeName <float> () { return "float"; }
+    template <> const char* TypeName <double> () { return "double"; }
+    template <> const char* TypeName <long long> () { return "long long"; }
+
+    template <class Container> const char* ContainerName ();
+    template <> const char* ContainerName <std::vector <float> > () { return "vector"; }
+    template <> const char* ContainerName <std::vector <double> > () { return "vector"; }
+    template <> const char* ContainerName <std::vector <long long> > () { return "vector"; }
+    template <> const char* ContainerName <std::list <float> > () { return "list"; }
+    template <> const char* ContainerName <std::list <double> > () { return "list"; }
+    template <> const char* ContainerName <std::list <long long> > () { return "list"; }
+
+    /*!
+        \brief Benchmarks each selected algorithm for a single polyline stored in a Container.
+    */
+    template <unsigned DIM, class Container>
+    class Runner
+    {
+        typedef typename Container::value_type value_type;
+        typedef typename Container::const_iterator iterator;
+
+    public:
+        Runner (const Options& options, const std::string& generator, const std::vector <double>& coords,
+                Report& report) :
+            mOptions (options),
+            mGenerator (generator),
+            mCoords (coords),
+            mPolyline (coords.begin (), coords.end ()),
+            mReport (report)
+        {}
+
+        void Run () {
+            const iterator first = mPolyline.begin ();
+            const iterator last = mPolyline.end ();
+            const std::size_t size = mCoords.size () / DIM;
+            const value_type tol = static_cast <value_type> (mOptions.tol);
+            const value_type areaTol = static_cast <value_type> (mOptions.tol * mOptions.tol);    // for vw
+            const unsigned count = static_cast <unsigned> (std::max <std::size_t> (2, size / 100));
+            const unsigned threads = std::max (2u, std::thread::hardware_concurrency ());
+            typedef std::vector <value_type> Output;
+            typedef std::vector <unsigned> Indices;
+            typedef std::vector <double> Errors;
+            typedef std::vector <unsigned char> Levels;
+            value_type levelTols [8];      // for dp_levels
+            for (unsigned k = 0; k < 8; ++k) {
+                levelTols [k] = static_cast <value_type> (mOptions.tol * (1 << k));
+            }
+            // for dp_boxes and dpn_boxes; only built for contiguous containers, and ignored otherwise
+            BoundingBoxHierarchy <DIM, value_type> boxes;
+            if (const value_type* coords = util::contiguous_iterator <iterator>::address (first)) {
+                boxes.Build (coords, coords + size * DIM);
+            }
+
+            Measure ("np", [&] () {
+                Output out; simplify_nth_point <DIM> (first, last, 10, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("rd", [&] () {
+                Output out; simplify_radial_distance <DIM> (first, last, tol, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("pd", [&] () {
+                Output out; simplify_perpendicular_distance <DIM> (first, last, tol, 1, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("rw", [&] () {
+                Output out; simplify_reumann_witkam <DIM> (first, last, tol, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("op", [&] () {
+                Output out; simplify_opheim <DIM> (first, last, tol, 5 * tol, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("la", [&] () {
+                Output out; simplify_lang <DIM> (first, last, tol, 16, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("dp", [&] () {
+                Output out; simplify_douglas_peucker <DIM> (first, last, tol, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("dp_parallel", [&] () {
+                Output out; simplify_douglas_peucker_parallel <DIM> (first, last, tol, threads, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("dp_chunked", [&] () {
+                Output out; simplify_douglas_peucker_chunked <DIM> (first, last, tol, 65536, threads, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("dp_hull", [&] () {
+                Output out; simplify_douglas_peucker_hull <DIM> (first, last, tol, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("dpn", [&] () {
+                Output out; simplify_douglas_peucker_n <DIM> (first, last, count, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("dp_indices", [&] () {
+                Indices out; simplify_douglas_peucker_indices <DIM> (first, last, tol, std::back_inserter (out));
+                return out.size ();
+            });
+            Measure ("dpn_indices", [&] () {
+                Indices out; simplify_douglas_peucker_n_indices <DIM> (first, last, count, std::back_inserter (out));
+                return out.size ();
+            });
+            Measure ("dp_errors", [&] () {
+                Output out; Errors errors;
+                simplify_douglas_peucker_errors <DIM> (first, last, tol, std::back_inserter (out),
+                                                       std::back_inserter (errors));
+                return out.size () / DIM;
+            });
+            Measure ("dpn_errors", [&] () {
+                Output out; Errors errors;
+                simplify_douglas_peucker_n_errors <DIM> (first, last, count, std::back_inserter (out),
+                                                         std::back_inserter (errors));
+                return out.size () / DIM;
+            });
+            Measure ("dp_levels", [&] () {
+                Levels levels;
+                simplify_douglas_peucker_levels <DIM> (first, last, levelTols, levelTols + 8,
+                                                       std::back_inserter (levels));
+                return std::size_t (levels.size () - std::count (levels.begin (), levels.end (), 0));
+            });
+            Measure ("dp_boxes", [&] () {
+                Output out; simplify_douglas_peucker <DIM> (first, last, tol, boxes, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("dpn_boxes", [&] () {
+                Output out; simplify_douglas_peucker_n <DIM> (first, last, count, boxes, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("vw", [&] () {
+                Output out; simplify_visvalingam_whyatt <DIM> (first, last, areaTol, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            Measure ("vw_n", [&] () {
+                Output out; simplify_visvalingam_whyatt_n <DIM> (first, last, count, std::back_inserter (out));
+                return out.size () / DIM;
+            });
+            MeasureClassic ();
+        }
+
+    private:
+        template <class Function>
+        void Measure (const char* algorithm, Function function) {
+            if (!mOptions.Selected (mOptions.algorithms, algorithm)) {
+                return;
+            }
+            std::cerr << algorithm << " " << mGenerator << " " << TypeName <value_type> () << " "
+                      << ContainerName <Container> () << " " << DIM << "D " << mCoords.size () / DIM << std::endl;
+
+            Result result;
+            result.algorithm = algorithm;
+            result.generator = mGenerator;
+            result.type = TypeName <value_type> ();
+            result.container = ContainerName <Container> ();
+            result.dim = DIM;
+            result.size = mCoords.size () / DIM;
+            result.repeat = 0;
+            result.best = 0.0;
+
+            // the first run also measures the memory usage
+            Heap::ResetPeak ();
+            std::size_t heap = Heap::Current ();
+            double total = 0.0;
+            do {
+                Timer timer;
+                result.output = function ();
+                double elapsed = timer.Elapsed ();
+                if (!result.repeat) {
+                    result.peakHeap = Heap::Peak () - heap;
+                }
+                result.best = result.repeat ? std::min (result.best, elapsed) : elapsed;
+                total += elapsed;
+                ++result.repeat;
+            }
+            while (result.repeat < mOptions.repeat || total < mOptions.minTime * 1e9);
+            result.mean = total / result.repeat;
+            mReport.Add (result);
+        }
+
+        // classic::poly_simplify only supports 2d float points, stored in an array
+        void MeasureClassic () {
+            if (DIM != 2 || TypeName <value_type> () != std::string ("float") ||
+                ContainerName <Container> () != std::string ("vector"))
+            {
+                return;
+            }
+            int count = static_cast <int> (mCoords.size () / DIM);
+            std::vector <classic::Point> points (count);
+            std::vector <classic::Point> simplified (count);
+            for (int i=0; i<count; ++i) {
+                points [i].x = static_cast <float> (mCoords [i*DIM]);
+                points [i].y = static_cast <float> (mCoords [i*DIM+1]);
+            }
+            float tol = static_cast <float> (mOptions.tol);
+            Measure ("dp_classic", [&] () {
+                return static_cast <std::size_t> (classic::poly_simplify (tol, &points [0], count, &simplified [0]));
+            });
+        }
+
+    private:
+        const Options& mOptions;
+        const std::string& mGenerator;
+        const std::vector <double>& mCoords;
+        const Container mPolyline;
+        Report& mReport;
+    };
+
+    template <unsigned DIM, class T>
+    void Run (const Options& options, const std::string& generator, const std::vector <double>& coords,
+              Report& report)
+    {
+        if (!options.Selected (options.types, TypeName <T> ())) {
+            return;
+        }
+        if (options.Selected (options.containers, "vector")) {
+            Runner <DIM, std::vector <T> > (options, generator, coords, report).Run ();
+        }
+        if (options.Selected (options.containers, "list")) {
+            Runner <DIM, std::list <T> > (options, generator, coords, report).Run ();
+        }
+    }
+
+    template <unsigned DIM>
+    void Run (const Options& options, const std::string& generator, const std::vector <double>& coords,
+              Report& report)
+    {
+        Run <DIM, float> (options, generator, coords, report);
+        Run <DIM, double> (options, generator, coords, report);
+        Run <DIM, long long> (options, generator, coords, report);
+    }
+
+    std::vector <std::string> Split (const std::string& list) {
+        std::vector <std::string> items;
+        std::istringstream is (list);
+        std::string item;
+        while (std::getline (is, item, ',')) {
+            items.push_back (item);
+        }
+        return items;
+    }
+
+    void Usage () {
+        std::cerr <<
+            "usage: psimpl-bench [options]\n"
+            "  --algorithms a,b,..  np, rd, pd, rw, op, la, dp, dp_parallel, dp_chunked,\n"
+            "                       dp_hull, dpn, dp_indices, dpn_indices, dp_errors,\n"
+            "                       dpn_errors, dp_levels, dp_boxes, dpn_boxes, vw, vw_n,\n"
+            "                       dp_classic\n"
+            "  --generators a,b,..  curve, gps, spiral, zigzag\n"
+            "  --types a,b,..       float, double, long long\n"
+            "  --containers a,b,..  vector, list\n"
+            "  --dims a,b,..        2, 3\n"
+            "  --min-size n         smallest polyline in points (default 1e3)\n"
+            "  --max-size n         largest polyline in points (default 1e6, at most 1e8)\n"
+            "  --repeat n           minimum number of measured runs (default 3)\n"
+            "  --min-time s         minimum measured time per benchmark (default 0.1)\n"
+            "  --tol t              distance tolerance, squared for the area of vw (default 5)\n"
+            "  --seed n             generator seed (default 1)\n"
+            "  --output file        JSON destination (default stdout)\n"
+            "Sizes increase by a factor of 10, starting at the smallest size.\n";
+    }
+
+    bool Parse (int argc, char* argv [], Options& options) {
+        for (int i=1; i<argc; ++i) {
+            std::string arg = argv [i];
+            if (i + 1 == argc) {
+                return false;
+            }
+            std::string value = argv [++i];
+            if      (arg == "--algorithms")   options.algorithms = Split (value);
+            else if (arg == "--generators")   options.generators = Split (value);
+            else if (arg == "--types")        options.types = Split (value);
+            else if (arg == "--containers")   options.containers = Split (value);
+            else if (arg == "--min-size")     options.minSize = static_cast <std::size_t> (std::atof (value.c_str ()));
+            else if (arg == "--max-size")     options.maxSize = static_cast <std::size_t> (std::atof (value.c_str ()));
+            else if (arg == "--repeat")       options.repeat = std::atoi (value.c_str ());
+            else if (arg == "--min-time")     options.minTime = std::atof (value.c_str ());
+            else if (arg == "--tol")          options.tol = std::atof (value.c_str ());
+            else if (arg == "--seed")         options.seed = std::atoi (value.c_str ());
+            else if (arg == "--output")       options.output = value;
+            else if (arg == "--dims") {
+                options.dims.clear ();
+                std::vector <std::string> dims = Split (value);
+                for (std::size_t d=0; d<dims.size (); ++d) {
+                    options.dims.push_back (std::atoi (dims [d].c_str ()));
+                }
+            }
+            else {
+                return false;
+            }
+        }
+        for (std::size_t g=0; g<options.generators.size (); ++g) {
+            Generator::Kind kind;
+            if (!Generator::Parse (options.generators [g], kind)) {
+                return false;
+            }
+        }
+        return options.minSize >= 2 && options.minSize <= options.maxSize && options.maxSize <= 100000000;
+    }
+}}
+
+
+int main (int argc, char* argv [])
+{
+    using namespace psimpl::bench;
+
+    Options options;
+    if (!Parse (argc, argv, options)) {
+        Usage ();
+        return 1;
+    }
+
+    Report report;
+    Generator generator (options.seed);
+    std::vector <double> coords;
+    for (std::size_t g=0; g<options.generators.size (); ++g) {
+        Generator::Kind kind;
+        Generator::Parse (options.generators [g], kind);
+        for (std::size_t size=options.minSize; size<=options.maxSize; size*=10) {
+            for (std::size_t d=0; d<options.dims.size (); ++d) {
+                unsigned dim = options.dims [d];
+                generator.Generate (kind, size, dim, coords);
+                switch (dim) {
+                case 2:     Run <2> (options, options.generators [g], coords, report); break;
+                case 3:     Run <3> (options, options.generators [g], coords, report); break;
+                default:    std::cerr << "unsupported dimension: " << dim << std::endl; break;
+                }
+            }
+        }
+    }
+
+    std::ostringstream compiler;
+#if defined __clang__
+    compiler << "clang " << __clang_major__ << "." << __clang_minor__;
+#elif defined __GNUC__
+    compiler << "gcc " << __GNUC__ << "." << __GNUC_MINOR__;
+#elif defined _MSC_VER
+    compiler << "msvc " << _MSC_VER;
+#endif
+
+    if (options.output.empty ()) {
+        report.Write (std::cout, compiler.str ());
+    }
+    else {
+        std::ofstream os (options.output.c_str ());
+        report.Write (os, compiler.str ());
+    }
+    return 0;
+}
@@ -0,0 +1,20 @@
+# -------------------------------------------------
+# Headless benchmark of all simplification routines
+# -------------------------------------------------
+TARGET = psimpl-bench
+TEMPLATE = app
+CONFIG += console release
+CONFIG -= qt
+
+HEADERS += \
+    bench.h \
+    generator.h \
+    ../lib/psimpl.h \
+    ../demo/psimpl_reference.h
+
+SOURCES += \
+    main.cpp \
+    bench.cpp \
+    generator.cpp
+
+unix:LIBS += -pthread
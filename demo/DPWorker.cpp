@@ -40,13 +40,69 @@
 namespace psimpl {
 
     DPWorker::DPWorker (QObject* inParent) :
-        QObject (inParent)
+        QObject (inParent),
+        mRequest (0)
     {
         // note: disable this line during testing
         srand ((unsigned)QTime::currentTime ().msec ());
     }
 
-    void DPWorker::Generate (int inCount) {
+    int DPWorker::NewRequest () {
+        int request = mRequest.fetchAndAddOrdered (1) + 1;
+        // stop the running simplification, its result is stale
+        mControl.Cancel ();
+        return request;
+    }
+
+    void DPWorker::Cancel () {
+        NewRequest ();
+    }
+
+    bool DPWorker::IsStale (int request) const {
+        return request != mRequest;
+    }
+
+    bool DPWorker::Start (int request) {
+        // a request that becomes stale after the reset also cancels the control again
+        mControl.Reset ();
+        return !IsStale (request);
+    }
+
+    void DPWorker::Convert (Container cont) {
+        switch (cont) {
+        case ARRAY_FLOAT:
+            if (mFloatCoords.size () != mGeneratedCoords.size ()) {
+                emit SignalConvertingPolyline ();
+                mFloatCoords.resize (mGeneratedCoords.size ());
+                for (int c=0; c<mGeneratedCoords.size (); c++) {
+                    mFloatCoords [c] = mGeneratedCoords [c];
+                }
+            }
+            break;
+        case VECTOR_DOUBLE:
+            if (mDoubleCoords.size () != (std::size_t) mGeneratedCoords.size ()) {
+                emit SignalConvertingPolyline ();
+                mDoubleCoords = mGeneratedCoords.toStdVector ();
+            }
+            break;
+        case LIST_LONGLONG:
+            if (mLongLongCoords.size () != (std::size_t) mGeneratedCoords.size ()) {
+                emit SignalConvertingPolyline ();
+                mLongLongCoords.clear ();
+                foreach (double coord, mGeneratedCoords) {
+                    mLongLongCoords.push_back (coord);
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void DPWorker::Generate (int request, int inCount) {
+        if (IsStale (request))
+            return;
+
         emit SignalGeneratingPolyline ();
 
         QTime t;
@@ -54,6 +110,9 @@ namespace psimpl {
 
         mGeneratedCoords.resize (inCount*2);
         mSimplifiedCoords.clear ();
+        mFloatCoords.clear ();
+        mDoubleCoords.clear ();
+        mLongLongCoords.clear ();
 
         qreal miny = inCount;
         qreal maxy = -inCount;
@@ -81,10 +140,20 @@ namespace psimpl {
             mGeneratedCoords [i*2+1] = (mGeneratedCoords [i*2+1] - miny) * 0.5 * scaley;
         }
         //mGeneratedCoords.push_back(0);
-        emit SignalGeneratedPolyline (t.elapsed (), mGeneratedCoords);
+        int duration = t.elapsed ();
+
+        // prepare drawing, and discard the polyline when a new request was made meanwhile
+        SharedLevelOfDetail lod (new LevelOfDetail (mGeneratedCoords));
+        if (IsStale (request))
+            return;
+
+        emit SignalGeneratedPolyline (duration, lod);
     }
 
-    void DPWorker::SimplifyNP (Container cont, int n) {
+    void DPWorker::SimplifyNP (int request, Container cont, int n) {
+        if (IsStale (request))
+            return;
+
         QTime t;
         int duration = 0;
 
@@ -94,22 +163,15 @@ namespace psimpl {
         case ARRAY_FLOAT:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            float* generatedPoints = new float [mGeneratedCoords.size ()];
-            for (int c=0; c<mGeneratedCoords.size (); c++) {
-                generatedPoints [c] = mGeneratedCoords [c];
-            }
+            Convert (ARRAY_FLOAT);
             // simplify
             emit SignalSimplifyingPolyline ();
-            const float* begin = generatedPoints;
-            const float* end = generatedPoints + mGeneratedCoords.size ();
+            const float* begin = mFloatCoords.constData ();
+            const float* end = mFloatCoords.constData () + mFloatCoords.size ();
             t.start ();
             simplify_nth_point <2> (begin, end, n,
                                     std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            // done
-            emit SignalCleaningConvertedPolyline ();
-            delete [] generatedPoints;
             break;
         }
         case QVECTOR_DOUBLE:
@@ -127,45 +189,41 @@ namespace psimpl {
         case VECTOR_DOUBLE:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::vector <double> generatedPoints = mGeneratedCoords.toStdVector ();
+            Convert (VECTOR_DOUBLE);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::vector <double>::const_iterator begin = generatedPoints.begin ();
-            std::vector <double>::const_iterator end = generatedPoints.end ();
+            std::vector <double>::const_iterator begin = mDoubleCoords.begin ();
+            std::vector <double>::const_iterator end = mDoubleCoords.end ();
             t.start ();
             simplify_nth_point <2> (begin, end, n,
                                     std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         case LIST_LONGLONG:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::list <long long> generatedPoints;
-            foreach (double coord, mGeneratedCoords) {
-                generatedPoints.push_back (coord);
-            }
+            Convert (LIST_LONGLONG);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::list <long long>::const_iterator begin = generatedPoints.begin ();
-            std::list <long long>::const_iterator end = generatedPoints.end ();
+            std::list <long long>::const_iterator begin = mLongLongCoords.begin ();
+            std::list <long long>::const_iterator end = mLongLongCoords.end ();
             t.start ();
             simplify_nth_point <2> (begin, end, n,
                                     std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         default:
             break;
         }
-        DoSignalSimplifiedPolyline (duration);
+        DoSignalSimplifiedPolyline (request, duration);
     }
 
-    void DPWorker::SimplifyRD (Container cont, QString tol) {
+    void DPWorker::SimplifyRD (int request, Container cont, QString tol) {
+        if (IsStale (request))
+            return;
+
         QTime t;
         int duration = 0;
 
@@ -175,22 +233,15 @@ namespace psimpl {
         case ARRAY_FLOAT:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            float* generatedPoints = new float [mGeneratedCoords.size ()];
-            for (int c=0; c<mGeneratedCoords.size (); c++) {
-                generatedPoints [c] = mGeneratedCoords [c];
-            }
+            Convert (ARRAY_FLOAT);
             // simplify
             emit SignalSimplifyingPolyline ();
-            const float* begin = generatedPoints;
-            const float* end = generatedPoints + mGeneratedCoords.size ();
+            const float* begin = mFloatCoords.constData ();
+            const float* end = mFloatCoords.constData () + mFloatCoords.size ();
             t.start ();
             simplify_radial_distance <2> (begin, end, tol.toFloat(),
                                           std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            // done
-            emit SignalCleaningConvertedPolyline ();
-            delete [] generatedPoints;
             break;
         }
         case QVECTOR_DOUBLE:
@@ -208,45 +259,41 @@ namespace psimpl {
         case VECTOR_DOUBLE:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::vector <double> generatedPoints = mGeneratedCoords.toStdVector ();
+            Convert (VECTOR_DOUBLE);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::vector <double>::const_iterator begin = generatedPoints.begin ();
-            std::vector <double>::const_iterator end = generatedPoints.end ();
+            std::vector <double>::const_iterator begin = mDoubleCoords.begin ();
+            std::vector <double>::const_iterator end = mDoubleCoords.end ();
             t.start ();
             simplify_radial_distance <2> (begin, end, tol.toDouble (),
                                           std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         case LIST_LONGLONG:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::list <long long> generatedPoints;
-            foreach (double coord, mGeneratedCoords) {
-                generatedPoints.push_back (coord);
-            }
+            Convert (LIST_LONGLONG);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::list <long long>::const_iterator begin = generatedPoints.begin ();
-            std::list <long long>::const_iterator end = generatedPoints.end ();
+            std::list <long long>::const_iterator begin = mLongLongCoords.begin ();
+            std::list <long long>::const_iterator end = mLongLongCoords.end ();
             t.start ();
             simplify_radial_distance <2> (begin, end, tol.toLongLong (),
                                           std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         default:
             break;
         }
-        DoSignalSimplifiedPolyline (duration);
+        DoSignalSimplifiedPolyline (request, duration);
     }
 
-    void DPWorker::SimplifyPD (Container cont, QString tol, int repeat) {
+    void DPWorker::SimplifyPD (int request, Container cont, QString tol, int repeat) {
+        if (IsStale (request))
+            return;
+
         QTime t;
         int duration = 0;
 
@@ -256,22 +303,15 @@ namespace psimpl {
         case ARRAY_FLOAT:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            float* generatedPoints = new float [mGeneratedCoords.size ()];
-            for (int c=0; c<mGeneratedCoords.size (); c++) {
-                generatedPoints [c] = mGeneratedCoords [c];
-            }
+            Convert (ARRAY_FLOAT);
             // simplify
             emit SignalSimplifyingPolyline ();
-            const float* begin = generatedPoints;
-            const float* end = generatedPoints + mGeneratedCoords.size ();
+            const float* begin = mFloatCoords.constData ();
+            const float* end = mFloatCoords.constData () + mFloatCoords.size ();
             t.start ();
             simplify_perpendicular_distance <2> (begin, end, tol.toFloat(), repeat,
                                                  std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            // done
-            emit SignalCleaningConvertedPolyline ();
-            delete [] generatedPoints;
             break;
         }
         case QVECTOR_DOUBLE:
@@ -289,46 +329,42 @@ namespace psimpl {
         case VECTOR_DOUBLE:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::vector <double> generatedPoints = mGeneratedCoords.toStdVector ();
+            Convert (VECTOR_DOUBLE);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::vector <double>::const_iterator begin = generatedPoints.begin ();
-            std::vector <double>::const_iterator end = generatedPoints.end ();
+            std::vector <double>::const_iterator begin = mDoubleCoords.begin ();
+            std::vector <double>::const_iterator end = mDoubleCoords.end ();
             t.start ();
             simplify_perpendicular_distance <2> (begin, end, tol.toDouble (), repeat,
                                                  std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         case LIST_LONGLONG:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::list <long long> generatedPoints;
-            foreach (double coord, mGeneratedCoords) {
-                generatedPoints.push_back (coord);
-            }
+            Convert (LIST_LONGLONG);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::list <long long>::const_iterator begin = generatedPoints.begin ();
-            std::list <long long>::const_iterator end = generatedPoints.end ();
+            std::list <long long>::const_iterator begin = mLongLongCoords.begin ();
+            std::list <long long>::const_iterator end = mLongLongCoords.end ();
             t.start ();
             simplify_perpendicular_distance <2> (begin, end, tol.toLongLong (), repeat,
                                                  std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         default:
             break;
         }
-        DoSignalSimplifiedPolyline (duration);
+        DoSignalSimplifiedPolyline (request, duration);
     }
 
-    void DPWorker::SimplifyRW (Container cont, QString tol)
+    void DPWorker::SimplifyRW (int request, Container cont, QString tol)
     {
+        if (IsStale (request))
+            return;
+
         QTime t;
         int duration = 0;
 
@@ -338,22 +374,15 @@ namespace psimpl {
         case ARRAY_FLOAT:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            float* generatedPoints = new float [mGeneratedCoords.size ()];
-            for (int c=0; c<mGeneratedCoords.size (); c++) {
-                generatedPoints [c] = mGeneratedCoords [c];
-            }
+            Convert (ARRAY_FLOAT);
             // simplify
             emit SignalSimplifyingPolyline ();
-            const float* begin = generatedPoints;
-            const float* end = generatedPoints + mGeneratedCoords.size ();
+            const float* begin = mFloatCoords.constData ();
+            const float* end = mFloatCoords.constData () + mFloatCoords.size ();
             t.start ();
             simplify_reumann_witkam <2> (begin, end, tol.toFloat(),
                                          std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            // done
-            emit SignalCleaningConvertedPolyline ();
-            delete [] generatedPoints;
             break;
         }
         case QVECTOR_DOUBLE:
@@ -371,45 +400,41 @@ namespace psimpl {
         case VECTOR_DOUBLE:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::vector <double> generatedPoints = mGeneratedCoords.toStdVector ();
+            Convert (VECTOR_DOUBLE);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::vector <double>::const_iterator begin = generatedPoints.begin ();
-            std::vector <double>::const_iterator end = generatedPoints.end ();
+            std::vector <double>::const_iterator begin = mDoubleCoords.begin ();
+            std::vector <double>::const_iterator end = mDoubleCoords.end ();
             t.start ();
             simplify_reumann_witkam <2> (begin, end, tol.toDouble (),
                                          std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         case LIST_LONGLONG:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::list <long long> generatedPoints;
-            foreach (double coord, mGeneratedCoords) {
-                generatedPoints.push_back (coord);
-            }
+            Convert (LIST_LONGLONG);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::list <long long>::const_iterator begin = generatedPoints.begin ();
-            std::list <long long>::const_iterator end = generatedPoints.end ();
+            std::list <long long>::const_iterator begin = mLongLongCoords.begin ();
+            std::list <long long>::const_iterator end = mLongLongCoords.end ();
             t.start ();
             simplify_reumann_witkam <2> (begin, end, tol.toLongLong (),
                                          std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         default:
             break;
         }
-        DoSignalSimplifiedPolyline (duration);
+        DoSignalSimplifiedPolyline (request, duration);
     }
 
-    void DPWorker::SimplifyOp (Container cont, QString minTol, QString maxTol) {
+    void DPWorker::SimplifyOp (int request, Container cont, QString minTol, QString maxTol) {
+        if (IsStale (request))
+            return;
+
         QTime t;
         int duration = 0;
 
@@ -419,22 +444,15 @@ namespace psimpl {
         case ARRAY_FLOAT:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            float* generatedPoints = new float [mGeneratedCoords.size ()];
-            for (int c=0; c<mGeneratedCoords.size (); c++) {
-                generatedPoints [c] = mGeneratedCoords [c];
-            }
+            Convert (ARRAY_FLOAT);
             // simplify
             emit SignalSimplifyingPolyline ();
-            const float* begin = generatedPoints;
-            const float* end = generatedPoints + mGeneratedCoords.size ();
+            const float* begin = mFloatCoords.constData ();
+            const float* end = mFloatCoords.constData () + mFloatCoords.size ();
             t.start ();
             simplify_opheim <2> (begin, end, minTol.toFloat(), maxTol.toFloat(),
                                  std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            // done
-            emit SignalCleaningConvertedPolyline ();
-            delete [] generatedPoints;
             break;
         }
         case QVECTOR_DOUBLE:
@@ -452,45 +470,41 @@ namespace psimpl {
         case VECTOR_DOUBLE:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::vector <double> generatedPoints = mGeneratedCoords.toStdVector ();
+            Convert (VECTOR_DOUBLE);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::vector <double>::const_iterator begin = generatedPoints.begin ();
-            std::vector <double>::const_iterator end = generatedPoints.end ();
+            std::vector <double>::const_iterator begin = mDoubleCoords.begin ();
+            std::vector <double>::const_iterator end = mDoubleCoords.end ();
             t.start ();
             simplify_opheim <2> (begin, end, minTol.toDouble(), maxTol.toDouble(),
                                  std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         case LIST_LONGLONG:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::list <long long> generatedPoints;
-            foreach (double coord, mGeneratedCoords) {
-                generatedPoints.push_back (coord);
-            }
+            Convert (LIST_LONGLONG);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::list <long long>::const_iterator begin = generatedPoints.begin ();
-            std::list <long long>::const_iterator end = generatedPoints.end ();
+            std::list <long long>::const_iterator begin = mLongLongCoords.begin ();
+            std::list <long long>::const_iterator end = mLongLongCoords.end ();
             t.start ();
             simplify_opheim <2> (begin, end, minTol.toLongLong(), maxTol.toLongLong(),
                                  std::back_inserter (mSimplifiedCoords));
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         default:
             break;
         }
-        DoSignalSimplifiedPolyline (duration);
+        DoSignalSimplifiedPolyline (request, duration);
     }
 
-    void DPWorker::SimplifyLa (Container cont, QString tol, int size) {
+    void DPWorker::SimplifyLa (int request, Container cont, QString tol, int size) {
+        if (!Start (request))
+            return;
+
         QTime t;
         int duration = 0;
 
@@ -500,22 +514,15 @@ namespace psimpl {
         case ARRAY_FLOAT:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            float* generatedPoints = new float [mGeneratedCoords.size ()];
-            for (int c=0; c<mGeneratedCoords.size (); c++) {
-                generatedPoints [c] = mGeneratedCoords [c];
-            }
+            Convert (ARRAY_FLOAT);
             // simplify
             emit SignalSimplifyingPolyline ();
-            const float* begin = generatedPoints;
-            const float* end = generatedPoints + mGeneratedCoords.size ();
+            const float* begin = mFloatCoords.constData ();
+            const float* end = mFloatCoords.constData () + mFloatCoords.size ();
             t.start ();
             simplify_lang <2> (begin, end, tol.toFloat(), size,
-                               std::back_inserter (mSimplifiedCoords));
+                               std::back_inserter (mSimplifiedCoords), mControl);
             duration = t.elapsed ();
-            // done
-            emit SignalCleaningConvertedPolyline ();
-            delete [] generatedPoints;
             break;
         }
         case QVECTOR_DOUBLE:
@@ -526,52 +533,48 @@ namespace psimpl {
             QVector <qreal>::const_iterator end = mGeneratedCoords.constEnd ();
             t.start ();
             simplify_lang <2> (begin, end, tol.toDouble(), size,
-                               std::back_inserter (mSimplifiedCoords));
+                               std::back_inserter (mSimplifiedCoords), mControl);
             duration = t.elapsed ();
             break;
         }
         case VECTOR_DOUBLE:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::vector <double> generatedPoints = mGeneratedCoords.toStdVector ();
+            Convert (VECTOR_DOUBLE);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::vector <double>::const_iterator begin = generatedPoints.begin ();
-            std::vector <double>::const_iterator end = generatedPoints.end ();
+            std::vector <double>::const_iterator begin = mDoubleCoords.begin ();
+            std::vector <double>::const_iterator end = mDoubleCoords.end ();
             t.start ();
             simplify_lang <2> (begin, end, tol.toDouble(), size,
-                               std::back_inserter (mSimplifiedCoords));
+                               std::back_inserter (mSimplifiedCoords), mControl);
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         case LIST_LONGLONG:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::list <long long> generatedPoints;
-            foreach (double coord, mGeneratedCoords) {
-                generatedPoints.push_back (coord);
-            }
+            Convert (LIST_LONGLONG);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::list <long long>::const_iterator begin = generatedPoints.begin ();
-            std::list <long long>::const_iterator end = generatedPoints.end ();
+            std::list <long long>::const_iterator begin = mLongLongCoords.begin ();
+            std::list <long long>::const_iterator end = mLongLongCoords.end ();
             t.start ();
             simplify_lang <2> (begin, end, tol.toLongLong(), size,
-                               std::back_inserter (mSimplifiedCoords));
+                               std::back_inserter (mSimplifiedCoords), mControl);
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         default:
             break;
         }
-        DoSignalSimplifiedPolyline (duration);
+        DoSignalSimplifiedPolyline (request, duration);
     }
 
-    void DPWorker::SimplifyDP (Container cont, QString tol) {
+    void DPWorker::SimplifyDP (int request, Container cont, QString tol) {
+        if (!Start (request))
+            return;
+
         QTime t;
         int duration = 0;
 
@@ -581,22 +584,15 @@ namespace psimpl {
         case ARRAY_FLOAT:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            float* generatedPoints = new float [mGeneratedCoords.size ()];
-            for (int c=0; c<mGeneratedCoords.size (); c++) {
-                generatedPoints [c] = mGeneratedCoords [c];
-            }
+            Convert (ARRAY_FLOAT);
             // simplify
             emit SignalSimplifyingPolyline ();
-            const float* begin = generatedPoints;
-            const float* end = generatedPoints + mGeneratedCoords.size ();
+            const float* begin = mFloatCoords.constData ();
+            const float* end = mFloatCoords.constData () + mFloatCoords.size ();
             t.start ();
             simplify_douglas_peucker <2> (begin, end, tol.toFloat(),
-                                          std::back_inserter (mSimplifiedCoords));
+                                          std::back_inserter (mSimplifiedCoords), mControl);
             duration = t.elapsed ();
-            // done
-            emit SignalCleaningConvertedPolyline ();
-            delete [] generatedPoints;
             break;
         }
         case QVECTOR_DOUBLE:
@@ -607,52 +603,48 @@ namespace psimpl {
             QVector <qreal>::const_iterator end = mGeneratedCoords.constEnd ();
             t.start ();
             simplify_douglas_peucker <2> (begin, end, tol.toDouble (),
-                                          std::back_inserter (mSimplifiedCoords));
+                                          std::back_inserter (mSimplifiedCoords), mControl);
             duration = t.elapsed ();
             break;
         }
         case VECTOR_DOUBLE:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::vector <double> generatedPoints = mGeneratedCoords.toStdVector ();
+            Convert (VECTOR_DOUBLE);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::vector <double>::const_iterator begin = generatedPoints.begin ();
-            std::vector <double>::const_iterator end = generatedPoints.end ();
+            std::vector <double>::const_iterator begin = mDoubleCoords.begin ();
+            std::vector <double>::const_iterator end = mDoubleCoords.end ();
             t.start ();
             simplify_douglas_peucker <2> (begin, end, tol.toDouble (),
-                                          std::back_inserter (mSimplifiedCoords));
+                                          std::back_inserter (mSimplifiedCoords), mControl);
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         case LIST_LONGLONG:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::list <long long> generatedPoints;
-            foreach (double coord, mGeneratedCoords) {
-                generatedPoints.push_back (coord);
-            }
+            Convert (LIST_LONGLONG);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::list <long long>::const_iterator begin = generatedPoints.begin ();
-            std::list <long long>::const_iterator end = generatedPoints.end ();
+            std::list <long long>::const_iterator begin = mLongLongCoords.begin ();
+            std::list <long long>::const_iterator end = mLongLongCoords.end ();
             t.start ();
             simplify_douglas_peucker <2> (begin, end, tol.toLongLong (),
-                                          std::back_inserter (mSimplifiedCoords));
+                                          std::back_inserter (mSimplifiedCoords), mControl);
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         default:
             break;
         }
-        DoSignalSimplifiedPolyline (duration);
+        DoSignalSimplifiedPolyline (request, duration);
     }
 
-    void DPWorker::SimplifyDP_variant (Container cont, int count) {
+    void DPWorker::SimplifyDP_variant (int request, Container cont, int count) {
+        if (!Start (request))
+            return;
+
         QTime t;
         int duration = 0;
 
@@ -662,22 +654,15 @@ namespace psimpl {
         case ARRAY_FLOAT:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            float* generatedPoints = new float [mGeneratedCoords.size ()];
-            for (int c=0; c<mGeneratedCoords.size (); c++) {
-                generatedPoints [c] = mGeneratedCoords [c];
-            }
+            Convert (ARRAY_FLOAT);
             // simplify
             emit SignalSimplifyingPolyline ();
-            const float* begin = generatedPoints;
-            const float* end = generatedPoints + mGeneratedCoords.size ();
+            const float* begin = mFloatCoords.constData ();
+            const float* end = mFloatCoords.constData () + mFloatCoords.size ();
             t.start ();
             simplify_douglas_peucker_n <2> (begin, end, count,
-                                            std::back_inserter (mSimplifiedCoords));
+                                            std::back_inserter (mSimplifiedCoords), mControl);
             duration = t.elapsed ();
-            // done
-            emit SignalCleaningConvertedPolyline ();
-            delete [] generatedPoints;
             break;
         }
         case QVECTOR_DOUBLE:
@@ -688,52 +673,48 @@ namespace psimpl {
             QVector <qreal>::const_iterator end = mGeneratedCoords.constEnd ();
             t.start ();
             simplify_douglas_peucker_n <2> (begin, end, count,
-                                            std::back_inserter (mSimplifiedCoords));
+                                            std::back_inserter (mSimplifiedCoords), mControl);
             duration = t.elapsed ();
             break;
         }
         case VECTOR_DOUBLE:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::vector <double> generatedPoints = mGeneratedCoords.toStdVector ();
+            Convert (VECTOR_DOUBLE);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::vector <double>::const_iterator begin = generatedPoints.begin ();
-            std::vector <double>::const_iterator end = generatedPoints.end ();
+            std::vector <double>::const_iterator begin = mDoubleCoords.begin ();
+            std::vector <double>::const_iterator end = mDoubleCoords.end ();
             t.start ();
             simplify_douglas_peucker_n <2> (begin, end, count,
-                                            std::back_inserter (mSimplifiedCoords));
+                                            std::back_inserter (mSimplifiedCoords), mControl);
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         case LIST_LONGLONG:
         {
             // convert
-            emit SignalConvertingPolyline ();
-            std::list <long long> generatedPoints;
-            foreach (double coord, mGeneratedCoords) {
-                generatedPoints.push_back (coord);
-            }
+            Convert (LIST_LONGLONG);
             // simplify
             emit SignalSimplifyingPolyline ();
-            std::list <long long>::const_iterator begin = generatedPoints.begin ();
-            std::list <long long>::const_iterator end = generatedPoints.end ();
+            std::list <long long>::const_iterator begin = mLongLongCoords.begin ();
+            std::list <long long>::const_iterator end = mLongLongCoords.end ();
             t.start ();
             simplify_douglas_peucker_n <2> (begin, end, count,
-                                            std::back_inserter (mSimplifiedCoords));
+                                            std::back_inserter (mSimplifiedCoords), mControl);
             duration = t.elapsed ();
-            emit SignalCleaningConvertedPolyline ();
             break;
         }
         default:
             break;
         }
-        DoSignalSimplifiedPolyline (duration);
+        DoSignalSimplifiedPolyline (request, duration);
     }
 
-    void DPWorker::SimplifyDP_reference (QString tol) {
+    void DPWorker::SimplifyDP_reference (int request, QString tol) {
+        if (IsStale (request))
+            return;
+
         mSimplifiedCoords.clear();
         // convert generated polyline to Point array
         emit SignalConvertingPolyline ();
@@ -761,10 +742,13 @@ namespace psimpl {
         delete [] generatedPoints;
         delete [] simplifiedPoints;
         
-        DoSignalSimplifiedPolyline (duration);
+        DoSignalSimplifiedPolyline (request, duration);
     }
 
-    void DPWorker::DoSignalSimplifiedPolyline (qreal duration) {
+    void DPWorker::DoSignalSimplifiedPolyline (int request, qreal duration) {
+        if (IsStale (request))
+            return;
+
         bool validStatistics = false;
 
         math::Statistics stats = 
@@ -772,11 +756,15 @@ namespace psimpl {
                 mGeneratedCoords.constBegin (), mGeneratedCoords.constEnd (),
                 mSimplifiedCoords.constBegin (), mSimplifiedCoords.constEnd (), &validStatistics);
 
+        SharedLevelOfDetail lod (new LevelOfDetail (mSimplifiedCoords));
+        if (IsStale (request))
+            return;
+
         if (validStatistics) {
-            emit SignalSimplifiedPolyline (duration, mSimplifiedCoords, stats.max, stats.sum, stats.mean, stats.std);
+            emit SignalSimplifiedPolyline (duration, lod, stats.max, stats.sum, stats.mean, stats.std);
         }
         else {
-            emit SignalSimplifiedPolyline (duration, mSimplifiedCoords);
+            emit SignalSimplifiedPolyline (duration, lod);
         }
     }
 } // namespace psimpl
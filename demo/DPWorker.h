@@ -35,8 +35,13 @@
 #define DPWORKER_H
 
 
+#include "LevelOfDetail.h"
+#include <QtCore/QAtomicInt>
+#include <QtCore/QMetaType>
 #include <QtCore/QObject>
 #include <QtCore/QVector>
+#include <list>
+#include <vector>
 
 
 namespace psimpl {
@@ -53,8 +58,14 @@ namespace psimpl {
         
         Polylines are always generated in a QVector <qreal> container. Before simplification the
         polyline is converted to the specified container type. This allows for easy adding of new 
-        container types.
-        
+        container types. Each conversion is performed once per generated polyline, and is reused by
+        all following simplifications.
+
+        The worker is meant to live in its own thread; its slots are invoked using queued
+        connections. Each request is identified by a number obtained from NewRequest. Requests
+        that are superseded by a newer request, or cancelled, are either skipped or have their
+        results discarded. A running DP, DPn or Lang simplification is stopped as soon as its
+        request becomes stale.
     */
     class DPWorker : public QObject
     {
@@ -63,39 +74,53 @@ namespace psimpl {
     public:
         DPWorker (QObject* inParent = 0);
 
-        void Generate (int inCount);
-        void SimplifyNP (Container cont, int n);
-        void SimplifyRD (Container cont, QString tol);
-        void SimplifyPD (Container cont, QString tol, int repeat);
-        void SimplifyRW (Container cont, QString tol);
-        void SimplifyOp (Container cont, QString minTol, QString maxTol);
-        void SimplifyLa (Container cont, QString tol, int size);
-        void SimplifyDP (Container cont, QString tol);
-        void SimplifyDP_variant (Container cont, int count);
-        void SimplifyDP_reference (QString tol);
-
-        int GetGeneratedPointCount () { return mGeneratedCoords.size () / 2; }
-        int GetSimplifiedGeneratedPointCount () { return mSimplifiedCoords.size () / 2; }
+        //! \brief Returns the number of a new request, which makes all previous requests stale; thread safe.
+        int NewRequest ();
+        //! \brief Makes all previous requests stale; thread safe.
+        void Cancel ();
+
+    public slots:
+        void Generate (int request, int inCount);
+        void SimplifyNP (int request, Container cont, int n);
+        void SimplifyRD (int request, Container cont, QString tol);
+        void SimplifyPD (int request, Container cont, QString tol, int repeat);
+        void SimplifyRW (int request, Container cont, QString tol);
+        void SimplifyOp (int request, Container cont, QString minTol, QString maxTol);
+        void SimplifyLa (int request, Container cont, QString tol, int size);
+        void SimplifyDP (int request, Container cont, QString tol);
+        void SimplifyDP_variant (int request, Container cont, int count);
+        void SimplifyDP_reference (int request, QString tol);
 
     private:
-        void DoSignalSimplifiedPolyline (qreal duration);
+        bool IsStale (int request) const;
+        //! \brief Prepares mControl for a simplification; returns false when the request is stale.
+        bool Start (int request);
+        void Convert (Container cont);
+        void DoSignalSimplifiedPolyline (int request, qreal duration);
 
     signals:
         void SignalGeneratingPolyline ();
         void SignalConvertingPolyline ();
         void SignalSimplifyingPolyline ();
-        void SignalCleaningConvertedPolyline ();
-        
-        void SignalGeneratedPolyline (int duration, QVector <qreal>& polyline);
-        void SignalSimplifiedPolyline (int duration, QVector <qreal>& polyline);
-        void SignalSimplifiedPolyline (int duration, QVector <qreal>& polyline, double max, double sum, double mean, double std);
+
+        void SignalGeneratedPolyline (int duration, SharedLevelOfDetail polyline);
+        void SignalSimplifiedPolyline (int duration, SharedLevelOfDetail polyline);
+        void SignalSimplifiedPolyline (int duration, SharedLevelOfDetail polyline, double max, double sum, double mean, double std);
 
     private:
         QVector <qreal> mGeneratedCoords;
         QVector <qreal> mSimplifiedCoords;
+        QVector <float> mFloatCoords;           //! generated polyline converted to ARRAY_FLOAT
+        std::vector <double> mDoubleCoords;     //! generated polyline converted to VECTOR_DOUBLE
+        std::list <long long> mLongLongCoords;  //! generated polyline converted to LIST_LONGLONG
+        QAtomicInt mRequest;                    //! the most recent request
+        SimplificationControl mControl;         //! stops DP, DPn and Lang when their request becomes stale
     };
 
 } // namespace psimpl
 
 
+Q_DECLARE_METATYPE (psimpl::Container)
+
+
 #endif // DPWORKER_H
@@ -0,0 +1,133 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#include "LevelOfDetail.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <QtGui/QPainter>
+
+
+namespace psimpl {
+
+    //! number of points per tile, including the point that is shared with the next tile
+    static const int TILE_SIZE = 1024;
+    //! the range of LODs, which limits the tolerance to [2^-60, 2^60]
+    static const int MIN_LEVEL = -60;
+    static const int MAX_LEVEL = 60;
+
+    //! \brief Unlike QRectF::intersects, also handles rectangles of zero width or height.
+    static bool Overlaps (const QRectF& a, const QRectF& b)
+    {
+        return a.left () <= b.right () && b.left () <= a.right () &&
+               a.top () <= b.bottom () && b.top () <= a.bottom ();
+    }
+
+    LevelOfDetail::LevelOfDetail (const QVector <qreal>& polyline) :
+        mCoords (polyline),
+        mTiles (qMax (2 * polyline.size (), 1 << 20))
+    {
+        int pointCount = PointCount ();
+        if (!pointCount)
+            return;
+
+        qreal minx = mCoords [0];
+        qreal maxx = mCoords [0];
+        qreal miny = mCoords [1];
+        qreal maxy = mCoords [1];
+        for (int i=1; i<pointCount; i++) {
+            minx = qMin (minx, mCoords [i*2]);
+            maxx = qMax (maxx, mCoords [i*2]);
+            miny = qMin (miny, mCoords [i*2+1]);
+            maxy = qMax (maxy, mCoords [i*2+1]);
+        }
+        mBounds = QRectF (QPointF (minx, miny), QPointF (maxx, maxy));
+        mHierarchy.Build (mCoords.constBegin (), mCoords.constEnd ());
+    }
+
+    void LevelOfDetail::Draw (QPainter& painter, const QRectF& view, qreal pixelSize)
+    {
+        if (!mHierarchy.PointCount () || !(pixelSize > 0))
+            return;
+
+        // the coarsest LOD whose tolerance does not exceed one pixel
+        int level = (int) std::floor (std::log (pixelSize) / std::log (2.0));
+        level = qBound (MIN_LEVEL, level, MAX_LEVEL);
+
+        const Tiles& tiles = GetTiles (level);
+        foreach (const Tile& tile, tiles) {
+            if (Overlaps (tile.bounds, view)) {
+                painter.drawPath (tile.path);
+            }
+        }
+    }
+
+    const LevelOfDetail::Tiles& LevelOfDetail::GetTiles (int level)
+    {
+        Tiles* tiles = mTiles.object (level);
+        if (tiles)
+            return *tiles;
+
+        std::vector <unsigned> indices;
+        mHierarchy.DouglasPeuckerIndices ((qreal) std::ldexp (1.0, level),
+                                          std::back_inserter (indices));
+
+        // split the LOD into tiles that share their end points
+        tiles = new Tiles;
+        for (std::size_t first = 0; first + 1 < indices.size (); first += TILE_SIZE - 1) {
+            std::size_t last = std::min (first + TILE_SIZE, indices.size ());
+            const qreal* point = mCoords.constData () + 2 * indices [first];
+            qreal minx = point [0];
+            qreal maxx = point [0];
+            qreal miny = point [1];
+            qreal maxy = point [1];
+
+            Tile tile;
+            tile.path.moveTo (point [0], point [1]);
+            for (std::size_t i = first + 1; i < last; i++) {
+                point = mCoords.constData () + 2 * indices [i];
+                tile.path.lineTo (point [0], point [1]);
+                minx = qMin (minx, point [0]);
+                maxx = qMax (maxx, point [0]);
+                miny = qMin (miny, point [1]);
+                maxy = qMax (maxy, point [1]);
+            }
+            tile.bounds = QRectF (QPointF (minx, miny), QPointF (maxx, maxy));
+            tiles->push_back (tile);
+        }
+        // the maximum cost of the cache exceeds the point count, so the insert always succeeds
+        mTiles.insert (level, tiles, (int) indices.size ());
+        return *tiles;
+    }
+
+} // namespace psimpl
@@ -0,0 +1,100 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#ifndef LEVELOFDETAIL_H
+#define LEVELOFDETAIL_H
+
+
+#include "../lib/psimpl.h"
+#include <QtCore/QCache>
+#include <QtCore/QMetaType>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+#include <QtGui/QPainterPath>
+
+
+class QPainter;
+
+
+namespace psimpl {
+
+    /*!
+        \brief A polyline that is drawn at screen resolution.
+
+        On construction a Douglas-Peucker hierarchy is built for the polyline, which is
+        expensive and should be done outside the GUI thread. Afterwards each level of detail
+        (LOD) is obtained from the hierarchy in time proportional to its point count. LOD k is
+        the DP simplification for tolerance 2^k, and Draw selects the coarsest LOD whose
+        tolerance does not exceed one pixel.
+
+        Each LOD is converted to a sequence of painter paths (tiles) of a fixed point count. Only
+        the tiles that intersect the visible area are drawn. The tiles are cached per LOD, so
+        panning and zooming back and forth does not rebuild them. Drawing is not thread safe,
+        and should only be done from the GUI thread.
+    */
+    class LevelOfDetail
+    {
+    public:
+        explicit LevelOfDetail (const QVector <qreal>& polyline);
+
+        int PointCount () const { return mCoords.size () / 2; }
+        QRectF BoundingRect () const { return mBounds; }
+        void Draw (QPainter& painter, const QRectF& view, qreal pixelSize);
+
+    private:
+        //! \brief A part of a LOD, including its bounds.
+        struct Tile
+        {
+            QPainterPath path;
+            QRectF bounds;
+        };
+        typedef QVector <Tile> Tiles;
+
+        const Tiles& GetTiles (int level);
+
+    private:
+        QVector <qreal> mCoords;
+        QRectF mBounds;
+        DouglasPeuckerHierarchy <2, qreal> mHierarchy;
+        QCache <int, Tiles> mTiles;     //! tiles per LOD, the cost is the point count
+    };
+
+    typedef QSharedPointer <LevelOfDetail> SharedLevelOfDetail;
+
+} // namespace psimpl
+
+
+Q_DECLARE_METATYPE (psimpl::SharedLevelOfDetail)
+
+
+#endif // LEVELOFDETAIL_H
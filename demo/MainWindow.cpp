@@ -36,15 +36,24 @@
 #include "DPWorker.h"
 #include <cmath>
 #include <QtGui/QToolButton>
+#include <QtCore/QMetaObject>
 
 
 namespace psimpl {
 
     MainWindow::MainWindow (QWidget *parent) :
         QMainWindow (parent),
-        ui (new Ui::MainWindow)
+        ui (new Ui::MainWindow),
+        mGeneratedPointCount (0),
+        mSimplifying (false)
     {
-        mWorker = new DPWorker (this);
+        qRegisterMetaType <Container> ("Container");
+        qRegisterMetaType <SharedLevelOfDetail> ("SharedLevelOfDetail");
+
+        // the worker lives in its own thread, so the window stays responsive
+        mWorker = new DPWorker;
+        mWorker->moveToThread (&mWorkerThread);
+        mWorkerThread.start ();
 
         ui->setupUi (this);
         ui->polyTypeComboBox->setCurrentIndex(VECTOR_DOUBLE);
@@ -58,19 +67,37 @@ namespace psimpl {
                  this, SLOT (SlotConvertingPolyline ()));
         connect (mWorker, SIGNAL (SignalSimplifyingPolyline ()),
                  this, SLOT (SlotSimplifyingPolyline ()));
-        connect (mWorker, SIGNAL (SignalCleaningConvertedPolyline ()),
-                 this, SLOT (SlotCleaningConvertedPolyline ()));
-
-        connect (mWorker, SIGNAL (SignalGeneratedPolyline (int, QVector <qreal>&)),
-                 this, SLOT (SlotGeneratedPolyline (int, QVector <qreal>&)));
-        connect (mWorker, SIGNAL (SignalSimplifiedPolyline (int, QVector <qreal>&)),
-                 this, SLOT (SlotSimplifiedPolyline (int, QVector <qreal>&)));
-        connect (mWorker, SIGNAL (SignalSimplifiedPolyline (int, QVector <qreal>&, double, double, double, double)),
-                 this, SLOT (SlotSimplifiedPolyline (int, QVector <qreal>&, double, double, double, double)));
+
+        connect (mWorker, SIGNAL (SignalGeneratedPolyline (int, SharedLevelOfDetail)),
+                 this, SLOT (SlotGeneratedPolyline (int, SharedLevelOfDetail)));
+        connect (mWorker, SIGNAL (SignalSimplifiedPolyline (int, SharedLevelOfDetail)),
+                 this, SLOT (SlotSimplifiedPolyline (int, SharedLevelOfDetail)));
+        connect (mWorker, SIGNAL (SignalSimplifiedPolyline (int, SharedLevelOfDetail, double, double, double, double)),
+                 this, SLOT (SlotSimplifiedPolyline (int, SharedLevelOfDetail, double, double, double, double)));
+
+        // changing any parameter cancels a pending simplification
+        connect (ui->algorithmComboBox, SIGNAL (currentIndexChanged (int)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->polyTypeComboBox, SIGNAL (currentIndexChanged (int)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->npSpinBox, SIGNAL (valueChanged (int)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->pdSpinBox, SIGNAL (valueChanged (int)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->lookAheadLaSpinBox, SIGNAL (valueChanged (int)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->dpvSpinBox, SIGNAL (valueChanged (int)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->rdLineEdit, SIGNAL (textChanged (QString)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->pdLineEdit, SIGNAL (textChanged (QString)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->rwLineEdit, SIGNAL (textChanged (QString)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->minOpLineEdit, SIGNAL (textChanged (QString)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->maxOpLineEdit, SIGNAL (textChanged (QString)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->laLineEdit, SIGNAL (textChanged (QString)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->dpLineEdit, SIGNAL (textChanged (QString)), this, SLOT (SlotParametersChanged ()));
+        connect (ui->dprLineEdit, SIGNAL (textChanged (QString)), this, SLOT (SlotParametersChanged ()));
     }
 
     MainWindow::~MainWindow ()
     {
+        // the current request is finished before the thread stops
+        mWorker->Cancel ();
+        mWorkerThread.quit ();
+        mWorkerThread.wait ();
         delete ui;
         delete mWorker;
     }
@@ -105,58 +132,100 @@ namespace psimpl {
         ui->togglePushButton->setDisabled (true);
     }
 
+    void MainWindow::BeginSimplification ()
+    {
+        if (!mSimplifying) {
+            QApplication::setOverrideCursor (QCursor (Qt::WaitCursor));
+            mSimplifying = true;
+        }
+    }
+
+    void MainWindow::EndSimplification ()
+    {
+        if (mSimplifying) {
+            QApplication::restoreOverrideCursor ();
+            mSimplifying = false;
+        }
+    }
+
     void MainWindow::on_generatePushButton_clicked ()
     {
+        // generating supersedes any pending simplification
+        EndSimplification ();
         QApplication::setOverrideCursor (QCursor (Qt::WaitCursor));
         DisableButtons ();
-        mWorker->Generate (ui->polyPointCountSpinBox->value ());
+        QMetaObject::invokeMethod (mWorker, "Generate", Qt::QueuedConnection,
+            Q_ARG (int, mWorker->NewRequest ()), Q_ARG (int, ui->polyPointCountSpinBox->value ()));
     }
 
     void MainWindow::on_simplifyPushButton_clicked ()
     {
-        QApplication::setOverrideCursor (QCursor (Qt::WaitCursor));
-        DisableButtons ();
+        // the buttons stay enabled, so that a new simplification can supersede the pending one
+        BeginSimplification ();
+        int request = mWorker->NewRequest ();
+        Container cont = (Container)ui->polyTypeComboBox->currentIndex ();
 
         switch (ui->algorithmComboBox->currentIndex ())
         {
         case NTH_POINT:
-            mWorker->SimplifyNP ((Container)ui->polyTypeComboBox->currentIndex (), ui->npSpinBox->value ());
+            QMetaObject::invokeMethod (mWorker, "SimplifyNP", Qt::QueuedConnection,
+                Q_ARG (int, request), Q_ARG (Container, cont), Q_ARG (int, ui->npSpinBox->value ()));
             break;
 
         case RADIAL_DISTANCE:
-            mWorker->SimplifyRD ((Container)ui->polyTypeComboBox->currentIndex (), ui->rdLineEdit->text ());
+            QMetaObject::invokeMethod (mWorker, "SimplifyRD", Qt::QueuedConnection,
+                Q_ARG (int, request), Q_ARG (Container, cont), Q_ARG (QString, ui->rdLineEdit->text ()));
             break;
 
         case PERPENDICULAR_DISTANCE:
-            mWorker->SimplifyPD ((Container)ui->polyTypeComboBox->currentIndex (), ui->pdLineEdit->text (), ui->pdSpinBox->value ());
+            QMetaObject::invokeMethod (mWorker, "SimplifyPD", Qt::QueuedConnection,
+                Q_ARG (int, request), Q_ARG (Container, cont), Q_ARG (QString, ui->pdLineEdit->text ()),
+                Q_ARG (int, ui->pdSpinBox->value ()));
             break;
 
         case REUMANN_WITKAM:
-            mWorker->SimplifyRW ((Container)ui->polyTypeComboBox->currentIndex (), ui->rwLineEdit->text ());
+            QMetaObject::invokeMethod (mWorker, "SimplifyRW", Qt::QueuedConnection,
+                Q_ARG (int, request), Q_ARG (Container, cont), Q_ARG (QString, ui->rwLineEdit->text ()));
             break;
 
         case OPHEIM:
-            mWorker->SimplifyOp ((Container)ui->polyTypeComboBox->currentIndex (), ui->minOpLineEdit->text (), ui->maxOpLineEdit->text ());
+            QMetaObject::invokeMethod (mWorker, "SimplifyOp", Qt::QueuedConnection,
+                Q_ARG (int, request), Q_ARG (Container, cont), Q_ARG (QString, ui->minOpLineEdit->text ()),
+                Q_ARG (QString, ui->maxOpLineEdit->text ()));
             break;
 
         case LANG:
-            mWorker->SimplifyLa ((Container)ui->polyTypeComboBox->currentIndex (), ui->laLineEdit->text (), ui->lookAheadLaSpinBox->value ());
+            QMetaObject::invokeMethod (mWorker, "SimplifyLa", Qt::QueuedConnection,
+                Q_ARG (int, request), Q_ARG (Container, cont), Q_ARG (QString, ui->laLineEdit->text ()),
+                Q_ARG (int, ui->lookAheadLaSpinBox->value ()));
             break;
 
         case DOUGLAS_PEUCKER:
-            mWorker->SimplifyDP ((Container)ui->polyTypeComboBox->currentIndex (), ui->dpLineEdit->text ());
+            QMetaObject::invokeMethod (mWorker, "SimplifyDP", Qt::QueuedConnection,
+                Q_ARG (int, request), Q_ARG (Container, cont), Q_ARG (QString, ui->dpLineEdit->text ()));
             break;
 
         case DOUGLAS_PEUCKER_VARIANT:
-            mWorker->SimplifyDP_variant ((Container)ui->polyTypeComboBox->currentIndex (), ui->dpvSpinBox->value ());
+            QMetaObject::invokeMethod (mWorker, "SimplifyDP_variant", Qt::QueuedConnection,
+                Q_ARG (int, request), Q_ARG (Container, cont), Q_ARG (int, ui->dpvSpinBox->value ()));
             break;
 
         case DOUGLAS_PEUCKER_REFERENCE:
-            mWorker->SimplifyDP_reference (ui->dprLineEdit->text ());
+            QMetaObject::invokeMethod (mWorker, "SimplifyDP_reference", Qt::QueuedConnection,
+                Q_ARG (int, request), Q_ARG (QString, ui->dprLineEdit->text ()));
             break;
         }
     }
 
+    void MainWindow::SlotParametersChanged ()
+    {
+        if (mSimplifying) {
+            mWorker->Cancel ();
+            EndSimplification ();
+            ui->statusBar->showMessage ("Simplification cancelled");
+        }
+    }
+
     void MainWindow::on_algorithmComboBox_currentIndexChanged (int index)
     {
         if (index == DOUGLAS_PEUCKER_REFERENCE) {
@@ -204,13 +273,10 @@ namespace psimpl {
         ui->statusBar->showMessage ("Simplifying polyline...");
     }
 
-    void MainWindow::SlotCleaningConvertedPolyline () {
-        ui->statusBar->showMessage ("Deleting converted polyline...");
-    }
-
-    void MainWindow::SlotGeneratedPolyline (int duration, QVector <qreal>& polyline)
+    void MainWindow::SlotGeneratedPolyline (int duration, SharedLevelOfDetail polyline)
     {
         ui->statusBar->showMessage (QString ("Generation took %1 ms").arg (duration));
+        mGeneratedPointCount = polyline->PointCount ();
         ui->renderArea->SetGeneratedPolyline (polyline);
         ui->simplGroupBox->setEnabled (true);
         EnableButtons ();
@@ -218,9 +284,9 @@ namespace psimpl {
         update();
     }
 
-    void MainWindow::SlotSimplifiedPolyline (int duration, QVector <qreal>& polyline)
+    void MainWindow::SlotSimplifiedPolyline (int duration, SharedLevelOfDetail polyline)
     {
-        int pointCount = polyline.count () / 2;
+        int pointCount = polyline->PointCount ();
         ui->maxValueLabel->setText ("-");
         ui->sumValueLabel->setText ("-");
         ui->meanValueLabel->setText ("-");
@@ -229,16 +295,15 @@ namespace psimpl {
             QString ("Simplification took %1 ms; %2 (%3%) points remaining").
                 arg (duration).
                 arg (pointCount).
-                arg (100.0 * pointCount / mWorker->GetGeneratedPointCount()));
+                arg (100.0 * pointCount / mGeneratedPointCount));
         ui->renderArea->SetSimplifiedPolyline(polyline);
-        EnableButtons ();
-        QApplication::restoreOverrideCursor ();
+        EndSimplification ();
         update();
     }
 
-    void MainWindow::SlotSimplifiedPolyline (int duration, QVector <qreal>& polyline, double max, double sum, double mean, double std)
+    void MainWindow::SlotSimplifiedPolyline (int duration, SharedLevelOfDetail polyline, double max, double sum, double mean, double std)
     {
-        int pointCount = polyline.count () / 2;
+        int pointCount = polyline->PointCount ();
         ui->maxValueLabel->setText (QString::number (max));
         ui->sumValueLabel->setText (QString::number (sum));
         ui->meanValueLabel->setText (QString::number (mean));
@@ -247,10 +312,9 @@ namespace psimpl {
             QString ("Simplification took %1 ms; %2 (%3%) points remaining").
                 arg (duration).
                 arg (pointCount).
-                arg (100.0 * pointCount / mWorker->GetGeneratedPointCount()));
+                arg (100.0 * pointCount / mGeneratedPointCount));
         ui->renderArea->SetSimplifiedPolyline(polyline);
-        EnableButtons ();
-        QApplication::restoreOverrideCursor ();
+        EndSimplification ();
         update();
     }
 } // namespace psimpl
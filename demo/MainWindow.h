@@ -35,6 +35,8 @@
 #define MAINWINDOW_H
 
 
+#include "LevelOfDetail.h"
+#include <QtCore/QThread>
 #include <QtGui/QMainWindow>
 
 
@@ -79,10 +81,15 @@ namespace psimpl {
     private:
         void EnableButtons ();
         void DisableButtons ();
+        void BeginSimplification ();
+        void EndSimplification ();
 
     private:
         Ui::MainWindow *ui;
         DPWorker* mWorker;
+        QThread mWorkerThread;          //! the thread in which mWorker processes its requests
+        int mGeneratedPointCount;
+        bool mSimplifying;              //! a simplification request is pending
 
 private slots:
     void on_simplifiedPolylineCheckBox_toggled(bool checked);
@@ -94,10 +101,10 @@ private slots:
     void SlotGeneratingPolyline ();
     void SlotConvertingPolyline ();
     void SlotSimplifyingPolyline ();
-    void SlotCleaningConvertedPolyline ();
-    void SlotGeneratedPolyline (int duration, QVector <qreal>& polyline);
-    void SlotSimplifiedPolyline (int duration, QVector <qreal>& polyline);
-    void SlotSimplifiedPolyline (int duration, QVector <qreal>& polyline, double max, double sum, double mean, double std);
+    void SlotParametersChanged ();
+    void SlotGeneratedPolyline (int duration, SharedLevelOfDetail polyline);
+    void SlotSimplifiedPolyline (int duration, SharedLevelOfDetail polyline);
+    void SlotSimplifiedPolyline (int duration, SharedLevelOfDetail polyline, double max, double sum, double mean, double std);
 };
 
 } // namespace psimpl
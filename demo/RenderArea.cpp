@@ -32,7 +32,10 @@
 */
 
 #include "RenderArea.h"
+#include <cmath>
+#include <QtGui/QMouseEvent>
 #include <QtGui/QPainter>
+#include <QtGui/QWheelEvent>
 
 
 namespace psimpl {
@@ -46,78 +49,111 @@ namespace psimpl {
     }
 
     void RenderArea::paintEvent(QPaintEvent * /*inEvent*/) {
-        if (!mGeneratedPolyline.elementCount ())
+        if (!mGeneratedPolyline)
             return;
 
-        QRectF rect = mGeneratedPolyline.boundingRect ();
+        QRectF rect = GetView ();
         if (!rect.isValid ())
             return;
 
         QPainter painter (this);
+        QTransform transform = GetTransform (rect);
+        painter.setTransform (transform);
 
-        if (mKeepAspectRatio) {
-            qreal scale = qMin ((width () - 1) / rect.width (), (height () - 1) / rect.height ());
-            painter.translate ((width () - (rect.width () * scale)) / 2.0,
-                               (height () - (rect.height () * scale)) / 2.0);
-            painter.scale (scale, scale);
-            painter.translate (-rect.left (), -rect.top ());
-        }
-        else {
-            painter.scale ((width () - 1) / rect.width (), (height () - 1) / rect.height ());
-            painter.translate (-rect.left (), -rect.top ());
-        }
+        // the visible area and the size of a pixel, in polyline coordinates
+        QRectF visible = transform.inverted ().mapRect (QRectF (0, 0, width (), height ()));
+        qreal pixelSize = qMin (1.0 / transform.m11 (), 1.0 / transform.m22 ());
 
         if (mDrawGeneratedPolyline) {
             painter.setPen (Qt::darkBlue);
-            painter.drawPath (mGeneratedPolyline);
+            mGeneratedPolyline->Draw (painter, visible, pixelSize);
         }
 
-        if (!mSimplifiedPolyline.elementCount ())
+        if (!mSimplifiedPolyline)
             return;
 
         if (mDrawSimplifiedPolyline) {
             painter.setPen (Qt::darkRed);
-            painter.drawPath (mSimplifiedPolyline);
+            mSimplifiedPolyline->Draw (painter, visible, pixelSize);
         }
     }
 
-    QPainterPath RenderArea::Convert (QVector <qreal>& polyline)
+    void RenderArea::wheelEvent (QWheelEvent *inEvent)
+    {
+        QRectF rect = GetView ();
+        if (!rect.isValid ())
+            return;
+
+        // zoom around the mouse position, up to a millionth of the generated polyline
+        QRectF bounds = mGeneratedPolyline->BoundingRect ();
+        qreal factor = std::pow (1.25, -inEvent->delta () / 120.0);
+        factor = qMax (factor, 1e-6 * bounds.width () / rect.width ());
+        factor = qMax (factor, 1e-6 * bounds.height () / rect.height ());
+        QPointF center = GetTransform (rect).inverted ().map (QPointF (inEvent->pos ()));
+        mView = QRectF (center + (rect.topLeft () - center) * factor,
+                        center + (rect.bottomRight () - center) * factor);
+        update ();
+    }
+
+    void RenderArea::mousePressEvent (QMouseEvent *inEvent)
     {
-        // limit paths to max 100.000 points to speed up drawing
-        const int threshold = 100000;
+        mDragPosition = inEvent->pos ();
+    }
 
-        QPainterPath path;
-        if (polyline.empty ()) {
-            return path;
+    void RenderArea::mouseMoveEvent (QMouseEvent *inEvent)
+    {
+        QRectF rect = GetView ();
+        if (!(inEvent->buttons () & Qt::LeftButton) || !rect.isValid ())
+            return;
+
+        QTransform inverse = GetTransform (rect).inverted ();
+        mView = rect.translated (inverse.map (QPointF (mDragPosition)) - inverse.map (QPointF (inEvent->pos ())));
+        mDragPosition = inEvent->pos ();
+        update ();
+    }
+
+    void RenderArea::mouseDoubleClickEvent (QMouseEvent * /*inEvent*/)
+    {
+        mView = QRectF ();
+        update ();
+    }
+
+    QRectF RenderArea::GetView () const
+    {
+        if (!mView.isNull ())
+            return mView;
+        if (mGeneratedPolyline)
+            return mGeneratedPolyline->BoundingRect ();
+        return QRectF ();
+    }
+
+    QTransform RenderArea::GetTransform (const QRectF& rect) const
+    {
+        QTransform transform;
+        if (mKeepAspectRatio) {
+            qreal scale = qMin ((width () - 1) / rect.width (), (height () - 1) / rect.height ());
+            transform.translate ((width () - (rect.width () * scale)) / 2.0,
+                                 (height () - (rect.height () * scale)) / 2.0);
+            transform.scale (scale, scale);
+            transform.translate (-rect.left (), -rect.top ());
         }
-        int pointCount = polyline.size () / 2;
-        qreal skipStep = (qreal) (pointCount - threshold) / (qreal) threshold;
-        qreal skipValue = skipStep;
-
-        path.moveTo(polyline [0], polyline [1]);
-        for (int i=1; i<pointCount; i++) {
-            if (skipValue > 1.0) {
-                skipValue -= 1.0;
-            }
-            else {
-                path.lineTo (polyline [i*2], polyline [i*2+1]);
-                skipValue += skipStep;
-            }
+        else {
+            transform.scale ((width () - 1) / rect.width (), (height () - 1) / rect.height ());
+            transform.translate (-rect.left (), -rect.top ());
         }
-        int elemCount = path.elementCount ();
-        elemCount++;
-        return path;
+        return transform;
     }
 
-    void RenderArea::SetGeneratedPolyline (QVector <qreal>& polyline)
+    void RenderArea::SetGeneratedPolyline (SharedLevelOfDetail polyline)
     {
-        mSimplifiedPolyline = QPainterPath ();
-        mGeneratedPolyline = Convert (polyline);
+        mSimplifiedPolyline.clear ();
+        mGeneratedPolyline = polyline;
+        mView = QRectF ();
     }
 
-    void RenderArea::SetSimplifiedPolyline (QVector <qreal>& polyline)
+    void RenderArea::SetSimplifiedPolyline (SharedLevelOfDetail polyline)
     {
-        mSimplifiedPolyline = Convert (polyline);
+        mSimplifiedPolyline = polyline;
     }
 
 } // namespace psimpl
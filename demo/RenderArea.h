@@ -35,36 +35,46 @@
 #define RENDERAREA_H
 
 
+#include "LevelOfDetail.h"
 #include <QtGui/QFrame>
-#include <QtGui/QPainterPath>
+#include <QtGui/QTransform>
 
 
 namespace psimpl {
 
     /*!
         \brief A frame that can draw polylines and their simplification.
-        
-        Note that the point count of each polyline is always limited to 100.000 to speed up drawing.
+
+        Only the visible part of each polyline is drawn, at the level of detail that matches the
+        screen resolution. The view is zoomed using the mouse wheel, panned by dragging, and reset
+        by double clicking.
     */
     class RenderArea : public QFrame
     {
     public:
         RenderArea (QWidget *inParent = 0, Qt::WindowFlags inFlags = 0);
-        void SetGeneratedPolyline (QVector <qreal>& polyline);
-        void SetSimplifiedPolyline (QVector <qreal>& polyline);
+        void SetGeneratedPolyline (SharedLevelOfDetail polyline);
+        void SetSimplifiedPolyline (SharedLevelOfDetail polyline);
         void SetVisibleGeneratedPolyline (bool visible) { mDrawGeneratedPolyline = visible; }
         void SetVisibleSimplifiedPolyline (bool visible) { mDrawSimplifiedPolyline = visible; }
         void SetKeepAspectRatio (bool keep) { mKeepAspectRatio = keep; }
 
     protected:
         void paintEvent (QPaintEvent *inEvent);
+        void wheelEvent (QWheelEvent *inEvent);
+        void mousePressEvent (QMouseEvent *inEvent);
+        void mouseMoveEvent (QMouseEvent *inEvent);
+        void mouseDoubleClickEvent (QMouseEvent *inEvent);
 
     private:
-        QPainterPath Convert (QVector <qreal>& polyline);
+        QRectF GetView () const;
+        QTransform GetTransform (const QRectF& rect) const;
 
     private:
-        QPainterPath mGeneratedPolyline;
-        QPainterPath mSimplifiedPolyline;
+        SharedLevelOfDetail mGeneratedPolyline;
+        SharedLevelOfDetail mSimplifiedPolyline;
+        QRectF mView;               //! visible part of the polylines; null shows the entire generated polyline
+        QPoint mDragPosition;       //! last mouse position while panning
         bool mDrawGeneratedPolyline;
         bool mDrawSimplifiedPolyline;
         bool mKeepAspectRatio;
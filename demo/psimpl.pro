@@ -7,9 +7,11 @@ VERSION = 7
 SOURCES += main.cpp \
     MainWindow.cpp \
     DPWorker.cpp \
+    LevelOfDetail.cpp \
     RenderArea.cpp
 HEADERS += MainWindow.h \
     DPWorker.h \
+    LevelOfDetail.h \
     RenderArea.h \
     psimpl_reference.h \
     psimpl.h \
@@ -227,8 +227,8 @@ namespace psimpl {
                 if (mk[i])
                     sV[m++] = vt[i];
             }
-            delete vt;
-            delete mk;
+            delete [] vt;
+            delete [] mk;
             return m;         // m vertices in simplified polyline
         }
         //===================================================================
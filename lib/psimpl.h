@@ -93,12 +93,54 @@
 #define PSIMPL_GENERIC
 
 
-#include <queue>
-#include <stack>
+#include <deque>
+#include <vector>
+#include <iterator>
 #include <numeric>
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// SSE2 is used for the key search of Douglas-Peucker, unless PSIMPL_NO_SIMD is defined
+#if !defined (PSIMPL_NO_SIMD) && (defined (__SSE2__) || defined (_M_X64) || \
+                                  (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define PSIMPL_SSE2
+    #include <emmintrin.h>
+#endif
+
+// bit scan intrinsics are used for the key sets of Douglas-Peucker
+#if defined (_MSC_VER)
+    #include <intrin.h>
+#endif
+
+// 128 bit integers are used for exact distances between 64 bit integer points, unless
+// PSIMPL_NO_INT128 is defined
+#if !defined (PSIMPL_NO_INT128) && defined (__SIZEOF_INT128__)
+    #define PSIMPL_INT128
+#endif
+
+// the work done by the simplification routines is counted and timed when PSIMPL_INSTRUMENTATION
+// is defined, see psimpl::instrument
+#ifdef PSIMPL_INSTRUMENTATION
+    #define PSIMPL_COUNT(counter, n) (psimpl::instrument::counters ().counter += (n))
+    #define PSIMPL_COUNT_MAX(counter, n) psimpl::instrument::maximize (psimpl::instrument::counters ().counter, (n))
+    #define PSIMPL_TIMER(timer) psimpl::instrument::PhaseTimer timer
+    #define PSIMPL_LAP(timer, phase) timer.Lap (psimpl::instrument::counters ().phase)
+#else
+    #define PSIMPL_COUNT(counter, n) ((void) 0)
+    #define PSIMPL_COUNT_MAX(counter, n) ((void) 0)
+    #define PSIMPL_TIMER(timer)
+    #define PSIMPL_LAP(timer, phase) ((void) 0)
+#endif
 
 
 /*!
@@ -157,1734 +199,10523 @@ namespace psimpl
         template <typename T> inline void swap (scoped_array <T>& a, scoped_array <T>& b) {
             a.swap (b);
         }
-    }
-
-    /*!
-        \brief Contains functions for calculating statistics and distances between various geometric entities.
-    */
-    namespace math
-    {
-        /*!
-            \brief POD structure for storing several statistical values
-        */
-        struct Statistics
-        {
-            Statistics () :
-                max (0),
-                sum (0),
-                mean (0),
-                std (0)
-            {}
-
-            double max;
-            double sum;
-            double mean;
-            double std;     //! standard deviation
-        };
 
-        /*!
-            \brief Determines if two points have the exact same coordinates.
+        //! \brief Returns the index of the lowest set bit of a non-zero word.
+        inline unsigned trailing_zeros (unsigned long long word) {
+        #if defined (__GNUC__)
+            return static_cast <unsigned> (__builtin_ctzll (word));
+        #elif defined (_MSC_VER) && defined (_M_X64)
+            unsigned long index;
+            _BitScanForward64 (&index, word);
+            return static_cast <unsigned> (index);
+        #else
+            unsigned index = 0;
+            for (; !(word & 1); word >>= 1) {
+                ++index;
+            }
+            return index;
+        #endif
+        }
 
-            \param[in] p1       the first coordinate of the first point
-            \param[in] p2       the first coordinate of the second point
-            \return             true when the points are equal; false otherwise
-        */
-        template <unsigned DIM, class InputIterator>
-        inline bool equal (
-            InputIterator p1,
-            InputIterator p2)
-        {
-            for (unsigned d = 0; d < DIM; ++d) {
-                if (*p1 != *p2) {
-                    return false;
-                }
-                ++p1;
-                ++p2;
+        //! \brief Returns the number of set bits of a word.
+        inline unsigned bit_count (unsigned long long word) {
+        #if defined (__GNUC__)
+            return static_cast <unsigned> (__builtin_popcountll (word));
+        #else
+            unsigned count = 0;
+            for (; word; word &= word - 1) {
+                ++count;
             }
-            return true;
+            return count;
+        #endif
         }
 
         /*!
-            \brief Creates a vector from two points.
+            \brief Determines if an iterator refers to consecutive elements of an array.
 
-            \param[in] p1       the first coordinate of the first point
-            \param[in] p2       the first coordinate of the second point
-            \param[in] result   the resulting vector (p2-p1)
-            \return             one beyond the last coordinate of the resulting vector
+            Pointers and std::vector iterators are recognized as contiguous. For any other
+            iterator type value is false and address returns 0.
         */
-        template <unsigned DIM, class InputIterator, class OutputIterator>
-        inline OutputIterator make_vector (
-            InputIterator p1,
-            InputIterator p2,
-            OutputIterator result)
+        template <class Iterator,
+                  bool CONTIGUOUS = std::is_pointer <Iterator>::value ||
+                      std::is_same <Iterator, typename std::vector <
+                          typename std::iterator_traits <Iterator>::value_type>::iterator>::value ||
+                      std::is_same <Iterator, typename std::vector <
+                          typename std::iterator_traits <Iterator>::value_type>::const_iterator>::value>
+        struct contiguous_iterator
         {
-            for (unsigned d = 0; d < DIM; ++d) {
-                *result = *p2 - *p1;
-                ++result;
-                ++p1;
-                ++p2;
-            }
-            return result;
-        }
+            typedef typename std::iterator_traits <Iterator>::value_type value_type;
+            static const bool value = true;
 
-        /*!
-            \brief Computes the dot product of two vectors.
+            //! \brief Returns the address of the element the iterator refers to.
+            static const value_type* address (Iterator it) {
+                return &*it;
+            }
+        };
 
-            \param[in] v1   the first coordinate of the first vector
-            \param[in] v2   the first coordinate of the second vector
-            \return         the dot product (v1 * v2)
-        */
-        template <unsigned DIM, class InputIterator>
-        inline typename std::iterator_traits <InputIterator>::value_type dot (
-            InputIterator v1,
-            InputIterator v2)
+        template <class Iterator>
+        struct contiguous_iterator <Iterator, false>
         {
-            typename std::iterator_traits <InputIterator>::value_type result = 0;
-            for (unsigned d = 0; d < DIM; ++d) {
-                result += (*v1) * (*v2);
-                ++v1;
-                ++v2;
+            typedef typename std::iterator_traits <Iterator>::value_type value_type;
+            static const bool value = false;
+
+            static const value_type* address (Iterator) {
+                return 0;
             }
-            return result;
-        }
+        };
 
         /*!
-            \brief Peforms linear interpolation between two points.
+            \brief Provides access to the coordinates of a point type.
 
-            \param[in] p1           the first coordinate of the first point
-            \param[in] p2           the first coordinate of the second point
-            \param[in] fraction     the fraction used during interpolation
-            \param[in] result       the interpolation result (p1 + fraction * (p2 - p1))
-            \return                 one beyond the last coordinate of the interpolated point
+            The default implementation indexes the point, which suits arrays and point classes
+            that provide operator []. Other point types require a specialization, f.e.:
+
+            <pre>
+            struct Sample { double x, y, z; long long t; };
+
+            template <> struct psimpl::util::point_traits <Sample> {
+                typedef double value_type;
+                static double get (const Sample& p, unsigned d) { return (&p.x) [d]; }
+                static void set (Sample& p, unsigned d, double v) { (&p.x) [d] = v; }
+            };
+            </pre>
         */
-        template <unsigned DIM, class InputIterator, class OutputIterator>
-        inline OutputIterator interpolate (
-            InputIterator p1,
-            InputIterator p2,
-            float fraction,
-            OutputIterator result)
+        template <class Point>
+        struct point_traits
         {
-            typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+            typedef typename std::decay <decltype (std::declval <const Point&> () [0])>::type value_type;
 
-            for (unsigned d = 0; d < DIM; ++d) {
-                *result = *p1 + static_cast <value_type> (fraction * (*p2 - *p1));
-                ++result;
-                ++p1;
-                ++p2;
+            //! \brief Returns coordinate d of point p.
+            static value_type get (const Point& p, unsigned d) {
+                return p [d];
             }
-            return result;
-        }
+
+            //! \brief Sets coordinate d of point p to v.
+            static void set (Point& p, unsigned d, value_type v) {
+                p [d] = v;
+            }
+        };
 
         /*!
-            \brief Computes the squared distance of two points
+            \brief Iterates the coordinates of a range of points.
 
-            \param[in] p1   the first coordinate of the first point
-            \param[in] p2   the first coordinate of the second point
-            \return         the squared distance
+            Presents a range of points as the flat range of coordinates x, y, x, y, ... that the
+            simplification and error routines expect, without copying the points. The
+            coordinates are read through the Traits type. The iterator category is that of the
+            point iterator.
         */
-        template <unsigned DIM, class InputIterator1, class InputIterator2>
-        inline typename std::iterator_traits <InputIterator1>::value_type point_distance2 (
-            InputIterator1 p1,
-            InputIterator2 p2)
+        template <unsigned DIM, class PointIterator,
+                  class Traits = point_traits <typename std::iterator_traits <PointIterator>::value_type> >
+        class point_coord_iterator
         {
-            typename std::iterator_traits <InputIterator1>::value_type result = 0;
-            for (unsigned d = 0; d < DIM; ++d) {
-                result += (*p1 - *p2) * (*p1 - *p2);
-                ++p1;
-                ++p2;
+        public:
+            typedef typename std::iterator_traits <PointIterator>::iterator_category iterator_category;
+            typedef typename Traits::value_type value_type;
+            typedef typename std::iterator_traits <PointIterator>::difference_type difference_type;
+            typedef const value_type* pointer;
+            typedef value_type reference;
+
+            point_coord_iterator () :
+                coord (0)
+            {}
+
+            //! \brief Refers to the first coordinate of the point that point refers to.
+            explicit point_coord_iterator (PointIterator point) :
+                point (point),
+                coord (0)
+            {}
+
+            value_type operator * () const {
+                return Traits::get (*point, coord);
             }
-            return result;
-        }
 
-        /*!
-            \brief Computes the squared distance between an infinite line (l1, l2) and a point p
+            value_type operator [] (difference_type n) const {
+                return *(*this + n);
+            }
 
-            \param[in] l1   the first coordinate of the first point on the line
-            \param[in] l2   the first coordinate of the second point on the line
-            \param[in] p    the first coordinate of the test point
-            \return         the squared distance
-        */
-        template <unsigned DIM, class InputIterator>
-        inline typename std::iterator_traits <InputIterator>::value_type line_distance2 (
-            InputIterator l1,
-            InputIterator l2,
-            InputIterator p)
-        {
-            typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+            point_coord_iterator& operator ++ () {
+                if (++coord == DIM) {
+                    ++point;
+                    coord = 0;
+                }
+                return *this;
+            }
 
-            value_type v [DIM];                 // vector l1 --> l2
-            value_type w [DIM];                 // vector l1 --> p
+            point_coord_iterator operator ++ (int) {
+                point_coord_iterator it = *this;
+                ++*this;
+                return it;
+            }
 
-            make_vector <DIM> (l1, l2, v);
-            make_vector <DIM> (l1, p,  w);
+            point_coord_iterator& operator -- () {
+                if (coord == 0) {
+                    --point;
+                    coord = DIM;
+                }
+                --coord;
+                return *this;
+            }
 
-            value_type cv = dot <DIM> (v, v);   // squared length of v
-            value_type cw = dot <DIM> (w, v);   // project w onto v
+            point_coord_iterator operator -- (int) {
+                point_coord_iterator it = *this;
+                --*this;
+                return it;
+            }
 
-            // avoid problems with divisions when value_type is an integer type
-            float fraction = cv == 0 ? 0 : static_cast <float> (cw) / static_cast <float> (cv);
+            point_coord_iterator& operator += (difference_type n) {
+                difference_type index = static_cast <difference_type> (coord) + n;
+                difference_type points = index / static_cast <difference_type> (DIM);
+                index %= static_cast <difference_type> (DIM);
+                if (index < 0) {
+                    index += DIM;
+                    --points;
+                }
+                point += points;
+                coord = static_cast <unsigned> (index);
+                return *this;
+            }
 
-            value_type proj [DIM];              // p projected onto line (l1, l2)
-            interpolate <DIM> (l1, l2, fraction, proj);
+            point_coord_iterator& operator -= (difference_type n) {
+                return *this += -n;
+            }
 
-            return point_distance2 <DIM> (p, proj);
-        }
+            point_coord_iterator operator + (difference_type n) const {
+                point_coord_iterator it = *this;
+                return it += n;
+            }
 
-        /*!
-            \brief Computes the squared distance between a line segment (s1, s2) and a point p
+            point_coord_iterator operator - (difference_type n) const {
+                point_coord_iterator it = *this;
+                return it -= n;
+            }
 
-            \param[in] s1   the first coordinate of the start point of the segment
-            \param[in] s2   the first coordinate of the end point of the segment
-            \param[in] p    the first coordinate of the test point
-            \return         the squared distance
-        */
-        template <unsigned DIM, class InputIterator>
-        inline typename std::iterator_traits <InputIterator>::value_type segment_distance2 (
-            InputIterator s1,
-            InputIterator s2,
-            InputIterator p)
-        {
-            typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+            difference_type operator - (const point_coord_iterator& it) const {
+                return (point - it.point) * static_cast <difference_type> (DIM) +
+                       static_cast <difference_type> (coord) - static_cast <difference_type> (it.coord);
+            }
+
+            bool operator == (const point_coord_iterator& it) const {
+                return point == it.point && coord == it.coord;
+            }
 
-            value_type v [DIM];        // vector s1 --> s2
-            value_type w [DIM];        // vector s1 --> p
+            bool operator != (const point_coord_iterator& it) const {
+                return !(*this == it);
+            }
 
-            make_vector <DIM> (s1, s2, v);
-            make_vector <DIM> (s1, p,  w);
+            bool operator < (const point_coord_iterator& it) const {
+                return *this - it < 0;
+            }
 
-            value_type cw = dot <DIM> (w, v);   // project w onto v
-            if (cw <= 0) {
-                // projection of w lies to the left of s1
-                return point_distance2 <DIM> (p, s1);
+            bool operator > (const point_coord_iterator& it) const {
+                return it < *this;
             }
 
-            value_type cv = dot <DIM> (v, v);   // squared length of v
-            if (cv <= cw) {
-                // projection of w lies to the right of s2
-                return point_distance2 <DIM> (p, s2);
+            bool operator <= (const point_coord_iterator& it) const {
+                return !(it < *this);
             }
 
-            // avoid problems with divisions when value_type is an integer type
-            float fraction = cv == 0 ? 0 : static_cast <float> (cw) / static_cast <float> (cv);
+            bool operator >= (const point_coord_iterator& it) const {
+                return !(*this < it);
+            }
 
-            value_type proj [DIM];    // p projected onto segement (s1, s2)
-            interpolate <DIM> (s1, s2, fraction, proj);
+            //! \brief Returns the point iterator that refers to the current point.
+            PointIterator base () const {
+                return point;
+            }
 
-            return point_distance2 <DIM> (p, proj);
-        }
+        private:
+            PointIterator point;    //! the current point
+            unsigned coord;         //! the current coordinate of the current point
+        };
 
         /*!
-            \brief Computes the squared distance between a ray (r1, r2) and a point p
+            \brief Writes coordinates to a range of points.
 
-            \param[in] r1   the first coordinate of the start point of the ray
-            \param[in] r2   the first coordinate of a point on the ray
-            \param[in] p    the first coordinate of the test point
-            \return         the squared distance
+            Collects each DIM successive coordinates into a Point, which is then written to the
+            point output iterator. The coordinates are set through the Traits type; any other
+            members of Point are value initialized. Use an indices routine, f.e.
+            simplify_douglas_peucker_indices, to keep those members of the original points.
         */
-        template <unsigned DIM, class InputIterator>
-        inline typename std::iterator_traits <InputIterator>::value_type ray_distance2 (
-            InputIterator r1,
-            InputIterator r2,
-            InputIterator p)
+        template <unsigned DIM, class Point, class PointOutputIterator, class Traits = point_traits <Point> >
+        class point_output_iterator
         {
-            typedef typename std::iterator_traits <InputIterator>::value_type value_type;
-
-            value_type v [DIM];        // vector r1 --> r2
-            value_type w [DIM];        // vector r1 --> p
+        public:
+            typedef std::output_iterator_tag iterator_category;
+            typedef void value_type;
+            typedef void difference_type;
+            typedef void pointer;
+            typedef void reference;
+
+            explicit point_output_iterator (PointOutputIterator result) :
+                result (result),
+                point (),
+                coord (0)
+            {}
 
-            make_vector <DIM> (r1, r2, v);
-            make_vector <DIM> (r1, p,  w);
+            point_output_iterator& operator * () {
+                return *this;
+            }
 
-            value_type cv = dot <DIM> (v, v);    // squared length of v
-            value_type cw = dot <DIM> (w, v);    // project w onto v
+            point_output_iterator& operator = (typename Traits::value_type value) {
+                Traits::set (point, coord, value);
+                if (++coord == DIM) {
+                    *result = point;
+                    ++result;
+                    point = Point ();
+                    coord = 0;
+                }
+                return *this;
+            }
 
-            if (cw <= 0) {
-                // projection of w lies to the left of r1 (not on the ray)
-                return point_distance2 <DIM> (p, r1);
+            point_output_iterator& operator ++ () {
+                return *this;
             }
 
-            // avoid problems with divisions when value_type is an integer type
-            float fraction = cv == 0 ? 0 : static_cast <float> (cw) / static_cast <float> (cv);
+            point_output_iterator& operator ++ (int) {
+                return *this;
+            }
 
-            value_type proj [DIM];    // p projected onto ray (r1, r2)
-            interpolate <DIM> (r1, r2, fraction, proj);
+            //! \brief Returns the point output iterator beyond the last written point.
+            PointOutputIterator base () const {
+                return result;
+            }
 
-            return point_distance2 <DIM> (p, proj);
-        }
+        private:
+            PointOutputIterator result;     //! destination of the points
+            Point point;                    //! the point that is being written
+            unsigned coord;                 //! the next coordinate of point
+        };
 
         /*!
-            \brief Computes various statistics for the range [first, last)
+            \brief Counts the coordinates that are written to it, without storing them.
 
-            \param[in] first   the first value
-            \param[in] last    one beyond the last value
-            \return            the calculated statistics
+            Allows any routine to be used as a dry run that only determines the size of its
+            output, f.e. to allocate the destination exactly before the actual run:
+
+                simplify_opheim <2> (first, last, min, max, counting_iterator ()).count () / 2
+
+            returns the number of vertices of the simplified polyline. Note that this performs
+            the complete simplification; use the two-phase SelectDouglasPeucker or
+            SelectDouglasPeuckerN with CopySelection to avoid computing DP or DPn twice.
         */
-        template <class InputIterator>
-        inline Statistics compute_statistics (
-            InputIterator first,
-            InputIterator last)
+        class counting_iterator
         {
-            typedef typename std::iterator_traits <InputIterator>::value_type value_type;
-            typedef typename std::iterator_traits <InputIterator>::difference_type diff_type;
+        public:
+            typedef std::output_iterator_tag iterator_category;
+            typedef void value_type;
+            typedef void difference_type;
+            typedef void pointer;
+            typedef void reference;
+
+            counting_iterator () :
+                n (0)
+            {}
 
-            Statistics stats;
+            counting_iterator& operator * () {
+                return *this;
+            }
 
-            diff_type count = std::distance (first, last);
-            if (count == 0) {
-                return stats;
+            template <class T>
+            counting_iterator& operator = (const T&) {
+                ++n;
+                return *this;
             }
 
-            value_type init = 0;
-            stats.max = static_cast <double> (*std::max_element (first, last));
-            stats.sum = static_cast <double> (std::accumulate (first, last, init));
-            stats.mean = stats.sum / count;
-            std::transform (first, last, first, std::bind2nd (std::minus <value_type> (), stats.mean));
-            stats.std = std::sqrt (static_cast <double> (std::inner_product (first, last, first, init)) / count);
-            return stats;
-        }
-    }
+            counting_iterator& operator ++ () {
+                return *this;
+            }
 
-    /*!
-        \brief Provides various simplification algorithms for n-dimensional simple polylines.
+            counting_iterator& operator ++ (int) {
+                return *this;
+            }
 
-        A polyline is simple when it is non-closed and non-selfintersecting. All algorithms
-        operate on input iterators and output iterators. Note that unisgned integer types are
-        NOT supported.
-    */
-    template <unsigned DIM, class InputIterator, class OutputIterator>
-    class PolylineSimplification
-    {
-        typedef typename std::iterator_traits <InputIterator>::difference_type diff_type;
-        typedef typename std::iterator_traits <InputIterator>::value_type value_type;
-        typedef typename std::iterator_traits <const value_type*>::difference_type ptr_diff_type;
+            //! \brief Returns the number of values that have been written.
+            std::size_t count () const {
+                return n;
+            }
+
+        private:
+            std::size_t n;      //! number of written values
+        };
 
-    public:
         /*!
-            \brief Performs the nth point routine (NP).
+            \brief Encodes coordinates as a compact stream of bytes.
 
-            NP is an O(n) algorithm for polyline simplification. It keeps only the first, last and
-            each nth point. As an example, consider any random line of 8 points. Using n = 3 will
-            always yield a simplification consisting of points: 1, 4, 7, 8
+            Each coordinate is quantized to the nearest multiple of precision, and replaced by the
+            difference with the same coordinate of the previous point. These deltas are small
+            for the vertices of a polyline, and are zigzag encoded, so that small negative
+            values are small as well, and written as a variable length integer of 7 bits per
+            byte. Passing this iterator as the output of a simplification routine encodes the
+            simplified polyline, without an intermediate coordinate buffer:
 
-            \image html psimpl_np.png
+                simplify_douglas_peucker <2> (first, last, tol,
+                    make_varint_output_iterator <2> (std::back_inserter (bytes), 1e-6)).base ()
 
-            NP is applied to the range [first, last). The resulting simplified polyline is copied
-            to the output range [result, result + m*DIM), where m is the number of vertices of the
-            simplified polyline. The return value is the end of the output range: result + m*DIM.
+            returns the end of the encoded stream. The quantization is done in double precision,
+            and the quantized values must fit in a long long. Use a varint_input_iterator to
+            decode the stream.
+        */
+        template <unsigned DIM, class ByteOutputIterator>
+        class varint_output_iterator
+        {
+        public:
+            typedef std::output_iterator_tag iterator_category;
+            typedef void value_type;
+            typedef void difference_type;
+            typedef void pointer;
+            typedef void reference;
+
+            varint_output_iterator (ByteOutputIterator result, double precision) :
+                result (result),
+                scale (1 / precision),
+                coord (0)
+            {
+                std::fill_n (previous, DIM, 0);
+            }
 
-            Input (Type) requirements:
-            1- DIM is not 0, where DIM represents the dimension of the polyline
-            2- The InputIterator type models the concept of a forward iterator
-            3- The input iterator value type is convertible to a value type of the OutputIterator
-            4- The range [first, last) contains only vertex coordinates in multiples of DIM, f.e.:
-               x, y, z, x, y, z, x, y, z when DIM = 3
-            5- The range [first, last) contains at least 2 vertices
-            6- n is not 0
-
-            In case these requirements are not met, the entire input range [first, last) is copied
-            to the output range [result, result + (last - first)) OR compile errors may occur.
-
-            \param[in] first    the first coordinate of the first polyline point
-            \param[in] last     one beyond the last coordinate of the last polyline point
-            \param[in] n        specifies 'each nth point'
-            \param[in] result   destination of the simplified polyline
-            \return             one beyond the last coordinate of the simplified polyline
-        */
-        OutputIterator NthPoint (
-            InputIterator first,
-            InputIterator last,
-            unsigned n,
-            OutputIterator result)
-        {
-            diff_type coordCount = std::distance (first, last);
-            diff_type pointCount = DIM              // protect against zero DIM
-                                   ? coordCount / DIM
-                                   : 0;
+            varint_output_iterator& operator * () {
+                return *this;
+            }
 
-            // validate input and check if simplification required
-            if (coordCount % DIM || pointCount < 3 || n < 2) {
-                return std::copy (first, last, result);
+            varint_output_iterator& operator = (double value) {
+                long long quantized = static_cast <long long> (std::floor (value * scale + 0.5));
+                // wrap around instead of overflowing; the decoder wraps identically
+                long long delta = static_cast <long long> (
+                    static_cast <unsigned long long> (quantized) -
+                    static_cast <unsigned long long> (previous [coord]));
+                previous [coord] = quantized;
+                coord = (coord + 1) % DIM;
+
+                // zigzag: 0, -1, 1, -2, 2, ... -> 0, 1, 2, 3, 4, ...
+                unsigned long long zigzag = delta < 0
+                    ? ~(static_cast <unsigned long long> (delta) << 1)
+                    : static_cast <unsigned long long> (delta) << 1;
+                while (zigzag >= 0x80) {
+                    *result = static_cast <unsigned char> (zigzag | 0x80);
+                    ++result;
+                    zigzag >>= 7;
+                }
+                *result = static_cast <unsigned char> (zigzag);
+                ++result;
+                return *this;
             }
 
-            unsigned remaining = pointCount - 1;    // the number of points remaining after key
-            InputIterator key = first;              // indicates the current key
+            varint_output_iterator& operator ++ () {
+                return *this;
+            }
 
-            // the first point is always part of the simplification
-            CopyKey (key, result);
+            varint_output_iterator& operator ++ (int) {
+                return *this;
+            }
 
-            // copy each nth point
-            while (Forward (key, n, remaining)) {
-                CopyKey (key, result);
+            //! \brief Returns the byte output iterator beyond the last written byte.
+            ByteOutputIterator base () const {
+                return result;
             }
 
-            return result;
-        }
+        private:
+            ByteOutputIterator result;      //! destination of the bytes
+            double scale;                   //! reciprocal of the quantization precision
+            long long previous [DIM];       //! quantized coordinates of the previous point
+            unsigned coord;                 //! the next coordinate of the current point
+        };
 
         /*!
-            \brief Performs the (radial) distance between points routine (RD).
-
-            RD is a brute-force O(n) algorithm for polyline simplification. It reduces successive
-            vertices that are clustered too closely to a single vertex, called a key. The resulting
-            keys form the simplified polyline.
+            \brief Decodes coordinates from a stream of bytes, written by varint_output_iterator.
 
-            \image html psimpl_rd.png
+            Iterates the coordinates of the encoded stream [first, last), which must have been
+            written with the same DIM and precision. Each coordinate is decoded when the iterator
+            is advanced. The byte iterator must be a forward iterator, so that the decoded range
+            can be passed to the simplification and error routines as well. The end of the
+            range is the iterator that is constructed for the empty stream [last, last).
+        */
+        template <unsigned DIM, class T, class ByteIterator>
+        class varint_input_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const T* pointer;
+            typedef const T& reference;
+
+            varint_input_iterator () :
+                bytes (),
+                last (),
+                precision (1),
+                value (),
+                coord (0),
+                done (true)
+            {
+                std::fill_n (previous, DIM, 0);
+            }
 
-            RD is applied to the range [first, last) using the specified tolerance tol. The
-            resulting simplified polyline is copied to the output range [result, result + m*DIM),
-            where m is the number of vertices of the simplified polyline. The return value is the
-            end of the output range: result + m*DIM.
+            varint_input_iterator (ByteIterator first, ByteIterator last, double precision) :
+                bytes (first),
+                last (last),
+                precision (precision),
+                value (),
+                coord (0),
+                done (false)
+            {
+                std::fill_n (previous, DIM, 0);
+                Decode ();
+            }
 
-            Input (Type) requirements:
-            1- DIM is not 0, where DIM represents the dimension of the polyline
-            2- The InputIterator type models the concept of a forward iterator
-            3- The input iterator value type is convertible to a value type of the output iterator
-            4- The range [first, last) contains only vertex coordinates in multiples of DIM, f.e.:
-               x, y, z, x, y, z, x, y, z when DIM = 3
-            5- The range [first, last) contains at least 2 vertices
-            6- tol is not 0
+            reference operator * () const {
+                return value;
+            }
 
-            In case these requirements are not met, the entire input range [first, last) is copied
-            to the output range [result, result + (last - first)) OR compile errors may occur.
+            pointer operator -> () const {
+                return &value;
+            }
 
-            \param[in] first    the first coordinate of the first polyline point
-            \param[in] last     one beyond the last coordinate of the last polyline point
-            \param[in] tol      radial (point-to-point) distance tolerance
-            \param[in] result   destination of the simplified polyline
-            \return             one beyond the last coordinate of the simplified polyline
-        */
-        OutputIterator RadialDistance (
-            InputIterator first,
-            InputIterator last,
-            value_type tol,
-            OutputIterator result)
-        {
-            diff_type coordCount = std::distance (first, last);
-            diff_type pointCount = DIM      // protect against zero DIM
-                                   ? coordCount / DIM
-                                   : 0;
-            value_type tol2 = tol * tol;    // squared distance tolerance
+            varint_input_iterator& operator ++ () {
+                Decode ();
+                return *this;
+            }
 
-            // validate input and check if simplification required
-            if (coordCount % DIM || pointCount < 3 || tol2 == 0) {
-                return std::copy (first, last, result);
+            varint_input_iterator operator ++ (int) {
+                varint_input_iterator it = *this;
+                Decode ();
+                return it;
             }
 
-            InputIterator current = first;  // indicates the current key
-            InputIterator next = first;     // used to find the next key
+            bool operator == (const varint_input_iterator& it) const {
+                return done || it.done ? done == it.done : bytes == it.bytes;
+            }
 
-            // the first point is always part of the simplification
-            CopyKeyAdvance (next, result);
+            bool operator != (const varint_input_iterator& it) const {
+                return !(*this == it);
+            }
 
-            // Skip first and last point, because they are always part of the simplification
-            for (diff_type index = 1; index < pointCount - 1; ++index) {
-                if (math::point_distance2 <DIM> (current, next) < tol2) {
-                    Advance (next);
-                    continue;
+        private:
+            //! \brief Decodes the next coordinate, or marks the end of the stream.
+            void Decode () {
+                if (bytes == last) {
+                    done = true;
+                    return;
                 }
-                current = next;
-                CopyKeyAdvance (next, result);
+                unsigned long long zigzag = 0;
+                for (unsigned shift = 0; bytes != last; shift += 7) {
+                    unsigned char byte = static_cast <unsigned char> (*bytes);
+                    ++bytes;
+                    if (shift < 64) {
+                        zigzag |= static_cast <unsigned long long> (byte & 0x7F) << shift;
+                    }
+                    if (!(byte & 0x80)) {
+                        break;
+                    }
+                }
+                unsigned long long delta = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+                long long quantized = static_cast <long long> (
+                    static_cast <unsigned long long> (previous [coord]) + delta);
+                previous [coord] = quantized;
+                coord = (coord + 1) % DIM;
+                value = static_cast <T> (quantized * precision);
             }
-            // the last point is always part of the simplification
-            CopyKeyAdvance (next, result);
 
-            return result;
-        }
+        private:
+            ByteIterator bytes;             //! the first byte of the next coordinate
+            ByteIterator last;              //! one beyond the last byte of the stream
+            double precision;               //! quantization precision
+            long long previous [DIM];       //! quantized coordinates of the previous point
+            T value;                        //! the current coordinate
+            unsigned coord;                 //! the next coordinate of the current point
+            bool done;                      //! indicates if the end of the stream was reached
+        };
 
         /*!
-            \brief Repeatedly performs the perpendicular distance routine (PD).
-
-            The algorithm stops after calling the PD routine 'repeat' times OR when the
-            simplification does not improve. Note that this algorithm will need to store
-            up to two intermediate simplification results.
-
-            \sa PerpendicularDistance(InputIterator, InputIterator, value_type, OutputIterator)
+            \brief Iterates the coordinates of points that are stored as DIM separate columns.
 
-            \param[in] first    the first coordinate of the first polyline point
-            \param[in] last     one beyond the last coordinate of the last polyline point
-            \param[in] tol      perpendicular (segment-to-point) distance tolerance
-            \param[in] repeat   the number of times to successively apply the PD routine
-            \param[in] result   destination of the simplified polyline
-            \return             one beyond the last coordinate of the simplified polyline
+            Presents the columns x [], y [], ... as the flat range of coordinates x, y, x, y, ...
+            that the simplification and error routines expect, without copying the points. The
+            same iterator type is used to write to columns.
         */
-        OutputIterator PerpendicularDistance (
-            InputIterator first,
-            InputIterator last,
-            value_type tol,
-            unsigned repeat,
-            OutputIterator result)
+        template <unsigned DIM, class T>
+        class column_iterator
         {
-            if (repeat == 1) {
-                // single pass
-                return PerpendicularDistance (first, last, tol, result);
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef typename std::remove_const <T>::type value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef T* pointer;
+            typedef T& reference;
+
+            column_iterator () :
+                index (0),
+                coord (0)
+            {
+                std::fill_n (columns, DIM, static_cast <T*> (0));
             }
-            // only validate repeat; other input is validated by simplify_perpendicular_distance
-            if (repeat < 1) {
-                return std::copy (first, last, result);
+
+            //! \brief Refers to the first coordinate of point index of the columns.
+            column_iterator (T* const* columns, difference_type index) :
+                index (index),
+                coord (0)
+            {
+                std::copy (columns, columns + DIM, this->columns);
             }
-            diff_type coordCount = std::distance (first, last);
 
-            // first pass: [first, last) --> temporary array 'tempPoly'
-            util::scoped_array <value_type> tempPoly (coordCount);
-            PolylineSimplification <DIM, InputIterator, value_type*> psimpl_to_array;
-            diff_type tempCoordCount = std::distance (tempPoly.get (),
-                psimpl_to_array.PerpendicularDistance (first, last, tol, tempPoly.get ()));
+            T& operator * () const {
+                return columns [coord][index];
+            }
 
-            // check if simplification did not improved
-            if (coordCount == tempCoordCount) {
-                return std::copy (tempPoly.get (), tempPoly.get () + coordCount, result);
+            T& operator [] (difference_type n) const {
+                return *(*this + n);
             }
-            std::swap (coordCount, tempCoordCount);
-            --repeat;
 
-            // intermediate passes: temporary array 'tempPoly' --> temporary array 'tempResult'
-            if (1 < repeat) {
-                util::scoped_array <value_type> tempResult (coordCount);
-                PolylineSimplification <DIM, value_type*, value_type*> psimpl_arrays;
+            column_iterator& operator ++ () {
+                if (++coord == static_cast <difference_type> (DIM)) {
+                    ++index;
+                    coord = 0;
+                }
+                return *this;
+            }
 
-                while (--repeat) {
-                    tempCoordCount = std::distance (tempResult.get (),
-                        psimpl_arrays.PerpendicularDistance (
-                            tempPoly.get (), tempPoly.get () + coordCount, tol, tempResult.get ()));
+            column_iterator operator ++ (int) {
+                column_iterator it = *this;
+                ++*this;
+                return it;
+            }
 
-                    // check if simplification did not improved
-                    if (coordCount == tempCoordCount) {
-                        return std::copy (tempPoly.get (), tempPoly.get () + coordCount, result);
-                    }
-                    util::swap (tempPoly, tempResult);
-                    std::swap (coordCount, tempCoordCount);
+            column_iterator& operator -- () {
+                if (coord == 0) {
+                    --index;
+                    coord = DIM;
                 }
+                --coord;
+                return *this;
             }
 
-            // final pass: temporary array 'tempPoly' --> result
-            PolylineSimplification <DIM, value_type*, OutputIterator> psimpl_from_array;
-            return psimpl_from_array.PerpendicularDistance (
-                tempPoly.get (), tempPoly.get () + coordCount, tol, result);
-        }
+            column_iterator operator -- (int) {
+                column_iterator it = *this;
+                --*this;
+                return it;
+            }
 
-        /*!
-            \brief Performs the perpendicular distance routine (PD).
+            column_iterator& operator += (difference_type n) {
+                if (coord == 0 && n % static_cast <difference_type> (DIM) == 0) {
+                    // whole points, as used by the simplification routines
+                    index += n / static_cast <difference_type> (DIM);
+                    return *this;
+                }
+                difference_type position = index * static_cast <difference_type> (DIM) + coord + n;
+                index = position / static_cast <difference_type> (DIM);
+                coord = position % static_cast <difference_type> (DIM);
+                return *this;
+            }
 
-            PD is an O(n) algorithm for polyline simplification. It computes the perpendicular
-            distance of each point pi to the line segment S(pi-1, pi+1). Only when this distance is
-            larger than the given tolerance will pi be part of the simpification. Note that the
-            original polyline can only be reduced by a maximum of 50%. Multiple passes are required
-            to achieve higher points reductions.
+            column_iterator& operator -= (difference_type n) {
+                return *this += -n;
+            }
 
-            \image html psimpl_pd.png
+            column_iterator operator + (difference_type n) const {
+                column_iterator it = *this;
+                return it += n;
+            }
 
-            PD is applied to the range [first, last) using the specified tolerance tol. The
-            resulting simplified polyline is copied to the output range [result, result + m*DIM),
-            where m is the number of vertices of the simplified polyline. The return value is the
-            end of the output range: result + m*DIM.
+            column_iterator operator - (difference_type n) const {
+                column_iterator it = *this;
+                return it -= n;
+            }
 
-            Input (Type) requirements:
-            1- DIM is not 0, where DIM represents the dimension of the polyline
-            2- The InputIterator type models the concept of a forward iterator
-            3- The input iterator value type is convertible to a value type of the output iterator
-            4- The range [first, last) contains only vertex coordinates in multiples of DIM, f.e.:
-               x, y, z, x, y, z, x, y, z when DIM = 3
-            5- The range [first, last) contains at least 2 vertices
-            6- tol is not 0
+            difference_type operator - (const column_iterator& it) const {
+                return (index - it.index) * static_cast <difference_type> (DIM) + coord - it.coord;
+            }
 
-            In case these requirements are not met, the entire input range [first, last) is copied
-            to the output range [result, result + (last - first)) OR compile errors may occur.
+            bool operator == (const column_iterator& it) const {
+                return index == it.index && coord == it.coord;
+            }
 
-            \param[in] first    the first coordinate of the first polyline point
-            \param[in] last     one beyond the last coordinate of the last polyline point
-            \param[in] tol      perpendicular (segment-to-point) distance tolerance
-            \param[in] result   destination of the simplified polyline
-            \return             one beyond the last coordinate of the simplified polyline
-        */
-        OutputIterator PerpendicularDistance (
-            InputIterator first,
-            InputIterator last,
-            value_type tol,
-            OutputIterator result)
-        {
-            diff_type coordCount = std::distance (first, last);
-            diff_type pointCount = DIM      // protect against zero DIM
-                                   ? coordCount / DIM
-                                   : 0;
-            value_type tol2 = tol * tol;    // squared distance tolerance
+            bool operator != (const column_iterator& it) const {
+                return !(*this == it);
+            }
 
-            // validate input and check if simplification required
-            if (coordCount % DIM || pointCount < 3 || tol2 == 0) {
-                return std::copy (first, last, result);
+            bool operator < (const column_iterator& it) const {
+                return *this - it < 0;
             }
 
-            InputIterator p0 = first;
-            InputIterator p1 = AdvanceCopy(p0);
-            InputIterator p2 = AdvanceCopy(p1);
+            bool operator > (const column_iterator& it) const {
+                return it < *this;
+            }
 
-            // the first point is always part of the simplification
-            CopyKey (p0, result);
+            bool operator <= (const column_iterator& it) const {
+                return !(it < *this);
+            }
 
-            while (p2 != last) {
-                // test p1 against line segment S(p0, p2)
-                if (math::segment_distance2 <DIM> (p0, p2, p1) < tol2) {
-                    CopyKey (p2, result);
-                    // move up by two points
-                    p0 = p2;
-                    Advance (p1, 2);
-                    if (p1 == last) {
-                        // protect against advancing p2 beyond last
-                        break;
-                    }
-                    Advance (p2, 2);
-                }
-                else {
-                    CopyKey (p1, result);
-                    // move up by one point
-                    p0 = p1;
-                    p1 = p2;
-                    Advance (p2);
-                }
+            bool operator >= (const column_iterator& it) const {
+                return !(*this < it);
             }
-            // make sure the last point is part of the simplification
-            if (p1 != last) {
-                CopyKey (p1, result);
+
+            //! \brief Returns the point index of the current coordinate.
+            difference_type point () const {
+                return index;
             }
-            return result;
-        }
 
-        /*!
-            \brief Performs Reumann-Witkam approximation (RW).
+            //! \brief Returns coordinate d of the current point, which must be at coordinate 0.
+            T& at (unsigned d) const {
+                return columns [d][index];
+            }
 
-            The O(n) RW routine uses a point-to-line (perpendicular) distance tolerance. It defines
-            a line through the first two vertices of the original polyline. For each successive
-            vertex vi its perpendicular distance to this line is calculated. A new key is found at
-            vi-1, when this distance exceeds the specified tolerance. The vertices vi and vi+1 are
-            then used to define a new line, and the process repeats itself.
+        private:
+            T* columns [DIM];           //! the first coordinate of each column
+            difference_type index;      //! the current point
+            difference_type coord;      //! the current coordinate (column) of the current point
+        };
 
-            \image html psimpl_rw.png
+        //! \brief Returns a coordinate iterator that refers to the first coordinate of point.
+        template <unsigned DIM, class PointIterator>
+        point_coord_iterator <DIM, PointIterator> make_point_coord_iterator (PointIterator point) {
+            return point_coord_iterator <DIM, PointIterator> (point);
+        }
 
-            RW routine is applied to the range [first, last) using the specified perpendicular
-            distance tolerance tol. The resulting simplified polyline is copied to the output range
-            [result, result + m*DIM), where m is the number of vertices of the simplified polyline.
-            The return value is the end of the output range: result + m*DIM.
+        //! \brief Returns a coordinate output iterator that writes points of type Point to result.
+        template <unsigned DIM, class Point, class PointOutputIterator>
+        point_output_iterator <DIM, Point, PointOutputIterator> make_point_output_iterator (
+            PointOutputIterator result)
+        {
+            return point_output_iterator <DIM, Point, PointOutputIterator> (result);
+        }
 
-            Input (Type) Requirements:
-            1- DIM is not 0, where DIM represents the dimension of the polyline
-            2- The InputIterator type models the concept of a forward iterator
-            3- The input iterator value type is convertible to a value type of the output iterator
-            4- The range [first, last) contains vertex coordinates in multiples of DIM,
-               f.e.: x, y, z, x, y, z, x, y, z when DIM = 3
-            5- The range [first, last) contains at least 2 vertices
-            6- tol is not 0
+        //! \brief Returns a coordinate output iterator that encodes coordinates as bytes to result.
+        template <unsigned DIM, class ByteOutputIterator>
+        varint_output_iterator <DIM, ByteOutputIterator> make_varint_output_iterator (
+            ByteOutputIterator result,
+            double precision)
+        {
+            return varint_output_iterator <DIM, ByteOutputIterator> (result, precision);
+        }
 
-            In case these requirements are not met, the entire input range [first, last) is copied
-            to the output range [result, result + (last - first)) OR compile errors may occur.
+        //! \brief Returns a coordinate iterator that decodes coordinates of type T from [first, last).
+        template <unsigned DIM, class T, class ByteIterator>
+        varint_input_iterator <DIM, T, ByteIterator> make_varint_input_iterator (
+            ByteIterator first,
+            ByteIterator last,
+            double precision)
+        {
+            return varint_input_iterator <DIM, T, ByteIterator> (first, last, precision);
+        }
 
-            \param[in] first    the first coordinate of the first polyline point
-            \param[in] last     one beyond the last coordinate of the last polyline point
-            \param[in] tol      perpendicular (point-to-line) distance tolerance
-            \param[in] result   destination of the simplified polyline
-            \return             one beyond the last coordinate of the simplified polyline
+        //! \brief Returns a coordinate iterator that refers to the first coordinate of point index.
+        template <unsigned DIM, class T>
+        column_iterator <DIM, T> make_column_iterator (T* const* columns, std::ptrdiff_t index) {
+            return column_iterator <DIM, T> (columns, index);
+        }
+    }
+
+    /*!
+        \brief Contains the optional instrumentation of the simplification routines.
+
+        When PSIMPL_INSTRUMENTATION is defined, each thread counts the work done by the routines
+        it calls. Otherwise nothing is counted, and get_counters always returns zeros.
+    */
+    namespace instrument
+    {
+        /*!
+            \brief POD structure for storing work counters and phase timings
         */
-        OutputIterator ReumannWitkam (
-            InputIterator first,
-            InputIterator last,
-            value_type tol,
-            OutputIterator result)
+        struct Counters
         {
-            diff_type coordCount = std::distance (first, last);
-            diff_type pointCount = DIM      // protect against zero DIM
-                                   ? coordCount / DIM
-                                   : 0;
-            value_type tol2 = tol * tol;    // squared distance tolerance
+            Counters () :
+                pointDistances (0),
+                lineDistances (0),
+                segmentDistances (0),
+                rayDistances (0),
+                keys (0),
+                stackPushes (0),
+                stackDepth (0),
+                heapPushes (0),
+                heapPops (0),
+                backwardSteps (0),
+                scratchBytes (0),
+                reduceTime (0),
+                approximateTime (0),
+                copyTime (0)
+            {}
 
-            // validate input and check if simplification required
-            if (coordCount % DIM || pointCount < 3 || tol2 == 0) {
-                return std::copy (first, last, result);
+            //! \brief Adds the counters and timings of c; the stack depth becomes the maximum.
+            Counters& operator += (const Counters& c) {
+                pointDistances += c.pointDistances;
+                lineDistances += c.lineDistances;
+                segmentDistances += c.segmentDistances;
+                rayDistances += c.rayDistances;
+                keys += c.keys;
+                stackPushes += c.stackPushes;
+                stackDepth = std::max (stackDepth, c.stackDepth);
+                heapPushes += c.heapPushes;
+                heapPops += c.heapPops;
+                backwardSteps += c.backwardSteps;
+                scratchBytes += c.scratchBytes;
+                reduceTime += c.reduceTime;
+                approximateTime += c.approximateTime;
+                copyTime += c.copyTime;
+                return *this;
             }
 
-            // define the line L(p0, p1)
-            InputIterator p0 = first;               // indicates the current key
-            InputIterator p1 = AdvanceCopy (first); // indicates the next point after p0
-
-            // keep track of two test points
-            InputIterator pi = p1;     // the previous test point
-            InputIterator pj = p1;     // the current test point (pi+1)
+            unsigned long long pointDistances;      //! math::point_distance2 calls, including those of the other distance functions
+            unsigned long long lineDistances;       //! math::line_distance2 calls
+            unsigned long long segmentDistances;    //! math::segment_distance2 calls and vectorized segment distances
+            unsigned long long rayDistances;        //! math::ray_distance2 calls
+            unsigned long long keys;                //! keys found by a Douglas-Peucker key search
+            unsigned long long stackPushes;         //! sub polylines pushed onto a Douglas-Peucker stack
+            unsigned long long stackDepth;          //! maximum size of a Douglas-Peucker stack
+            unsigned long long heapPushes;          //! sub polylines pushed onto a DPn sorted job-queue
+            unsigned long long heapPops;            //! sub polylines popped from a DPn sorted job-queue
+            unsigned long long backwardSteps;       //! Lang search region reductions
+            unsigned long long scratchBytes;        //! bytes allocated for workspace buffers
+            double reduceTime;                      //! seconds spent on RD preprocessing or copying the input
+            double approximateTime;                 //! seconds spent on the Douglas-Peucker approximation
+            double copyTime;                        //! seconds spent on copying the keys to the output
+        };
 
-            // the first point is always part of the simplification
-            CopyKey (p0, result);
+#ifdef PSIMPL_INSTRUMENTATION
+        /*!
+            \brief The counters of a thread, and those added by the worker threads it created.
+        */
+        struct ThreadCounters
+        {
+            Counters local;         //! work done by the thread itself
+            Counters workers;       //! work done by finished worker threads
+            std::mutex mutex;       //! protects workers
+        };
 
-            // check each point pj against L(p0, p1)
-            for (diff_type j = 2; j < pointCount; ++j) {
-                pi = pj;
-                Advance (pj);
+        inline ThreadCounters& thread_counters () {
+            static thread_local ThreadCounters c;
+            return c;
+        }
 
-                if (math::line_distance2 <DIM> (p0, p1, pj) < tol2) {
-                    continue;
-                }
-                // found the next key at pi
-                CopyKey (pi, result);
-                // define new line L(pi, pj)
-                p0 = pi;
-                p1 = pj;
-            }
-            // the last point is always part of the simplification
-            CopyKey (pj, result);
+        //! \brief Returns the counters of the calling thread, excluding its worker threads.
+        inline Counters& counters () {
+            return thread_counters ().local;
+        }
 
-            return result;
+        //! \brief Sets counter to value if value is larger.
+        inline void maximize (unsigned long long& counter, std::size_t value) {
+            counter = std::max <unsigned long long> (counter, value);
         }
 
         /*!
-            \brief Performs Opheim approximation (OP).
+            \brief Measures the time spent on successive phases of a routine.
+        */
+        class PhaseTimer
+        {
+        public:
+            PhaseTimer () :
+                start (std::chrono::steady_clock::now ())
+            {}
 
-            The O(n) OP routine is very similar to the Reumann-Witkam (RW) routine, and can be seen
-            as a constrained version of that RW routine. OP uses both a minimum and a maximum
-            distance tolerance to constrain the search area. For each successive vertex vi, its
-            radial distance to the current key vkey (initially v0) is calculated. The last point
-            within the minimum distance tolerance is used to define a ray R (vkey, vi). If no
-            such vi exists, the ray is defined as R(vkey, vkey+1). For each successive vertex vj
-            beyond vi its perpendicular distance to the ray R is calculated. A new key is found at
-            vj-1, when this distance exceeds the minimum tolerance Or when the radial distance
-            between vj and the vkey exceeds the maximum tolerance. After a new key is found, the
-            process repeats itself.
+            //! \brief Adds the time since the previous lap to phase, and starts a new lap.
+            void Lap (double& phase) {
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now ();
+                phase += std::chrono::duration <double> (now - start).count ();
+                start = now;
+            }
 
-            \image html psimpl_op.png
+        private:
+            std::chrono::steady_clock::time_point start;
+        };
+#endif
+
+        //! \brief Returns the counters of the calling thread; all zero when not instrumented.
+        inline Counters get_counters () {
+#ifdef PSIMPL_INSTRUMENTATION
+            ThreadCounters& c = thread_counters ();
+            std::lock_guard <std::mutex> lock (c.mutex);
+            Counters result = c.local;
+            return result += c.workers;
+#else
+            return Counters ();
+#endif
+        }
 
-            OP routine is applied to the range [first, last) using the specified distance tolerances
-            min_tol and max_tol. The resulting simplified polyline is copied to the output range
-            [result, result + m*DIM), where m is the number of vertices of the simplified polyline.
-            The return value is the end of the output range: result + m*DIM.
+        //! \brief Resets the counters of the calling thread to zero.
+        inline void reset_counters () {
+#ifdef PSIMPL_INSTRUMENTATION
+            ThreadCounters& c = thread_counters ();
+            std::lock_guard <std::mutex> lock (c.mutex);
+            c.local = Counters ();
+            c.workers = Counters ();
+#endif
+        }
 
-            Input (Type) Requirements:
-            1- DIM is not 0, where DIM represents the dimension of the polyline
-            2- The InputIterator type models the concept of a forward iterator
-            3- The input iterator value type is convertible to a value type of the output iterator
-            4- The range [first, last) contains vertex coordinates in multiples of DIM,
-               f.e.: x, y, z, x, y, z, x, y, z when DIM = 3
-            5- The range [first, last) contains at least 2 vertices
-            6- min_tol is not 0
-            7- max_tol is not 0
+        /*!
+            \brief Creates a thread that calls f (args...).
 
-            In case these requirements are not met, the entire input range [first, last) is copied
-            to the output range [result, result + (last - first)) OR compile errors may occur.
+            When instrumented, the counters of the thread are added to those of the creating
+            thread once f returns. The parallel routines use this for their worker threads, so
+            that get_counters includes all work done on behalf of the calling thread.
+        */
+        template <class Function, class... Args>
+        std::thread make_thread (Function&& f, Args&&... args) {
+#ifdef PSIMPL_INSTRUMENTATION
+            ThreadCounters* parent = &thread_counters ();
+            auto task = std::bind (std::forward <Function> (f), std::forward <Args> (args)...);
+            return std::thread ([parent, task] () mutable {
+                task ();
+                std::lock_guard <std::mutex> lock (parent->mutex);
+                parent->workers += counters ();
+            });
+#else
+            return std::thread (std::forward <Function> (f), std::forward <Args> (args)...);
+#endif
+        }
+    }
 
-            \param[in] first    the first coordinate of the first polyline point
-            \param[in] last     one beyond the last coordinate of the last polyline point
-            \param[in] min_tol  radial and perpendicular (point-to-ray) distance tolerance
-            \param[in] max_tol  radial distance tolerance
-            \param[in] result   destination of the simplified polyline
-            \return             one beyond the last coordinate of the simplified polyline
+    /*!
+        \brief Contains functions for calculating statistics and distances between various geometric entities.
+    */
+    namespace math
+    {
+        /*!
+            \brief POD structure for storing several statistical values
         */
-        OutputIterator Opheim (
-            InputIterator first,
-            InputIterator last,
-            value_type min_tol,
-            value_type max_tol,
-            OutputIterator result)
+        struct Statistics
         {
-            diff_type coordCount = std::distance (first, last);
-            diff_type pointCount = DIM                    // protect against zero DIM
-                                   ? coordCount / DIM
-                                   : 0;
-            value_type min_tol2 = min_tol * min_tol;    // squared minimum distance tolerance
-            value_type max_tol2 = max_tol * max_tol;    // squared maximum distance tolerance
-
-            // validate input and check if simplification required
-            if (coordCount % DIM || pointCount < 3 || min_tol2 == 0 || max_tol2 == 0) {
-                return std::copy (first, last, result);
-            }
+            Statistics () :
+                max (0),
+                sum (0),
+                mean (0),
+                std (0)
+            {}
 
-            // define the ray R(r0, r1)
-            InputIterator r0 = first;  // indicates the current key and start of the ray
-            InputIterator r1 = first;  // indicates a point on the ray
-            bool rayDefined = false;
+            double max;
+            double sum;
+            double mean;
+            double std;     //! standard deviation
+        };
 
-            // keep track of two test points
-            InputIterator pi = r0;     // the previous test point
-            InputIterator pj =         // the current test point (pi+1)
-                AdvanceCopy (pi);
+        /*!
+            \brief Computes Statistics in a single pass, without storing the values.
 
-            // the first point is always part of the simplification
-            CopyKey (r0, result);
+            The mean and standard deviation are updated for each value using Welford's method,
+            which avoids the cancellation of summing squares. The sum, and thus the mean, is
+            accumulated in the order the values are added.
+        */
+        class StatisticsAccumulator
+        {
+        public:
+            StatisticsAccumulator () :
+                count (0),
+                max (0),
+                sum (0),
+                mean (0),
+                m2 (0)
+            {}
 
-            for (diff_type j = 2; j < pointCount; ++j) {
-                pi = pj;
-                Advance (pj);
+            //! \brief Adds a value.
+            void Add (double value) {
+                ++count;
+                if (count == 1 || max < value) {
+                    max = value;
+                }
+                sum += value;
+                double delta = value - mean;
+                mean += delta / count;
+                m2 += delta * (value - mean);
+            }
 
-                if (!rayDefined) {
-                    // discard each point within minimum tolerance
-                    if (math::point_distance2 <DIM> (r0, pj) < min_tol2) {
-                        continue;
-                    }
-                    // the last point within minimum tolerance pi defines the ray R(r0, r1)
-                    r1 = pi;
-                    rayDefined = true;
+            //! \brief Returns the statistics of all added values; all zero when none were added.
+            Statistics Result () const {
+                Statistics stats;
+                if (count) {
+                    stats.max = max;
+                    stats.sum = sum;
+                    stats.mean = sum / count;
+                    stats.std = std::sqrt (m2 / count);
                 }
+                return stats;
+            }
 
-                // check each point pj against R(r0, r1)
-                if (math::point_distance2 <DIM> (r0, pj) < max_tol2 &&
-                    math::ray_distance2 <DIM> (r0, r1, pj) < min_tol2)
-                {
-                    continue;
+        private:
+            std::size_t count;      //! number of values
+            double max;             //! maximum value
+            double sum;             //! sum of all values
+            double mean;            //! running mean
+            double m2;              //! sum of squared differences from the running mean
+        };
+
+        /*!
+            \brief Determines if two points have the exact same coordinates.
+
+            \param[in] p1       the first coordinate of the first point
+            \param[in] p2       the first coordinate of the second point
+            \return             true when the points are equal; false otherwise
+        */
+        template <unsigned DIM, class InputIterator>
+        inline bool equal (
+            InputIterator p1,
+            InputIterator p2)
+        {
+            for (unsigned d = 0; d < DIM; ++d) {
+                if (*p1 != *p2) {
+                    return false;
                 }
-                // found the next key at pi
-                CopyKey (pi, result);
-                // define new ray R(pi, pj)
-                r0 = pi;
-                rayDefined = false;
+                ++p1;
+                ++p2;
             }
-            // the last point is always part of the simplification
-            CopyKey (pj, result);
+            return true;
+        }
+
+        /*!
+            \brief Creates a vector from two points.
 
+            \param[in] p1       the first coordinate of the first point
+            \param[in] p2       the first coordinate of the second point
+            \param[in] result   the resulting vector (p2-p1)
+            \return             one beyond the last coordinate of the resulting vector
+        */
+        template <unsigned DIM, class InputIterator, class OutputIterator>
+        inline OutputIterator make_vector (
+            InputIterator p1,
+            InputIterator p2,
+            OutputIterator result)
+        {
+            for (unsigned d = 0; d < DIM; ++d) {
+                *result = *p2 - *p1;
+                ++result;
+                ++p1;
+                ++p2;
+            }
             return result;
         }
 
         /*!
-            \brief Performs Lang approximation (LA).
+            \brief Computes the dot product of two vectors.
 
-            The LA routine defines a fixed size search-region. The first and last points of that
-            search region form a segment. This segment is used to calculate the perpendicular
-            distance to each intermediate point. If any calculated distance is larger than the
-            specified tolerance, the search region will be shrunk by excluding its last point. This
-            process will continue untill all calculated distances fall below the specified tolerance
-            , or there are no more intermediate points. At this point all intermediate points are
-            removed and a new search region is defined starting at the last point from old search
-            region.
-            Note that the size of the search region (look_ahead parameter) controls the maximum
-            amount of simplification, e.g.: a size of 20 will always result in a simplification that
-            contains at least 5% of the original points.
+            \param[in] v1   the first coordinate of the first vector
+            \param[in] v2   the first coordinate of the second vector
+            \return         the dot product (v1 * v2)
+        */
+        template <unsigned DIM, class InputIterator>
+        inline typename std::iterator_traits <InputIterator>::value_type dot (
+            InputIterator v1,
+            InputIterator v2)
+        {
+            typename std::iterator_traits <InputIterator>::value_type result = 0;
+            for (unsigned d = 0; d < DIM; ++d) {
+                result += (*v1) * (*v2);
+                ++v1;
+                ++v2;
+            }
+            return result;
+        }
 
-            \image html psimpl_la.png
+        /*!
+            \brief Peforms linear interpolation between two points.
 
-            LA routine is applied to the range [first, last) using the specified tolerance and
-            look ahead values. The resulting simplified polyline is copied to the output range
-            [result, result + m*DIM), where m is the number of vertices of the simplified polyline.
-            The return value is the end of the output range: result + m*DIM.
+            \param[in] p1           the first coordinate of the first point
+            \param[in] p2           the first coordinate of the second point
+            \param[in] fraction     the fraction used during interpolation
+            \param[in] result       the interpolation result (p1 + fraction * (p2 - p1))
+            \return                 one beyond the last coordinate of the interpolated point
+        */
+        template <unsigned DIM, class InputIterator, class OutputIterator>
+        inline OutputIterator interpolate (
+            InputIterator p1,
+            InputIterator p2,
+            float fraction,
+            OutputIterator result)
+        {
+            typedef typename std::iterator_traits <InputIterator>::value_type value_type;
 
-            Input (Type) Requirements:
-            1- DIM is not 0, where DIM represents the dimension of the polyline
-            2- The InputIterator type models the concept of a bidirectional iterator
-            3- The InputIterator value type is convertible to a value type of the output iterator
-            4- The range [first, last) contains vertex coordinates in multiples of DIM,
-               f.e.: x, y, z, x, y, z, x, y, z when DIM = 3
-            5- The range [first, last) contains at least 2 vertices
-            6- tol is not 0
-            7- look_ahead is not zero
+            for (unsigned d = 0; d < DIM; ++d) {
+                *result = *p1 + static_cast <value_type> (fraction * (*p2 - *p1));
+                ++result;
+                ++p1;
+                ++p2;
+            }
+            return result;
+        }
 
-            In case these requirements are not met, the entire input range [first, last) is copied
-            to the output range [result, result + (last - first)) OR compile errors may occur.
+        /*!
+            \brief Determines if ExactProjection computes the distances for value_type T.
 
-            \param[in] first      the first coordinate of the first polyline point
-            \param[in] last       one beyond the last coordinate of the last polyline point
-            \param[in] tol        perpendicular (point-to-segment) distance tolerance
-            \param[in] look_ahead defines the size of the search region
-            \param[in] result     destination of the simplified polyline
-            \return               one beyond the last coordinate of the simplified polyline
+            Only signed integer types qualify. The vectors between points of an unsigned type
+            wrap around, and their squares would overflow the wide type.
         */
-        OutputIterator Lang (
-            InputIterator first,
-            InputIterator last,
-            value_type tol,
-            unsigned look_ahead,
-            OutputIterator result)
+        template <typename T>
+        struct exact_projection : std::integral_constant <bool,
+            std::numeric_limits <T>::is_integer && std::numeric_limits <T>::is_signed> {};
+
+        /*!
+            \brief Precision policy that computes projection fractions in a fixed type F.
+
+            The line, segment and ray distance functions project the test point onto the line,
+            using the fraction cw / cv. A precision policy selects the type in which that
+            fraction is computed, for a given value_type T, through fraction <T>::type.
+            Integer types for which ExactProjection is used do not compute a fraction, and are
+            not affected by the policy.
+        */
+        template <typename F>
+        struct fixed_precision
         {
-            diff_type coordCount = std::distance (first, last);
-            diff_type pointCount = DIM      // protect against zero DIM
-                                   ? coordCount / DIM
-                                   : 0;
-            value_type tol2 = tol * tol;    // squared minimum distance tolerance
-            
-            // validate input and check if simplification required
-            if (coordCount % DIM || pointCount < 3 || look_ahead < 2 || tol2 == 0) {
-                return std::copy (first, last, result);
-            }
+            template <typename T>
+            struct fraction
+            {
+                typedef F type;
+            };
+        };
 
-            InputIterator current = first;          // indicates the current key
-            InputIterator next = first;             // used to find the next key
+        //! \brief Computes fractions in float; fast, and the default.
+        struct float_precision : fixed_precision <float> {};
 
-            unsigned remaining = pointCount - 1;    // the number of points remaining after current
-            unsigned moved = Forward (next, look_ahead, remaining);
+        //! \brief Computes fractions in double.
+        struct double_precision : fixed_precision <double> {};
 
-            // the first point is always part of the simplification
-            CopyKey (current, result);
+        //! \brief Computes fractions in long double.
+        struct long_double_precision : fixed_precision <long double> {};
 
-            while (moved) {
-                value_type d2 = 0;
-                InputIterator p = AdvanceCopy (current);
+        /*!
+            \brief Computes fractions in the value_type of the polyline.
 
-                while (p != next) {
-                    d2 = std::max (d2, math::segment_distance2 <DIM> (current, next, p));
-                    if (tol2 < d2) {
-                        break;
-                    }
-                    Advance (p);
+            Integer types, which cannot hold a fraction, use double.
+        */
+        struct value_precision
+        {
+            template <typename T>
+            struct fraction
+            {
+                typedef typename std::conditional <std::numeric_limits <T>::is_integer,
+                    double, T>::type type;
+            };
+        };
+
+        //! \brief Marks fraction type F, for which exact distances are rounded up; see ExactProjection.
+        template <typename F>
+        struct round_up {};
+
+        /*!
+            \brief Computes fractions like Precision does, but rounds exact integer distances up.
+
+            The rounded down distances of ExactProjection decide point < tol2 and tol2 <= point
+            exactly. Routines that test tol2 < point instead, or that report the distance as an
+            error, use this policy: the rounded up distance is never smaller than the exact one.
+            Floating point and unsigned types are not affected.
+        */
+        template <class Precision>
+        struct round_up_precision
+        {
+            template <typename T>
+            struct fraction
+            {
+                typedef typename Precision::template fraction <T>::type base;
+                typedef typename std::conditional <exact_projection <T>::value,
+                    round_up <base>, base>::type type;
+            };
+        };
+
+        template <unsigned DIM, typename F> struct Distance;
+
+        /*!
+            \brief Computes the squared distance of two points
+
+            \param[in] p1   the first coordinate of the first point
+            \param[in] p2   the first coordinate of the second point
+            \return         the squared distance
+        */
+        template <unsigned DIM, class InputIterator1, class InputIterator2>
+        inline typename std::iterator_traits <InputIterator1>::value_type point_distance2 (
+            InputIterator1 p1,
+            InputIterator2 p2)
+        {
+            PSIMPL_COUNT(pointDistances, 1);
+            return Distance <DIM, float>::PointDistance2 (p1, p2);
+        }
+
+        /*!
+            \brief Computes the squared distance between a point p and its projection onto a line.
+
+            The projection of p onto the line (l1, l2) is computed by interpolation, using a
+            fraction of type F. Specializations exist for signed integer types, see
+            ExactProjection and exact_projection.
+        */
+        template <typename T,
+                  typename F = float,
+                  bool EXACT = exact_projection <T>::value,
+                  std::size_t SIZE = sizeof (T)>
+        struct Projection
+        {
+            /*!
+                \param[in] l1   the first coordinate of the first point on the line
+                \param[in] l2   the first coordinate of the second point on the line
+                \param[in] p    the first coordinate of the test point
+                \param[in] w    the vector l1 --> p
+                \param[in] cw   the dot product of w and the vector v: l1 --> l2
+                \param[in] cv   the squared length of v
+                \return         the squared distance
+            */
+            template <unsigned DIM, class InputIterator>
+            static T Distance2 (
+                InputIterator l1,
+                InputIterator l2,
+                InputIterator p,
+                const T* /*w*/,
+                T cw,
+                T cv)
+            {
+                // avoid problems with divisions when value_type is an integer type
+                F fraction = cv == 0 ? 0 : static_cast <F> (cw) / static_cast <F> (cv);
+
+                T proj [DIM];           // p projected onto line (l1, l2)
+                for (unsigned d = 0; d < DIM; ++d) {
+                    proj [d] = *l1 + static_cast <T> (fraction * (*l2 - *l1));
+                    ++l1;
+                    ++l2;
+                }
+
+                return point_distance2 <DIM> (p, proj);
+            }
+
+            //! \brief Distance2 for 2 dimensions, given the point coordinates and w.
+            static T Distance2 (
+                T ax, T ay,
+                T bx, T by,
+                T px, T py,
+                T /*wx*/, T /*wy*/,
+                T cw,
+                T cv)
+            {
+                F fraction = cv == 0 ? 0 : static_cast <F> (cw) / static_cast <F> (cv);
+                T qx = ax + static_cast <T> (fraction * (bx - ax));
+                T qy = ay + static_cast <T> (fraction * (by - ay));
+                PSIMPL_COUNT(pointDistances, 1);
+                return (px - qx) * (px - qx) + (py - qy) * (py - qy);
+            }
+
+            //! \brief Distance2 for 3 dimensions, given the point coordinates and w.
+            static T Distance2 (
+                T ax, T ay, T az,
+                T bx, T by, T bz,
+                T px, T py, T pz,
+                T /*wx*/, T /*wy*/, T /*wz*/,
+                T cw,
+                T cv)
+            {
+                F fraction = cv == 0 ? 0 : static_cast <F> (cw) / static_cast <F> (cv);
+                T qx = ax + static_cast <T> (fraction * (bx - ax));
+                T qy = ay + static_cast <T> (fraction * (by - ay));
+                T qz = az + static_cast <T> (fraction * (bz - az));
+                PSIMPL_COUNT(pointDistances, 1);
+                return (px - qx) * (px - qx) + (py - qy) * (py - qy) + (pz - qz) * (pz - qz);
+            }
+        };
+
+        /*!
+            \brief Computes the exact squared distance between a point and its projection onto a line.
+
+            Instead of interpolating the projection, the squared distance is computed as
+            (|w|^2 * cv - cw^2) / cv, using a signed integer type Wide that is twice as wide as
+            the signed integer type T. The result is rounded down, or up when UP is set, and is
+            otherwise exact as long as the squared distances of the polyline fit in T. Comparing
+            the rounded down distance against an integer tolerance using < or >= gives the same
+            outcome as for the exact distance. Comparisons using > or <= require the rounded up
+            distance instead, which round_up_precision selects.
+        */
+        template <typename T, typename Wide, bool UP = false>
+        struct ExactProjection
+        {
+            template <unsigned DIM, class InputIterator>
+            static T Distance2 (
+                InputIterator /*l1*/,
+                InputIterator /*l2*/,
+                InputIterator /*p*/,
+                const T* w,
+                T cw,
+                T cv)
+            {
+                Wide cww = 0;           // squared length of w
+                for (unsigned d = 0; d < DIM; ++d) {
+                    cww += static_cast <Wide> (w [d]) * w [d];
                 }
-                if (d2 < tol2) {
-                    current = next;
-                    CopyKey (current, result);
-                    moved = Forward (next, look_ahead, remaining);
+                return Divide (cww, cw, cv);
+            }
+
+            //! \brief Distance2 for 2 dimensions, given the point coordinates and w.
+            static T Distance2 (
+                T /*ax*/, T /*ay*/,
+                T /*bx*/, T /*by*/,
+                T /*px*/, T /*py*/,
+                T wx, T wy,
+                T cw,
+                T cv)
+            {
+                return Divide (static_cast <Wide> (wx) * wx + static_cast <Wide> (wy) * wy,
+                               cw, cv);
+            }
+
+            //! \brief Distance2 for 3 dimensions, given the point coordinates and w.
+            static T Distance2 (
+                T /*ax*/, T /*ay*/, T /*az*/,
+                T /*bx*/, T /*by*/, T /*bz*/,
+                T /*px*/, T /*py*/, T /*pz*/,
+                T wx, T wy, T wz,
+                T cw,
+                T cv)
+            {
+                return Divide (static_cast <Wide> (wx) * wx + static_cast <Wide> (wy) * wy +
+                               static_cast <Wide> (wz) * wz, cw, cv);
+            }
+
+        private:
+            //! \brief Computes the squared distance (cww * cv - cw^2) / cv, where cww = |w|^2.
+            static T Divide (
+                Wide cww,
+                T cw,
+                T cv)
+            {
+                if (cv == 0) {
+                    return static_cast <T> (cww);
                 }
-                else {
-                    Backward (next, remaining);
+                Wide numerator = cww * cv - static_cast <Wide> (cw) * cw;
+                Wide quotient = numerator / cv;
+                if (UP && quotient * cv < numerator) {
+                    ++quotient;
                 }
+                return static_cast <T> (quotient);
             }
-            return result;
-        }
+        };
 
-        /*!
-            \brief Performs Douglas-Peucker approximation (DP).
+        template <typename T, typename F> struct Projection <T, F, true, 1> : ExactProjection <T, long long> {};
+        template <typename T, typename F> struct Projection <T, F, true, 2> : ExactProjection <T, long long> {};
+        template <typename T, typename F> struct Projection <T, F, true, 4> : ExactProjection <T, long long> {};
+        template <typename T, typename F> struct Projection <T, round_up <F>, true, 1> : ExactProjection <T, long long, true> {};
+        template <typename T, typename F> struct Projection <T, round_up <F>, true, 2> : ExactProjection <T, long long, true> {};
+        template <typename T, typename F> struct Projection <T, round_up <F>, true, 4> : ExactProjection <T, long long, true> {};
+#ifdef PSIMPL_INT128
+        __extension__ typedef __int128 int128;
+        template <typename T, typename F> struct Projection <T, F, true, 8> : ExactProjection <T, int128> {};
+        template <typename T, typename F> struct Projection <T, round_up <F>, true, 8> : ExactProjection <T, int128, true> {};
+#else
+        template <typename T, typename F> struct Projection <T, round_up <F>, true, 8> : Projection <T, F, true, 8> {};
+#endif
 
-            The DP algorithm uses the RadialDistance (RD) routine O(n) as a preprocessing step.
-            After RD the algorithm is O (n m) in worst case and O(n log m) on average, where m < n
-            (m is the number of points after RD).
+        /*!
+            \brief Computes the squared distance between an infinite line (l1, l2) and a point p
 
-            The DP algorithm starts with a simplification that is the single edge joining the first
-            and last vertices of the polyline. The distance of the remaining vertices to that edge
-            are computed. The vertex that is furthest away from theedge (called a key), and has a
-            computed distance that is larger than a specified tolerance, will be added to the
-            simplification. This process will recurse for each edge in the current simplification,
-            untill all vertices of the original polyline are within tolerance.
+            \param[in] l1   the first coordinate of the first point on the line
+            \param[in] l2   the first coordinate of the second point on the line
+            \param[in] p    the first coordinate of the test point
+            \return         the squared distance
+        */
+        template <unsigned DIM, class Precision = float_precision, class InputIterator>
+        inline typename std::iterator_traits <InputIterator>::value_type line_distance2 (
+            InputIterator l1,
+            InputIterator l2,
+            InputIterator p)
+        {
+            PSIMPL_COUNT(lineDistances, 1);
+            typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+            typedef typename Precision::template fraction <value_type>::type fraction_type;
+            return Distance <DIM, fraction_type>::LineDistance2 (l1, l2, p);
+        }
 
-            \image html psimpl_dp.png
+        /*!
+            \brief Computes the squared distance between a line segment (s1, s2) and a point p
 
-            Note that this algorithm will create a copy of the input polyline during the vertex
-            reduction step.
+            \param[in] s1   the first coordinate of the start point of the segment
+            \param[in] s2   the first coordinate of the end point of the segment
+            \param[in] p    the first coordinate of the test point
+            \return         the squared distance
+        */
+        template <unsigned DIM, class Precision = float_precision, class InputIterator>
+        inline typename std::iterator_traits <InputIterator>::value_type segment_distance2 (
+            InputIterator s1,
+            InputIterator s2,
+            InputIterator p)
+        {
+            PSIMPL_COUNT(segmentDistances, 1);
+            typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+            typedef typename Precision::template fraction <value_type>::type fraction_type;
+            return Distance <DIM, fraction_type>::SegmentDistance2 (s1, s2, p);
+        }
 
-            RD followed by DP is applied to the range [first, last) using the specified tolerance
-            tol. The resulting simplified polyline is copied to the output range
-            [result, result + m*DIM), where m is the number of vertices of the simplified polyline.
-            The return value is the end of the output range: result + m*DIM.
+        /*!
+            \brief Computes the squared distance between a ray (r1, r2) and a point p
 
-            Input (Type) requirements:
-            1- DIM is not 0, where DIM represents the dimension of the polyline
-            2- The InputIterator type models the concept of a forward iterator
-            3- The InputIterator value type is convertible to a value type of the output iterator
-            4- The range [first, last) contains vertex coordinates in multiples of DIM, f.e.:
-               x, y, z, x, y, z, x, y, z when DIM = 3
-            5- The range [first, last) contains at least 2 vertices
-            6- tol is not 0
+            \param[in] r1   the first coordinate of the start point of the ray
+            \param[in] r2   the first coordinate of a point on the ray
+            \param[in] p    the first coordinate of the test point
+            \return         the squared distance
+        */
+        template <unsigned DIM, class Precision = float_precision, class InputIterator>
+        inline typename std::iterator_traits <InputIterator>::value_type ray_distance2 (
+            InputIterator r1,
+            InputIterator r2,
+            InputIterator p)
+        {
+            PSIMPL_COUNT(rayDistances, 1);
+            typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+            typedef typename Precision::template fraction <value_type>::type fraction_type;
+            return Distance <DIM, fraction_type>::RayDistance2 (r1, r2, p);
+        }
 
-            In case these requirements are not met, the entire input range [first, last) is copied
-            to the output range [result, result + (last - first)) OR compile errors may occur.
+        /*!
+            \brief The point of a column iterator, read into a local array.
 
-            \param[in] first    the first coordinate of the first polyline point
-            \param[in] last     one beyond the last coordinate of the last polyline point
-            \param[in] tol      perpendicular (point-to-segment) distance tolerance
-            \param[in] result   destination of the simplified polyline
-            \return             one beyond the last coordinate of the simplified polyline
+            The distance functions are overloaded for column iterators, so that they read each
+            point directly from its columns, and run the kernels for arrays. Advancing and
+            copying the column iterators themselves is much more expensive than the distance
+            computation. The iterators must refer to the first coordinate of a point.
         */
-        OutputIterator DouglasPeucker (
-            InputIterator first,
-            InputIterator last,
-            value_type tol,
-            OutputIterator result)
+        template <unsigned DIM, class T>
+        struct ColumnPoint
         {
-            diff_type coordCount = std::distance (first, last);
-            diff_type pointCount = DIM      // protect against zero DIM
-                                   ? coordCount / DIM
-                                   : 0;
-            // validate input and check if simplification required
-            if (coordCount % DIM || pointCount < 3 || tol == 0) {
-                return std::copy (first, last, result);
+            explicit ColumnPoint (const util::column_iterator <DIM, T>& it) {
+                for (unsigned d = 0; d < DIM; ++d) {
+                    coords [d] = it.at (d);
+                }
             }
-            // radial distance routine as preprocessing
-            util::scoped_array <value_type> reduced (coordCount);   // radial distance results
-            PolylineSimplification <DIM, InputIterator, value_type*> psimpl_to_array;
-            ptr_diff_type reducedCoordCount = std::distance (reduced.get (),
-                psimpl_to_array.RadialDistance (first, last, tol, reduced.get ()));
-            ptr_diff_type reducedPointCount = reducedCoordCount / DIM;
 
-            // douglas-peucker approximation
-            util::scoped_array <unsigned char> keys (pointCount);         // douglas-peucker results
-            DPHelper::Approximate (reduced.get (), reducedCoordCount, tol, keys.get ());
+            typename std::remove_const <T>::type coords [DIM];  //! the coordinates of the point
+        };
+
+        //! \brief point_distance2 for column iterators, see ColumnPoint.
+        template <unsigned DIM, class T>
+        inline typename std::remove_const <T>::type point_distance2 (
+            const util::column_iterator <DIM, T>& p1,
+            const util::column_iterator <DIM, T>& p2)
+        {
+            return point_distance2 <DIM> (ColumnPoint <DIM, T> (p1).coords,
+                                          ColumnPoint <DIM, T> (p2).coords);
+        }
+
+        //! \brief line_distance2 for column iterators, see ColumnPoint.
+        template <unsigned DIM, class Precision = float_precision, class T>
+        inline typename std::remove_const <T>::type line_distance2 (
+            const util::column_iterator <DIM, T>& l1,
+            const util::column_iterator <DIM, T>& l2,
+            const util::column_iterator <DIM, T>& p)
+        {
+            return line_distance2 <DIM, Precision> (ColumnPoint <DIM, T> (l1).coords,
+                                                    ColumnPoint <DIM, T> (l2).coords,
+                                                    ColumnPoint <DIM, T> (p).coords);
+        }
+
+        //! \brief segment_distance2 for column iterators, see ColumnPoint.
+        template <unsigned DIM, class Precision = float_precision, class T>
+        inline typename std::remove_const <T>::type segment_distance2 (
+            const util::column_iterator <DIM, T>& s1,
+            const util::column_iterator <DIM, T>& s2,
+            const util::column_iterator <DIM, T>& p)
+        {
+            return segment_distance2 <DIM, Precision> (ColumnPoint <DIM, T> (s1).coords,
+                                                       ColumnPoint <DIM, T> (s2).coords,
+                                                       ColumnPoint <DIM, T> (p).coords);
+        }
+
+        //! \brief ray_distance2 for column iterators, see ColumnPoint.
+        template <unsigned DIM, class Precision = float_precision, class T>
+        inline typename std::remove_const <T>::type ray_distance2 (
+            const util::column_iterator <DIM, T>& r1,
+            const util::column_iterator <DIM, T>& r2,
+            const util::column_iterator <DIM, T>& p)
+        {
+            return ray_distance2 <DIM, Precision> (ColumnPoint <DIM, T> (r1).coords,
+                                                   ColumnPoint <DIM, T> (r2).coords,
+                                                   ColumnPoint <DIM, T> (p).coords);
+        }
+
+        /*!
+            \brief Generic implementation of the distance functions, for any dimension.
+
+            Coordinates are read through the input iterators each time they are needed, and the
+            vectors between the points are stored in temporary arrays. Projection fractions are
+            computed in type F.
+        */
+        template <unsigned DIM, typename F = float>
+        struct GenericDistance
+        {
+            //! \brief See point_distance2.
+            template <class InputIterator1, class InputIterator2>
+            static typename std::iterator_traits <InputIterator1>::value_type PointDistance2 (
+                InputIterator1 p1,
+                InputIterator2 p2)
+            {
+                typename std::iterator_traits <InputIterator1>::value_type result = 0;
+                for (unsigned d = 0; d < DIM; ++d) {
+                    result += (*p1 - *p2) * (*p1 - *p2);
+                    ++p1;
+                    ++p2;
+                }
+                return result;
+            }
+
+            //! \brief See line_distance2.
+            template <class InputIterator>
+            static typename std::iterator_traits <InputIterator>::value_type LineDistance2 (
+                InputIterator l1,
+                InputIterator l2,
+                InputIterator p)
+            {
+                typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+
+                value_type v [DIM];                 // vector l1 --> l2
+                value_type w [DIM];                 // vector l1 --> p
+
+                make_vector <DIM> (l1, l2, v);
+                make_vector <DIM> (l1, p,  w);
+
+                value_type cv = dot <DIM> (v, v);   // squared length of v
+                value_type cw = dot <DIM> (w, v);   // project w onto v
+
+                return Projection <value_type, F>::template Distance2 <DIM> (l1, l2, p, w, cw, cv);
+            }
+
+            //! \brief See segment_distance2.
+            template <class InputIterator>
+            static typename std::iterator_traits <InputIterator>::value_type SegmentDistance2 (
+                InputIterator s1,
+                InputIterator s2,
+                InputIterator p)
+            {
+                typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+
+                value_type v [DIM];        // vector s1 --> s2
+                value_type w [DIM];        // vector s1 --> p
+
+                make_vector <DIM> (s1, s2, v);
+                make_vector <DIM> (s1, p,  w);
+
+                value_type cw = dot <DIM> (w, v);   // project w onto v
+                if (cw <= 0) {
+                    // projection of w lies to the left of s1
+                    return point_distance2 <DIM> (p, s1);
+                }
+
+                value_type cv = dot <DIM> (v, v);   // squared length of v
+                if (cv <= cw) {
+                    // projection of w lies to the right of s2
+                    return point_distance2 <DIM> (p, s2);
+                }
+
+                return Projection <value_type, F>::template Distance2 <DIM> (s1, s2, p, w, cw, cv);
+            }
+
+            //! \brief See ray_distance2.
+            template <class InputIterator>
+            static typename std::iterator_traits <InputIterator>::value_type RayDistance2 (
+                InputIterator r1,
+                InputIterator r2,
+                InputIterator p)
+            {
+                typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+
+                value_type v [DIM];        // vector r1 --> r2
+                value_type w [DIM];        // vector r1 --> p
+
+                make_vector <DIM> (r1, r2, v);
+                make_vector <DIM> (r1, p,  w);
+
+                value_type cv = dot <DIM> (v, v);    // squared length of v
+                value_type cw = dot <DIM> (w, v);    // project w onto v
+
+                if (cw <= 0) {
+                    // projection of w lies to the left of r1 (not on the ray)
+                    return point_distance2 <DIM> (p, r1);
+                }
+
+                return Projection <value_type, F>::template Distance2 <DIM> (r1, r2, p, w, cw, cv);
+            }
+        };
+
+        /*!
+            \brief Fused implementation of the line, segment and ray distance functions.
+
+            Each coordinate of the three points is read exactly once, into local arrays. The
+            vectors, dot products and projection are then computed from those locals in a single
+            function, with loops of DIM iterations. The same operations are performed in the same
+            order as GenericDistance, so the results are bit-for-bit identical. Dimensions 2 and 3
+            are specialized as straight-line code on scalar locals, without any arrays.
+        */
+        template <unsigned DIM, typename F = float>
+        struct FusedDistance : GenericDistance <DIM, F>
+        {
+            //! \brief See line_distance2.
+            template <class InputIterator>
+            static typename std::iterator_traits <InputIterator>::value_type LineDistance2 (
+                InputIterator l1,
+                InputIterator l2,
+                InputIterator p)
+            {
+                typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+
+                value_type a [DIM], b [DIM], c [DIM], w [DIM];
+                value_type cw, cv;
+                Prepare (l1, l2, p, a, b, c, w, cw, cv);
+
+                return Projection <value_type, F>::template Distance2 <DIM> (a, b, c, w, cw, cv);
+            }
+
+            //! \brief See segment_distance2.
+            template <class InputIterator>
+            static typename std::iterator_traits <InputIterator>::value_type SegmentDistance2 (
+                InputIterator s1,
+                InputIterator s2,
+                InputIterator p)
+            {
+                typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+
+                value_type a [DIM], b [DIM], c [DIM], w [DIM];
+                value_type cw, cv;
+                Prepare (s1, s2, p, a, b, c, w, cw, cv);
+
+                if (cw <= 0) {
+                    // projection of w lies to the left of s1
+                    return point_distance2 <DIM> (c, a);
+                }
+                if (cv <= cw) {
+                    // projection of w lies to the right of s2
+                    return point_distance2 <DIM> (c, b);
+                }
+                return Projection <value_type, F>::template Distance2 <DIM> (a, b, c, w, cw, cv);
+            }
+
+            //! \brief See ray_distance2.
+            template <class InputIterator>
+            static typename std::iterator_traits <InputIterator>::value_type RayDistance2 (
+                InputIterator r1,
+                InputIterator r2,
+                InputIterator p)
+            {
+                typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+
+                value_type a [DIM], b [DIM], c [DIM], w [DIM];
+                value_type cw, cv;
+                Prepare (r1, r2, p, a, b, c, w, cw, cv);
+
+                if (cw <= 0) {
+                    // projection of w lies to the left of r1 (not on the ray)
+                    return point_distance2 <DIM> (c, a);
+                }
+                return Projection <value_type, F>::template Distance2 <DIM> (a, b, c, w, cw, cv);
+            }
+
+        private:
+            /*!
+                \brief Reads three points, and computes the projection of p1 --> p onto p1 --> p2.
+
+                \param[in] p1       the first coordinate of the first point
+                \param[in] p2       the first coordinate of the second point
+                \param[in] p        the first coordinate of the test point
+                \param[out] a       the coordinates of p1
+                \param[out] b       the coordinates of p2
+                \param[out] c       the coordinates of p
+                \param[out] w       the vector p1 --> p
+                \param[out] cw      the dot product of w and the vector v: p1 --> p2
+                \param[out] cv      the squared length of v
+            */
+            template <class InputIterator, typename T>
+            static void Prepare (
+                InputIterator p1,
+                InputIterator p2,
+                InputIterator p,
+                T* a,
+                T* b,
+                T* c,
+                T* w,
+                T& cw,
+                T& cv)
+            {
+                for (unsigned d = 0; d < DIM; ++d) {
+                    a [d] = *p1;
+                    b [d] = *p2;
+                    c [d] = *p;
+                    ++p1;
+                    ++p2;
+                    ++p;
+                }
+                cw = 0;
+                cv = 0;
+                for (unsigned d = 0; d < DIM; ++d) {
+                    T v = b [d] - a [d];
+                    w [d] = c [d] - a [d];
+                    cw += w [d] * v;
+                    cv += v * v;
+                }
+            }
+        };
+
+        //! \brief FusedDistance for 2 dimensions.
+        template <typename F>
+        struct FusedDistance <2, F> : GenericDistance <2, F>
+        {
+            //! \brief See line_distance2.
+            template <class InputIterator>
+            static typename std::iterator_traits <InputIterator>::value_type LineDistance2 (
+                InputIterator l1,
+                InputIterator l2,
+                InputIterator p)
+            {
+                typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+
+                const value_type ax = *l1, ay = *++l1;
+                const value_type bx = *l2, by = *++l2;
+                const value_type px = *p,  py = *++p;
+                const value_type vx = bx - ax, vy = by - ay;    // vector l1 --> l2
+                const value_type wx = px - ax, wy = py - ay;    // vector l1 --> p
+                const value_type cw = wx * vx + wy * vy;        // project w onto v
+                const value_type cv = vx * vx + vy * vy;        // squared length of v
+
+                return Projection <value_type, F>::Distance2 (
+                    ax, ay, bx, by, px, py, wx, wy, cw, cv);
+            }
+
+            //! \brief See segment_distance2.
+            template <class InputIterator>
+            static typename std::iterator_traits <InputIterator>::value_type SegmentDistance2 (
+                InputIterator s1,
+                InputIterator s2,
+                InputIterator p)
+            {
+                typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+
+                const value_type ax = *s1, ay = *++s1;
+                const value_type bx = *s2, by = *++s2;
+                const value_type px = *p,  py = *++p;
+                const value_type vx = bx - ax, vy = by - ay;    // vector s1 --> s2
+                const value_type wx = px - ax, wy = py - ay;    // vector s1 --> p
+                const value_type cw = wx * vx + wy * vy;        // project w onto v
+                const value_type cv = vx * vx + vy * vy;        // squared length of v
+
+                if (cw <= 0) {
+                    // projection of w lies to the left of s1
+                    PSIMPL_COUNT(pointDistances, 1);
+                    return wx * wx + wy * wy;
+                }
+                if (cv <= cw) {
+                    // projection of w lies to the right of s2
+                    PSIMPL_COUNT(pointDistances, 1);
+                    return (px - bx) * (px - bx) + (py - by) * (py - by);
+                }
+                return Projection <value_type, F>::Distance2 (
+                    ax, ay, bx, by, px, py, wx, wy, cw, cv);
+            }
+
+            //! \brief See ray_distance2.
+            template <class InputIterator>
+            static typename std::iterator_traits <InputIterator>::value_type RayDistance2 (
+                InputIterator r1,
+                InputIterator r2,
+                InputIterator p)
+            {
+                typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+
+                const value_type ax = *r1, ay = *++r1;
+                const value_type bx = *r2, by = *++r2;
+                const value_type px = *p,  py = *++p;
+                const value_type vx = bx - ax, vy = by - ay;    // vector r1 --> r2
+                const value_type wx = px - ax, wy = py - ay;    // vector r1 --> p
+                const value_type cw = wx * vx + wy * vy;        // project w onto v
+                const value_type cv = vx * vx + vy * vy;        // squared length of v
+
+                if (cw <= 0) {
+                    // projection of w lies to the left of r1 (not on the ray)
+                    PSIMPL_COUNT(pointDistances, 1);
+                    return wx * wx + wy * wy;
+                }
+                return Projection <value_type, F>::Distance2 (
+                    ax, ay, bx, by, px, py, wx, wy, cw, cv);
+            }
+        };
+
+        //! \brief FusedDistance for 3 dimensions.
+        template <typename F>
+        struct FusedDistance <3, F> : GenericDistance <3, F>
+        {
+            //! \brief See line_distance2.
+            template <class InputIterator>
+            static typename std::iterator_traits <InputIterator>::value_type LineDistance2 (
+                InputIterator l1,
+                InputIterator l2,
+                InputIterator p)
+            {
+                typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+
+                const value_type ax = *l1, ay = *++l1, az = *++l1;
+                const value_type bx = *l2, by = *++l2, bz = *++l2;
+                const value_type px = *p,  py = *++p,  pz = *++p;
+                const value_type vx = bx - ax, vy = by - ay, vz = bz - az;  // vector l1 --> l2
+                const value_type wx = px - ax, wy = py - ay, wz = pz - az;  // vector l1 --> p
+                const value_type cw = wx * vx + wy * vy + wz * vz;          // project w onto v
+                const value_type cv = vx * vx + vy * vy + vz * vz;          // squared length of v
+
+                return Projection <value_type, F>::Distance2 (
+                    ax, ay, az, bx, by, bz, px, py, pz, wx, wy, wz, cw, cv);
+            }
+
+            //! \brief See segment_distance2.
+            template <class InputIterator>
+            static typename std::iterator_traits <InputIterator>::value_type SegmentDistance2 (
+                InputIterator s1,
+                InputIterator s2,
+                InputIterator p)
+            {
+                typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+
+                const value_type ax = *s1, ay = *++s1, az = *++s1;
+                const value_type bx = *s2, by = *++s2, bz = *++s2;
+                const value_type px = *p,  py = *++p,  pz = *++p;
+                const value_type vx = bx - ax, vy = by - ay, vz = bz - az;  // vector s1 --> s2
+                const value_type wx = px - ax, wy = py - ay, wz = pz - az;  // vector s1 --> p
+                const value_type cw = wx * vx + wy * vy + wz * vz;          // project w onto v
+                const value_type cv = vx * vx + vy * vy + vz * vz;          // squared length of v
+
+                if (cw <= 0) {
+                    // projection of w lies to the left of s1
+                    PSIMPL_COUNT(pointDistances, 1);
+                    return wx * wx + wy * wy + wz * wz;
+                }
+                if (cv <= cw) {
+                    // projection of w lies to the right of s2
+                    PSIMPL_COUNT(pointDistances, 1);
+                    return (px - bx) * (px - bx) + (py - by) * (py - by) + (pz - bz) * (pz - bz);
+                }
+                return Projection <value_type, F>::Distance2 (
+                    ax, ay, az, bx, by, bz, px, py, pz, wx, wy, wz, cw, cv);
+            }
+
+            //! \brief See ray_distance2.
+            template <class InputIterator>
+            static typename std::iterator_traits <InputIterator>::value_type RayDistance2 (
+                InputIterator r1,
+                InputIterator r2,
+                InputIterator p)
+            {
+                typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+
+                const value_type ax = *r1, ay = *++r1, az = *++r1;
+                const value_type bx = *r2, by = *++r2, bz = *++r2;
+                const value_type px = *p,  py = *++p,  pz = *++p;
+                const value_type vx = bx - ax, vy = by - ay, vz = bz - az;  // vector r1 --> r2
+                const value_type wx = px - ax, wy = py - ay, wz = pz - az;  // vector r1 --> p
+                const value_type cw = wx * vx + wy * vy + wz * vz;          // project w onto v
+                const value_type cv = vx * vx + vy * vy + vz * vz;          // squared length of v
+
+                if (cw <= 0) {
+                    // projection of w lies to the left of r1 (not on the ray)
+                    PSIMPL_COUNT(pointDistances, 1);
+                    return wx * wx + wy * wy + wz * wz;
+                }
+                return Projection <value_type, F>::Distance2 (
+                    ax, ay, az, bx, by, bz, px, py, pz, wx, wy, wz, cw, cv);
+            }
+        };
+
+        /*!
+            \brief Selects the implementation of the distance functions for a dimension.
+
+            Dimensions 2, 3 and 4 use FusedDistance; all others use GenericDistance.
+        */
+        template <unsigned DIM, typename F = float> struct Distance : GenericDistance <DIM, F> {};
+        template <typename F> struct Distance <2, F> : FusedDistance <2, F> {};
+        template <typename F> struct Distance <3, F> : FusedDistance <3, F> {};
+        template <typename F> struct Distance <4, F> : FusedDistance <4, F> {};
+
+        /*!
+            \brief Finds the test point that is furthest away from a line segment.
+
+            This generic implementation calls segment_distance2 for each test point, computing
+            projection fractions in type F. Vectorized specializations exist for float and
+            double coordinates in 2 and 3 dimensions, with float fractions or, for double
+            coordinates, double fractions.
+        */
+        template <unsigned DIM, typename T, typename F = float>
+        struct FarthestPoint
+        {
+            /*!
+                \brief Scans count test points for the last point with the maximum distance.
+
+                The test points are stored consecutively, starting at points. The key is only
+                updated by a test point whose squared distance to the segment is at least dist2.
+                Of all test points with the maximum distance, the last one is selected.
+
+                \param[in] s1           the first coordinate of the start point of the segment
+                \param[in] s2           the first coordinate of the end point of the segment
+                \param[in] points       the first coordinate of the first test point
+                \param[in] count        the number of test points
+                \param[in,out] key      index of the furthest test point
+                \param[in,out] dist2    squared distance of the furthest test point
+            */
+            static void Find (
+                const T* s1,
+                const T* s2,
+                const T* points,
+                std::ptrdiff_t count,
+                std::ptrdiff_t& key,
+                T& dist2)
+            {
+                for (std::ptrdiff_t p = 0; p < count; ++p, points += DIM) {
+                    T d2 = segment_distance2 <DIM, fixed_precision <F> > (s1, s2, points);
+                    if (d2 < dist2) {
+                        continue;
+                    }
+                    key = p;
+                    dist2 = d2;
+                }
+            }
+        };
+
+        /*!
+            \brief Computes the distances of test points to a line segment.
+
+            This generic implementation calls segment_distance2 for each test point, computing
+            projection fractions in type F. Vectorized specializations exist for float and
+            double coordinates in 2 and 3 dimensions, with float fractions or, for double
+            coordinates, double fractions.
+        */
+        template <unsigned DIM, typename T, typename F = float>
+        struct SegmentDistances
+        {
+            /*!
+                \brief Computes the squared distance of count test points to a segment.
+
+                The test points are stored consecutively, starting at points.
+
+                \param[in] s1       the first coordinate of the start point of the segment
+                \param[in] s2       the first coordinate of the end point of the segment
+                \param[in] points   the first coordinate of the first test point
+                \param[in] count    the number of test points
+                \param[out] dist2   squared distance of each test point
+            */
+            static void Compute (
+                const T* s1,
+                const T* s2,
+                const T* points,
+                std::ptrdiff_t count,
+                T* dist2)
+            {
+                for (std::ptrdiff_t p = 0; p < count; ++p, points += DIM) {
+                    dist2 [p] = segment_distance2 <DIM, fixed_precision <F> > (s1, s2, points);
+                }
+            }
+        };
+
+#ifdef PSIMPL_SSE2
+        //! \brief SSE2 operations on 4 packed floats, with 32 bit point indices.
+        struct SseFloat
+        {
+            typedef float value_type;
+            typedef __m128 vector;
+            enum { LANES = 4 };
+
+            static vector Set (float a) { return _mm_set1_ps (a); }
+            static vector Add (vector a, vector b) { return _mm_add_ps (a, b); }
+            static vector Sub (vector a, vector b) { return _mm_sub_ps (a, b); }
+            static vector Mul (vector a, vector b) { return _mm_mul_ps (a, b); }
+            static vector LessEqual (vector a, vector b) { return _mm_cmple_ps (a, b); }
+            static vector NotLess (vector a, vector b) { return _mm_cmpnlt_ps (a, b); }
+            static vector Select (vector mask, vector a, vector b) {
+                return _mm_or_ps (_mm_and_ps (mask, a), _mm_andnot_ps (mask, b));
+            }
+            static __m128i Select (vector mask, __m128i a, __m128i b) {
+                __m128i m = _mm_castps_si128 (mask);
+                return _mm_or_si128 (_mm_and_si128 (m, a), _mm_andnot_si128 (m, b));
+            }
+            //! \brief coordinate d of the next LANES points
+            template <unsigned DIM>
+            static vector Load (const float* p, unsigned d) {
+                return _mm_set_ps (p [3*DIM+d], p [2*DIM+d], p [DIM+d], p [d]);
+            }
+            //! \brief float (cw) / float (cv), like segment_distance2
+            static vector Fraction (vector cw, float cv, float /*precision*/) {
+                return _mm_div_ps (cw, _mm_set1_ps (cv));
+            }
+            static __m128i Index (int first) { return _mm_setr_epi32 (first, first+1, first+2, first+3); }
+            static __m128i Index (__m128i index, int n) { return _mm_add_epi32 (index, _mm_set1_epi32 (n)); }
+            static void Store (vector v, __m128i index, float* values, std::ptrdiff_t* indices) {
+                int tmp [LANES];
+                _mm_storeu_ps (values, v);
+                _mm_storeu_si128 (reinterpret_cast <__m128i*> (tmp), index);
+                std::copy (tmp, tmp + LANES, indices);
+            }
+            static void Store (vector v, float* values) { _mm_storeu_ps (values, v); }
+        };
+
+        //! \brief SSE2 operations on 2 packed doubles, with 64 bit point indices.
+        struct SseDouble
+        {
+            typedef double value_type;
+            typedef __m128d vector;
+            enum { LANES = 2 };
+
+            static vector Set (double a) { return _mm_set1_pd (a); }
+            static vector Add (vector a, vector b) { return _mm_add_pd (a, b); }
+            static vector Sub (vector a, vector b) { return _mm_sub_pd (a, b); }
+            static vector Mul (vector a, vector b) { return _mm_mul_pd (a, b); }
+            static vector LessEqual (vector a, vector b) { return _mm_cmple_pd (a, b); }
+            static vector NotLess (vector a, vector b) { return _mm_cmpnlt_pd (a, b); }
+            static vector Select (vector mask, vector a, vector b) {
+                return _mm_or_pd (_mm_and_pd (mask, a), _mm_andnot_pd (mask, b));
+            }
+            static __m128i Select (vector mask, __m128i a, __m128i b) {
+                __m128i m = _mm_castpd_si128 (mask);
+                return _mm_or_si128 (_mm_and_si128 (m, a), _mm_andnot_si128 (m, b));
+            }
+            //! \brief coordinate d of the next LANES points
+            template <unsigned DIM>
+            static vector Load (const double* p, unsigned d) {
+                return _mm_set_pd (p [DIM+d], p [d]);
+            }
+            //! \brief float (cw) / float (cv), like segment_distance2
+            static vector Fraction (vector cw, double cv, float /*precision*/) {
+                __m128 fraction = _mm_div_ps (_mm_cvtpd_ps (cw), _mm_set1_ps (static_cast <float> (cv)));
+                return _mm_cvtps_pd (fraction);
+            }
+            //! \brief cw / cv, like segment_distance2 with double fractions
+            static vector Fraction (vector cw, double cv, double /*precision*/) {
+                return _mm_div_pd (cw, _mm_set1_pd (cv));
+            }
+            static __m128i Index (int first) {
+                // sign extend, so that negative (invalid) indices remain negative
+                return _mm_set_epi32 (first+1 < 0 ? -1 : 0, first+1, first < 0 ? -1 : 0, first);
+            }
+            static __m128i Index (__m128i index, int n) { return _mm_add_epi64 (index, _mm_set_epi32 (0, n, 0, n)); }
+            static void Store (vector v, __m128i index, double* values, std::ptrdiff_t* indices) {
+                long long tmp [LANES];
+                _mm_storeu_pd (values, v);
+                _mm_storeu_si128 (reinterpret_cast <__m128i*> (tmp), index);
+                std::copy (tmp, tmp + LANES, indices);
+            }
+            static void Store (vector v, double* values) { _mm_storeu_pd (values, v); }
+        };
+
+        /*!
+            \brief Segment (s1, s2) broadcasted over all lanes.
+
+            Computes the squared distance of Sse::LANES test points at once, using the exact same
+            operations as segment_distance2 with fractions of type F.
+        */
+        template <unsigned DIM, class Sse, typename F>
+        struct SegmentSse
+        {
+            typedef typename Sse::value_type T;
+            typedef typename Sse::vector vector;
+
+            SegmentSse (const T* p1, const T* p2) {
+                T vs [DIM];
+                make_vector <DIM> (p1, p2, vs);
+                cvScalar = dot <DIM> (vs, vs);
+                cv = Sse::Set (cvScalar);
+                for (unsigned d = 0; d < DIM; ++d) {
+                    s1 [d] = Sse::Set (p1 [d]);
+                    s2 [d] = Sse::Set (p2 [d]);
+                    v [d] = Sse::Set (vs [d]);
+                }
+            }
+
+            //! \brief squared distances of the next LANES points
+            vector Distance2 (const T* points) const {
+                vector p [DIM];
+                vector w [DIM];                 // vector s1 --> p
+                for (unsigned d = 0; d < DIM; ++d) {
+                    p [d] = Sse::template Load <DIM> (points, d);
+                    w [d] = Sse::Sub (p [d], s1 [d]);
+                }
+                vector cw = Sse::Mul (w [0], v [0]);
+                vector left = Sse::Mul (w [0], w [0]);
+                vector right = Sse::Sub (p [0], s2 [0]);
+                right = Sse::Mul (right, right);
+                for (unsigned d = 1; d < DIM; ++d) {
+                    cw = Sse::Add (cw, Sse::Mul (w [d], v [d]));
+                    left = Sse::Add (left, Sse::Mul (w [d], w [d]));
+                    vector r = Sse::Sub (p [d], s2 [d]);
+                    right = Sse::Add (right, Sse::Mul (r, r));
+                }
+
+                // p projected onto segment (s1, s2)
+                vector fraction = Sse::Fraction (cw, cvScalar, F ());
+                vector proj = Sse::Sub (p [0], Sse::Add (s1 [0], Sse::Mul (fraction, v [0])));
+                vector inner = Sse::Mul (proj, proj);
+                for (unsigned d = 1; d < DIM; ++d) {
+                    proj = Sse::Sub (p [d], Sse::Add (s1 [d], Sse::Mul (fraction, v [d])));
+                    inner = Sse::Add (inner, Sse::Mul (proj, proj));
+                }
+
+                vector zero = Sse::Set (0);
+                return Sse::Select (Sse::LessEqual (cw, zero), left,
+                       Sse::Select (Sse::LessEqual (cv, cw), right, inner));
+            }
+
+            vector s1 [DIM];
+            vector s2 [DIM];
+            vector v [DIM];         // vector s1 --> s2
+            vector cv;              // squared length of v
+            T cvScalar;
+        };
+
+        /*!
+            \brief Vectorized implementation of FarthestPoint.
+
+            Computes the squared distance of 2 * Sse::LANES test points per iteration, using the
+            exact same operations as segment_distance2. Each lane keeps track of its own
+            maximum; a horizontal maximum with index over all lanes produces the result.
+        */
+        template <unsigned DIM, class Sse, typename F>
+        struct FarthestPointSse
+        {
+            typedef typename Sse::value_type T;
+            typedef typename Sse::vector vector;
+
+            static void Find (
+                const T* s1,
+                const T* s2,
+                const T* points,
+                std::ptrdiff_t count,
+                std::ptrdiff_t& key,
+                T& dist2)
+            {
+                // limit the range of the point indices to 32 bits
+                const std::ptrdiff_t BLOCK_SIZE = 1 << 30;
+                for (std::ptrdiff_t block = 0; block < count; block += BLOCK_SIZE) {
+                    FindBlock (s1, s2, points + block * DIM, std::min (BLOCK_SIZE, count - block),
+                               block, key, dist2);
+                }
+            }
+
+        private:
+            typedef SegmentSse <DIM, Sse, F> Segment;
+
+            static void FindBlock (
+                const T* s1,
+                const T* s2,
+                const T* points,
+                std::ptrdiff_t count,
+                std::ptrdiff_t offset,
+                std::ptrdiff_t& key,
+                T& dist2)
+            {
+                const int LANES = Sse::LANES;
+
+                Segment segment (s1, s2);
+
+                // two independent sets of lanes
+                vector max1 = Sse::Set (dist2);
+                vector max2 = max1;
+                __m128i key1 = Sse::Index (-LANES);     // invalid (negative) indices
+                __m128i key2 = key1;
+                __m128i index1 = Sse::Index (0);
+                __m128i index2 = Sse::Index (LANES);
+
+                std::ptrdiff_t p = 0;
+                for (; p + 2*LANES <= count; p += 2*LANES) {
+                    Step (segment, points + p * DIM, index1, max1, key1);
+                    Step (segment, points + (p + LANES) * DIM, index2, max2, key2);
+                    index1 = Sse::Index (index1, 2*LANES);
+                    index2 = Sse::Index (index2, 2*LANES);
+                }
+                if (p + LANES <= count) {
+                    Step (segment, points + p * DIM, index1, max1, key1);
+                    p += LANES;
+                }
+                PSIMPL_COUNT(segmentDistances, p);
+
+                // horizontal maximum with index
+                T maxima [2*LANES];
+                std::ptrdiff_t keys [2*LANES];
+                Sse::Store (max1, key1, maxima, keys);
+                Sse::Store (max2, key2, maxima + LANES, keys + LANES);
+                std::ptrdiff_t blockKey = -1;
+                for (int l = 0; l < 2*LANES; ++l) {
+                    if (keys [l] < 0 || maxima [l] < dist2) {
+                        continue;
+                    }
+                    if (blockKey < 0 || dist2 < maxima [l] || blockKey < keys [l]) {
+                        blockKey = keys [l];
+                        dist2 = maxima [l];
+                    }
+                }
+                if (0 <= blockKey) {
+                    key = offset + blockKey;
+                }
+
+                // remaining points
+                for (points += p * DIM; p < count; ++p, points += DIM) {
+                    T d2 = segment_distance2 <DIM, fixed_precision <F> > (s1, s2, points);
+                    if (d2 < dist2) {
+                        continue;
+                    }
+                    key = offset + p;
+                    dist2 = d2;
+                }
+            }
+
+            //! \brief Computes the distances of the next LANES points, and updates the maxima.
+            static void Step (
+                const Segment& segment,
+                const T* points,
+                __m128i index,
+                vector& max,
+                __m128i& key)
+            {
+                vector d2 = segment.Distance2 (points);
+                vector update = Sse::NotLess (d2, max);
+                max = Sse::Select (update, d2, max);
+                key = Sse::Select (update, index, key);
+            }
+        };
+
+        template <> struct FarthestPoint <2, float, float> : FarthestPointSse <2, SseFloat, float> {};
+        template <> struct FarthestPoint <3, float, float> : FarthestPointSse <3, SseFloat, float> {};
+        template <> struct FarthestPoint <2, double, float> : FarthestPointSse <2, SseDouble, float> {};
+        template <> struct FarthestPoint <3, double, float> : FarthestPointSse <3, SseDouble, float> {};
+        template <> struct FarthestPoint <2, double, double> : FarthestPointSse <2, SseDouble, double> {};
+        template <> struct FarthestPoint <3, double, double> : FarthestPointSse <3, SseDouble, double> {};
+
+        //! \brief Vectorized implementation of SegmentDistances.
+        template <unsigned DIM, class Sse, typename F>
+        struct SegmentDistancesSse
+        {
+            typedef typename Sse::value_type T;
+
+            static void Compute (
+                const T* s1,
+                const T* s2,
+                const T* points,
+                std::ptrdiff_t count,
+                T* dist2)
+            {
+                SegmentSse <DIM, Sse, F> segment (s1, s2);
+                std::ptrdiff_t p = 0;
+                for (; p + Sse::LANES <= count; p += Sse::LANES) {
+                    Sse::Store (segment.Distance2 (points + p * DIM), dist2 + p);
+                }
+                PSIMPL_COUNT(segmentDistances, p);
+                for (; p < count; ++p) {
+                    dist2 [p] = segment_distance2 <DIM, fixed_precision <F> > (s1, s2, points + p * DIM);
+                }
+            }
+        };
+
+        template <> struct SegmentDistances <2, float, float> : SegmentDistancesSse <2, SseFloat, float> {};
+        template <> struct SegmentDistances <3, float, float> : SegmentDistancesSse <3, SseFloat, float> {};
+        template <> struct SegmentDistances <2, double, float> : SegmentDistancesSse <2, SseDouble, float> {};
+        template <> struct SegmentDistances <3, double, float> : SegmentDistancesSse <3, SseDouble, float> {};
+        template <> struct SegmentDistances <2, double, double> : SegmentDistancesSse <2, SseDouble, double> {};
+        template <> struct SegmentDistances <3, double, double> : SegmentDistancesSse <3, SseDouble, double> {};
+#endif // PSIMPL_SSE2
+
+        /*!
+            \brief Computes various statistics for the range [first, last)
+
+            The range is traversed once and is not modified. All values are converted to double.
+
+            \sa StatisticsAccumulator
+
+            \param[in] first   the first value
+            \param[in] last    one beyond the last value
+            \return            the calculated statistics
+        */
+        template <class InputIterator>
+        inline Statistics compute_statistics (
+            InputIterator first,
+            InputIterator last)
+        {
+            StatisticsAccumulator stats;
+            for (; first != last; ++first) {
+                stats.Add (static_cast <double> (*first));
+            }
+            return stats.Result ();
+        }
+    }
+
+    /*!
+        \brief Indicates for each point of a polyline if it is a key, using a single bit per point.
+
+        DouglasPeucker and DouglasPeuckerN store their keys in a key set, which uses 8 times
+        less memory than a byte per point. Only the multi-threaded DouglasPeuckerParallel, whose
+        threads mark keys concurrently, uses a byte per point. The keys are copied to the output
+        a word of 64 points at a time, skipping words without keys, and visiting only the set
+        bits of the other words. DouglasPeuckerKeys and DouglasPeuckerNKeys output the key set
+        itself, f.e. to select the attributes of the keys, or to combine the keys of several
+        simplifications.
+
+        The storage of a key set only grows, so that it can be reused without heap allocations.
+    */
+    class KeySet
+    {
+        template <unsigned, class, class, class> friend class PolylineSimplification;
+        typedef unsigned long long word_type;
+
+    public:
+        //! \brief Number of points per word.
+        static const unsigned WORD_BITS = 64;
+
+        KeySet () :
+            size (0)
+        {}
+
+        //! \brief Creates a key set of count points, without any keys.
+        explicit KeySet (std::size_t count) :
+            size (0)
+        {
+            Reset (count);
+        }
+
+        //! \brief Resizes the key set to count points, and removes all keys.
+        void Reset (std::size_t count) {
+            std::size_t wordCount = (count + WORD_BITS - 1) / WORD_BITS;
+            if (words.size () < wordCount) {
+                words.resize (wordCount);
+            }
+            std::fill_n (words.begin (), wordCount, 0);
+            size = count;
+        }
+
+        //! \brief Marks point index as a key.
+        void Set (std::size_t index) {
+            words [index / WORD_BITS] |= word_type (1) << (index % WORD_BITS);
+        }
+
+        //! \brief Indicates if point index is a key.
+        bool Test (std::size_t index) const {
+            return (words [index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+        }
+
+        //! \brief Returns the number of points.
+        std::size_t Size () const {
+            return size;
+        }
+
+        //! \brief Returns the number of keys.
+        std::size_t Count () const {
+            std::size_t count = 0;
+            for (std::size_t w = 0; w < WordCount (); ++w) {
+                count += util::bit_count (words [w]);
+            }
+            return count;
+        }
+
+        /*!
+            \brief Calls function with the point index of each key, in increasing order.
+        */
+        template <class Function>
+        void ForEach (Function function) const {
+            for (std::size_t w = 0; w < WordCount (); ++w) {
+                for (word_type word = words [w]; word; word &= word - 1) {
+                    function (w * WORD_BITS + util::trailing_zeros (word));
+                }
+            }
+        }
+
+        /*!
+            \brief Copies the point index of each key to the output range [result, result + m),
+            in increasing order, where m is the number of keys.
+
+            \param[in] result   destination of the indices
+            \return             one beyond the last index
+        */
+        template <class IndexIterator>
+        IndexIterator Indices (IndexIterator result) const {
+            ForEach ([&] (std::size_t index) {
+                *result = index;
+                ++result;
+            });
+            return result;
+        }
+
+    private:
+        //! \brief Returns the number of words in use.
+        std::size_t WordCount () const {
+            return (size + WORD_BITS - 1) / WORD_BITS;
+        }
+
+        //! \brief Marks all points as key.
+        void SetAll () {
+            std::fill_n (words.begin (), WordCount (), ~word_type (0));
+            if (size % WORD_BITS) {
+                words [WordCount () - 1] = (word_type (1) << (size % WORD_BITS)) - 1;
+            }
+        }
+
+    private:
+        std::vector <word_type> words;      //! a bit per point, the lowest bit is the first point
+        std::size_t size;                   //! number of points
+    };
+
+    /*!
+        \brief Reusable scratch memory for the simplification and error routines.
+
+        DouglasPeucker, DouglasPeuckerN, the repeated PerpendicularDistance and
+        ComputePositionalErrors2Parallel need temporary buffers, as do the single pass routines
+        for input without random access. These are taken from a workspace, whose buffers only
+        grow. Once they fit the largest polyline, the single threaded routines perform no heap
+        allocations. The multi-threaded routines still allocate their threads and job queues,
+        and DouglasPeuckerHull its path hulls, on every call. A workspace also holds the
+        selection of the two-phase SelectDouglasPeucker and SelectDouglasPeuckerN routines.
+
+        Each PolylineSimplification instance owns a workspace. A workspace can also be supplied
+        by the caller, f.e. one per thread, and be shared by PolylineSimplification instances
+        for different iterator types. A workspace must not be used by multiple threads at once.
+    */
+    template <class T>
+    class Workspace
+    {
+        template <unsigned, class, class, class> friend class PolylineSimplification;
+        typedef std::ptrdiff_t ptr_diff_type;
+
+    public:
+        Workspace () :
+            selectionSize (0)
+        {}
+
+        //! \brief Defines a sub polyline.
+        struct SubPoly {
+            SubPoly (ptr_diff_type first=0, ptr_diff_type last=0) :
+                first (first), last (last) {}
+
+            ptr_diff_type first;    //! coord index of the first point
+            ptr_diff_type last;     //! coord index of the last point
+        };
+
+        //! \brief Defines the key of a polyline.
+        struct KeyInfo {
+            KeyInfo (ptr_diff_type index=0, T dist2=0) :
+                index (index), dist2 (dist2) {}
+
+            ptr_diff_type index;    //! coord index of the key
+            T dist2;                //! squared distance of the key to a segment
+        };
+
+        //! \brief Defines a sub polyline including its key.
+        struct SubPolyAlt {
+            SubPolyAlt (ptr_diff_type first=0, ptr_diff_type last=0) :
+                first (first), last (last) {}
+
+            ptr_diff_type first;    //! coord index of the first point
+            ptr_diff_type last;     //! coord index of the last point
+            KeyInfo keyInfo;        //! key of this sub poly
+        };
+
+        //! \brief Defines the effective area of a point.
+        struct AreaInfo {
+            AreaInfo (ptr_diff_type index=0, double area2=0) :
+                index (index), area2 (area2) {}
+
+            ptr_diff_type index;    //! point index
+            double area2;           //! squared effective area of the point
+        };
+
+    private:
+        std::vector <T> coords;                 //! (reduced) copy of the input polyline, or its keys
+        std::vector <T> temp;                   //! intermediate results
+        std::vector <unsigned char> keys;       //! indicates for each point if it is a key
+        KeySet keySet;                          //! a bit per point, indicates if it is a key (douglas-peucker)
+        std::vector <ptr_diff_type> indices;    //! original point index of each reduced point
+        std::vector <SubPoly> stack;            //! lifo job-queue of douglas-peucker
+        std::vector <SubPolyAlt> heap;          //! sorted job-queue of douglas-peucker n
+        std::vector <ptr_diff_type> links;      //! previous and next point of each point (visvalingam-whyatt)
+        std::vector <AreaInfo> queue;           //! min-heap of removable points (visvalingam-whyatt)
+        std::vector <ptr_diff_type> positions;  //! heap position of each point (visvalingam-whyatt)
+        std::vector <T> bounds;                 //! bounding boxes of the segment tree (nearest errors)
+        std::vector <ptr_diff_type> nodes;      //! traversal stack of the segment tree (nearest errors)
+        std::vector <ptr_diff_type> selection;  //! point indices of the last two-phase simplification
+        std::size_t selectionSize;              //! coordinate count of the last two-phase simplification
+    };
+
+    /*!
+        \brief Bounding boxes of consecutive polyline points, that speed up the DP key search.
+
+        The points are grouped into leaves of LEAF_SIZE consecutive points, and pairs of
+        consecutive nodes are merged into a parent node, up to a single root. Each node stores
+        the bounding box of its points. Building the hierarchy is O(n). The key search of DP and
+        DPn skips all points of a node, when no point in its bounding box can be further away
+        from the segment than the key found so far. The keys found are identical to those found
+        without hierarchy.
+
+        The hierarchy does not copy any coordinates. It refers to the contiguous polyline it was
+        built for, which must not be modified or destroyed while the hierarchy is used. As the
+        hierarchy only depends on the polyline, it can be reused by any number of DP and DPn
+        calls on that polyline, f.e. for different tolerances. The hierarchy is only used for
+        floating point coordinates. Its bounds include the rounding errors of the distance
+        computations, which limits the number of skipped points for float coordinates far
+        from the origin.
+    */
+    template <unsigned DIM, class T>
+    class BoundingBoxHierarchy
+    {
+        template <unsigned, class, class, class> friend class PolylineSimplification;
+        typedef std::ptrdiff_t ptr_diff_type;
+
+    public:
+        BoundingBoxHierarchy () :
+            coords (0),
+            pointCount (0)
+        {}
+
+        //! \brief Builds the hierarchy for the contiguous polyline [first, last), see Build.
+        BoundingBoxHierarchy (const T* first, const T* last) :
+            coords (0),
+            pointCount (0)
+        {
+            Build (first, last);
+        }
+
+        /*!
+            \brief Builds the hierarchy for the contiguous polyline [first, last).
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The range [first, last) contains vertex coordinates in multiples of DIM
+            3- The range [first, last) contains at least 2 vertices
+
+            In case these requirements are not met, the hierarchy is left empty.
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \return             true if the hierarchy was built
+        */
+        bool Build (
+            const T* first,
+            const T* last)
+        {
+            Clear ();
+            ptr_diff_type coordCount = last - first;
+            if (!DIM || coordCount % DIM || coordCount / DIM < 2) {
+                return false;
+            }
+            coords = first;
+            pointCount = coordCount / DIM;
+
+            // the bounding box of each leaf
+            ptr_diff_type count = (pointCount + LEAF_SIZE - 1) / LEAF_SIZE;
+            offsets.push_back (0);
+            boxes.resize (count * 2 * DIM);
+            for (ptr_diff_type n = 0; n < count; ++n) {
+                T* box = &boxes [n * 2 * DIM];
+                const T* point = coords + n * LEAF_SIZE * DIM;
+                const T* end = coords + std::min (pointCount, (n + 1) * LEAF_SIZE) * DIM;
+                std::copy (point, point + DIM, box);
+                std::copy (point, point + DIM, box + DIM);
+                for (point += DIM; point != end; point += DIM) {
+                    Merge (point, point, box);
+                }
+            }
+            // merge pairs of nodes, until a single root remains
+            while (1 < count) {
+                ptr_diff_type children = offsets.back ();
+                ptr_diff_type parents = offsets.back () + count;
+                offsets.push_back (parents);
+                boxes.resize ((parents + (count + 1) / 2) * 2 * DIM);
+                for (ptr_diff_type n = 0; n < count; n += 2) {
+                    const T* child = &boxes [(children + n) * 2 * DIM];
+                    T* box = &boxes [(parents + n / 2) * 2 * DIM];
+                    std::copy (child, child + 2 * DIM, box);
+                    if (n + 1 < count) {
+                        Merge (child + 2 * DIM, child + 3 * DIM, box);
+                    }
+                }
+                count = (count + 1) / 2;
+            }
+            return true;
+        }
+
+        //! \brief Removes all nodes from the hierarchy.
+        void Clear () {
+            coords = 0;
+            pointCount = 0;
+            boxes.clear ();
+            offsets.clear ();
+        }
+
+        //! \brief Returns the number of points of the polyline the hierarchy was built for.
+        std::size_t PointCount () const {
+            return static_cast <std::size_t> (pointCount);
+        }
+
+    private:
+        //! \brief Number of points of each leaf.
+        static const ptr_diff_type LEAF_SIZE = 64;
+
+        //! \brief Determines if the hierarchy was built for the polyline of count points at first.
+        bool Covers (const T* first, ptr_diff_type count) const {
+            return coords && coords == first && pointCount == count;
+        }
+
+        //! \brief Returns the number of levels; the leaves are level 0, the root is the last level.
+        unsigned LevelCount () const {
+            return static_cast <unsigned> (offsets.size ());
+        }
+
+        //! \brief Returns the number of nodes of the given level.
+        ptr_diff_type NodeCount (unsigned level) const {
+            ptr_diff_type end = level + 1 < LevelCount ()
+                                ? offsets [level + 1]
+                                : offsets [level] + 1;
+            return end - offsets [level];
+        }
+
+        //! \brief Returns the lower corner of a node, followed by its upper corner.
+        const T* Box (unsigned level, ptr_diff_type node) const {
+            return &boxes [(offsets [level] + node) * 2 * DIM];
+        }
+
+        //! \brief Extends box with the box [lower, upper].
+        static void Merge (const T* lower, const T* upper, T* box) {
+            for (unsigned d = 0; d < DIM; ++d) {
+                box [d] = std::min (box [d], lower [d]);
+                box [DIM + d] = std::max (box [DIM + d], upper [d]);
+            }
+        }
+
+    private:
+        const T* coords;                        //! the polyline the hierarchy was built for
+        ptr_diff_type pointCount;               //! number of points of the polyline
+        std::vector <T> boxes;                  //! lower and upper corner of each node, leaves first
+        std::vector <ptr_diff_type> offsets;    //! index of the first node of each level
+    };
+
+    /*!
+        \brief Cancels long running simplifications, and reports their progress.
+
+        DouglasPeucker, DouglasPeuckerN and Lang accept a control, which is checked once every
+        interval steps: stack pops for DP, queue pops for DPn and search regions for Lang. A
+        routine stops at the first check after Cancel was called, or after the deadline has
+        passed. Its output is then the partial result so far, whose quality differs per routine:
+        - DP keeps the keys that were found. DP refines its sub polylines depth-first, from the
+          first point towards the last point. The partial result is therefore not the best for
+          its number of keys: the first part of the polyline is fully refined, while the last
+          part is simplified too much. Use DPn when the partial result should be refined evenly.
+        - DPn keeps the keys that were found, which is the result of DPn for that many points.
+        - Lang ends the simplified polyline with the last polyline point.
+
+        Cancel and Progress may be called from any thread, the other members only while no
+        routine is using the control. A cancelled control remains cancelled until Reset is
+        called; the deadline applies to all routines until Reset is called.
+    */
+    class SimplificationControl
+    {
+        template <unsigned, class, class, class> friend class PolylineSimplification;
+
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        //! \brief Checks for cancellation and the deadline once every interval steps.
+        explicit SimplificationControl (unsigned interval = 16) :
+            cancelled (false),
+            progress (0),
+            interrupted (false),
+            hasDeadline (false),
+            interval (std::max (1u, interval)),
+            countdown (this->interval)
+        {}
+
+        //! \brief Requests the routine that uses this control to stop.
+        void Cancel () {
+            cancelled.store (true);
+        }
+
+        //! \brief Stops any routine that is still running at the given time.
+        void SetDeadline (Clock::time_point time) {
+            deadline = time;
+            hasDeadline = true;
+        }
+
+        //! \brief Clears the cancellation request and the deadline.
+        void Reset () {
+            cancelled.store (false);
+            hasDeadline = false;
+        }
+
+        //! \brief Returns the fraction [0, 1] of the work that was done, at the last check.
+        double Progress () const {
+            return progress.load (std::memory_order_relaxed);
+        }
+
+        //! \brief Indicates if the last routine was stopped before it finished.
+        bool Interrupted () const {
+            return interrupted;
+        }
+
+    private:
+        SimplificationControl (const SimplificationControl&);
+        SimplificationControl& operator = (const SimplificationControl&);
+
+        //! \brief Prepares the control for the next routine.
+        void Start () {
+            progress.store (0, std::memory_order_relaxed);
+            interrupted = false;
+            countdown = interval;
+        }
+
+        /*!
+            \brief Counts a step, and checks once every interval steps if the routine must stop.
+
+            \param[in] done     the fraction of the work that was done
+            \return             true when the routine must stop
+        */
+        bool Stop (double done) {
+            if (--countdown) {
+                return false;
+            }
+            countdown = interval;
+            progress.store (done, std::memory_order_relaxed);
+            interrupted = cancelled.load () || (hasDeadline && deadline <= Clock::now ());
+            return interrupted;
+        }
+
+        //! \brief Completes the progress of a routine that finished.
+        void Finish () {
+            if (!interrupted) {
+                progress.store (1, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        std::atomic <bool> cancelled;           //! indicates if Cancel was called
+        std::atomic <double> progress;          //! fraction of the work done at the last check
+        bool interrupted;                       //! indicates if the last routine was stopped
+        bool hasDeadline;                       //! indicates if a deadline was set
+        Clock::time_point deadline;             //! time at which routines are stopped
+        unsigned interval;                      //! number of steps between checks
+        unsigned countdown;                     //! number of steps until the next check
+    };
+
+    /*!
+        \brief Provides various simplification algorithms for n-dimensional simple polylines.
+
+        A polyline is simple when it is non-closed and non-selfintersecting. All algorithms
+        operate on input iterators and output iterators. Note that unisgned integer types are
+        NOT supported.
+
+        Temporary buffers are taken from a Workspace, which is kept between calls. Reusing a
+        single instance or workspace, f.e. one per thread, avoids repeated heap allocations. An
+        instance must not be used by multiple threads at once.
+
+        Input without random access, f.e. a std::list, is only traversed once by NthPoint,
+        RadialDistance, PerpendicularDistance, ReumannWitkam and Opheim. The input is validated
+        while it is simplified, so the keys are buffered in the workspace until the end of the
+        input is reached.
+
+        The Precision policy selects the type in which the line, segment and ray distances
+        compute their projection fractions: math::float_precision (the default, fastest),
+        math::value_precision, math::double_precision or math::long_double_precision. Far from
+        the origin, f.e. for UTM coordinates, float fractions can change which points are kept.
+    */
+    template <unsigned DIM, class InputIterator, class OutputIterator,
+              class Precision = math::float_precision>
+    class PolylineSimplification
+    {
+        template <unsigned, class> friend class DouglasPeuckerHierarchy;
+
+        typedef typename std::iterator_traits <InputIterator>::difference_type diff_type;
+        typedef typename std::iterator_traits <InputIterator>::value_type value_type;
+        typedef typename std::iterator_traits <const value_type*>::difference_type ptr_diff_type;
+        typedef typename Precision::template fraction <value_type>::type fraction_type;
+        //! \brief Precision of key distances and errors, which must not be rounded down.
+        typedef math::round_up_precision <Precision> KeyPrecision;
+        typedef typename KeyPrecision::template fraction <value_type>::type key_fraction_type;
+
+        //! \brief Indicates if the number of coordinates can be determined in constant time.
+        static const bool RANDOM_ACCESS = std::is_base_of <std::random_access_iterator_tag,
+            typename std::iterator_traits <InputIterator>::iterator_category>::value;
+
+    public:
+        //! \brief Uses its own workspace for all temporary buffers.
+        PolylineSimplification () :
+            external (0),
+            control (0)
+        {}
+
+        //! \brief Uses the given workspace for all temporary buffers.
+        explicit PolylineSimplification (Workspace <value_type>& workspace) :
+            external (&workspace),
+            control (0)
+        {}
+
+        /*!
+            \brief Performs the nth point routine (NP).
+
+            NP is an O(n) algorithm for polyline simplification. It keeps only the first, last and
+            each nth point. As an example, consider any random line of 8 points. Using n = 3 will
+            always yield a simplification consisting of points: 1, 4, 7, 8
+
+            \image html psimpl_np.png
+
+            NP is applied to the range [first, last). The resulting simplified polyline is copied
+            to the output range [result, result + m*DIM), where m is the number of vertices of the
+            simplified polyline. The return value is the end of the output range: result + m*DIM.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The input iterator value type is convertible to a value type of the OutputIterator
+            4- The range [first, last) contains only vertex coordinates in multiples of DIM, f.e.:
+               x, y, z, x, y, z, x, y, z when DIM = 3
+            5- The range [first, last) contains at least 2 vertices
+            6- n is not 0
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] n        specifies 'each nth point'
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator NthPoint (
+            InputIterator first,
+            InputIterator last,
+            unsigned n,
+            OutputIterator result)
+        {
+            if (!RANDOM_ACCESS) {
+                return NthPointSinglePass (first, last, n, result);
+            }
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM              // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || n < 2) {
+                return std::copy (first, last, result);
+            }
+
+            unsigned remaining = pointCount - 1;    // the number of points remaining after key
+            InputIterator key = first;              // indicates the current key
+
+            // the first point is always part of the simplification
+            CopyKey (key, result);
+
+            // copy each nth point
+            while (Forward (key, n, remaining)) {
+                CopyKey (key, result);
+            }
+
+            return result;
+        }
+
+        /*!
+            \brief Performs the (radial) distance between points routine (RD).
+
+            RD is a brute-force O(n) algorithm for polyline simplification. It reduces successive
+            vertices that are clustered too closely to a single vertex, called a key. The resulting
+            keys form the simplified polyline.
+
+            \image html psimpl_rd.png
+
+            RD is applied to the range [first, last) using the specified tolerance tol. The
+            resulting simplified polyline is copied to the output range [result, result + m*DIM),
+            where m is the number of vertices of the simplified polyline. The return value is the
+            end of the output range: result + m*DIM.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The input iterator value type is convertible to a value type of the output iterator
+            4- The range [first, last) contains only vertex coordinates in multiples of DIM, f.e.:
+               x, y, z, x, y, z, x, y, z when DIM = 3
+            5- The range [first, last) contains at least 2 vertices
+            6- tol is not 0
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] tol      radial (point-to-point) distance tolerance
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator RadialDistance (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            OutputIterator result)
+        {
+            if (!RANDOM_ACCESS) {
+                return RadialDistanceSinglePass (first, last, tol, result);
+            }
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            value_type tol2 = tol * tol;    // squared distance tolerance
+
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || tol2 == 0) {
+                return std::copy (first, last, result);
+            }
+
+            InputIterator current = first;  // indicates the current key
+            InputIterator next = first;     // used to find the next key
+
+            // the first point is always part of the simplification
+            CopyKeyAdvance (next, result);
+
+            // Skip first and last point, because they are always part of the simplification
+            for (diff_type index = 1; index < pointCount - 1; ++index) {
+                if (math::point_distance2 <DIM> (current, next) < tol2) {
+                    Advance (next);
+                    continue;
+                }
+                current = next;
+                CopyKeyAdvance (next, result);
+            }
+            // the last point is always part of the simplification
+            CopyKeyAdvance (next, result);
+
+            return result;
+        }
+
+        /*!
+            \brief Repeatedly performs the perpendicular distance routine (PD).
+
+            The algorithm stops after calling the PD routine 'repeat' times OR when the
+            simplification does not improve. Note that this algorithm will need to store
+            one intermediate simplification result. The first pass copies the keys of the
+            input to a temporary array; each intermediate pass then compacts that array in
+            place, and the final pass copies its keys to the output.
+
+            \sa PerpendicularDistance(InputIterator, InputIterator, value_type, OutputIterator)
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] tol      perpendicular (segment-to-point) distance tolerance
+            \param[in] repeat   the number of times to successively apply the PD routine
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator PerpendicularDistance (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            unsigned repeat,
+            OutputIterator result)
+        {
+            if (repeat == 1) {
+                // single pass
+                return PerpendicularDistance (first, last, tol, result);
+            }
+            // only validate repeat; other input is validated by simplify_perpendicular_distance
+            if (repeat < 1) {
+                return std::copy (first, last, result);
+            }
+            diff_type coordCount = std::distance (first, last);
+
+            // first pass: [first, last) --> temporary array 'tempPoly'
+            value_type* tempPoly = Reserve (Scratch ().coords, coordCount);
+            PolylineSimplification <DIM, InputIterator, value_type*, Precision> psimpl_to_array;
+            diff_type tempCoordCount = std::distance (tempPoly,
+                psimpl_to_array.PerpendicularDistance (first, last, tol, tempPoly));
+
+            // check if simplification did not improved
+            if (coordCount == tempCoordCount) {
+                return std::copy (tempPoly, tempPoly + coordCount, result);
+            }
+            std::swap (coordCount, tempCoordCount);
+            --repeat;
+
+            // intermediate passes: temporary array 'tempPoly' --> itself
+            PolylineSimplification <DIM, value_type*, value_type*, Precision> psimpl_arrays;
+            while (1 < repeat--) {
+                tempCoordCount = std::distance (tempPoly,
+                    psimpl_arrays.PerpendicularDistance (
+                        tempPoly, tempPoly + coordCount, tol, tempPoly));
+
+                // check if simplification did not improved
+                if (coordCount == tempCoordCount) {
+                    return std::copy (tempPoly, tempPoly + coordCount, result);
+                }
+                std::swap (coordCount, tempCoordCount);
+            }
+
+            // final pass: temporary array 'tempPoly' --> result
+            PolylineSimplification <DIM, value_type*, OutputIterator, Precision> psimpl_from_array;
+            return psimpl_from_array.PerpendicularDistance (
+                tempPoly, tempPoly + coordCount, tol, result);
+        }
+
+        /*!
+            \brief Performs the perpendicular distance routine (PD).
+
+            PD is an O(n) algorithm for polyline simplification. It computes the perpendicular
+            distance of each point pi to the line segment S(pi-1, pi+1). Only when this distance is
+            larger than the given tolerance will pi be part of the simpification. Note that the
+            original polyline can only be reduced by a maximum of 50%. Multiple passes are required
+            to achieve higher points reductions.
+
+            \image html psimpl_pd.png
+
+            PD is applied to the range [first, last) using the specified tolerance tol. The
+            resulting simplified polyline is copied to the output range [result, result + m*DIM),
+            where m is the number of vertices of the simplified polyline. The return value is the
+            end of the output range: result + m*DIM.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The input iterator value type is convertible to a value type of the output iterator
+            4- The range [first, last) contains only vertex coordinates in multiples of DIM, f.e.:
+               x, y, z, x, y, z, x, y, z when DIM = 3
+            5- The range [first, last) contains at least 2 vertices
+            6- tol is not 0
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] tol      perpendicular (segment-to-point) distance tolerance
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator PerpendicularDistance (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            OutputIterator result)
+        {
+            if (!RANDOM_ACCESS) {
+                return PerpendicularDistanceSinglePass (first, last, tol, result);
+            }
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            value_type tol2 = tol * tol;    // squared distance tolerance
+
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || tol2 == 0) {
+                return std::copy (first, last, result);
+            }
+
+            InputIterator p0 = first;
+            InputIterator p1 = AdvanceCopy(p0);
+            InputIterator p2 = AdvanceCopy(p1);
+
+            // the first point is always part of the simplification
+            CopyKey (p0, result);
+
+            while (p2 != last) {
+                // test p1 against line segment S(p0, p2)
+                if (math::segment_distance2 <DIM, Precision> (p0, p2, p1) < tol2) {
+                    CopyKey (p2, result);
+                    // move up by two points
+                    p0 = p2;
+                    Advance (p1, 2);
+                    if (p1 == last) {
+                        // protect against advancing p2 beyond last
+                        break;
+                    }
+                    Advance (p2, 2);
+                }
+                else {
+                    CopyKey (p1, result);
+                    // move up by one point
+                    p0 = p1;
+                    p1 = p2;
+                    Advance (p2);
+                }
+            }
+            // make sure the last point is part of the simplification
+            if (p1 != last) {
+                CopyKey (p1, result);
+            }
+            return result;
+        }
+
+        /*!
+            \brief Performs Reumann-Witkam approximation (RW).
+
+            The O(n) RW routine uses a point-to-line (perpendicular) distance tolerance. It defines
+            a line through the first two vertices of the original polyline. For each successive
+            vertex vi its perpendicular distance to this line is calculated. A new key is found at
+            vi-1, when this distance exceeds the specified tolerance. The vertices vi and vi+1 are
+            then used to define a new line, and the process repeats itself.
+
+            \image html psimpl_rw.png
+
+            RW routine is applied to the range [first, last) using the specified perpendicular
+            distance tolerance tol. The resulting simplified polyline is copied to the output range
+            [result, result + m*DIM), where m is the number of vertices of the simplified polyline.
+            The return value is the end of the output range: result + m*DIM.
+
+            Input (Type) Requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The input iterator value type is convertible to a value type of the output iterator
+            4- The range [first, last) contains vertex coordinates in multiples of DIM,
+               f.e.: x, y, z, x, y, z, x, y, z when DIM = 3
+            5- The range [first, last) contains at least 2 vertices
+            6- tol is not 0
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] tol      perpendicular (point-to-line) distance tolerance
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator ReumannWitkam (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            OutputIterator result)
+        {
+            if (!RANDOM_ACCESS) {
+                return ReumannWitkamSinglePass (first, last, tol, result);
+            }
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            value_type tol2 = tol * tol;    // squared distance tolerance
+
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || tol2 == 0) {
+                return std::copy (first, last, result);
+            }
+
+            // define the line L(p0, p1)
+            InputIterator p0 = first;               // indicates the current key
+            InputIterator p1 = AdvanceCopy (first); // indicates the next point after p0
+
+            // keep track of two test points
+            InputIterator pi = p1;     // the previous test point
+            InputIterator pj = p1;     // the current test point (pi+1)
+
+            // the first point is always part of the simplification
+            CopyKey (p0, result);
+
+            // check each point pj against L(p0, p1)
+            for (diff_type j = 2; j < pointCount; ++j) {
+                pi = pj;
+                Advance (pj);
+
+                if (math::line_distance2 <DIM, Precision> (p0, p1, pj) < tol2) {
+                    continue;
+                }
+                // found the next key at pi
+                CopyKey (pi, result);
+                // define new line L(pi, pj)
+                p0 = pi;
+                p1 = pj;
+            }
+            // the last point is always part of the simplification
+            CopyKey (pj, result);
+
+            return result;
+        }
+
+        /*!
+            \brief Performs Opheim approximation (OP).
+
+            The O(n) OP routine is very similar to the Reumann-Witkam (RW) routine, and can be seen
+            as a constrained version of that RW routine. OP uses both a minimum and a maximum
+            distance tolerance to constrain the search area. For each successive vertex vi, its
+            radial distance to the current key vkey (initially v0) is calculated. The last point
+            within the minimum distance tolerance is used to define a ray R (vkey, vi). If no
+            such vi exists, the ray is defined as R(vkey, vkey+1). For each successive vertex vj
+            beyond vi its perpendicular distance to the ray R is calculated. A new key is found at
+            vj-1, when this distance exceeds the minimum tolerance Or when the radial distance
+            between vj and the vkey exceeds the maximum tolerance. After a new key is found, the
+            process repeats itself.
+
+            \image html psimpl_op.png
+
+            OP routine is applied to the range [first, last) using the specified distance tolerances
+            min_tol and max_tol. The resulting simplified polyline is copied to the output range
+            [result, result + m*DIM), where m is the number of vertices of the simplified polyline.
+            The return value is the end of the output range: result + m*DIM.
+
+            Input (Type) Requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The input iterator value type is convertible to a value type of the output iterator
+            4- The range [first, last) contains vertex coordinates in multiples of DIM,
+               f.e.: x, y, z, x, y, z, x, y, z when DIM = 3
+            5- The range [first, last) contains at least 2 vertices
+            6- min_tol is not 0
+            7- max_tol is not 0
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] min_tol  radial and perpendicular (point-to-ray) distance tolerance
+            \param[in] max_tol  radial distance tolerance
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator Opheim (
+            InputIterator first,
+            InputIterator last,
+            value_type min_tol,
+            value_type max_tol,
+            OutputIterator result)
+        {
+            if (!RANDOM_ACCESS) {
+                return OpheimSinglePass (first, last, min_tol, max_tol, result);
+            }
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM                    // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            value_type min_tol2 = min_tol * min_tol;    // squared minimum distance tolerance
+            value_type max_tol2 = max_tol * max_tol;    // squared maximum distance tolerance
+
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || min_tol2 == 0 || max_tol2 == 0) {
+                return std::copy (first, last, result);
+            }
+
+            // define the ray R(r0, r1)
+            InputIterator r0 = first;  // indicates the current key and start of the ray
+            InputIterator r1 = first;  // indicates a point on the ray
+            bool rayDefined = false;
+
+            // keep track of two test points
+            InputIterator pi = r0;     // the previous test point
+            InputIterator pj =         // the current test point (pi+1)
+                AdvanceCopy (pi);
+
+            // the first point is always part of the simplification
+            CopyKey (r0, result);
+
+            for (diff_type j = 2; j < pointCount; ++j) {
+                pi = pj;
+                Advance (pj);
+
+                if (!rayDefined) {
+                    // discard each point within minimum tolerance
+                    if (math::point_distance2 <DIM> (r0, pj) < min_tol2) {
+                        continue;
+                    }
+                    // the last point within minimum tolerance pi defines the ray R(r0, r1)
+                    r1 = pi;
+                    rayDefined = true;
+                }
+
+                // check each point pj against R(r0, r1)
+                if (math::point_distance2 <DIM> (r0, pj) < max_tol2 &&
+                    math::ray_distance2 <DIM, Precision> (r0, r1, pj) < min_tol2)
+                {
+                    continue;
+                }
+                // found the next key at pi
+                CopyKey (pi, result);
+                // define new ray R(pi, pj)
+                r0 = pi;
+                rayDefined = false;
+            }
+            // the last point is always part of the simplification
+            CopyKey (pj, result);
+
+            return result;
+        }
+
+        /*!
+            \brief Performs Lang approximation (LA).
+
+            The LA routine defines a fixed size search-region. The first and last points of that
+            search region form a segment. This segment is used to calculate the perpendicular
+            distance to each intermediate point. If any calculated distance is larger than the
+            specified tolerance, the search region will be shrunk by excluding its last point. This
+            process will continue untill all calculated distances fall below the specified tolerance
+            , or there are no more intermediate points. At this point all intermediate points are
+            removed and a new search region is defined starting at the last point from old search
+            region.
+            Note that the size of the search region (look_ahead parameter) controls the maximum
+            amount of simplification, e.g.: a size of 20 will always result in a simplification that
+            contains at least 5% of the original points.
+
+            The search region is buffered, so that shrinking it does not require moving an
+            iterator backwards. The point that caused the search region to shrink is tested first
+            against the next, smaller, search region. Usually it is still outside the tolerance,
+            which limits the work per search region to O(look_ahead) instead of
+            O(look_ahead^2). The buffer holds up to 2 * (look_ahead + 1) points and is taken from
+            the workspace.
+
+            \image html psimpl_la.png
+
+            LA routine is applied to the range [first, last) using the specified tolerance and
+            look ahead values. The resulting simplified polyline is copied to the output range
+            [result, result + m*DIM), where m is the number of vertices of the simplified polyline.
+            The return value is the end of the output range: result + m*DIM.
+
+            Input (Type) Requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to a value type of the output iterator
+            4- The range [first, last) contains vertex coordinates in multiples of DIM,
+               f.e.: x, y, z, x, y, z, x, y, z when DIM = 3
+            5- The range [first, last) contains at least 2 vertices
+            6- tol is not 0
+            7- look_ahead is not zero
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \param[in] first      the first coordinate of the first polyline point
+            \param[in] last       one beyond the last coordinate of the last polyline point
+            \param[in] tol        perpendicular (point-to-segment) distance tolerance
+            \param[in] look_ahead defines the size of the search region
+            \param[in] result     destination of the simplified polyline
+            \return               one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator Lang (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            unsigned look_ahead,
+            OutputIterator result)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            value_type tol2 = tol * tol;    // squared minimum distance tolerance
+            
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || look_ahead < 2 || tol2 == 0) {
+                return std::copy (first, last, result);
+            }
+
+            // buffer holding the search region [current, current + look_ahead]
+            ptr_diff_type regionSize = std::min <diff_type> (look_ahead, pointCount - 1) + 1;
+            ptr_diff_type capacity = 2 * regionSize;
+            value_type* region = Reserve (Scratch ().coords, capacity * DIM);
+
+            ptr_diff_type current = 0;              // buffer index of the current key
+            ptr_diff_type count = 0;                // number of buffered points
+            diff_type unread = pointCount;          // number of points not yet buffered
+
+            // the first point is always part of the simplification
+            value_type* point = region;
+            CopyPointAdvance (first, point);
+            ++count;
+            --unread;
+            CopyPoint (region, result);
+
+            for (;;) {
+                if (control && control->Stop (double (pointCount - unread) / pointCount)) {
+                    // end the simplification with the last point
+                    if (unread) {
+                        std::advance (first, (unread - 1) * DIM);
+                        CopyKey (first, result);
+                    }
+                    else if (current + 1 < count) {
+                        CopyPoint (region + (count - 1) * DIM, result);
+                    }
+                    break;
+                }
+                // buffer the search region, moving it to the front when needed
+                if (capacity < current + regionSize) {
+                    std::copy (region + current * DIM, region + count * DIM, region);
+                    count -= current;
+                    current = 0;
+                }
+                while (count < current + regionSize && unread) {
+                    point = region + count * DIM;
+                    CopyPointAdvance (first, point);
+                    ++count;
+                    --unread;
+                }
+                ptr_diff_type next = count - 1;     // the last point of the search region
+                if (next == current) {
+                    break;
+                }
+
+                // shrink the search region until all intermediate points are within tolerance
+                const value_type* points = region;
+                ptr_diff_type outlier = 0;          // the point that shrunk the search region
+                for (; current + 1 < next; --next) {
+                    const value_type* s1 = points + current * DIM;
+                    const value_type* s2 = points + next * DIM;
+                    if (current < outlier && outlier < next &&
+                        tol2 <= math::segment_distance2 <DIM, Precision> (s1, s2, points + outlier * DIM))
+                    {
+                        PSIMPL_COUNT(backwardSteps, 1);
+                        continue;
+                    }
+                    ptr_diff_type p = current + 1;
+                    for (; p < next; ++p) {
+                        if (tol2 <= math::segment_distance2 <DIM, Precision> (s1, s2, points + p * DIM)) {
+                            break;
+                        }
+                    }
+                    if (p == next) {
+                        break;
+                    }
+                    outlier = p;
+                    PSIMPL_COUNT(backwardSteps, 1);
+                }
+                current = next;
+                CopyPoint (region + current * DIM, result);
+            }
+            return result;
+        }
+
+        /*!
+            \brief Performs the Lang simplification routine (LA), which can be stopped early.
+
+            Identical to Lang, except that the control is checked once every interval search
+            regions. When the routine is stopped, the simplified polyline is ended with the last
+            polyline point, see SimplificationControl.
+
+            \sa Lang
+
+            \param[in] first      the first coordinate of the first polyline point
+            \param[in] last       one beyond the last coordinate of the last polyline point
+            \param[in] tol        perpendicular (point-to-segment) distance tolerance
+            \param[in] look_ahead defines the size of the search region
+            \param[in] result     destination of the simplified polyline
+            \param[in] control    cancels the routine and reports its progress
+            \return               one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator Lang (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            unsigned look_ahead,
+            OutputIterator result,
+            SimplificationControl& control)
+        {
+            ControlScope scope (this->control, control);
+            return Lang (first, last, tol, look_ahead, result);
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DP).
+
+            The DP algorithm uses the RadialDistance (RD) routine O(n) as a preprocessing step.
+            After RD the algorithm is O (n m) in worst case and O(n log m) on average, where m < n
+            (m is the number of points after RD).
+
+            The DP algorithm starts with a simplification that is the single edge joining the first
+            and last vertices of the polyline. The distance of the remaining vertices to that edge
+            are computed. The vertex that is furthest away from theedge (called a key), and has a
+            computed distance that is larger than a specified tolerance, will be added to the
+            simplification. This process will recurse for each edge in the current simplification,
+            untill all vertices of the original polyline are within tolerance.
+
+            \image html psimpl_dp.png
+
+            Note that this algorithm will create a copy of the input polyline during the vertex
+            reduction step, unless the input is contiguous (a pointer or std::vector iterator).
+            In that case only the point indices of the reduced polyline are stored.
+
+            RD followed by DP is applied to the range [first, last) using the specified tolerance
+            tol. The resulting simplified polyline is copied to the output range
+            [result, result + m*DIM), where m is the number of vertices of the simplified polyline.
+            The return value is the end of the output range: result + m*DIM.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to a value type of the output iterator
+            4- The range [first, last) contains vertex coordinates in multiples of DIM, f.e.:
+               x, y, z, x, y, z, x, y, z when DIM = 3
+            5- The range [first, last) contains at least 2 vertices
+            6- tol is not 0
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] tol      perpendicular (point-to-segment) distance tolerance
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator DouglasPeucker (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            OutputIterator result)
+        {
+            return DouglasPeuckerParallel (first, last, tol, 1, result);
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DP), which can be stopped early.
+
+            Identical to DouglasPeucker, except that the control is checked once every interval
+            sub polylines. When the approximation is stopped, the keys found so far are copied to
+            the output. As sub polylines are refined depth-first, these keys only simplify the
+            first part of the polyline within tol, see SimplificationControl.
+
+            \sa DouglasPeucker
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] tol      perpendicular (point-to-segment) distance tolerance
+            \param[in] result   destination of the simplified polyline
+            \param[in] control  cancels the approximation and reports its progress
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator DouglasPeucker (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            OutputIterator result,
+            SimplificationControl& control)
+        {
+            ControlScope scope (this->control, control);
+            return DouglasPeucker (first, last, tol, result);
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DP), using a bounding box hierarchy.
+
+            The result is identical to that of DouglasPeucker. The key of each long sub polyline
+            is searched for using the hierarchy, which skips the points that cannot be further
+            away from the segment than the key found so far, see BoundingBoxHierarchy. The
+            hierarchy can be reused for any tolerance.
+
+            The hierarchy is only used when it was built for the input itself, which requires
+            contiguous input (a pointer or std::vector iterator). Otherwise the hierarchy is
+            ignored.
+
+            \sa DouglasPeucker
+
+            \param[in] first        the first coordinate of the first polyline point
+            \param[in] last         one beyond the last coordinate of the last polyline point
+            \param[in] tol          perpendicular (point-to-segment) distance tolerance
+            \param[in] hierarchy    the bounding box hierarchy of the polyline [first, last)
+            \param[in] result       destination of the simplified polyline
+            \return                 one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator DouglasPeucker (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            const BoundingBoxHierarchy <DIM, value_type>& hierarchy,
+            OutputIterator result)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            const value_type* coords = util::contiguous_iterator <InputIterator>::address (first);
+            if (coordCount % DIM || pointCount < 3 || tol == 0 ||
+                !hierarchy.Covers (coords, pointCount))
+            {
+                return DouglasPeucker (first, last, tol, result);
+            }
+            return DouglasPeuckerContiguous (first, coords, pointCount, tol, 1, result, &hierarchy);
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DP) using multiple threads.
+
+            The result is identical to that of DouglasPeucker. The RD preprocessing step and the
+            copying of the keys are performed single threaded, so only the approximation itself
+            scales with threadCount: the end-to-end speedup is bounded by the time these serial
+            steps take, which grows with the number of RD survivors. The first and largest sub
+            polylines are searched for their key by all threads at once. Once enough sub
+            polylines are available, each thread processes its own job queue, stealing jobs from
+            the other threads when it runs out of work. Sub polylines that are too small to be
+            worth scheduling are processed single threaded by the thread that owns them.
+
+            Note that the output is only written after all threads have finished.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to a value type of the output iterator
+            4- The range [first, last) contains vertex coordinates in multiples of DIM, f.e.:
+               x, y, z, x, y, z, x, y, z when DIM = 3
+            5- The range [first, last) contains at least 2 vertices
+            6- tol is not 0
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \sa DouglasPeucker
+
+            \param[in] first        the first coordinate of the first polyline point
+            \param[in] last         one beyond the last coordinate of the last polyline point
+            \param[in] tol          perpendicular (point-to-segment) distance tolerance
+            \param[in] threadCount  number of threads to use; 0 selects the number of hardware threads
+            \param[in] result       destination of the simplified polyline
+            \return                 one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator DouglasPeuckerParallel (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            unsigned threadCount,
+            OutputIterator result)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || tol == 0) {
+                return std::copy (first, last, result);
+            }
+            if (util::contiguous_iterator <InputIterator>::value) {
+                return DouglasPeuckerContiguous (
+                    first, util::contiguous_iterator <InputIterator>::address (first),
+                    pointCount, tol, threadCount, result);
+            }
+            // radial distance routine as preprocessing
+            PSIMPL_TIMER(timer);
+            value_type* reduced = Reserve (Scratch ().coords, coordCount);  // radial distance results
+            PolylineSimplification <DIM, InputIterator, value_type*, Precision> psimpl_to_array;
+            ptr_diff_type reducedCoordCount = std::distance (reduced,
+                psimpl_to_array.RadialDistance (first, last, tol, reduced));
+            ptr_diff_type reducedPointCount = reducedCoordCount / DIM;
+            PSIMPL_LAP(timer, reduceTime);
+
+            // douglas-peucker approximation
+            if (threadCount == 1) {
+                KeySet& keys = Scratch ().keySet;                               // douglas-peucker results
+                keys.Reset (reducedPointCount);
+                DPHelper::Approximate (reduced, reducedCoordCount, tol, typename DPHelper::KeyBits (keys),
+                                       Scratch ().stack, 0, control);
+                PSIMPL_LAP(timer, approximateTime);
+
+                // copy all keys
+                CopyKeys (reduced, keys, result);
+            }
+            else {
+                unsigned char* keys = Reserve (Scratch ().keys, pointCount);  // douglas-peucker results
+                DPHelper::ApproximateParallel (reduced, reducedCoordCount, tol, threadCount, keys,
+                                               Scratch ().stack);
+                PSIMPL_LAP(timer, approximateTime);
+
+                // copy all keys
+                CopyKeys (reduced, keys, reducedPointCount, result);
+            }
+            PSIMPL_LAP(timer, copyTime);
+            return result;
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DP) in chunks of bounded size.
+
+            The polyline is divided into chunks of chunkSize points, where successive chunks
+            share their end point (anchor). Each chunk is simplified independently using
+            DouglasPeucker, and the results are stitched together at the anchors. Because DP
+            always keeps the end points of a polyline, every anchor is part of the
+            simplification, and each point lies within tol of the simplified chunk it belongs
+            to. The result therefore only differs from that of DouglasPeucker near the anchors.
+
+            The input is traversed twice: once to count and validate its coordinates, as invalid
+            input is copied in its entirety, and once to read it one chunk at a time. Up to
+            threadCount chunks are simplified in parallel, each by its own thread and workspace.
+            The RadialDistance (RD) preprocessing step of DouglasPeucker is performed per chunk,
+            and restarts at each anchor. Its scratch memory, like that of the approximation, holds
+            at most chunkSize points. The memory usage is therefore bounded by the number of
+            threads times the chunk size, independent of the length of the polyline.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to a value type of the output iterator
+            4- The range [first, last) contains vertex coordinates in multiples of DIM, f.e.:
+               x, y, z, x, y, z, x, y, z when DIM = 3
+            5- The range [first, last) contains at least 2 vertices
+            6- tol is not 0
+            7- chunkSize is at least 2
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \sa DouglasPeucker
+
+            \param[in] first        the first coordinate of the first polyline point
+            \param[in] last         one beyond the last coordinate of the last polyline point
+            \param[in] tol          perpendicular (point-to-segment) distance tolerance
+            \param[in] chunkSize    number of points per chunk, including both anchors
+            \param[in] threadCount  number of threads to use; 0 selects the number of hardware threads
+            \param[in] result       destination of the simplified polyline
+            \return                 one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator DouglasPeuckerChunked (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            std::size_t chunkSize,
+            unsigned threadCount,
+            OutputIterator result)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || tol == 0 || chunkSize < 2) {
+                return std::copy (first, last, result);
+            }
+            if (threadCount == 0) {
+                threadCount = std::max (1u, std::thread::hardware_concurrency ());
+            }
+            std::vector <Chunk> chunks (threadCount);
+            diff_type unread = pointCount;      // number of points not yet read
+            value_type anchor [DIM];            // the last point of the previous chunk
+            bool anchored = false;              // the next chunk starts at the anchor
+
+            while (unread) {
+                // read the next chunks, each starting at the last point of its predecessor
+                unsigned chunkCount = 0;
+                for (; chunkCount < threadCount && unread; ++chunkCount) {
+                    Chunk& chunk = chunks [chunkCount];
+                    chunk.coords.clear ();
+                    chunk.anchored = anchored;
+                    if (anchored) {
+                        chunk.coords.insert (chunk.coords.end (), anchor, anchor + DIM);
+                    }
+                    diff_type count = std::min <diff_type> (
+                        unread, static_cast <diff_type> (chunkSize - (anchored ? 1 : 0)));
+                    for (diff_type c=0; c<count*DIM; ++c, ++first) {
+                        chunk.coords.push_back (*first);
+                    }
+                    unread -= count;
+                    std::copy (chunk.coords.end () - DIM, chunk.coords.end (), anchor);
+                    anchored = true;
+                }
+
+                // simplify
+                if (chunkCount == 1) {
+                    SimplifyChunk (&chunks [0], tol);
+                }
+                else {
+                    std::vector <std::thread> threads;
+                    for (unsigned t=1; t<chunkCount; ++t) {
+                        threads.push_back (instrument::make_thread (&SimplifyChunk, &chunks [t], tol));
+                    }
+                    SimplifyChunk (&chunks [0], tol);
+                    for (unsigned t=0; t<threads.size (); ++t) {
+                        threads [t].join ();
+                    }
+                }
+
+                // stitch the chunks together, skipping each anchor that is already copied
+                for (unsigned t=0; t<chunkCount; ++t) {
+                    const std::vector <value_type>& simplified = chunks [t].result;
+                    result = std::copy (simplified.begin () + (chunks [t].anchored ? DIM : 0),
+                                        simplified.end (), result);
+                }
+            }
+            return result;
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DP) using path hulls.
+
+            This 2D-only implementation of DP is based on the path hull algorithm of Hershberger
+            and Snoeyink; after the RadialDistance (RD) preprocessing step. The furthest point of
+            a sub polyline is found by searching the convex hulls of both halves of that sub
+            polyline, instead of testing each point. The hulls are built once and are shrunk,
+            instead of rebuilt, when the sub polyline is split at its key; only the shortest part
+            will need new hulls. This is O(n log n) in worst case, but only for simple polylines
+            whose points project onto the segment of their sub polyline.
+
+            Note that convex hulls can only locate the point furthest away from the infinite line
+            through the end points of a sub polyline. This is also the point furthest away from
+            the segment, as long as all points project onto that segment. The hulls are used to
+            check this: when some point projects beyond an end point, all hull points are tested
+            instead. Also note that the hulls are built incrementally, which only works for
+            simple polylines. Each point that is skipped while building a hull is therefore
+            tested against the hull. When it lies outside, the sub polyline is not simple, and it
+            is approximated by DouglasPeucker instead. Self-intersecting input hence approaches
+            the O(n^2) worst case of DouglasPeucker. In all cases the keys equal those of
+            DouglasPeucker, except when multiple points are (nearly) equally far away.
+
+            Input (Type) requirements:
+            1- DIM is 2, for any other dimension DouglasPeucker is performed instead
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to a value type of the output iterator
+            4- The range [first, last) contains vertex coordinates in multiples of DIM, f.e.:
+               x, y, x, y, x, y when DIM = 2
+            5- The range [first, last) contains at least 2 vertices
+            6- tol is not 0
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \sa DouglasPeucker
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] tol      perpendicular (point-to-segment) distance tolerance
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator DouglasPeuckerHull (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            OutputIterator result)
+        {
+            if (DIM != 2) {
+                return DouglasPeucker (first, last, tol, result);
+            }
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = coordCount / DIM;
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || tol == 0) {
+                return std::copy (first, last, result);
+            }
+            // radial distance routine as preprocessing
+            PSIMPL_TIMER(timer);
+            value_type* reduced = Reserve (Scratch ().coords, coordCount);  // radial distance results
+            PolylineSimplification <DIM, InputIterator, value_type*, Precision> psimpl_to_array;
+            ptr_diff_type reducedCoordCount = std::distance (reduced,
+                psimpl_to_array.RadialDistance (first, last, tol, reduced));
+            ptr_diff_type reducedPointCount = reducedCoordCount / DIM;
+            PSIMPL_LAP(timer, reduceTime);
+
+            // douglas-peucker approximation
+            unsigned char* keys = Reserve (Scratch ().keys, pointCount);      // douglas-peucker results
+            DPHelper::ApproximateHull (reduced, reducedCoordCount, tol, keys, Scratch ().stack);
+            PSIMPL_LAP(timer, approximateTime);
+
+            // copy all keys
+            CopyKeys (reduced, keys, reducedPointCount, result);
+            PSIMPL_LAP(timer, copyTime);
+            return result;
+        }
+
+        /*!
+            \brief Performs a Douglas-Peucker approximation variant (DPn).
+
+            This algorithm is a variation of the original implementation. Instead of considering
+            one polyline segment at a time, all segments of the current simplified polyline are
+            evaluated at each step. Only the vertex with the maximum distance from its edge is
+            added to the simplification. This process will recurse untill the the simplification
+            contains the desired amount of vertices.
+
+            The algorithm, which does not use the (radial) distance between points routine as a
+            preprocessing step, is O(n2) in worst case and O(n log n) on average.
+
+            Equally distant vertices are added in the order in which they appear in the polyline.
+            Earlier implementations, based on std::priority_queue, broke such ties by the layout
+            of the heap, so for input with equally distant vertices the selected vertices may
+            differ from those.
+
+            Note that this algorithm will create a copy of the input polyline for performance
+            reasons.
+
+            DPn is applied to the range [first, last). The resulting simplified polyline consists
+            of count vertices and is copied to the output range [result, result + count). The
+            return value is the end of the output range: result + count.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to a value type of the output iterator
+            4- The range [first, last) contains vertex coordinates in multiples of DIM, f.e.:
+               x, y, z, x, y, z, x, y, z when DIM = 3
+            5- The range [first, last) contains a minimum of count vertices
+            6- count is at least 2
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \sa DouglasPeucker
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] count    the maximum number of points of the simplified polyline
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator DouglasPeuckerN (
+            InputIterator first,
+            InputIterator last,
+            unsigned count,
+            OutputIterator result)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount <= static_cast <diff_type> (count) || count < 2) {
+                return std::copy (first, last, result);
+            }
+
+            // copy coords
+            PSIMPL_TIMER(timer);
+            value_type* coords = Reserve (Scratch ().coords, coordCount);
+            for (ptr_diff_type c=0; c<coordCount; ++c) {
+                coords [c] = *first;
+                ++first;
+            }
+            PSIMPL_LAP(timer, reduceTime);
+
+            // douglas-peucker approximation
+            KeySet& keys = Scratch ().keySet;
+            keys.Reset (pointCount);
+            DPHelper::ApproximateN (coords, coordCount, count, typename DPHelper::KeyBits (keys),
+                                    Scratch ().heap, 0, control);
+            PSIMPL_LAP(timer, approximateTime);
+
+            // copy keys
+            CopyKeys (coords, keys, result);
+            PSIMPL_LAP(timer, copyTime);
+            return result;
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DPn), which can be stopped early.
+
+            Identical to DouglasPeuckerN, except that the control is checked once every interval
+            keys. When the approximation is stopped, the keys found so far are copied to the
+            output. This is the result of DouglasPeuckerN for that number of points.
+
+            \sa DouglasPeuckerN
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] count    the maximum number of points of the simplified polyline
+            \param[in] result   destination of the simplified polyline
+            \param[in] control  cancels the approximation and reports its progress
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator DouglasPeuckerN (
+            InputIterator first,
+            InputIterator last,
+            unsigned count,
+            OutputIterator result,
+            SimplificationControl& control)
+        {
+            ControlScope scope (this->control, control);
+            return DouglasPeuckerN (first, last, count, result);
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DPn), using a bounding box hierarchy.
+
+            The result is identical to that of DouglasPeuckerN. The key of each long sub polyline
+            is searched for using the hierarchy, which skips the points that cannot be further
+            away from the segment than the key found so far, see BoundingBoxHierarchy. The
+            hierarchy can be reused for any point count, and the input is not copied.
+
+            The hierarchy is only used when it was built for the input itself, which requires
+            contiguous input (a pointer or std::vector iterator). Otherwise the hierarchy is
+            ignored.
+
+            \sa DouglasPeuckerN
+
+            \param[in] first        the first coordinate of the first polyline point
+            \param[in] last         one beyond the last coordinate of the last polyline point
+            \param[in] count        the maximum number of points of the simplified polyline
+            \param[in] hierarchy    the bounding box hierarchy of the polyline [first, last)
+            \param[in] result       destination of the simplified polyline
+            \return                 one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator DouglasPeuckerN (
+            InputIterator first,
+            InputIterator last,
+            unsigned count,
+            const BoundingBoxHierarchy <DIM, value_type>& hierarchy,
+            OutputIterator result)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            const value_type* coords = util::contiguous_iterator <InputIterator>::address (first);
+            if (coordCount % DIM || pointCount <= static_cast <diff_type> (count) || count < 2 ||
+                !hierarchy.Covers (coords, pointCount))
+            {
+                return DouglasPeuckerN (first, last, count, result);
+            }
+
+            // douglas-peucker approximation
+            PSIMPL_TIMER(timer);
+            KeySet& keys = Scratch ().keySet;
+            keys.Reset (pointCount);
+            DPHelper::ApproximateN (typename DPHelper::IndexedPoints (coords, 0, &hierarchy),
+                                    coordCount, count, typename DPHelper::KeyBits (keys),
+                                    Scratch ().heap);
+            PSIMPL_LAP(timer, approximateTime);
+
+            // copy keys
+            CopyKeys (coords, keys, result);
+            PSIMPL_LAP(timer, copyTime);
+            return result;
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DP), outputting point indices.
+
+            Identical to DouglasPeucker, except that instead of the coordinates of each key, its
+            zero-based point index into the range [first, last) is copied to the output range
+            [result, result + m), where m is the number of vertices of the simplified polyline.
+            The indices are in increasing order. The return value is the end of the output range:
+            result + m.
+
+            This allows attributes that are stored next to the coordinates (f.e. time stamps) to
+            be selected, without having to match the output coordinates against the input.
+
+            In case the requirements of DouglasPeucker are not met, the indices of all points
+            [0, n) are copied to the output range [result, result + n), where n is the number of
+            complete points in the range [first, last).
+
+            \sa DouglasPeucker
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] tol      perpendicular (point-to-segment) distance tolerance
+            \param[in] result   destination of the indices of the simplified polyline points
+            \return             one beyond the last index of the simplified polyline
+        */
+        template <class IndexIterator>
+        IndexIterator DouglasPeuckerIndices (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            IndexIterator result)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || tol == 0) {
+                return CopyIndices (pointCount, result);
+            }
+            // copy the original indices of all keys
+            const ptr_diff_type* indices = DouglasPeuckerSelect (first, pointCount, tol);
+            Scratch ().keySet.ForEach ([&] (std::size_t p) {
+                *result = indices [p];
+                ++result;
+            });
+            return result;
+        }
+
+        /*!
+            \brief Performs a Douglas-Peucker approximation variant (DPn), outputting point indices.
+
+            Identical to DouglasPeuckerN, except that instead of the coordinates of each key, its
+            zero-based point index into the range [first, last) is copied to the output range
+            [result, result + count). The indices are in increasing order. The return value is
+            the end of the output range: result + count.
+
+            In case the requirements of DouglasPeuckerN are not met, the indices of all points
+            [0, n) are copied to the output range [result, result + n), where n is the number of
+            complete points in the range [first, last).
+
+            \sa DouglasPeuckerN
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] count    the maximum number of points of the simplified polyline
+            \param[in] result   destination of the indices of the simplified polyline points
+            \return             one beyond the last index of the simplified polyline
+        */
+        template <class IndexIterator>
+        IndexIterator DouglasPeuckerNIndices (
+            InputIterator first,
+            InputIterator last,
+            unsigned count,
+            IndexIterator result)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount <= static_cast <diff_type> (count) || count < 2) {
+                return CopyIndices (pointCount, result);
+            }
+
+            // copy the indices of all keys
+            DouglasPeuckerNApproximate (first, coordCount, count, Scratch ().keySet);
+            return Scratch ().keySet.Indices (result);
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DP), outputting a key set.
+
+            Identical to DouglasPeucker, except that the simplified polyline is stored as the
+            key set keys, which indicates for each point of the range [first, last) if it is a
+            vertex of the simplified polyline. The return value is the number of vertices.
+
+            In case the requirements of DouglasPeucker are not met, all n complete points of
+            the range [first, last) are keys.
+
+            \sa DouglasPeucker
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] tol      perpendicular (point-to-segment) distance tolerance
+            \param[out] keys    the key set of the simplified polyline, resized to n points
+            \return             the number of vertices of the simplified polyline
+        */
+        std::size_t DouglasPeuckerKeys (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            KeySet& keys)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            keys.Reset (pointCount);
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || tol == 0) {
+                keys.SetAll ();
+                return pointCount;
+            }
+
+            // mark the original indices of all keys
+            const ptr_diff_type* indices = DouglasPeuckerSelect (first, pointCount, tol);
+            std::size_t keyCount = 0;
+            Scratch ().keySet.ForEach ([&] (std::size_t p) {
+                keys.Set (indices [p]);
+                ++keyCount;
+            });
+            return keyCount;
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DPn), outputting a key set.
+
+            Identical to DouglasPeuckerN, except that the simplified polyline is stored as the
+            key set keys, which indicates for each point of the range [first, last) if it is a
+            vertex of the simplified polyline. The return value is the number of vertices.
+
+            In case the requirements of DouglasPeuckerN are not met, all n complete points of
+            the range [first, last) are keys.
+
+            \sa DouglasPeuckerN
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] count    the maximum number of points of the simplified polyline
+            \param[out] keys    the key set of the simplified polyline, resized to n points
+            \return             the number of vertices of the simplified polyline
+        */
+        std::size_t DouglasPeuckerNKeys (
+            InputIterator first,
+            InputIterator last,
+            unsigned count,
+            KeySet& keys)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount <= static_cast <diff_type> (count) || count < 2) {
+                keys.Reset (pointCount);
+                keys.SetAll ();
+                return pointCount;
+            }
+            DouglasPeuckerNApproximate (first, coordCount, count, keys);
+            return keys.Count ();
+        }
+
+        /*!
+            \brief Performs the first phase of a two-phase Douglas-Peucker approximation (DP).
+
+            Determines the keys of DouglasPeucker, without copying any coordinates. Instead, the
+            point indices of the keys are stored in the workspace, and the number of coordinates
+            that DouglasPeucker would output is returned. This allows the caller to allocate the
+            destination exactly, after which CopySelection writes the simplified polyline into
+            it.
+
+            The selection remains valid until the next SelectDouglasPeucker or
+            SelectDouglasPeuckerN call that uses the same workspace. Other routines do not
+            affect it.
+
+            \sa DouglasPeucker
+            \sa CopySelection
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] tol      perpendicular (point-to-segment) distance tolerance
+            \return             the number of coordinates of the simplified polyline
+        */
+        std::size_t SelectDouglasPeucker (
+            InputIterator first,
+            InputIterator last,
+            value_type tol)
+        {
+            diff_type coordCount = std::distance (first, last);
+            ptr_diff_type* selection = Reserve (Scratch ().selection, DIM ? coordCount / DIM : 0);
+            ptr_diff_type count = DouglasPeuckerIndices (first, last, tol, selection) - selection;
+            return Select (coordCount, count);
+        }
+
+        /*!
+            \brief Performs the first phase of a two-phase Douglas-Peucker approximation (DPn).
+
+            Determines the keys of DouglasPeuckerN, without copying any coordinates. Instead, the
+            point indices of the keys are stored in the workspace, and the number of coordinates
+            that DouglasPeuckerN would output is returned. This allows the caller to allocate the
+            destination exactly, after which CopySelection writes the simplified polyline into
+            it.
+
+            The selection remains valid until the next SelectDouglasPeucker or
+            SelectDouglasPeuckerN call that uses the same workspace. Other routines do not
+            affect it.
+
+            \sa DouglasPeuckerN
+            \sa CopySelection
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] count    the maximum number of points of the simplified polyline
+            \return             the number of coordinates of the simplified polyline
+        */
+        std::size_t SelectDouglasPeuckerN (
+            InputIterator first,
+            InputIterator last,
+            unsigned count)
+        {
+            diff_type coordCount = std::distance (first, last);
+            ptr_diff_type* selection = Reserve (Scratch ().selection, DIM ? coordCount / DIM : 0);
+            ptr_diff_type keyCount = DouglasPeuckerNIndices (first, last, count, selection) - selection;
+            return Select (coordCount, keyCount);
+        }
+
+        /*!
+            \brief Performs the second phase of a two-phase Douglas-Peucker approximation.
+
+            Copies the polyline that was selected by the last SelectDouglasPeucker or
+            SelectDouglasPeuckerN call to the output range [result, result + m), where m is the
+            value returned by that call. The range [first, last) must be the one that was passed
+            to that call, and must not have been modified since. Only a single pass over the
+            input is made, up to the last selected point.
+
+            In case the requirements of the selection routine were not met, the entire input
+            range is copied, as would be done by DouglasPeucker or DouglasPeuckerN.
+
+            \sa SelectDouglasPeucker
+            \sa SelectDouglasPeuckerN
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator CopySelection (
+            InputIterator first,
+            OutputIterator result)
+        {
+            std::size_t coordCount = Scratch ().selectionSize;
+            if (!DIM || coordCount % DIM) {
+                // invalid input; the selection is the entire input range
+                for (std::size_t c=0; c<coordCount; ++c) {
+                    *result = *first;
+                    ++result;
+                    ++first;
+                }
+                return result;
+            }
+            const ptr_diff_type* selection = Scratch ().selection.data ();
+            ptr_diff_type keyCount = coordCount / DIM;
+            ptr_diff_type current = 0;
+            for (ptr_diff_type k=0; k<keyCount; ++k) {
+                std::advance (first, (selection [k] - current) * DIM);
+                current = selection [k] + 1;
+                CopyKeyAdvance (first, result);
+            }
+            return result;
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DP), outputting the error of each segment.
+
+            Identical to DouglasPeucker, except that for each segment of the simplified polyline
+            the maximum squared distance of the points it replaces is copied to the output range
+            [errors, errors + m - 1), where m is the number of vertices of the simplified
+            polyline. These distances are the ones computed by the key search, so no additional
+            pass over the polyline is needed.
+
+            Note that only the points that remain after the RadialDistance preprocessing step are
+            taken into account. Each point removed by that step lies within tol of a point that is
+            taken into account. Use DouglasPeuckerNErrors or ComputePositionalErrors2 when the
+            exact positional errors are required.
+
+            In case the requirements of DouglasPeucker are not met, the entire input range
+            [first, last) is copied to the output range [result, result + (last - first)), and an
+            error of 0 is copied for each segment between the complete points of the input.
+
+            \sa DouglasPeucker
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] tol      perpendicular (point-to-segment) distance tolerance
+            \param[in] result   destination of the simplified polyline
+            \param[in] errors   destination of the squared error of each simplified segment
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        template <class ErrorIterator>
+        OutputIterator DouglasPeuckerErrors (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            OutputIterator result,
+            ErrorIterator errors)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || tol == 0) {
+                CopyZeroErrors (pointCount, errors);
+                return std::copy (first, last, result);
+            }
+            // radial distance routine as preprocessing
+            value_type* reduced = Reserve (Scratch ().coords, coordCount);  // radial distance results
+            PolylineSimplification <DIM, InputIterator, value_type*, Precision> psimpl_to_array;
+            ptr_diff_type reducedCoordCount = std::distance (reduced,
+                psimpl_to_array.RadialDistance (first, last, tol, reduced));
+            ptr_diff_type reducedPointCount = reducedCoordCount / DIM;
+
+            // douglas-peucker approximation
+            unsigned char* keys = Reserve (Scratch ().keys, pointCount);      // douglas-peucker results
+            value_type* keyErrors = Reserve (Scratch ().temp, reducedPointCount);
+            DPHelper::Approximate (reduced, reducedCoordCount, tol, keys, Scratch ().stack, keyErrors);
+
+            // copy all keys and the errors of their segments
+            CopyKeys (reduced, keys, reducedPointCount, result);
+            CopyKeyErrors (keys, keyErrors, reducedPointCount, errors);
+            return result;
+        }
+
+        /*!
+            \brief Performs a Douglas-Peucker approximation variant (DPn), outputting the error of
+            each segment.
+
+            Identical to DouglasPeuckerN, except that for each segment of the simplified polyline
+            the maximum squared distance of the points it replaces is copied to the output range
+            [errors, errors + count - 1). These are the positional errors of the simplification,
+            as computed by the key search, so no additional pass over the polyline is needed.
+
+            In case the requirements of DouglasPeuckerN are not met, the entire input range
+            [first, last) is copied to the output range [result, result + (last - first)), and an
+            error of 0 is copied for each segment between the complete points of the input.
+
+            \sa DouglasPeuckerN
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] count    the maximum number of points of the simplified polyline
+            \param[in] result   destination of the simplified polyline
+            \param[in] errors   destination of the squared error of each simplified segment
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        template <class ErrorIterator>
+        OutputIterator DouglasPeuckerNErrors (
+            InputIterator first,
+            InputIterator last,
+            unsigned count,
+            OutputIterator result,
+            ErrorIterator errors)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount <= static_cast <diff_type> (count) || count < 2) {
+                CopyZeroErrors (pointCount, errors);
+                return std::copy (first, last, result);
+            }
+
+            // copy coords
+            value_type* coords = Reserve (Scratch ().coords, coordCount);
+            for (ptr_diff_type c=0; c<coordCount; ++c) {
+                coords [c] = *first;
+                ++first;
+            }
+
+            // douglas-peucker approximation
+            unsigned char* keys = Reserve (Scratch ().keys, pointCount);
+            value_type* keyErrors = Reserve (Scratch ().temp, pointCount);
+            DPHelper::ApproximateN (coords, coordCount, count, keys, Scratch ().heap, keyErrors);
+
+            // copy keys and the errors of their segments
+            CopyKeys (coords, keys, pointCount, result);
+            CopyKeyErrors (keys, keyErrors, pointCount, errors);
+            return result;
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DP) for multiple tolerances at once.
+
+            DP results are nested: a key for a tolerance is also a key for each smaller
+            tolerance. Instead of a simplification per tolerance, the level of each point is
+            determined: the number of tolerances for which the point is a key. The
+            simplification for tolerance k (zero-based) consists of the points whose level is
+            larger than k.
+
+            The RD preprocessing step is performed once, using the smallest tolerance. A single
+            DP run then finds the keys for the smallest tolerance; when a sub polyline is split,
+            the level of its key is the number of tolerances whose squared value is smaller than
+            the squared key distance, but at most the level of the enclosing keys. As a result,
+            the total cost is that of a single DouglasPeucker call with the smallest tolerance.
+            For that tolerance the keys equal those of DouglasPeucker. For the larger tolerances
+            the keys equal DP applied to the output of the shared RD step; they differ from
+            separate DouglasPeucker calls only in the points that RD removes.
+
+            The level of each point of the range [first, last) is copied to the output range
+            [levels, levels + n), where n is the number of points. The return value is the end
+            of the output range: levels + n.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The ToleranceIterator type models the concept of an input iterator
+            4- The LevelIterator value type can be assigned an unsigned value
+            5- The range [first, last) contains vertex coordinates in multiples of DIM, f.e.:
+               x, y, z, x, y, z, x, y, z when DIM = 3
+            6- The range [first, last) contains at least 2 vertices
+            7- The range [tol_first, tol_last) contains between 1 and 255 positive tolerances,
+               in increasing order
+
+            In case these requirements are not met, each complete point is assigned the number
+            of tolerances as its level, as in case of invalid input each DouglasPeucker call
+            copies the entire polyline.
+
+            \sa DouglasPeucker
+
+            \param[in] first        the first coordinate of the first polyline point
+            \param[in] last         one beyond the last coordinate of the last polyline point
+            \param[in] tol_first    the smallest perpendicular (point-to-segment) distance tolerance
+            \param[in] tol_last     one beyond the largest tolerance
+            \param[in] levels       destination of the level of each point
+            \return                 one beyond the last level
+        */
+        template <class ToleranceIterator, class LevelIterator>
+        LevelIterator DouglasPeuckerLevels (
+            InputIterator first,
+            InputIterator last,
+            ToleranceIterator tol_first,
+            ToleranceIterator tol_last,
+            LevelIterator levels)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            std::vector <value_type>& tols = Scratch ().temp;
+            tols.assign (tol_first, tol_last);
+            ptr_diff_type levelCount = static_cast <ptr_diff_type> (tols.size ());
+            // validate input and check if simplification required
+            bool valid = 0 < levelCount && levelCount <= std::numeric_limits <unsigned char>::max () &&
+                         0 < tols [0];
+            for (ptr_diff_type t=1; valid && t<levelCount; ++t) {
+                valid = !(tols [t] < tols [t-1]);
+            }
+            if (coordCount % DIM || pointCount < 3 || !valid) {
+                for (diff_type p=0; p<pointCount; ++p) {
+                    *levels = static_cast <unsigned> (levelCount);
+                    ++levels;
+                }
+                return levels;
+            }
+            PSIMPL_TIMER(timer);
+            // radial distance routine as preprocessing, keeping track of the original indices;
+            // contiguous input is not copied
+            const value_type* coords = util::contiguous_iterator <InputIterator>::address (first);
+            value_type* reduced = coords ? 0 : Reserve (Scratch ().coords, coordCount);
+            ptr_diff_type* indices = Reserve (Scratch ().indices, pointCount);
+            ptr_diff_type reducedPointCount = RadialDistanceIndices (
+                first, pointCount, tols [0], reduced, indices);
+            PSIMPL_LAP(timer, reduceTime);
+
+            // douglas-peucker approximation, storing the level of each key
+            for (ptr_diff_type t=0; t<levelCount; ++t) {
+                tols [t] *= tols [t];
+            }
+            unsigned char* keys = Reserve (Scratch ().keys, pointCount);
+            if (!coords) {
+                DPHelper::ApproximateLevels (static_cast <const value_type*> (reduced),
+                    reducedPointCount * DIM, &tols [0], levelCount, keys, Scratch ().stack);
+            }
+            else if (reducedPointCount == pointCount) {
+                DPHelper::ApproximateLevels (coords, coordCount, &tols [0], levelCount, keys,
+                    Scratch ().stack);
+            }
+            else {
+                DPHelper::ApproximateLevels (typename DPHelper::IndexedPoints (coords, indices),
+                    reducedPointCount * DIM, &tols [0], levelCount, keys, Scratch ().stack);
+            }
+            PSIMPL_LAP(timer, approximateTime);
+
+            // copy the level of each point; points removed by RD have level 0
+            for (ptr_diff_type p=0, r=0; p<pointCount; ++p) {
+                if (r < reducedPointCount && indices [r] == p) {
+                    *levels = static_cast <unsigned> (keys [r++]);
+                }
+                else {
+                    *levels = 0u;
+                }
+                ++levels;
+            }
+            PSIMPL_LAP(timer, copyTime);
+            return levels;
+        }
+
+        /*!
+            \brief Performs Visvalingam-Whyatt approximation (VW).
+
+            VW repeatedly removes the point with the smallest effective area: the area of the
+            triangle formed by that point and its two neighbours. The areas of the neighbours are
+            then recomputed. The effective area of a point is never smaller than that of any point
+            removed before it, so the order of removal does not depend on the tolerance; a
+            simplification for a larger tolerance is always a subset of one for a smaller
+            tolerance, and matches the VisvalingamWhyattN simplification of the same size.
+
+            All points with an effective area smaller than tol are removed. The remaining points
+            are linked in a doubly linked list, and the removable points are kept in an indexed
+            binary min-heap; both are stored in flat arrays in the workspace, which makes VW
+            O(n log n) in worst case. Contiguous input (pointers and std::vector iterators) is
+            used in-place; any other input is copied.
+
+            VW is applied to the range [first, last) using effective area tolerance tol. The
+            resulting simplified polyline is copied to the output range [result, result + m*DIM],
+            where m is the number of vertices of the simplified polyline. The return value is the
+            end of the output range: result + m*DIM.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to a value type of the output iterator
+            4- The range [first, last) contains vertex coordinates in multiples of DIM, f.e.:
+               x, y, z, x, y, z, x, y, z when DIM = 3
+            5- The range [first, last) contains at least 2 vertices
+            6- tol is not 0
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \sa VisvalingamWhyattN
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] tol      effective (triangle) area tolerance
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator VisvalingamWhyatt (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            OutputIterator result)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount < 3 || tol == 0) {
+                return std::copy (first, last, result);
+            }
+            double area2 = static_cast <double> (tol) * static_cast <double> (tol);
+            return VisvalingamWhyattApproximate (first, pointCount, 2, area2, result);
+        }
+
+        /*!
+            \brief Performs Visvalingam-Whyatt approximation (VW), keeping count points.
+
+            Identical to VisvalingamWhyatt, except that points are removed until the
+            simplification consists of count vertices, regardless of their effective areas. Unlike
+            DouglasPeuckerN, VW is O(n log n) in worst case, and does not copy contiguous input.
+
+            VW is applied to the range [first, last). The resulting simplified polyline consists
+            of count vertices and is copied to the output range [result, result + count). The
+            return value is the end of the output range: result + count.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to a value type of the output iterator
+            4- The range [first, last) contains vertex coordinates in multiples of DIM, f.e.:
+               x, y, z, x, y, z, x, y, z when DIM = 3
+            5- The range [first, last) contains a minimum of count vertices
+            6- count is at least 2
+
+            In case these requirements are not met, the entire input range [first, last) is copied
+            to the output range [result, result + (last - first)) OR compile errors may occur.
+
+            \sa VisvalingamWhyatt
+
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \param[in] count    the maximum number of points of the simplified polyline
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator VisvalingamWhyattN (
+            InputIterator first,
+            InputIterator last,
+            unsigned count,
+            OutputIterator result)
+        {
+            diff_type coordCount = std::distance (first, last);
+            diff_type pointCount = DIM      // protect against zero DIM
+                                   ? coordCount / DIM
+                                   : 0;
+            // validate input and check if simplification required
+            if (coordCount % DIM || pointCount <= static_cast <diff_type> (count) || count < 2) {
+                return std::copy (first, last, result);
+            }
+            return VisvalingamWhyattApproximate (first, pointCount, count,
+                std::numeric_limits <double>::infinity (), result);
+        }
+
+        /*!
+            \brief Computes the squared positional error between a polyline and its simplification.
+
+            For each point in the range [original_first, original_last) the squared distance to the
+            simplification [simplified_first, simplified_last) is calculated. Each positional error
+            is copied to the output range [result, result + count), where count is the number of
+            points in the original polyline. The return value is the end of the output range:
+            result + count.
+
+            Note that both the original and simplified polyline must be defined using the same
+            value_type.
+
+            \image html psimpl_pos_error.png
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to a value type of the output iterator
+            4- The ranges [original_first, original_last) and [simplified_first, simplified_last)
+               contain vertex coordinates in multiples of DIM, f.e.: x, y, z, x, y, z, x, y, z
+               when DIM = 3
+            5- The ranges [original_first, original_last) and [simplified_first, simplified_last)
+               contain a minimum of 2 vertices
+            6- The range [simplified_first, simplified_last) represents a simplification of the
+               range [original_first, original_last), meaning each point in the simplification
+               has the exact same coordinates as some point from the original polyline
+
+            In case these requirements are not met, the valid flag is set to false OR
+            compile errors may occur.
+
+            \param[in] original_first   the first coordinate of the first polyline point
+            \param[in] original_last    one beyond the last coordinate of the last polyline point
+            \param[in] simplified_first the first coordinate of the first simplified polyline point
+            \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
+            \param[in] result           destination of the squared positional errors
+            \param[out] valid           [optional] indicates if the computed positional errors are valid
+            \return                     one beyond the last computed positional error
+        */
+        OutputIterator ComputePositionalErrors2 (
+            InputIterator original_first,
+            InputIterator original_last,
+            InputIterator simplified_first,
+            InputIterator simplified_last,
+            OutputIterator result,
+            bool* valid=0)
+        {
+            diff_type original_coordCount = std::distance (original_first, original_last);
+            diff_type original_pointCount = DIM     // protect against zero DIM
+                                            ? original_coordCount / DIM
+                                            : 0;
+
+            diff_type simplified_coordCount = std::distance (simplified_first, simplified_last);
+            diff_type simplified_pointCount = DIM   // protect against zero DIM
+                                              ? simplified_coordCount / DIM
+                                              : 0;
+
+            // validate input
+            if (original_coordCount % DIM || original_pointCount < 2 ||
+                simplified_coordCount % DIM || simplified_pointCount < 2 ||
+                original_pointCount < simplified_pointCount ||
+                !math::equal <DIM> (original_first, simplified_first))
+            {
+                if (valid) {
+                    *valid = false;
+                }
+                return result;
+            }
+
+            // define (simplified) line segment S(simplified_prev, simplified_first)
+            InputIterator simplified_prev = simplified_first;
+            std::advance (simplified_first, DIM);
+
+            // process each simplified line segment
+            while (simplified_first != simplified_last) {
+                // process each original point until it equals the end of the line segment
+                while (original_first != original_last &&
+                       !math::equal <DIM> (original_first, simplified_first))
+                {
+                    *result = math::segment_distance2 <DIM, KeyPrecision> (simplified_prev, simplified_first,
+                                                                original_first);
+                    ++result;
+                    std::advance (original_first, DIM);
+                }
+                // update line segment S
+                simplified_prev = simplified_first;
+                std::advance (simplified_first, DIM);
+            }
+            // check if last original point matched
+            if (original_first != original_last) {
+                *result = 0;
+                ++result;
+            }
+
+            if (valid) {
+                *valid = original_first != original_last;
+            }
+            return result;
+        }
+
+        /*!
+            \brief Computes the squared positional errors using multiple threads.
+
+            The result is identical to that of ComputePositionalErrors2. The original polyline is
+            copied single threaded, while matching the points of the simplification against it.
+            This splits the original polyline into one range of points per simplified segment.
+            The points are then divided into one part per thread. Each thread computes the
+            distances of its part, one simplified segment at a time, using
+            math::SegmentDistances. That is vectorized for float and double coordinates in 2 and
+            3 dimensions.
+
+            Each thread processes at least 4096 points. When that leaves a single thread,
+            ComputePositionalErrors2 is performed instead, as copying the polyline would only
+            add work. Otherwise the output is only written after all threads have finished.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to a value type of the output iterator
+            4- The ranges [original_first, original_last) and [simplified_first, simplified_last)
+               contain vertex coordinates in multiples of DIM, f.e.: x, y, z, x, y, z, x, y, z
+               when DIM = 3
+            5- The ranges [original_first, original_last) and [simplified_first, simplified_last)
+               contain a minimum of 2 vertices
+            6- The range [simplified_first, simplified_last) represents a simplification of the
+               range [original_first, original_last), meaning each point in the simplification
+               has the exact same coordinates as some point from the original polyline
+
+            In case these requirements are not met, the valid flag is set to false OR
+            compile errors may occur.
+
+            \sa ComputePositionalErrors2
+
+            \param[in] original_first   the first coordinate of the first polyline point
+            \param[in] original_last    one beyond the last coordinate of the last polyline point
+            \param[in] simplified_first the first coordinate of the first simplified polyline point
+            \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
+            \param[in] threadCount      number of threads to use; 0 selects the number of hardware threads
+            \param[in] result           destination of the squared positional errors
+            \param[out] valid           [optional] indicates if the computed positional errors are valid
+            \return                     one beyond the last computed positional error
+        */
+        OutputIterator ComputePositionalErrors2Parallel (
+            InputIterator original_first,
+            InputIterator original_last,
+            InputIterator simplified_first,
+            InputIterator simplified_last,
+            unsigned threadCount,
+            OutputIterator result,
+            bool* valid=0)
+        {
+            diff_type original_coordCount = std::distance (original_first, original_last);
+            diff_type original_pointCount = DIM     // protect against zero DIM
+                                            ? original_coordCount / DIM
+                                            : 0;
+
+            diff_type simplified_coordCount = std::distance (simplified_first, simplified_last);
+            diff_type simplified_pointCount = DIM   // protect against zero DIM
+                                              ? simplified_coordCount / DIM
+                                              : 0;
+
+            // each thread processes at least GRAIN_SIZE points, a single thread avoids the copy
+            const diff_type GRAIN_SIZE = 4096;
+            if (threadCount == 0) {
+                threadCount = std::max (1u, std::thread::hardware_concurrency ());
+            }
+            threadCount = static_cast <unsigned> (std::max <diff_type> (1,
+                std::min <diff_type> (threadCount, original_pointCount / GRAIN_SIZE)));
+            if (threadCount == 1) {
+                return ComputePositionalErrors2 (original_first, original_last,
+                                                 simplified_first, simplified_last,
+                                                 result, valid);
+            }
+
+            // validate input
+            if (original_coordCount % DIM || original_pointCount < 2 ||
+                simplified_coordCount % DIM || simplified_pointCount < 2 ||
+                original_pointCount < simplified_pointCount ||
+                !math::equal <DIM> (original_first, simplified_first))
+            {
+                if (valid) {
+                    *valid = false;
+                }
+                return result;
+            }
+
+            // copy the original polyline, while matching each simplified point except the first
+            // one; ends [s] stores the index of the original point that matches the end point of
+            // simplified segment s
+            value_type* coords = Reserve (Scratch ().coords, original_coordCount);
+            ptr_diff_type* ends = Reserve (Scratch ().indices, simplified_pointCount);
+            ptr_diff_type segmentCount = 0;
+            value_type segmentEnd [DIM];        // end point of the current simplified segment
+            value_type* point = segmentEnd;
+            std::advance (simplified_first, DIM);
+            CopyPointAdvance (simplified_first, point);
+
+            bool matched = false;
+            value_type* original = coords;
+            for (ptr_diff_type p=0; p<original_pointCount && !matched; ++p) {
+                CopyPointAdvance (original_first, original);
+                while (!matched && math::equal <DIM> (coords + p * DIM, segmentEnd)) {
+                    ends [segmentCount++] = p;
+                    matched = simplified_first == simplified_last;
+                    if (!matched) {
+                        point = segmentEnd;
+                        CopyPointAdvance (simplified_first, point);
+                    }
+                }
+            }
+            // the last segment ends beyond the original polyline, when its end point did not match
+            if (!matched) {
+                ends [segmentCount++] = original_pointCount;
+            }
+            ptr_diff_type errorCount = ends [segmentCount-1];
+
+            // compute the errors of each part
+            ptr_diff_type partSize = (errorCount + threadCount - 1) / threadCount;
+            value_type* errors = Reserve (Scratch ().temp, errorCount);
+            const value_type* unmatched = matched ? 0 : segmentEnd;
+
+            std::vector <std::thread> threads;
+            for (unsigned t = 0; t < threadCount; ++t) {
+                ptr_diff_type partFirst = std::min <ptr_diff_type> (errorCount, t * partSize);
+                ptr_diff_type partLast = std::min <ptr_diff_type> (errorCount, (t + 1) * partSize);
+                threads.push_back (instrument::make_thread (&ComputePositionalErrorsPart, coords, ends,
+                                                segmentCount, unmatched, partFirst, partLast,
+                                                errors));
+            }
+            for (unsigned t = 0; t < threadCount; ++t) {
+                threads [t].join ();
+            }
+
+            // copy the errors, and the error of the last original point that matched
+            result = std::copy (errors, errors + errorCount, result);
+            if (matched) {
+                *result = 0;
+                ++result;
+            }
+
+            if (valid) {
+                *valid = matched;
+            }
+            return result;
+        }
+
+        /*!
+            \brief Computes statistics for the positional errors between a polyline and its simplification.
+
+            Various statistics (mean, max, sum, std) are calculated for the positional errors
+            between the range [original_first, original_last) and its simplification the range
+            [simplified_first, simplified_last).
+
+            Each positional error is added to a math::StatisticsAccumulator as soon as it is
+            computed by ComputePositionalErrors2. This takes a single pass over both polylines,
+            without temporary buffers.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to double
+            4- The ranges [original_first, original_last) and [simplified_first, simplified_last)
+               contain vertex coordinates in multiples of DIM, f.e.: x, y, z, x, y, z, x, y, z
+               when DIM = 3
+            5- The ranges [original_first, original_last) and [simplified_first, simplified_last)
+               contain a minimum of 2 vertices
+            6- The range [simplified_first, simplified_last) represents a simplification of the
+               range [original_first, original_last), meaning each point in the simplification
+               has the exact same coordinates as some point from the original polyline
+
+            In case these requirements are not met, the valid flag is set to false OR
+            compile errors may occur.
+
+            \sa ComputePositionalErrors2
+
+            \param[in] original_first   the first coordinate of the first polyline point
+            \param[in] original_last    one beyond the last coordinate of the last polyline point
+            \param[in] simplified_first the first coordinate of the first simplified polyline point
+            \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
+            \param[out] valid           [optional] indicates if the computed statistics are valid
+            \return                     the computed statistics
+        */
+        math::Statistics ComputePositionalErrorStatistics (
+            InputIterator original_first,
+            InputIterator original_last,
+            InputIterator simplified_first,
+            InputIterator simplified_last,
+            bool* valid=0)
+        {
+            math::StatisticsAccumulator stats;
+            PolylineSimplification <DIM, InputIterator, ErrorStatisticsIterator, Precision> ps;
+            ps.ComputePositionalErrors2 (original_first, original_last,
+                                         simplified_first, simplified_last,
+                                         ErrorStatisticsIterator (stats), valid);
+            return stats.Result ();
+        }
+
+        /*!
+            \brief Computes the squared distance of each point of a polyline to the nearest
+            segment of another polyline.
+
+            For each point in the range [original_first, original_last) the squared distance to
+            the nearest segment of the polyline [simplified_first, simplified_last) is
+            calculated. Unlike ComputePositionalErrors2, the simplified polyline does not need to
+            consist of original points, so that f.e. snapped or quantized simplifications, or
+            those produced by other tools, can be scored. Each positional error is copied to the
+            output range [result, result + count), where count is the number of points in the
+            original polyline. The return value is the end of the output range: result + count.
+
+            A hierarchy of bounding boxes over the simplified segments (SegmentTree) is built
+            once, in O(m). Each original point is then matched against it, starting with the
+            nearest segment of the previous point. For n original points this takes roughly
+            O(n log m) instead of the O(n m) of comparing each point with each segment. When
+            the simplified polyline is a simplification in the ComputePositionalErrors2 sense,
+            the errors are never larger than those of ComputePositionalErrors2.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to a value type of the output iterator
+            4- The ranges [original_first, original_last) and [simplified_first, simplified_last)
+               contain vertex coordinates in multiples of DIM, f.e.: x, y, z, x, y, z, x, y, z
+               when DIM = 3
+            5- The ranges [original_first, original_last) and [simplified_first, simplified_last)
+               contain a minimum of 2 vertices
+
+            In case these requirements are not met, the valid flag is set to false OR
+            compile errors may occur.
+
+            \sa ComputePositionalErrors2
+
+            \param[in] original_first   the first coordinate of the first polyline point
+            \param[in] original_last    one beyond the last coordinate of the last polyline point
+            \param[in] simplified_first the first coordinate of the first simplified polyline point
+            \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
+            \param[in] result           destination of the squared positional errors
+            \param[out] valid           [optional] indicates if the computed positional errors are valid
+            \return                     one beyond the last computed positional error
+        */
+        OutputIterator ComputeNearestErrors2 (
+            InputIterator original_first,
+            InputIterator original_last,
+            InputIterator simplified_first,
+            InputIterator simplified_last,
+            OutputIterator result,
+            bool* valid=0)
+        {
+            diff_type original_coordCount = std::distance (original_first, original_last);
+            diff_type simplified_coordCount = std::distance (simplified_first, simplified_last);
+            bool ok = ValidPolylines (original_coordCount, simplified_coordCount);
+            if (valid) {
+                *valid = ok;
+            }
+            if (!ok) {
+                return result;
+            }
+            SegmentTree tree (PolylineCoords (simplified_first, simplified_coordCount),
+                              simplified_coordCount / DIM, Scratch ().bounds, Scratch ().nodes);
+            ptr_diff_type segment = 0;
+            value_type point [DIM];
+            while (original_first != original_last) {
+                for (unsigned d = 0; d < DIM; ++d, ++original_first) {
+                    point [d] = *original_first;
+                }
+                *result = tree.Nearest (point, segment);
+                ++result;
+            }
+            return result;
+        }
+
+        /*!
+            \brief Computes the Hausdorff distance between a polyline and its simplification.
+
+            The Hausdorff distance is the largest distance of any vertex of either polyline to
+            the other polyline: the maximum of ComputeNearestErrors2 for the original points,
+            and of ComputeNearestErrors2 for the simplified points against the original
+            polyline. As with ComputeNearestErrors2, the simplified polyline does not need to
+            consist of original points. Both directions use a SegmentTree, so that the total
+            cost is roughly O(n log m + m log n) for n original and m simplified points.
+
+            Input (Type) requirements:
+            1- DIM is not 0, where DIM represents the dimension of the polyline
+            2- The InputIterator type models the concept of a forward iterator
+            3- The InputIterator value type is convertible to double
+            4- The ranges [original_first, original_last) and [simplified_first, simplified_last)
+               contain vertex coordinates in multiples of DIM, f.e.: x, y, z, x, y, z, x, y, z
+               when DIM = 3
+            5- The ranges [original_first, original_last) and [simplified_first, simplified_last)
+               contain a minimum of 2 vertices
+
+            In case these requirements are not met, the valid flag is set to false and 0 is
+            returned OR compile errors may occur.
+
+            \sa ComputeNearestErrors2
+
+            \param[in] original_first   the first coordinate of the first polyline point
+            \param[in] original_last    one beyond the last coordinate of the last polyline point
+            \param[in] simplified_first the first coordinate of the first simplified polyline point
+            \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
+            \param[out] valid           [optional] indicates if the computed distance is valid
+            \return                     the Hausdorff distance
+        */
+        double ComputeHausdorffDistance (
+            InputIterator original_first,
+            InputIterator original_last,
+            InputIterator simplified_first,
+            InputIterator simplified_last,
+            bool* valid=0)
+        {
+            diff_type original_coordCount = std::distance (original_first, original_last);
+            diff_type simplified_coordCount = std::distance (simplified_first, simplified_last);
+            bool ok = ValidPolylines (original_coordCount, simplified_coordCount);
+            if (valid) {
+                *valid = ok;
+            }
+            if (!ok) {
+                return 0;
+            }
+            value_type max2 = std::max (
+                MaxNearestDistance2 (original_first, original_last, simplified_first, simplified_coordCount),
+                MaxNearestDistance2 (simplified_first, simplified_last, original_first, original_coordCount));
+            return std::sqrt (static_cast <double> (max2));
+        }
+
+    private:
+        /*!
+            \brief Output iterator that adds the root of each squared positional error to statistics.
+
+            \sa ComputePositionalErrorStatistics
+        */
+        class ErrorStatisticsIterator
+        {
+        public:
+            explicit ErrorStatisticsIterator (math::StatisticsAccumulator& stats) :
+                stats (&stats)
+            {}
+
+            ErrorStatisticsIterator& operator* () { return *this; }
+            ErrorStatisticsIterator& operator++ () { return *this; }
+
+            ErrorStatisticsIterator& operator= (value_type error2) {
+                stats->Add (std::sqrt (static_cast <double> (error2)));
+                return *this;
+            }
+
+        private:
+            math::StatisticsAccumulator* stats;
+        };
+
+        /*!
+            \brief Computes the squared positional errors of the original points [partFirst, partLast).
+
+            \sa ComputePositionalErrors2Parallel
+
+            \param[in] coords       array of original polyline coordinates
+            \param[in] ends         for each simplified segment the index of its matching end point
+            \param[in] segmentCount number of simplified segments
+            \param[in] unmatched    [optional] the end point of the last segment, when not matched
+            \param[in] partFirst    index of the first original point
+            \param[in] partLast     index of one beyond the last original point
+            \param[out] errors      for each original point its squared positional error
+        */
+        static void ComputePositionalErrorsPart (
+            const value_type* coords,
+            const ptr_diff_type* ends,
+            ptr_diff_type segmentCount,
+            const value_type* unmatched,
+            ptr_diff_type partFirst,
+            ptr_diff_type partLast,
+            value_type* errors)
+        {
+            // the first segment that contains partFirst
+            ptr_diff_type s = std::upper_bound (ends, ends + segmentCount, partFirst) - ends;
+            for (; partFirst < partLast; ++s) {
+                ptr_diff_type last = std::min (partLast, ends [s]);
+                const value_type* s1 = coords + (s ? ends [s-1] : 0) * DIM;
+                const value_type* s2 = unmatched && s+1 == segmentCount
+                                       ? unmatched
+                                       : coords + ends [s] * DIM;
+                math::SegmentDistances <DIM, value_type, key_fraction_type>::Compute (
+                    s1, s2, coords + partFirst * DIM, last - partFirst, errors + partFirst);
+                partFirst = last;
+            }
+        }
+
+        //! \brief A part of a polyline that is simplified by DouglasPeuckerChunked.
+        struct Chunk
+        {
+            std::vector <value_type> coords;        //! the points of the chunk
+            std::vector <value_type> result;        //! the simplified chunk
+            Workspace <value_type> workspace;       //! scratch memory of the thread
+            bool anchored;                          //! the first point is the previous anchor
+        };
+
+        //! \brief Simplifies a chunk using DouglasPeucker.
+        static void SimplifyChunk (
+            Chunk* chunk,
+            value_type tol)
+        {
+            typedef std::back_insert_iterator <std::vector <value_type> > ChunkIterator;
+            PolylineSimplification <DIM, const value_type*, ChunkIterator, Precision> ps (chunk->workspace);
+            chunk->result.clear ();
+            const value_type* coords = chunk->coords.data ();
+            ps.DouglasPeucker (coords, coords + chunk->coords.size (), tol,
+                               std::back_inserter (chunk->result));
+        }
+
+        /*!
+            \brief Performs DouglasPeuckerParallel on a contiguous polyline, without copying it.
+
+            The RD preprocessing step only stores the point index of each of its keys. DP is
+            then performed on the selected points, or directly on the input when RD did not
+            remove any points and no hierarchy is used. As the multi-threaded approximation
+            requires an array, the selected points are copied when threadCount is not 1.
+
+            \param[in] first        the first coordinate of the first polyline point
+            \param[in] coords       the address of the first coordinate
+            \param[in] pointCount   number of polyline points; at least 3
+            \param[in] tol          perpendicular (point-to-segment) distance tolerance
+            \param[in] threadCount  number of threads to use; 0 selects the number of hardware threads
+            \param[in] result       destination of the simplified polyline
+            \param[in] hierarchy    [optional] the bounding box hierarchy of coords; requires a
+                                    threadCount of 1
+            \return                 one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator DouglasPeuckerContiguous (
+            InputIterator first,
+            const value_type* coords,
+            ptr_diff_type pointCount,
+            value_type tol,
+            unsigned threadCount,
+            OutputIterator result,
+            const BoundingBoxHierarchy <DIM, value_type>* hierarchy=0)
+        {
+            // radial distance routine as preprocessing
+            PSIMPL_TIMER(timer);
+            ptr_diff_type* indices = Reserve (Scratch ().indices, pointCount);
+            ptr_diff_type reducedPointCount = RadialDistanceIndices (
+                first, pointCount, tol, 0, indices);
+
+            // douglas-peucker approximation
+            if (threadCount == 1) {
+                KeySet& keys = Scratch ().keySet;
+                keys.Reset (reducedPointCount);
+                PSIMPL_LAP(timer, reduceTime);
+                if (reducedPointCount == pointCount && !hierarchy) {
+                    DPHelper::Approximate (coords, pointCount * DIM, tol,
+                                           typename DPHelper::KeyBits (keys), Scratch ().stack, 0,
+                                           control);
+                    PSIMPL_LAP(timer, approximateTime);
+                    CopyKeys (coords, keys, result);
+                }
+                else {
+                    DPHelper::Approximate (typename DPHelper::IndexedPoints (
+                                               coords, reducedPointCount == pointCount ? 0 : indices, hierarchy),
+                                           reducedPointCount * DIM, tol,
+                                           typename DPHelper::KeyBits (keys), Scratch ().stack,
+                                           Reserve (Scratch ().coords, DPHelper::GATHER_SIZE * DIM),
+                                           control);
+                    PSIMPL_LAP(timer, approximateTime);
+                    CopyKeys (coords, indices, keys, result);
+                }
+            }
+            else if (reducedPointCount == pointCount && !hierarchy) {
+                unsigned char* keys = Reserve (Scratch ().keys, pointCount);
+                PSIMPL_LAP(timer, reduceTime);
+                DPHelper::ApproximateParallel (coords, pointCount * DIM, tol, threadCount, keys,
+                                               Scratch ().stack);
+                PSIMPL_LAP(timer, approximateTime);
+                CopyKeys (coords, keys, pointCount, result);
+            }
+            else {
+                unsigned char* keys = Reserve (Scratch ().keys, pointCount);
+                value_type* reduced = Reserve (Scratch ().coords, reducedPointCount * DIM);
+                for (ptr_diff_type p=0; p<reducedPointCount; ++p) {
+                    std::copy (coords + indices [p] * DIM, coords + (indices [p] + 1) * DIM,
+                               reduced + p * DIM);
+                }
+                PSIMPL_LAP(timer, reduceTime);
+                DPHelper::ApproximateParallel (reduced, reducedPointCount * DIM, tol, threadCount,
+                                               keys, Scratch ().stack);
+                PSIMPL_LAP(timer, approximateTime);
+                CopyKeys (reduced, keys, reducedPointCount, result);
+            }
+            PSIMPL_LAP(timer, copyTime);
+            return result;
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DP) on validated input, storing the
+            keys of the reduced polyline in the workspace key set.
+
+            \param[in] first        the first coordinate of the first polyline point
+            \param[in] pointCount   number of polyline points; at least 3
+            \param[in] tol          perpendicular (point-to-segment) distance tolerance
+            \return                 the original point index of each reduced point
+        */
+        const ptr_diff_type* DouglasPeuckerSelect (
+            InputIterator first,
+            ptr_diff_type pointCount,
+            value_type tol)
+        {
+            // radial distance routine as preprocessing, keeping track of the original indices;
+            // contiguous input is not copied
+            const value_type* coords = util::contiguous_iterator <InputIterator>::address (first);
+            value_type* reduced = coords ? 0 : Reserve (Scratch ().coords, pointCount * DIM);
+            ptr_diff_type* indices = Reserve (Scratch ().indices, pointCount);
+            ptr_diff_type reducedPointCount = RadialDistanceIndices (
+                first, pointCount, tol, reduced, indices);
+
+            // douglas-peucker approximation
+            KeySet& keys = Scratch ().keySet;
+            keys.Reset (reducedPointCount);
+            typename DPHelper::KeyBits bits (keys);
+            if (!coords) {
+                DPHelper::Approximate (reduced, reducedPointCount * DIM, tol, bits, Scratch ().stack);
+            }
+            else if (reducedPointCount == pointCount) {
+                DPHelper::Approximate (coords, pointCount * DIM, tol, bits, Scratch ().stack);
+            }
+            else {
+                DPHelper::Approximate (typename DPHelper::IndexedPoints (coords, indices),
+                                       reducedPointCount * DIM, tol, bits, Scratch ().stack,
+                                       Reserve (Scratch ().coords, DPHelper::GATHER_SIZE * DIM));
+            }
+            return indices;
+        }
+
+        /*!
+            \brief Performs Douglas-Peucker approximation (DPn) on validated input.
+
+            \param[in] first        the first coordinate of the first polyline point
+            \param[in] coordCount   number of polyline coordinates
+            \param[in] count        the maximum number of points of the simplified polyline
+            \param[out] keys        the key set of the simplified polyline
+        */
+        void DouglasPeuckerNApproximate (
+            InputIterator first,
+            ptr_diff_type coordCount,
+            unsigned count,
+            KeySet& keys)
+        {
+            // copy coords
+            value_type* coords = Reserve (Scratch ().coords, coordCount);
+            for (ptr_diff_type c=0; c<coordCount; ++c) {
+                coords [c] = *first;
+                ++first;
+            }
+
+            // douglas-peucker approximation
+            keys.Reset (coordCount / DIM);
+            DPHelper::ApproximateN (coords, coordCount, count, typename DPHelper::KeyBits (keys),
+                                    Scratch ().heap);
+        }
+
+        /*!
+            \brief Performs Visvalingam-Whyatt approximation on validated input.
+
+            \param[in] first        the first coordinate of the first polyline point
+            \param[in] pointCount   number of polyline points; at least 3
+            \param[in] count        minimum number of points to keep; at least 2
+            \param[in] area2        squared effective area tolerance
+            \param[in] result       destination of the simplified polyline
+            \return                 one beyond the last coordinate of the simplified polyline
+        */
+        OutputIterator VisvalingamWhyattApproximate (
+            InputIterator first,
+            ptr_diff_type pointCount,
+            ptr_diff_type count,
+            double area2,
+            OutputIterator result)
+        {
+            // use contiguous input in-place, copy any other input
+            PSIMPL_TIMER(timer);
+            const value_type* coords = util::contiguous_iterator <InputIterator>::address (first);
+            if (!coords) {
+                value_type* copy = Reserve (Scratch ().coords, pointCount * DIM);
+                for (ptr_diff_type c=0; c<pointCount*DIM; ++c, ++first) {
+                    copy [c] = *first;
+                }
+                coords = copy;
+            }
+            PSIMPL_LAP(timer, reduceTime);
+
+            // visvalingam-whyatt approximation
+            unsigned char* keys = Reserve (Scratch ().keys, pointCount);
+            VWHelper::Approximate (coords, pointCount, count, area2, keys,
+                                   Reserve (Scratch ().links, pointCount * 2),
+                                   Reserve (Scratch ().queue, pointCount),
+                                   Reserve (Scratch ().positions, pointCount));
+            PSIMPL_LAP(timer, approximateTime);
+
+            // copy keys
+            CopyKeys (coords, keys, pointCount, result);
+            PSIMPL_LAP(timer, copyTime);
+            return result;
+        }
+
+        /*!
+            \brief Checks the requirements of ComputeNearestErrors2 on both coordinate counts.
+        */
+        static bool ValidPolylines (
+            diff_type original_coordCount,
+            diff_type simplified_coordCount)
+        {
+            return DIM && original_coordCount % DIM == 0 && simplified_coordCount % DIM == 0 &&
+                   2 * DIM <= original_coordCount && 2 * DIM <= simplified_coordCount;
+        }
+
+        /*!
+            \brief Returns an array with the coordinates of a polyline.
+
+            Contiguous input is used directly; other input is copied to the workspace.
+
+            \param[in] first        the first coordinate of the first polyline point
+            \param[in] coordCount   number of coordinates of the polyline
+            \return                 array of coordCount polyline coordinates
+        */
+        const value_type* PolylineCoords (
+            InputIterator first,
+            diff_type coordCount)
+        {
+            const value_type* coords = util::contiguous_iterator <InputIterator>::address (first);
+            if (coords) {
+                return coords;
+            }
+            value_type* copy = Reserve (Scratch ().coords, coordCount);
+            for (diff_type c=0; c<coordCount; ++c, ++first) {
+                copy [c] = *first;
+            }
+            return copy;
+        }
+
+        /*!
+            \brief Returns the largest squared distance of the points [first, last) to the
+            polyline that starts at polyline_first.
+
+            \sa ComputeHausdorffDistance
+        */
+        value_type MaxNearestDistance2 (
+            InputIterator first,
+            InputIterator last,
+            InputIterator polyline_first,
+            diff_type polyline_coordCount)
+        {
+            SegmentTree tree (PolylineCoords (polyline_first, polyline_coordCount),
+                              polyline_coordCount / DIM, Scratch ().bounds, Scratch ().nodes);
+            ptr_diff_type segment = 0;
+            value_type point [DIM];
+            value_type max2 = 0;
+            while (first != last) {
+                for (unsigned d = 0; d < DIM; ++d, ++first) {
+                    point [d] = *first;
+                }
+                max2 = std::max (max2, tree.Nearest (point, segment));
+            }
+            return max2;
+        }
+
+        /*!
+            \brief Returns the workspace that provides all temporary buffers.
+        */
+        Workspace <value_type>& Scratch () {
+            return external ? *external : workspace;
+        }
+
+        /*!
+            \brief Makes a control available to the internal routines, while it is in scope.
+        */
+        class ControlScope
+        {
+        public:
+            ControlScope (SimplificationControl*& current, SimplificationControl& control) :
+                current (current)
+            {
+                control.Start ();
+                current = &control;
+            }
+
+            ~ControlScope () {
+                current->Finish ();
+                current = 0;
+            }
+
+        private:
+            SimplificationControl*& current;
+        };
+
+        /*!
+            \brief Returns a workspace buffer that holds at least count elements.
+
+            The buffer only grows, so that repeated calls are free of heap allocations once the
+            largest polyline has been processed.
+        */
+        template <class T>
+        static T* Reserve (
+            std::vector <T>& buffer,
+            ptr_diff_type count)
+        {
+            if (buffer.size () < static_cast <std::size_t> (count)) {
+                PSIMPL_COUNT(scratchBytes, (count - buffer.size ()) * sizeof (T));
+                buffer.resize (count);
+            }
+            return buffer.data ();
+        }
+
+        /*!
+            \brief Records the size of the selection of a two-phase simplification.
+
+            In case the input range is invalid, the selection is the entire input range.
+
+            \param[in] coordCount   the number of coordinates of the input range
+            \param[in] keyCount     the number of selected point indices
+            \return                 the number of coordinates of the simplified polyline
+        */
+        std::size_t Select (
+            diff_type coordCount,
+            ptr_diff_type keyCount)
+        {
+            Scratch ().selectionSize = (!DIM || coordCount % DIM)
+                                       ? static_cast <std::size_t> (coordCount)
+                                       : static_cast <std::size_t> (keyCount * DIM);
+            return Scratch ().selectionSize;
+        }
+
+        /*!
+            \brief Copies the key to the output destination, and increments the iterator.
+
+            \sa CopyKey
+
+            \param[in,out] key      the first coordinate of the key
+            \param[in,out] result   destination of the copied key
+        */
+        inline void CopyKeyAdvance (
+            InputIterator& key,
+            OutputIterator& result)
+        {
+            for (unsigned d = 0; d < DIM; ++d) {
+                *result = *key;
+                ++result;
+                ++key;
+            }
+        }
+
+        /*!
+            \brief Copies the key to the output destination.
+
+            \sa CopyKeyAdvance
+
+            \param[in]     key      the first coordinate of the key
+            \param[in,out] result   destination of the copied key
+        */
+        inline void CopyKey (
+            InputIterator key,
+            OutputIterator& result)
+        {
+            CopyKeyAdvance (key, result);
+        }
+
+        /*!
+            \brief Copies all points of an array that are marked as key to the output destination.
+
+            \param[in]     coords       array of polyline coordinates
+            \param[in]     keys         indicates for each polyline point if it is a key
+            \param[in]     pointCount   number of points in coords []
+            \param[in,out] result       destination of the copied keys
+        */
+        inline void CopyKeys (
+            const value_type* coords,
+            const unsigned char* keys,
+            ptr_diff_type pointCount,
+            OutputIterator& result)
+        {
+            for (ptr_diff_type p=0; p<pointCount; ++p, coords += DIM) {
+                if (keys [p]) {
+                    for (unsigned d = 0; d < DIM; ++d) {
+                        *result = coords [d];
+                        ++result;
+                    }
+                }
+            }
+        }
+
+        /*!
+            \brief Copies all points of an array that are in a key set to the output destination.
+
+            \param[in]     coords       array of polyline coordinates
+            \param[in]     keys         indicates for each polyline point if it is a key
+            \param[in,out] result       destination of the copied keys
+        */
+        inline void CopyKeys (
+            const value_type* coords,
+            const KeySet& keys,
+            OutputIterator& result)
+        {
+            keys.ForEach ([&] (std::size_t p) {
+                CopyPoint (coords + p * DIM, result);
+            });
+        }
+
+        /*!
+            \brief Copies all selected points of an array that are in a key set to the output
+            destination.
+
+            \param[in]     coords       array of polyline coordinates
+            \param[in]     indices      point index into coords [] of each selected point
+            \param[in]     keys         indicates for each selected point if it is a key
+            \param[in,out] result       destination of the copied keys
+        */
+        inline void CopyKeys (
+            const value_type* coords,
+            const ptr_diff_type* indices,
+            const KeySet& keys,
+            OutputIterator& result)
+        {
+            keys.ForEach ([&] (std::size_t p) {
+                CopyPoint (coords + indices [p] * DIM, result);
+            });
+        }
+
+        /*!
+            \brief Copies the error of each segment that starts at a key to the output destination.
+
+            \param[in]     keys         indicates for each polyline point if it is a key
+            \param[in]     errors       for each key the maximum squared distance of its segment
+            \param[in]     pointCount   number of points in keys []
+            \param[in,out] result       destination of the copied errors
+        */
+        template <class ErrorIterator>
+        static void CopyKeyErrors (
+            const unsigned char* keys,
+            const value_type* errors,
+            ptr_diff_type pointCount,
+            ErrorIterator& result)
+        {
+            // the last point is a key that does not start a segment
+            for (ptr_diff_type p=0; p<pointCount-1; ++p) {
+                if (keys [p]) {
+                    *result = errors [p];
+                    ++result;
+                }
+            }
+        }
+
+        /*!
+            \brief Copies a zero error for each segment between the complete points of the input.
+
+            \param[in]     pointCount   number of complete points
+            \param[in,out] result       destination of the copied errors
+        */
+        template <class ErrorIterator>
+        static void CopyZeroErrors (
+            diff_type pointCount,
+            ErrorIterator& result)
+        {
+            for (diff_type p=1; p<pointCount; ++p) {
+                *result = 0;
+                ++result;
+            }
+        }
+
+        /*!
+            \brief Copies the point from an array to the output destination.
+
+            \param[in]     point    the first coordinate of the point
+            \param[in,out] result   destination of the copied point
+        */
+        static void CopyPoint (
+            const value_type* point,
+            OutputIterator& result)
+        {
+            for (unsigned d = 0; d < DIM; ++d) {
+                *result = point [d];
+                ++result;
+            }
+        }
+
+        /*!
+            \brief Copies the point to an array, and increments both the iterator and the pointer.
+
+            \param[in,out] point    the first coordinate of the point
+            \param[in,out] result   destination of the copied point
+        */
+        static void CopyPointAdvance (
+            InputIterator& point,
+            value_type*& result)
+        {
+            for (unsigned d = 0; d < DIM; ++d) {
+                *result++ = *point;
+                ++point;
+            }
+        }
+
+        /*!
+            \brief Copies the indices [0, pointCount) to the output destination.
+
+            \param[in] pointCount   number of indices to copy
+            \param[in] result       destination of the copied indices
+            \return                 one beyond the last copied index
+        */
+        template <class IndexIterator>
+        static IndexIterator CopyIndices (
+            diff_type pointCount,
+            IndexIterator result)
+        {
+            for (diff_type p=0; p<pointCount; ++p) {
+                *result = p;
+                ++result;
+            }
+            return result;
+        }
+
+        /*!
+            \brief Performs the (radial) distance between points routine (RD) on a valid polyline,
+            storing the original point index of each key.
+
+            The keys are identical to those of RadialDistance.
+
+            \param[in]  first        the first coordinate of the first polyline point
+            \param[in]  pointCount   number of polyline points; at least 2
+            \param[in]  tol          radial (point-to-point) distance tolerance
+            \param[out] reduced      [optional] destination of the key coordinates
+            \param[out] indices      destination of the point index of each key
+            \return                  the number of keys
+        */
+        ptr_diff_type RadialDistanceIndices (
+            InputIterator first,
+            diff_type pointCount,
+            value_type tol,
+            value_type* reduced,
+            ptr_diff_type* indices)
+        {
+            value_type tol2 = tol * tol;    // squared distance tolerance
+            ptr_diff_type keyCount = 0;
+
+            InputIterator current = first;  // indicates the current key
+            InputIterator next = first;     // used to find the next key
+
+            // the first point is always part of the simplification
+            indices [keyCount++] = 0;
+            if (reduced) {
+                CopyPointAdvance (next, reduced);
+            }
+            else {
+                Advance (next);
+            }
+
+            // Skip first and last point, because they are always part of the simplification
+            for (diff_type index = 1; index < pointCount - 1; ++index) {
+                if (math::point_distance2 <DIM> (current, next) < tol2) {
+                    Advance (next);
+                    continue;
+                }
+                current = next;
+                indices [keyCount++] = index;
+                if (reduced) {
+                    CopyPointAdvance (next, reduced);
+                }
+                else {
+                    Advance (next);
+                }
+            }
+            // the last point is always part of the simplification
+            indices [keyCount++] = pointCount - 1;
+            if (reduced) {
+                CopyPointAdvance (next, reduced);
+            }
+
+            return keyCount;
+        }
+
+        /*!
+            \brief Performs the nth point routine (NP) in a single pass over the input.
+
+            The keys are identical to those of NthPoint.
+        */
+        OutputIterator NthPointSinglePass (
+            InputIterator first,
+            InputIterator last,
+            unsigned n,
+            OutputIterator result)
+        {
+            if (!DIM || n < 2) {
+                return std::copy (first, last, result);
+            }
+            ptr_diff_type keyCount = 0;
+            diff_type pointCount = 0;
+            InputIterator point = first;    // the current point
+            InputIterator next = first;     // the point after the current point
+
+            for (; next != last; ++pointCount) {
+                point = next;
+                if (!NextPoint (next, last)) {
+                    return std::copy (first, last, result);
+                }
+                // the first and each nth point are part of the simplification
+                if (pointCount % n == 0) {
+                    BufferKey (point, keyCount);
+                }
+            }
+            if (pointCount < 3) {
+                return std::copy (first, last, result);
+            }
+            // the last point is always part of the simplification
+            if ((pointCount - 1) % n) {
+                BufferKey (point, keyCount);
+            }
+            return CopyBufferedKeys (keyCount, result);
+        }
+
+        /*!
+            \brief Performs the (radial) distance between points routine (RD) in a single pass
+            over the input.
+
+            The keys are identical to those of RadialDistance.
+        */
+        OutputIterator RadialDistanceSinglePass (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            OutputIterator result)
+        {
+            value_type tol2 = tol * tol;    // squared distance tolerance
+            if (!DIM || tol2 == 0) {
+                return std::copy (first, last, result);
+            }
+            ptr_diff_type keyCount = 0;
+            diff_type pointCount = 0;
+            InputIterator current = first;  // indicates the current key
+            InputIterator point = first;    // the current point
+            InputIterator next = first;     // the point after the current point
+
+            for (; next != last; ++pointCount) {
+                point = next;
+                if (!NextPoint (next, last)) {
+                    return std::copy (first, last, result);
+                }
+                // the first and last point are always part of the simplification
+                if (pointCount == 0 || next == last ||
+                    !(math::point_distance2 <DIM> (current, point) < tol2))
+                {
+                    current = point;
+                    BufferKey (point, keyCount);
+                }
+            }
+            if (pointCount < 3) {
+                return std::copy (first, last, result);
+            }
+            return CopyBufferedKeys (keyCount, result);
+        }
+
+        /*!
+            \brief Performs the perpendicular distance routine (PD) in a single pass over the
+            input.
+
+            The keys are identical to those of PerpendicularDistance. Each point p2 completes the
+            triple (p0, p1, p2) that PerpendicularDistance tests. When p1 is removed, p2 becomes
+            the next key and the next point starts a new triple.
+        */
+        OutputIterator PerpendicularDistanceSinglePass (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            OutputIterator result)
+        {
+            value_type tol2 = tol * tol;    // squared distance tolerance
+            if (!DIM || tol2 == 0) {
+                return std::copy (first, last, result);
+            }
+            ptr_diff_type keyCount = 0;
+            diff_type pointCount = 0;
+            InputIterator p0 = first;       // the current key
+            InputIterator p1 = first;       // the point to test, if any
+            bool p1Defined = false;
+            InputIterator next = first;     // the point after the current point
+
+            for (; next != last; ++pointCount) {
+                InputIterator p2 = next;
+                if (!NextPoint (next, last)) {
+                    return std::copy (first, last, result);
+                }
+                if (pointCount == 0) {
+                    // the first point is always part of the simplification
+                    BufferKey (p2, keyCount);
+                }
+                else if (!p1Defined) {
+                    p1 = p2;
+                    p1Defined = true;
+                }
+                // test p1 against line segment S(p0, p2)
+                else if (math::segment_distance2 <DIM, Precision> (p0, p2, p1) < tol2) {
+                    BufferKey (p2, keyCount);
+                    p0 = p2;
+                    p1Defined = false;
+                }
+                else {
+                    BufferKey (p1, keyCount);
+                    p0 = p1;
+                    p1 = p2;
+                }
+            }
+            if (pointCount < 3) {
+                return std::copy (first, last, result);
+            }
+            // make sure the last point is part of the simplification
+            if (p1Defined) {
+                BufferKey (p1, keyCount);
+            }
+            return CopyBufferedKeys (keyCount, result);
+        }
+
+        /*!
+            \brief Performs Reumann-Witkam approximation (RW) in a single pass over the input.
+
+            The keys are identical to those of ReumannWitkam.
+        */
+        OutputIterator ReumannWitkamSinglePass (
+            InputIterator first,
+            InputIterator last,
+            value_type tol,
+            OutputIterator result)
+        {
+            value_type tol2 = tol * tol;    // squared distance tolerance
+            if (!DIM || tol2 == 0) {
+                return std::copy (first, last, result);
+            }
+            ptr_diff_type keyCount = 0;
+            diff_type pointCount = 0;
+            InputIterator p0 = first;       // indicates the current key
+            InputIterator p1 = first;       // indicates the next point after p0
+            InputIterator pi = first;       // the previous test point
+            InputIterator pj = first;       // the current test point (pi+1)
+            InputIterator next = first;     // the point after the current test point
+
+            for (; next != last; ++pointCount, pi = pj) {
+                pj = next;
+                if (!NextPoint (next, last)) {
+                    return std::copy (first, last, result);
+                }
+                if (pointCount == 0) {
+                    // the first point is always part of the simplification
+                    BufferKey (pj, keyCount);
+                    continue;
+                }
+                if (pointCount == 1) {
+                    // define the line L(p0, p1)
+                    p1 = pj;
+                    continue;
+                }
+                // check each point pj against L(p0, p1)
+                if (!(math::line_distance2 <DIM, Precision> (p0, p1, pj) < tol2)) {
+                    // found the next key at pi
+                    BufferKey (pi, keyCount);
+                    // define new line L(pi, pj)
+                    p0 = pi;
+                    p1 = pj;
+                }
+            }
+            if (pointCount < 3) {
+                return std::copy (first, last, result);
+            }
+            // the last point is always part of the simplification
+            BufferKey (pj, keyCount);
+            return CopyBufferedKeys (keyCount, result);
+        }
+
+        /*!
+            \brief Performs Opheim approximation (OP) in a single pass over the input.
+
+            The keys are identical to those of Opheim.
+        */
+        OutputIterator OpheimSinglePass (
+            InputIterator first,
+            InputIterator last,
+            value_type min_tol,
+            value_type max_tol,
+            OutputIterator result)
+        {
+            value_type min_tol2 = min_tol * min_tol;    // squared minimum distance tolerance
+            value_type max_tol2 = max_tol * max_tol;    // squared maximum distance tolerance
+            if (!DIM || min_tol2 == 0 || max_tol2 == 0) {
+                return std::copy (first, last, result);
+            }
+            ptr_diff_type keyCount = 0;
+            diff_type pointCount = 0;
+            InputIterator r0 = first;       // indicates the current key and start of the ray
+            InputIterator r1 = first;       // indicates a point on the ray
+            bool rayDefined = false;
+            InputIterator pi = first;       // the previous test point
+            InputIterator pj = first;       // the current test point (pi+1)
+            InputIterator next = first;     // the point after the current test point
+
+            for (; next != last; ++pointCount, pi = pj) {
+                pj = next;
+                if (!NextPoint (next, last)) {
+                    return std::copy (first, last, result);
+                }
+                if (pointCount == 0) {
+                    // the first point is always part of the simplification
+                    BufferKey (pj, keyCount);
+                    continue;
+                }
+                if (pointCount == 1) {
+                    continue;
+                }
+                if (!rayDefined) {
+                    // discard each point within minimum tolerance
+                    if (math::point_distance2 <DIM> (r0, pj) < min_tol2) {
+                        continue;
+                    }
+                    // the last point within minimum tolerance pi defines the ray R(r0, r1)
+                    r1 = pi;
+                    rayDefined = true;
+                }
+                // check each point pj against R(r0, r1)
+                if (math::point_distance2 <DIM> (r0, pj) < max_tol2 &&
+                    math::ray_distance2 <DIM, Precision> (r0, r1, pj) < min_tol2)
+                {
+                    continue;
+                }
+                // found the next key at pi
+                BufferKey (pi, keyCount);
+                // define new ray R(pi, pj)
+                r0 = pi;
+                rayDefined = false;
+            }
+            if (pointCount < 3) {
+                return std::copy (first, last, result);
+            }
+            // the last point is always part of the simplification
+            BufferKey (pj, keyCount);
+            return CopyBufferedKeys (keyCount, result);
+        }
+
+        /*!
+            \brief Increments the iterator by one point, without passing last.
+
+            \param[in,out] it      iterator to be advanced; not equal to last
+            \param[in]     last    one beyond the last coordinate of the polyline
+            \return                false when last was reached before the point was complete
+        */
+        inline bool NextPoint (
+            InputIterator& it,
+            InputIterator last)
+        {
+            for (unsigned d = 0; d < DIM; ++d) {
+                if (it == last) {
+                    return false;
+                }
+                ++it;
+            }
+            return true;
+        }
+
+        /*!
+            \brief Appends the key to the key buffer of the workspace.
+
+            \param[in]     key          the first coordinate of the key
+            \param[in,out] keyCount     number of buffered keys
+        */
+        void BufferKey (
+            InputIterator key,
+            ptr_diff_type& keyCount)
+        {
+            std::vector <value_type>& buffer = Scratch ().coords;
+            std::size_t end = static_cast <std::size_t> (keyCount + 1) * DIM;
+            if (buffer.size () < end) {
+                buffer.resize (std::max (end, 2 * buffer.size ()));
+            }
+            value_type* coords = buffer.data () + keyCount * DIM;
+            for (unsigned d = 0; d < DIM; ++d, ++key) {
+                coords [d] = *key;
+            }
+            ++keyCount;
+        }
+
+        /*!
+            \brief Copies the buffered keys to the output destination.
+
+            \param[in] keyCount     number of buffered keys
+            \param[in] result       destination of the keys
+            \return                 one beyond the last coordinate of the copied keys
+        */
+        OutputIterator CopyBufferedKeys (
+            ptr_diff_type keyCount,
+            OutputIterator result)
+        {
+            const value_type* coords = Scratch ().coords.data ();
+            return std::copy (coords, coords + keyCount * DIM, result);
+        }
+
+        /*!
+            \brief Increments the iterator by n points.
+
+            \sa AdvanceCopy
+
+            \param[in,out] it  iterator to be advanced
+            \param[in]     n   number of points to advance
+        */
+        inline void Advance (
+            InputIterator& it,
+            diff_type n = 1)
+        {
+            std::advance (it, n * static_cast <diff_type> (DIM));
+        }
+        
+        /*!
+            \brief Increments a copy of the iterator by n points.
+
+            \sa Advance
+
+            \param[in] it   iterator to be advanced
+            \param[in] n    number of points to advance
+            \return         an incremented copy of the input iterator
+        */
+        inline InputIterator AdvanceCopy (
+            InputIterator it,
+            diff_type n = 1)
+        {
+            Advance (it, n);
+            return it;
+        }
+
+        /*!
+            \brief Increments the iterator by n points if possible.
+
+            If there are fewer than n point remaining the iterator will be incremented to the last
+            point.
+
+            \param[in,out] it           iterator to be advanced
+            \param[in]     n            number of points to advance
+            \param[in,out] remaining    number of points remaining after it
+            \return                     the actual amount of points that the iterator advanced
+        */
+        inline unsigned Forward (
+            InputIterator& it,
+            unsigned n,
+            unsigned& remaining)
+        {
+            n = std::min (n, remaining);
+            Advance (it, n);
+            remaining -= n;
+            return n;
+        }
+
+    private:
+        /*!
+            \brief Douglas-Peucker approximation helper class.
+
+            Contains helper implentations for Douglas-Peucker approximation that operate solely on
+            value_type arrays and value_type pointers. Note that the PolylineSimplification
+            class only operates on iterators.
+        */
+        class DPHelper
+        {
+            typedef typename Workspace <value_type>::SubPoly SubPoly;
+            typedef typename Workspace <value_type>::KeyInfo KeyInfo;
+            typedef typename Workspace <value_type>::SubPolyAlt SubPolyAlt;
+
+        public:
+            //! \brief LIFO job-queue containing sub-polylines.
+            typedef std::vector <SubPoly> Stack;
+            //! \brief Sorted (max dist2) job-queue containing sub-polylines, see Push and Pop.
+            typedef std::vector <SubPolyAlt> Heap;
+
+            /*!
+                \brief Polyline that consists of selected points of a coordinate array.
+
+                Coord index i refers to the point with index indices [i / DIM] in coords [],
+                so that the polyline can be approximated without copying its points. Without
+                indices all points are selected. The optional hierarchy must have been built for
+                coords [], and is used to search long sub polylines for their key.
+            */
+            struct IndexedPoints {
+                IndexedPoints (const value_type* coords, const ptr_diff_type* indices,
+                               const BoundingBoxHierarchy <DIM, value_type>* hierarchy=0) :
+                    coords (coords), indices (indices), hierarchy (hierarchy) {}
+
+                //! \brief Returns the first coordinate of the point at coord index i.
+                const value_type* operator [] (ptr_diff_type i) const {
+                    return indices
+                           ? coords + indices [i / DIM] * DIM
+                           : coords + i;
+                }
+
+                //! \brief Returns the index into coords [] of the selected point with index p.
+                ptr_diff_type Original (ptr_diff_type p) const {
+                    return indices ? indices [p] : p;
+                }
+
+                const value_type* coords;       //! array of all coordinates
+                const ptr_diff_type* indices;   //! [optional] point index of each selected point
+                const BoundingBoxHierarchy <DIM, value_type>* hierarchy;   //! [optional] bounding boxes of coords []
+            };
+
+            /*!
+                \brief Key bits of a KeySet, starting at a point offset.
+
+                Used like a byte array of keys, see SetKey and ClearKeys, so that the same
+                approximation routines can store their keys in either.
+            */
+            struct KeyBits {
+                explicit KeyBits (KeySet& keys, ptr_diff_type offset=0) :
+                    words (keys.words.data ()), offset (offset) {}
+
+                //! \brief Returns the key bits that start at point index p.
+                KeyBits operator + (ptr_diff_type p) const {
+                    KeyBits bits (*this);
+                    bits.offset += p;
+                    return bits;
+                }
+
+                KeySet::word_type* words;       //! the words of the key set
+                ptr_diff_type offset;           //! point index of the first key bit
+            };
+
+            //! \brief Marks point p as a key.
+            static void SetKey (unsigned char* keys, ptr_diff_type p) {
+                keys [p] = 1;
+            }
+
+            //! \brief Marks point p as a key.
+            static void SetKey (const KeyBits& keys, ptr_diff_type p) {
+                p += keys.offset;
+                keys.words [p / KeySet::WORD_BITS] |= KeySet::word_type (1) << (p % KeySet::WORD_BITS);
+            }
+
+            //! \brief Marks the first count points as no key.
+            static void ClearKeys (unsigned char* keys, ptr_diff_type count) {
+                std::fill_n (keys, count, 0);
+            }
+
+            //! \brief Marks the first count points as no key.
+            static void ClearKeys (const KeyBits& keys, ptr_diff_type count) {
+                const ptr_diff_type bits = KeySet::WORD_BITS;
+                for (ptr_diff_type p = keys.offset; p < keys.offset + count; ) {
+                    if (p % bits == 0 && p + bits <= keys.offset + count) {
+                        keys.words [p / bits] = 0;
+                        p += bits;
+                    }
+                    else {
+                        keys.words [p / bits] &= ~(KeySet::word_type (1) << (p % bits));
+                        ++p;
+                    }
+                }
+            }
+
+            /*!
+                \brief Performs Douglas-Peucker approximation.
+
+                \param[in] coords       array of polyline coordinates
+                \param[in] coordCount   number of coordinates in coords []
+                \param[in] tol          approximation tolerance
+                \param[out] keys        indicates for each polyline point if it is a key: a byte
+                                        array or KeyBits
+                \param[in] stack        scratch memory for the job queue
+                \param[out] errors      [optional] for each key the maximum squared distance of
+                                        the points of the segment that starts at that key
+                \param[in] control      [optional] stops the approximation early
+            */
+            template <class Keys>
+            static void Approximate (
+                const value_type* coords,
+                ptr_diff_type coordCount,
+                value_type tol,
+                Keys keys,
+                Stack& stack,
+                value_type* errors=0,
+                SimplificationControl* control=0)
+            {
+                value_type tol2 = tol * tol;    // squared distance tolerance
+                ptr_diff_type pointCount = coordCount / DIM;
+                // zero out keys
+                ClearKeys (keys, pointCount);
+                SetKey (keys, 0);               // the first point is always a key
+                SetKey (keys, pointCount - 1);  // the last point is always a key
+
+                ApproximateRange (coords, SubPoly (0, coordCount-DIM), tol2, keys, stack, errors, control);
+            }
+
+            //! \brief Maximum number of points of a sub polyline that is gathered into an array.
+            static const ptr_diff_type GATHER_SIZE = 4096;
+
+            /*!
+                \brief Performs Douglas-Peucker approximation on selected points.
+
+                The keys found are identical to those found by Approximate for a copy of the
+                selected points. Sub polylines of at most GATHER_SIZE points are copied to the
+                local array once, and are approximated there. Larger sub polylines are searched
+                for their key directly.
+
+                \param[in] points       the selected points
+                \param[in] coordCount   number of coordinates of the selected points
+                \param[in] tol          approximation tolerance
+                \param[out] keys        indicates for each selected point if it is a key: a byte
+                                        array or KeyBits
+                \param[in] stack        scratch memory for the job queue
+                \param[in] local        scratch memory for GATHER_SIZE points
+                \param[in] control      [optional] stops the approximation early
+            */
+            template <class Keys>
+            static void Approximate (
+                const IndexedPoints& points,
+                ptr_diff_type coordCount,
+                value_type tol,
+                Keys keys,
+                Stack& stack,
+                value_type* local,
+                SimplificationControl* control=0)
+            {
+                value_type tol2 = tol * tol;    // squared distance tolerance
+                ptr_diff_type pointCount = coordCount / DIM;
+                // zero out keys
+                ClearKeys (keys, pointCount);
+                SetKey (keys, 0);               // the first point is always a key
+                SetKey (keys, pointCount - 1);  // the last point is always a key
+
+                stack.clear ();
+                stack.push_back (SubPoly (0, coordCount-DIM));
+                PSIMPL_COUNT(stackPushes, 1);
+
+                while (!stack.empty ()) {
+                    SubPoly subPoly = stack.back ();
+                    stack.pop_back ();
+                    // sub polys are taken from first to last point
+                    if (control && control->Stop (double (subPoly.first) / double (coordCount - DIM))) {
+                        stack.clear ();
+                        return;
+                    }
+                    ptr_diff_type first = subPoly.first / DIM;
+                    ptr_diff_type count = subPoly.last / DIM - first + 1;
+                    if (count <= GATHER_SIZE) {
+                        for (ptr_diff_type p = 0; p < count; ++p) {
+                            const value_type* point = points [(first + p) * DIM];
+                            std::copy (point, point + DIM, local + p * DIM);
+                        }
+                        ApproximateRange (local, SubPoly (0, (count - 1) * DIM), tol2,
+                                          keys + first, stack);
+                        continue;
+                    }
+                    KeyInfo keyInfo = FindKey (points, subPoly.first, subPoly.last);
+                    if (keyInfo.index && tol2 < keyInfo.dist2) {
+                        SetKey (keys, keyInfo.index / DIM);
+                        PSIMPL_COUNT(keys, 1);
+                        stack.push_back (SubPoly (keyInfo.index, subPoly.last));
+                        stack.push_back (SubPoly (subPoly.first, keyInfo.index));
+                        PSIMPL_COUNT(stackPushes, 2);
+                        PSIMPL_COUNT_MAX(stackDepth, stack.size ());
+                    }
+                }
+            }
+
+            /*!
+                \brief Performs Douglas-Peucker approximation for multiple tolerances.
+
+                Stores for each point the number of tolerances for which it is a key. The key
+                of a sub polyline is kept for a tolerance when its squared distance exceeds the
+                squared tolerance, and its enclosing keys are kept as well. The enclosing keys
+                are the end points of the sub polyline, so the level of each key is bounded by
+                the levels of both end points. Sub polylines are only split while their key is
+                kept for the smallest tolerance.
+
+                \param[in] points       the polyline points: an array of coordinates, or IndexedPoints
+                \param[in] coordCount   number of coordinates of the points
+                \param[in] tol2s        levelCount squared tolerances, in increasing order
+                \param[in] levelCount   number of tolerances; at most 255
+                \param[out] levels      the level of each point
+                \param[in] stack        scratch memory for the job queue
+            */
+            template <class Points>
+            static void ApproximateLevels (
+                const Points& points,
+                ptr_diff_type coordCount,
+                const value_type* tol2s,
+                ptr_diff_type levelCount,
+                unsigned char* levels,
+                Stack& stack)
+            {
+                ptr_diff_type pointCount = coordCount / DIM;
+                std::fill_n (levels, pointCount, 0);
+                // the end points are always keys
+                levels [0] = static_cast <unsigned char> (levelCount);
+                levels [pointCount - 1] = static_cast <unsigned char> (levelCount);
+
+                stack.clear ();
+                stack.push_back (SubPoly (0, coordCount-DIM));
+                PSIMPL_COUNT(stackPushes, 1);
+
+                while (!stack.empty ()) {
+                    SubPoly subPoly = stack.back ();
+                    stack.pop_back ();
+                    KeyInfo keyInfo = FindKey (points, subPoly.first, subPoly.last);
+                    if (!keyInfo.index) {
+                        continue;
+                    }
+                    // number of tolerances smaller than the key distance
+                    unsigned char level = static_cast <unsigned char> (
+                        std::lower_bound (tol2s, tol2s + levelCount, keyInfo.dist2) - tol2s);
+                    level = std::min (level, std::min (levels [subPoly.first / DIM],
+                                                       levels [subPoly.last / DIM]));
+                    if (!level) {
+                        continue;
+                    }
+                    levels [keyInfo.index / DIM] = level;
+                    PSIMPL_COUNT(keys, 1);
+                    stack.push_back (SubPoly (keyInfo.index, subPoly.last));
+                    stack.push_back (SubPoly (subPoly.first, keyInfo.index));
+                    PSIMPL_COUNT(stackPushes, 2);
+                    PSIMPL_COUNT_MAX(stackDepth, stack.size ());
+                }
+            }
+
+            /*!
+                \brief Performs Douglas-Peucker approximation using multiple threads.
+
+                The keys found are identical to those found by Approximate. As long as there are
+                fewer sub polylines than threads, the key of each sub polyline is searched for by
+                all threads at once. The remaining sub polylines are then distributed over the
+                job queues of the threads. Each thread processes its own queue LIFO, and steals
+                the oldest (largest) job from another queue when its own queue is empty. Sub
+                polylines with fewer than GRAIN_SIZE points are processed without scheduling.
+
+                \param[in] coords       array of polyline coordinates
+                \param[in] coordCount   number of coordinates in coords []
+                \param[in] tol          approximation tolerance
+                \param[in] threadCount  number of threads to use; 0 selects the hardware concurrency
+                \param[out] keys        indicates for each polyline point if it is a key
+                \param[in] stack        scratch memory for the job queue of the calling thread
+            */
+            static void ApproximateParallel (
+                const value_type* coords,
+                ptr_diff_type coordCount,
+                value_type tol,
+                unsigned threadCount,
+                unsigned char* keys,
+                Stack& stack)
+            {
+                value_type tol2 = tol * tol;    // squared distance tolerance
+                ptr_diff_type pointCount = coordCount / DIM;
+                if (threadCount == 0) {
+                    threadCount = std::max (1u, std::thread::hardware_concurrency ());
+                }
+                if (threadCount == 1 || pointCount < 2 * GRAIN_SIZE) {
+                    Approximate (coords, coordCount, tol, keys, stack);
+                    return;
+                }
+                // zero out keys
+                std::fill_n (keys, pointCount, 0);
+                keys [0] = 1;                   // the first point is always a key
+                keys [pointCount - 1] = 1;      // the last point is always a key
+
+                // the same threads search the first keys and then process the job queues
+                WorkerPool pool (threadCount);
+
+                // split breadth first, until there is enough work for each thread
+                std::deque <SubPoly> jobs;
+                jobs.push_back (SubPoly (0, coordCount-DIM));
+
+                while (!jobs.empty () && jobs.size () < threadCount) {
+                    SubPoly subPoly = jobs.front ();
+                    jobs.pop_front ();
+                    if ((subPoly.last - subPoly.first) / DIM < GRAIN_SIZE) {
+                        ApproximateRange (coords, subPoly, tol2, keys, stack);
+                        continue;
+                    }
+                    KeyInfo keyInfo = FindKeyParallel (coords, subPoly.first, subPoly.last, pool);
+                    if (keyInfo.index && tol2 < keyInfo.dist2) {
+                        keys [keyInfo.index / DIM] = 1;
+                        PSIMPL_COUNT(keys, 1);
+                        jobs.push_back (SubPoly (subPoly.first, keyInfo.index));
+                        jobs.push_back (SubPoly (keyInfo.index, subPoly.last));
+                    }
+                }
+                if (jobs.empty ()) {
+                    return;
+                }
+
+                // distribute the remaining jobs and let the threads process them
+                Scheduler scheduler (coords, tol2, keys, threadCount);
+                for (size_t j = 0; j < jobs.size (); ++j) {
+                    scheduler.Push (j % threadCount, jobs [j]);
+                }
+                pool.Run (scheduler);
+            }
+
+            /*!
+                \brief Performs Douglas-Peucker approximation.
+
+                \param[in] points       the polyline points: an array of coordinates, or IndexedPoints
+                \param[in] coordCount   number of coordinates of the points
+                \param[in] countTol     point count tolerance
+                \param[out] keys        indicates for each polyline point if it is a key: a byte
+                                        array or KeyBits
+                \param[in] queue        scratch memory for the sorted job queue
+                \param[out] errors      [optional] for each key the maximum squared distance of
+                                        the points of the segment that starts at that key
+                \param[in] control      [optional] stops the approximation early
+            */
+            template <class Points, class Keys>
+            static void ApproximateN (
+                const Points& points,
+                ptr_diff_type coordCount,
+                unsigned countTol,
+                Keys keys,
+                Heap& queue,
+                value_type* errors=0,
+                SimplificationControl* control=0)
+            {
+                ptr_diff_type pointCount = coordCount / DIM;
+                // zero out keys
+                ClearKeys (keys, pointCount);
+                SetKey (keys, 0);               // the first point is always a key
+                SetKey (keys, pointCount - 1);  // the last point is always a key
+                unsigned keyCount = 2;
+
+                if (countTol == 2) {
+                    if (errors) {
+                        errors [0] = FindKey (points, 0, coordCount-DIM).dist2;
+                    }
+                    return;
+                }
+
+                // sorted (max dist2) job queue containing sub-polylines; each iteration adds
+                // a key and at most one sub poly, so the queue never exceeds countTol entries
+                queue.clear ();
+                queue.reserve (countTol);
+                Split (points, SubPolyAlt (0, coordCount-DIM), 0, queue, errors);  // add complete poly
+
+                // sub polys that do not precede the threshold will never be taken
+                SubPolyAlt threshold;
+                const SubPolyAlt* bound = 0;
+
+                while (!queue.empty ()) {
+                    if (control && control->Stop (double (keyCount) / countTol)) {
+                        break;
+                    }
+                    SubPolyAlt subPoly = Pop (queue);   // take a sub poly
+                    // store the key
+                    SetKey (keys, subPoly.keyInfo.index / DIM);
+                    PSIMPL_COUNT(keys, 1);
+                    // check point count tolerance
+                    keyCount++;
+                    if (keyCount == countTol) {
+                        if (errors) {
+                            // the errors of both halves, which are not split any further
+                            errors [subPoly.first / DIM] =
+                                FindKey (points, subPoly.first, subPoly.keyInfo.index).dist2;
+                            errors [subPoly.keyInfo.index / DIM] =
+                                FindKey (points, subPoly.keyInfo.index, subPoly.last).dist2;
+                        }
+                        break;
+                    }
+                    // split the polyline at the key and recurse
+                    Split (points, SubPolyAlt (subPoly.first, subPoly.keyInfo.index), bound, queue, errors);
+                    Split (points, SubPolyAlt (subPoly.keyInfo.index, subPoly.last), bound, queue, errors);
+
+                    // only the first 'remaining' sub polys can still be taken, discard the others
+                    std::size_t remaining = countTol - keyCount;
+                    if (2 * remaining < queue.size ()) {
+                        std::nth_element (queue.begin (), queue.begin () + (remaining - 1),
+                                          queue.end (), Precedes);
+                        threshold = queue [remaining - 1];
+                        bound = &threshold;
+                        queue.resize (remaining);
+                        MakeHeap (queue);
+                    }
+                }
+            }
+
+            /*!
+                \brief Ranks all points by the order in which DPn adds them to the simplification.
+
+                Performs DPn until all points are added. The first and last point receive rank
+                0 and 1, points that are never added (f.e. collinear points) receive rank
+                pointCount. The key of a sub polyline is only kept by DP, when the key that
+                created that sub polyline is kept as well. The tolerance of each key is therefore
+                the minimum of its own squared distance and the tolerance of that creating key.
+
+                \param[in] coords       array of polyline coordinates
+                \param[in] coordCount   number of coordinates in coords []
+                \param[out] ranks       for each point the order in which it is added
+                \param[out] dist2       for each point the squared tolerance up to which DP keeps it
+                \param[in] queue        scratch memory for the job queue
+            */
+            static void ApproximateRanks (
+                const value_type* coords,
+                ptr_diff_type coordCount,
+                unsigned* ranks,
+                value_type* dist2,
+                Heap& queue)
+            {
+                ptr_diff_type pointCount = coordCount / DIM;
+                std::fill_n (ranks, pointCount, static_cast <unsigned> (pointCount));
+                std::fill_n (dist2, pointCount, value_type (0));
+                ranks [0] = 0;
+                ranks [pointCount - 1] = 1;
+                dist2 [0] = dist2 [pointCount - 1] = std::numeric_limits <value_type>::max ();
+                unsigned rank = 2;
+
+                queue.clear ();
+                Split (coords, SubPolyAlt (0, coordCount-DIM), 0, queue);  // add complete poly
+
+                while (!queue.empty ()) {
+                    SubPolyAlt subPoly = Pop (queue);   // take a sub poly
+                    // the sub poly was created by the most recently added end point
+                    ptr_diff_type first = subPoly.first / DIM;
+                    ptr_diff_type last = subPoly.last / DIM;
+                    value_type creator = ranks [first] < ranks [last] ? dist2 [last] : dist2 [first];
+                    // store the key
+                    ptr_diff_type key = subPoly.keyInfo.index / DIM;
+                    ranks [key] = rank++;
+                    dist2 [key] = std::min (subPoly.keyInfo.dist2, creator);
+                    // split the polyline at the key and recurse
+                    Split (coords, SubPolyAlt (subPoly.first, subPoly.keyInfo.index), 0, queue);
+                    Split (coords, SubPolyAlt (subPoly.keyInfo.index, subPoly.last), 0, queue);
+                }
+            }
+
+            /*!
+                \brief Performs 2D Douglas-Peucker approximation using path hulls.
+
+                Each sub polyline [i, j] is represented by a path hull: the convex hulls of the
+                points [i, tag] and [tag, j], with tag the middle point. The furthest point is
+                the furthest of the two extreme points of these hulls. After splitting at a key
+                k, the path hull of the part that still contains tag is obtained by undoing the
+                hull operations that added the points beyond k. The path hull of the other part
+                is built from scratch. As this part is at most half as long, each point is added
+                to a hull O(log n) times, making the algorithm O(n log n). When a point projects
+                beyond the end points of [i, j], its segment distance may exceed the line
+                distance of the extreme points, and all hull points are tested instead. When the
+                hulls of [i, j] turn out to be invalid, [i, j] is not simple, and ApproximateRange
+                finds its keys instead.
+
+                \param[in] coords       array of 2D polyline coordinates
+                \param[in] coordCount   number of coordinates in coords []
+                \param[in] tol          approximation tolerance
+                \param[out] keys        indicates for each polyline point if it is a key
+                \param[in] stack        scratch memory for the job queue
+            */
+            static void ApproximateHull (
+                const value_type* coords,
+                ptr_diff_type coordCount,
+                value_type tol,
+                unsigned char* keys,
+                Stack& stack)
+            {
+                value_type tol2 = tol * tol;    // squared distance tolerance
+                ptr_diff_type pointCount = coordCount / DIM;
+                // zero out keys
+                std::fill_n (keys, pointCount, 0);
+                keys [0] = 1;                   // the first point is always a key
+                keys [pointCount - 1] = 1;      // the last point is always a key
+
+                PathHull hull (coords, pointCount);
+
+                // sub polylines (point indices) that still require a path hull
+                stack.clear ();
+                stack.push_back (SubPoly (0, pointCount - 1));
+                PSIMPL_COUNT(stackPushes, 1);
+
+                while (!stack.empty ()) {
+                    ptr_diff_type i = stack.back ().first;
+                    ptr_diff_type j = stack.back ().last;
+                    stack.pop_back ();
+                    if (j - i < 2) {
+                        continue;
+                    }
+                    if (!hull.Build (i, j)) {
+                        // a non-simple sub polyline: approximate it without path hulls
+                        ApproximateRange (coords, SubPoly (i * DIM, j * DIM), tol2, keys, stack);
+                        continue;
+                    }
+
+                    while (1 < j - i) {
+                        ptr_diff_type k = hull.FindFurthest (i, j);
+                        if (k < 0) {
+                            // degenerate line (i, j): search all points and rebuild both parts
+                            KeyInfo keyInfo = FindKey (coords, i * DIM, j * DIM);
+                            if (!keyInfo.index || !(tol2 < keyInfo.dist2)) {
+                                break;
+                            }
+                            k = keyInfo.index / DIM;
+                            keys [k] = 1;
+                            PSIMPL_COUNT(keys, 1);
+                            stack.push_back (SubPoly (i, k));
+                            stack.push_back (SubPoly (k, j));
+                            PSIMPL_COUNT(stackPushes, 2);
+                            PSIMPL_COUNT_MAX(stackDepth, stack.size ());
+                            break;
+                        }
+                        if (!hull.ProjectsInside (i, j)) {
+                            // a point beyond the end points may be further away from the segment
+                            k = hull.FindFurthestFromSegment (i, j);
+                        }
+                        value_type d2 = math::segment_distance2 <DIM, KeyPrecision> (
+                            coords + i * DIM, coords + j * DIM, coords + k * DIM);
+                        if (k <= i || j <= k || !(tol2 < d2)) {
+                            break;
+                        }
+                        keys [k] = 1;
+                        PSIMPL_COUNT(keys, 1);
+                        // continue with the part that contains tag, schedule the other part
+                        if (hull.Split (k)) {
+                            stack.push_back (SubPoly (i, k));
+                            PSIMPL_COUNT(stackPushes, 1);
+                            PSIMPL_COUNT_MAX(stackDepth, stack.size ());
+                            i = k;
+                        }
+                        else {
+                            stack.push_back (SubPoly (k, j));
+                            PSIMPL_COUNT(stackPushes, 1);
+                            PSIMPL_COUNT_MAX(stackDepth, stack.size ());
+                            j = k;
+                        }
+                    }
+                }
+            }
+
+        private:
+            /*!
+                \brief Path hull of a 2D sub polyline, see ApproximateHull.
+
+                Both convex hulls are maintained using Melkman's algorithm: a deque of point
+                indices with the most recently added point at both ends, in counter clockwise
+                order. Each change to a deque is recorded, such that it can be undone. Points
+                that lie on the line through an edge adjacent to the most recent point, beyond
+                that point, are considered outside the hull.
+            */
+            class PathHull
+            {
+                enum Operation { PUSH, POP_TOP, POP_BOTTOM };
+
+                //! \brief Convex hull of a path, including its history.
+                struct Hull
+                {
+                    std::vector <ptr_diff_type> deque;
+                    std::vector <ptr_diff_type> history;         //! point index of each operation
+                    std::vector <unsigned char> operations;
+                    ptr_diff_type top;                          //! deque index of the topmost point
+                    ptr_diff_type bottom;                       //! deque index of the lowest point
+                    ptr_diff_type ops;                          //! number of recorded operations
+                };
+
+            public:
+                PathHull (const value_type* coords, ptr_diff_type pointCount) :
+                    coords (coords),
+                    tag (0)
+                {
+                    // each point is pushed at most once, and popped at most once
+                    for (unsigned h = 0; h < 2; ++h) {
+                        hulls [h].deque.resize (2 * pointCount + 1);
+                        hulls [h].history.resize (2 * pointCount);
+                        hulls [h].operations.resize (2 * pointCount);
+                    }
+                }
+
+                /*!
+                    \brief Builds the path hull of the sub polyline [i, j].
+
+                    \return false when the hulls are invalid, which is only possible for
+                    non-simple sub polylines
+                */
+                bool Build (ptr_diff_type i, ptr_diff_type j) {
+                    tag = i + (j - i) / 2;
+                    Init (hulls [0], tag);
+                    for (ptr_diff_type k = tag - 1; k >= i; --k) {
+                        if (!Add (hulls [0], k)) {
+                            return false;
+                        }
+                    }
+                    Init (hulls [1], tag);
+                    for (ptr_diff_type k = tag + 1; k <= j; ++k) {
+                        if (!Add (hulls [1], k)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                /*!
+                    \brief Reduces the path hull to the part of the sub polyline that contains tag.
+
+                    \param[in] k    the point at which the sub polyline is split
+                    \return         true: the path hull represents [k, j]; false: [i, k]
+                */
+                bool Split (ptr_diff_type k) {
+                    Hull& hull = hulls [k <= tag ? 0 : 1];
+                    while (hull.ops &&
+                           !(hull.operations [hull.ops - 1] == PUSH && hull.history [hull.ops - 1] == k))
+                    {
+                        Undo (hull);
+                    }
+                    if (k == tag) {
+                        while (hull.ops) {
+                            Undo (hull);
+                        }
+                    }
+                    return k <= tag;
+                }
+
+                /*!
+                    \brief Finds the point furthest away from the line (i, j).
+
+                    \return the index of the furthest point, or -1 when i and j coincide
+                */
+                ptr_diff_type FindFurthest (ptr_diff_type i, ptr_diff_type j) const {
+                    double dx = X (j) - X (i);
+                    double dy = Y (j) - Y (i);
+                    if (dx == 0 && dy == 0) {
+                        return -1;
+                    }
+                    double d0 = 0;
+                    double d1 = 0;
+                    ptr_diff_type k0 = Extreme (hulls [0], i, dx, dy, d0);
+                    ptr_diff_type k1 = Extreme (hulls [1], i, dx, dy, d1);
+                    return d1 < d0 || (d1 == d0 && k1 < k0) ? k0 : k1;
+                }
+
+                /*!
+                    \brief Finds the point furthest away from the segment (i, j).
+
+                    The distance to a segment is a convex function, such that its maximum is
+                    found at a hull point. All hull points are tested.
+
+                    \return the index of the furthest point
+                */
+                ptr_diff_type FindFurthestFromSegment (ptr_diff_type i, ptr_diff_type j) const {
+                    ptr_diff_type key = i;
+                    value_type max = 0;
+                    for (unsigned h = 0; h < 2; ++h) {
+                        const Hull& hull = hulls [h];
+                        for (ptr_diff_type v = hull.bottom; v < hull.top; ++v) {
+                            ptr_diff_type p = hull.deque [v];
+                            value_type d2 = math::segment_distance2 <DIM, KeyPrecision> (
+                                coords + i * DIM, coords + j * DIM, coords + p * DIM);
+                            if (max < d2 || (max == d2 && key < p)) {
+                                key = p;
+                                max = d2;
+                            }
+                        }
+                    }
+                    return key;
+                }
+
+                /*!
+                    \brief Determines if all points of the sub polyline [i, j] project onto the
+                    segment (i, j), such that line and segment distances are the same.
+
+                    The points with the smallest and largest projection are extreme points of
+                    the hulls, in the direction of the line and its opposite.
+                */
+                bool ProjectsInside (ptr_diff_type i, ptr_diff_type j) const {
+                    double dx = X (j) - X (i);
+                    double dy = Y (j) - Y (i);
+                    for (unsigned h = 0; h < 2; ++h) {
+                        ptr_diff_type k0 = Extreme (hulls [h], -dx, -dy);
+                        ptr_diff_type k1 = Extreme (hulls [h], dx, dy);
+                        if (dx * (X (k0) - X (i)) + dy * (Y (k0) - Y (i)) < 0 ||
+                            dx * (X (k1) - X (j)) + dy * (Y (k1) - Y (j)) > 0)
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+            private:
+                double X (ptr_diff_type p) const { return static_cast <double> (coords [p * DIM]); }
+                double Y (ptr_diff_type p) const { return static_cast <double> (coords [p * DIM + 1]); }
+
+                //! \brief (q - p) x (r - p), positive when r lies to the left of (p, q)
+                double Cross (ptr_diff_type p, ptr_diff_type q, ptr_diff_type r) const {
+                    return (X (q) - X (p)) * (Y (r) - Y (p)) - (Y (q) - Y (p)) * (X (r) - X (p));
+                }
+
+                /*!
+                    \brief Determines if r lies outside the hull, based on the edge (p, q).
+
+                    The edge is oriented counter clockwise, such that the hull lies to its left.
+                    Points on the line through (p, q) are only outside when beyond end point e.
+                */
+                bool Outside (ptr_diff_type p, ptr_diff_type q, ptr_diff_type r, ptr_diff_type e) const {
+                    double cross = Cross (p, q, r);
+                    if (cross != 0) {
+                        return cross < 0;
+                    }
+                    ptr_diff_type f = e == p ? q : p;
+                    return 0 < (X (r) - X (e)) * (X (e) - X (f)) + (Y (r) - Y (e)) * (Y (e) - Y (f));
+                }
+
+                void Init (Hull& hull, ptr_diff_type p) {
+                    hull.top = hull.bottom = static_cast <ptr_diff_type> (hull.deque.size () / 2);
+                    hull.deque [hull.top] = p;
+                    hull.ops = 0;
+                }
+
+                void Record (Hull& hull, Operation op, ptr_diff_type p) {
+                    hull.operations [hull.ops] = static_cast <unsigned char> (op);
+                    hull.history [hull.ops] = p;
+                    ++hull.ops;
+                }
+
+                /*!
+                    \brief Adds point p, which is adjacent to the most recently added point.
+
+                    Melkman's algorithm only tests the edges adjacent to the most recent point.
+                    When p lies inside both, it is skipped. For a simple polyline p then lies
+                    inside the hull. Otherwise p may lie outside some other edge. Each skipped
+                    point is therefore tested against all edges, which keeps every recorded
+                    hull equal to the convex hull of its points.
+
+                    \return false when p lies outside the hull, but was skipped
+                */
+                bool Add (Hull& hull, ptr_diff_type p) {
+                    std::vector <ptr_diff_type>& deque = hull.deque;
+                    if (hull.top == hull.bottom) {
+                        Push (hull, p);
+                        return true;
+                    }
+                    if (hull.top - hull.bottom == 2) {
+                        // segment [q, r, q] with q the most recent point: create a triangle
+                        ptr_diff_type q = deque [hull.top];
+                        ptr_diff_type r = deque [hull.bottom + 1];
+                        double cross = Cross (p, r, q);
+                        if (0 < cross) {
+                            Record (hull, POP_BOTTOM, deque [hull.bottom++]);   // [p, r, q, p]
+                        }
+                        else if (cross < 0) {
+                            Record (hull, POP_TOP, deque [hull.top--]);         // [p, q, r, p]
+                        }
+                        else if (Outside (r, q, p, q)) {
+                            Record (hull, POP_TOP, deque [hull.top--]);         // [p, r, p]
+                            Record (hull, POP_BOTTOM, deque [hull.bottom++]);
+                        }
+                        else {
+                            // p lies on the segment, unless it lies beyond r
+                            return !Outside (q, r, p, r);
+                        }
+                        Push (hull, p);
+                        return true;
+                    }
+                    // counter clockwise: deque [bottom] -> deque [bottom + 1] ... deque [top]
+                    bool top = Outside (deque [hull.top - 1], deque [hull.top], p, deque [hull.top]);
+                    bool bottom = Outside (deque [hull.bottom], deque [hull.bottom + 1], p, deque [hull.bottom]);
+                    if (!top && !bottom) {
+                        return Inside (hull, p);
+                    }
+                    // always keep at least two points
+                    while (top && hull.top - hull.bottom > 1) {
+                        Record (hull, POP_TOP, deque [hull.top--]);
+                        top = Outside (deque [hull.top - 1], deque [hull.top], p, deque [hull.top]);
+                    }
+                    while (bottom && hull.top - hull.bottom > 1) {
+                        Record (hull, POP_BOTTOM, deque [hull.bottom++]);
+                        bottom = Outside (deque [hull.bottom], deque [hull.bottom + 1], p, deque [hull.bottom]);
+                    }
+                    Push (hull, p);
+                    return true;
+                }
+
+                /*!
+                    \brief Determines if p lies inside the hull, or on its boundary.
+
+                    The hull is split into triangles that share the most recent point. The
+                    triangle that contains p, if any, is located using a binary search.
+                */
+                bool Inside (const Hull& hull, ptr_diff_type p) const {
+                    const ptr_diff_type* v = &hull.deque [hull.bottom];
+                    ptr_diff_type a = 1;
+                    ptr_diff_type b = hull.top - hull.bottom - 1;
+                    if (Cross (v [0], v [a], p) < 0 || Cross (v [0], v [b], p) > 0) {
+                        return false;
+                    }
+                    while (a + 1 < b) {
+                        ptr_diff_type c = a + (b - a) / 2;
+                        if (Cross (v [0], v [c], p) < 0) {
+                            b = c;
+                        }
+                        else {
+                            a = c;
+                        }
+                    }
+                    return !(Cross (v [a], v [b], p) < 0);
+                }
+
+                void Push (Hull& hull, ptr_diff_type p) {
+                    hull.deque [++hull.top] = p;
+                    hull.deque [--hull.bottom] = p;
+                    Record (hull, PUSH, p);
+                }
+
+                void Undo (Hull& hull) {
+                    --hull.ops;
+                    switch (hull.operations [hull.ops]) {
+                    case PUSH:
+                        --hull.top;
+                        ++hull.bottom;
+                        break;
+                    case POP_TOP:
+                        hull.deque [++hull.top] = hull.history [hull.ops];
+                        break;
+                    case POP_BOTTOM:
+                        hull.deque [--hull.bottom] = hull.history [hull.ops];
+                        break;
+                    }
+                }
+
+                /*!
+                    \brief Finds the hull point with the largest absolute distance to line (i, d).
+
+                    \param[in] hull     the convex hull to search
+                    \param[in] i        point on the line
+                    \param[in] dx       x component of the line direction
+                    \param[in] dy       y component of the line direction
+                    \param[out] dist    the absolute distance of the returned point, scaled by |d|
+                    \return             the point index of the extreme point
+                */
+                ptr_diff_type Extreme (const Hull& hull, ptr_diff_type i, double dx, double dy,
+                                       double& dist) const
+                {
+                    // extreme points in the direction of the line normal and its opposite
+                    ptr_diff_type k0 = Extreme (hull, -dy, dx);
+                    ptr_diff_type k1 = Extreme (hull, dy, -dx);
+                    double d0 = std::fabs (dx * (Y (k0) - Y (i)) - dy * (X (k0) - X (i)));
+                    double d1 = std::fabs (dx * (Y (k1) - Y (i)) - dy * (X (k1) - X (i)));
+                    if (d0 < d1 || (d0 == d1 && k0 < k1)) {
+                        dist = d1;
+                        return k1;
+                    }
+                    dist = d0;
+                    return k0;
+                }
+
+                /*!
+                    \brief Finds the hull point that is furthest in direction u.
+
+                    The hull points deque [bottom, top) form a convex polygon in counter clockwise
+                    order, closed by deque [top] == deque [bottom]. The extreme point is located
+                    using a binary search on the chains [a, b] that contain a local maximum. When
+                    the search fails, due to collinear edges or rounding, all hull points are
+                    tested.
+
+                    \param[in] hull     the convex hull to search
+                    \param[in] ux       x component of the direction
+                    \param[in] uy       y component of the direction
+                    \return             the point index of the extreme point
+                */
+                ptr_diff_type Extreme (const Hull& hull, double ux, double uy) const {
+                    const ptr_diff_type* v = &hull.deque [hull.bottom];
+                    ptr_diff_type n = hull.top - hull.bottom;
+
+                    if (n > 8) {
+                        if (Dot (ux, uy, v [0], v [1]) <= 0 && Dot (ux, uy, v [0], v [n-1]) <= 0) {
+                            return v [0];
+                        }
+                        ptr_diff_type a = 0;
+                        ptr_diff_type b = n;
+                        bool upA = Dot (ux, uy, v [0], v [1]) > 0;
+                        while (a + 1 < b) {
+                            ptr_diff_type c = a + (b - a) / 2;
+                            bool upC = Dot (ux, uy, v [c], v [c+1]) > 0;
+                            if (!upC && Dot (ux, uy, v [c-1], v [c]) >= 0) {
+                                return v [c];
+                            }
+                            // select the chain [a, c] or [c, b] that contains the maximum
+                            bool first = upA
+                                ? !upC || Dot (ux, uy, v [c], v [a]) > 0
+                                : !upC && Dot (ux, uy, v [a], v [c]) > 0;
+                            if (first) {
+                                b = c;
+                            }
+                            else {
+                                a = c;
+                                upA = upC;
+                            }
+                        }
+                    }
+                    // brute force
+                    ptr_diff_type key = v [0];
+                    double max = Dot (ux, uy, v [0], v [0]);
+                    for (ptr_diff_type h = 1; h < std::max (n, ptr_diff_type (1)); ++h) {
+                        double d = Dot (ux, uy, v [0], v [h]);
+                        if (max < d || (max == d && key < v [h])) {
+                            key = v [h];
+                            max = d;
+                        }
+                    }
+                    return key;
+                }
+
+                //! \brief u . (q - p)
+                double Dot (double ux, double uy, ptr_diff_type p, ptr_diff_type q) const {
+                    return ux * (X (q) - X (p)) + uy * (Y (q) - Y (p));
+                }
+
+            private:
+                const value_type* coords;
+                Hull hulls [2];         //! the left [i, tag] and right [tag, j] hull
+                ptr_diff_type tag;      //! point index of the middle point
+            };
+
+            //! \brief Minimum number of points of a sub polyline that is scheduled as a job.
+            static const ptr_diff_type GRAIN_SIZE = 4096;
+
+            /*!
+                \brief A fixed set of worker threads that repeatedly run a task together.
+
+                The threads are created once, and block on a condition variable between tasks.
+                Run calls task (t) once for each thread index t in [0, Size ()), where the calling
+                thread itself runs index 0, and returns when all threads have finished the task.
+            */
+            class WorkerPool
+            {
+            public:
+                explicit WorkerPool (unsigned threadCount) :
+                    context (0),
+                    invoke (0),
+                    generation (0),
+                    busy (0),
+                    stop (false)
+                {
+                    for (unsigned t = 1; t < threadCount; ++t) {
+                        threads.push_back (instrument::make_thread (&WorkerPool::Loop, this, t));
+                    }
+                }
+
+                ~WorkerPool () {
+                    {
+                        std::lock_guard <std::mutex> lock (mutex);
+                        stop = true;
+                    }
+                    start.notify_all ();
+                    for (size_t t = 0; t < threads.size (); ++t) {
+                        threads [t].join ();
+                    }
+                }
+
+                //! \brief Returns the number of threads, including the calling thread.
+                unsigned Size () const {
+                    return static_cast <unsigned> (threads.size () + 1);
+                }
+
+                template <class Task>
+                void Run (Task& task) {
+                    {
+                        std::lock_guard <std::mutex> lock (mutex);
+                        context = &task;
+                        invoke = &Invoke <Task>;
+                        busy = threads.size ();
+                        ++generation;
+                    }
+                    start.notify_all ();
+                    task (0u);
+                    std::unique_lock <std::mutex> lock (mutex);
+                    while (busy) {
+                        done.wait (lock);
+                    }
+                }
+
+            private:
+                template <class Task>
+                static void Invoke (void* task, unsigned thread) {
+                    (*static_cast <Task*> (task)) (thread);
+                }
+
+                void Loop (unsigned thread) {
+                    unsigned seen = 0;
+                    std::unique_lock <std::mutex> lock (mutex);
+                    for (;;) {
+                        while (!stop && seen == generation) {
+                            start.wait (lock);
+                        }
+                        if (stop) {
+                            return;
+                        }
+                        seen = generation;
+                        lock.unlock ();
+                        invoke (context, thread);
+                        lock.lock ();
+                        if (--busy == 0) {
+                            done.notify_one ();
+                        }
+                    }
+                }
+
+            private:
+                std::vector <std::thread> threads;
+                std::mutex mutex;                   //! protects all members below
+                std::condition_variable start;      //! signals a new task, or stop
+                std::condition_variable done;       //! signals that busy dropped to 0
+                void* context;                      //! the current task
+                void (*invoke) (void*, unsigned);   //! calls the current task
+                unsigned generation;                //! number of tasks started
+                size_t busy;                        //! number of workers still running the task
+                bool stop;
+            };
+
+            /*!
+                \brief Work-stealing scheduler for parallel Douglas-Peucker approximation.
+
+                Each thread owns a job queue. New sub polylines are pushed onto the back of the
+                queue of the thread that created them, and taken from the back by that same
+                thread. Idle threads steal from the front of the other queues, and block until a
+                job is queued when there is nothing to steal. The number of pending jobs is used
+                to detect when all work is done.
+            */
+            class Scheduler
+            {
+                //! \brief Job queue of a single thread.
+                struct Queue {
+                    std::mutex mutex;
+                    std::deque <SubPoly> jobs;
+                };
+
+            public:
+                Scheduler (const value_type* coords, value_type tol2, unsigned char* keys,
+                           unsigned threadCount) :
+                    coords (coords),
+                    tol2 (tol2),
+                    keys (keys),
+                    queues (threadCount),
+                    pending (0),
+                    queued (0)
+                {}
+
+                void Push (unsigned thread, const SubPoly& subPoly) {
+                    ++pending;
+                    {
+                        std::lock_guard <std::mutex> lock (queues [thread].mutex);
+                        queues [thread].jobs.push_back (subPoly);
+                    }
+                    ++queued;
+                    // taking the lock ensures that a thread about to wait sees the new job
+                    std::lock_guard <std::mutex> lock (idleMutex);
+                    idle.notify_one ();
+                    PSIMPL_COUNT(stackPushes, 1);
+                }
+
+                //! \brief Processes jobs until all work is done; called by each thread of a WorkerPool.
+                void operator () (unsigned thread) {
+                    Work (thread);
+                }
+
+                void Work (unsigned thread) {
+                    SubPoly subPoly;
+                    Stack stack;
+                    for (;;) {
+                        if (!Pop (thread, subPoly) && !Steal (thread, subPoly)) {
+                            std::unique_lock <std::mutex> lock (idleMutex);
+                            while (queued == 0 && 0 < pending) {
+                                idle.wait (lock);
+                            }
+                            if (pending == 0) {
+                                return;
+                            }
+                            continue;
+                        }
+                        if ((subPoly.last - subPoly.first) / DIM < GRAIN_SIZE) {
+                            ApproximateRange (coords, subPoly, tol2, keys, stack);
+                        }
+                        else {
+                            KeyInfo keyInfo = FindKey (coords, subPoly.first, subPoly.last);
+                            if (keyInfo.index && tol2 < keyInfo.dist2) {
+                                keys [keyInfo.index / DIM] = 1;
+                                PSIMPL_COUNT(keys, 1);
+                                Push (thread, SubPoly (keyInfo.index, subPoly.last));
+                                Push (thread, SubPoly (subPoly.first, keyInfo.index));
+                            }
+                        }
+                        // only mark the job as done after its children have been scheduled
+                        if (--pending == 0) {
+                            std::lock_guard <std::mutex> lock (idleMutex);
+                            idle.notify_all ();
+                        }
+                    }
+                }
+
+            private:
+                bool Pop (unsigned thread, SubPoly& subPoly) {
+                    std::lock_guard <std::mutex> lock (queues [thread].mutex);
+                    if (queues [thread].jobs.empty ()) {
+                        return false;
+                    }
+                    subPoly = queues [thread].jobs.back ();
+                    queues [thread].jobs.pop_back ();
+                    --queued;
+                    return true;
+                }
+
+                bool Steal (unsigned thread, SubPoly& subPoly) {
+                    for (size_t i = 1; i < queues.size (); ++i) {
+                        Queue& victim = queues [(thread + i) % queues.size ()];
+                        std::lock_guard <std::mutex> lock (victim.mutex);
+                        if (!victim.jobs.empty ()) {
+                            subPoly = victim.jobs.front ();
+                            victim.jobs.pop_front ();
+                            --queued;
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+            private:
+                const value_type* coords;
+                value_type tol2;
+                unsigned char* keys;
+                std::vector <Queue> queues;
+                std::atomic <ptr_diff_type> pending;   //! number of unfinished jobs
+                std::atomic <ptr_diff_type> queued;    //! number of jobs in the queues
+                std::mutex idleMutex;                  //! protects waiting on idle
+                std::condition_variable idle;          //! signals a new job, or that all work is done
+            };
+
+            /*!
+                \brief Performs Douglas-Peucker approximation on a single sub polyline.
+
+                \param[in] coords   array of polyline coordinates
+                \param[in] subPoly  the sub polyline to approximate
+                \param[in] tol2     squared approximation tolerance
+                \param[out] keys    indicates for each polyline point if it is a key: a byte array
+                                    or KeyBits
+                \param[in] stack    scratch memory for the LIFO job-queue
+                \param[out] errors  [optional] for each key the maximum squared distance of the
+                                    points of the segment that starts at that key
+                \param[in] control  [optional] stops the approximation early
+            */
+            template <class Keys>
+            static void ApproximateRange (
+                const value_type* coords,
+                SubPoly subPoly,
+                value_type tol2,
+                Keys keys,
+                Stack& stack,
+                value_type* errors=0,
+                SimplificationControl* control=0)
+            {
+                // LIFO job-queue containing sub-polylines, on top of any pending jobs
+                const std::size_t base = stack.size ();
+                const SubPoly range = subPoly;
+                stack.push_back (subPoly);      // add complete poly
+                PSIMPL_COUNT(stackPushes, 1);
+
+                while (base < stack.size ()) {
+                    subPoly = stack.back ();    // take a sub poly
+                    stack.pop_back ();          // and find its key
+                    // sub polys are taken from first to last point
+                    if (control && control->Stop (double (subPoly.first - range.first) /
+                                                  double (range.last - range.first)))
+                    {
+                        stack.resize (base);
+                        return;
+                    }
+                    KeyInfo keyInfo = FindKey (coords, subPoly.first, subPoly.last);
+                    if (keyInfo.index && tol2 < keyInfo.dist2) {
+                        // store the key if valid
+                        SetKey (keys, keyInfo.index / DIM);
+                        PSIMPL_COUNT(keys, 1);
+                        // split the polyline at the key and recurse
+                        stack.push_back (SubPoly (keyInfo.index, subPoly.last));
+                        stack.push_back (SubPoly (subPoly.first, keyInfo.index));
+                        PSIMPL_COUNT(stackPushes, 2);
+                        PSIMPL_COUNT_MAX(stackDepth, stack.size ());
+                    }
+                    else if (errors) {
+                        // the sub poly is a segment of the simplification
+                        errors [subPoly.first / DIM] = keyInfo.dist2;
+                    }
+                }
+            }
+
+            //! \brief Number of children of each node of the sorted job-queue.
+            static const std::size_t HEAP_ARITY = 4;
+
+            /*!
+                \brief Determines if a sub polyline is taken from the sorted job-queue before another.
+
+                Sub polylines are ordered by decreasing key distance. Equally distant keys are
+                ordered by their position, so the result does not depend on the heap layout.
+            */
+            static bool Precedes (const SubPolyAlt& a, const SubPolyAlt& b) {
+                return b.keyInfo.dist2 < a.keyInfo.dist2 ||
+                       (!(a.keyInfo.dist2 < b.keyInfo.dist2) && a.keyInfo.index < b.keyInfo.index);
+            }
+
+            /*!
+                \brief Finds the key of a sub polyline and adds it to the sorted job-queue.
+
+                Sub polylines without intermediate points are skipped without searching them.
+                Sub polylines that do not precede bound are not added, as they can no longer
+                contribute a key.
+
+                \param[in] points   the polyline points: an array of coordinates, or IndexedPoints
+                \param[in] subPoly  the sub polyline
+                \param[in] bound    [optional] the last sub polyline that can still be taken
+                \param[in] queue    the sorted job-queue
+                \param[out] errors  [optional] receives the key distance at the first point
+            */
+            template <class Points>
+            static void Split (
+                const Points& points,
+                SubPolyAlt subPoly,
+                const SubPolyAlt* bound,
+                Heap& queue,
+                value_type* errors=0)
+            {
+                if (subPoly.last - subPoly.first <= static_cast <ptr_diff_type> (DIM)) {
+                    if (errors) {
+                        errors [subPoly.first / DIM] = 0;
+                    }
+                    return;
+                }
+                subPoly.keyInfo = FindKey (points, subPoly.first, subPoly.last);
+                if (errors) {
+                    errors [subPoly.first / DIM] = subPoly.keyInfo.dist2;
+                }
+                if (bound && !Precedes (subPoly, *bound)) {
+                    return;
+                }
+                Push (queue, subPoly);
+            }
+
+            /*!
+                \brief Adds a sub polyline to the sorted job-queue.
+
+                The queue is a HEAP_ARITY-ary heap. Compared to a binary heap it is shallower and
+                the children of a node share cache lines, which makes Pop cheaper.
+            */
+            static void Push (Heap& queue, const SubPolyAlt& subPoly) {
+                std::size_t hole = queue.size ();
+                queue.push_back (subPoly);
+                PSIMPL_COUNT(heapPushes, 1);
+                while (hole) {
+                    std::size_t parent = (hole - 1) / HEAP_ARITY;
+                    if (!Precedes (subPoly, queue [parent])) {
+                        break;
+                    }
+                    queue [hole] = queue [parent];
+                    hole = parent;
+                }
+                queue [hole] = subPoly;
+            }
+
+            //! \brief Removes and returns the first sub polyline of the non-empty sorted job-queue.
+            static SubPolyAlt Pop (Heap& queue) {
+                SubPolyAlt top = queue.front ();
+                SubPolyAlt last = queue.back ();
+                queue.pop_back ();
+                PSIMPL_COUNT(heapPops, 1);
+                if (!queue.empty ()) {
+                    SiftDown (queue, 0, last);
+                }
+                return top;
+            }
+
+            //! \brief Reorders the sub polylines of the job-queue into a sorted job-queue.
+            static void MakeHeap (Heap& queue) {
+                if (queue.size () < 2) {
+                    return;
+                }
+                // sift down each parent, starting at the last one
+                for (std::size_t hole = (queue.size () - 2) / HEAP_ARITY + 1; hole--; ) {
+                    SiftDown (queue, hole, queue [hole]);
+                }
+            }
+
+            //! \brief Moves the hole down the sorted job-queue, until subPoly can be stored there.
+            static void SiftDown (Heap& queue, std::size_t hole, SubPolyAlt subPoly) {
+                std::size_t size = queue.size ();
+                for (;;) {
+                    std::size_t child = hole * HEAP_ARITY + 1;
+                    if (size <= child) {
+                        break;
+                    }
+                    std::size_t end = std::min (child + HEAP_ARITY, size);
+                    std::size_t best = child;
+                    for (++child; child < end; ++child) {
+                        if (Precedes (queue [child], queue [best])) {
+                            best = child;
+                        }
+                    }
+                    if (!Precedes (queue [best], subPoly)) {
+                        break;
+                    }
+                    queue [hole] = queue [best];
+                    hole = best;
+                }
+                queue [hole] = subPoly;
+            }
+
+            /*!
+                \brief Finds the key for the given sub polyline using multiple threads.
+
+                The range is split into one part per thread of the pool. Of all equally distant
+                points the last one is selected, just like FindKey does.
+
+                \sa FindKey
+            */
+            static KeyInfo FindKeyParallel (
+                const value_type* coords,
+                ptr_diff_type first,
+                ptr_diff_type last,
+                WorkerPool& pool)
+            {
+                unsigned threadCount = pool.Size ();
+                ptr_diff_type pointCount = (last - first) / DIM;
+                ptr_diff_type partSize = (pointCount + threadCount - 1) / threadCount;
+
+                std::vector <KeyInfo> partKeys (threadCount);
+                auto task = [&] (unsigned t) {
+                    ptr_diff_type partFirst = first + std::min <ptr_diff_type> (pointCount, t * partSize) * DIM;
+                    ptr_diff_type partLast = first + std::min <ptr_diff_type> (pointCount, (t + 1) * partSize) * DIM;
+                    FindKeyPart (coords, first, last, partFirst, partLast, &partKeys [t]);
+                };
+                pool.Run (task);
+
+                KeyInfo keyInfo;
+                for (unsigned t = 0; t < threadCount; ++t) {
+                    if (partKeys [t].index && keyInfo.dist2 <= partKeys [t].dist2) {
+                        keyInfo = partKeys [t];
+                    }
+                }
+                return keyInfo;
+            }
+
+            //! \brief Finds the key of segment (first, last) among the points [partFirst, partLast).
+            static void FindKeyPart (
+                const value_type* coords,
+                ptr_diff_type first,
+                ptr_diff_type last,
+                ptr_diff_type partFirst,
+                ptr_diff_type partLast,
+                KeyInfo* keyInfo)
+            {
+                partFirst = std::max <ptr_diff_type> (partFirst, first + DIM);
+                if (partLast <= partFirst) {
+                    return;
+                }
+                std::ptrdiff_t key = -1;
+                math::FarthestPoint <DIM, value_type, key_fraction_type>::Find (
+                    coords + first, coords + last, coords + partFirst, (partLast - partFirst) / DIM,
+                    key, keyInfo->dist2);
+                if (0 <= key) {
+                    keyInfo->index = partFirst + key * DIM;
+                }
+            }
+
+            /*!
+                \brief Finds the key for the given sub polyline.
+
+                Finds the point in the range [first, last] that is furthest away from the
+                segment (first, last). This point is called the key.
+
+                \param[in] coords   array of polyline coordinates
+                \param[in] first    the first coordinate of the first polyline point
+                \param[in] last     the first coordinate of the last polyline point
+                \return             the index of the key and its distance, or last when a key
+                                    could not be found
+            */
+            static KeyInfo FindKey (
+                const value_type* coords,
+                ptr_diff_type first,
+                ptr_diff_type last)
+            {
+                KeyInfo keyInfo;
+                FindKeyPart (coords, first, last, first + DIM, last, &keyInfo);
+                return keyInfo;
+            }
+
+            /*!
+                \brief Finds the key for the given sub polyline of selected points.
+
+                The key is identical to the one FindKey finds for a copy of the selected points.
+                The selected points are gathered in small blocks, that stay in cache while they
+                are searched.
+
+                \sa FindKey
+            */
+            static KeyInfo FindKey (
+                const IndexedPoints& points,
+                ptr_diff_type first,
+                ptr_diff_type last)
+            {
+                if (points.hierarchy && !std::numeric_limits <value_type>::is_integer &&
+                    HIERARCHY_SPAN <= points.Original (last / DIM) - points.Original (first / DIM))
+                {
+                    return FindKeyBounded (points, first, last);
+                }
+                if (!points.indices) {
+                    return FindKey (points.coords, first, last);
+                }
+
+                const ptr_diff_type BLOCK_SIZE = 256;   // points
+                value_type block [BLOCK_SIZE * DIM];
+
+                KeyInfo keyInfo;
+                const value_type* s1 = points [first];
+                const value_type* s2 = points [last];
+                for (ptr_diff_type i = first + DIM; i < last; i += BLOCK_SIZE * DIM) {
+                    ptr_diff_type count = std::min (BLOCK_SIZE, (last - i) / DIM);
+                    const ptr_diff_type* indices = points.indices + i / DIM;
+                    for (ptr_diff_type p = 0; p < count; ++p) {
+                        const value_type* point = points.coords + indices [p] * DIM;
+                        std::copy (point, point + DIM, block + p * DIM);
+                    }
+                    std::ptrdiff_t key = -1;
+                    math::FarthestPoint <DIM, value_type, key_fraction_type>::Find (
+                        s1, s2, block, count, key, keyInfo.dist2);
+                    if (0 <= key) {
+                        keyInfo.index = i + key * DIM;
+                    }
+                }
+                return keyInfo;
+            }
+
+            //! \brief Minimum number of points spanned by a sub polyline to use the hierarchy.
+            static const ptr_diff_type HIERARCHY_SPAN = 16 * BoundingBoxHierarchy <DIM, value_type>::LEAF_SIZE;
+
+            /*!
+                \brief Upper bound of the computed squared distances of the points in a box to a segment.
+
+                The distance to a segment is convex, so its maximum over a box is attained at one
+                of its corners. The corner distances are computed in double, and are widened by
+                the rounding errors that segment_distance2 can make in value_type and
+                fraction_type, and by the rounding up of exact integer distances. No point in the
+                box is therefore computed to be further away.
+            */
+            class SegmentBound
+            {
+            public:
+                SegmentBound (const value_type* s1, const value_type* s2) :
+                    cv (0),
+                    scale (0)
+                {
+                    for (unsigned d = 0; d < DIM; ++d) {
+                        origin [d] = s1 [d];
+                        v [d] = static_cast <double> (s2 [d]) - s1 [d];
+                        cv += v [d] * v [d];
+                        scale = std::max (scale, std::max (std::fabs (origin [d]),
+                                                           std::fabs (static_cast <double> (s2 [d]))));
+                    }
+                }
+
+                //! \brief Returns the bound for the box [box, box + DIM), [box + DIM, box + 2*DIM).
+                double Max2 (const value_type* box) const {
+                    double max2 = 0;
+                    double m = scale;
+                    for (unsigned corner = 0; corner < (1u << DIM); ++corner) {
+                        double w [DIM];     // vector s1 --> corner
+                        double cw = 0;
+                        for (unsigned d = 0; d < DIM; ++d) {
+                            double c = box [((corner >> d) & 1) ? DIM + d : d];
+                            m = std::max (m, std::fabs (c));
+                            w [d] = c - origin [d];
+                            cw += w [d] * v [d];
+                        }
+                        // distance to s1, s2 or the projection onto the segment
+                        double fraction = cw <= 0 ? 0 : cv <= cw ? 1 : cw / cv;
+                        double dist2 = 0;
+                        for (unsigned d = 0; d < DIM; ++d) {
+                            double e = w [d] - fraction * v [d];
+                            dist2 += e * e;
+                        }
+                        max2 = std::max (max2, dist2);
+                    }
+                    const double epsilon = std::max <double> (std::numeric_limits <value_type>::epsilon (),
+                                                              std::numeric_limits <double>::epsilon ());
+                    const double margin = 2 * (DIM + 2);
+                    double dist = std::sqrt (max2) + margin * (
+                        std::numeric_limits <fraction_type>::epsilon () * std::sqrt (cv) + epsilon * m);
+                    // exact integer distances are rounded up by less than 1
+                    const double roundUp = std::numeric_limits <value_type>::is_integer ? 1 : 0;
+                    return dist * dist * (1 + margin * epsilon) + roundUp;
+                }
+
+            private:
+                double origin [DIM];    //! s1
+                double v [DIM];         //! vector s1 --> s2
+                double cv;              //! squared length of v
+                double scale;           //! largest absolute coordinate of s1 and s2
+            };
+
+            /*!
+                \brief Finds the key for the given sub polyline, using the hierarchy of points.
+
+                The nodes that overlap the sub polyline are visited depth first, the child with
+                the largest distance bound first. Nodes whose bound is smaller than the distance
+                of the key found so far are skipped. Of all equally distant points the last one
+                is selected regardless of the order in which they are found, so the key is
+                identical to the one FindKey finds without hierarchy.
+
+                \sa FindKey
+            */
+            static KeyInfo FindKeyBounded (
+                const IndexedPoints& points,
+                ptr_diff_type first,
+                ptr_diff_type last)
+            {
+                typedef BoundingBoxHierarchy <DIM, value_type> Hierarchy;
+                const ptr_diff_type LEAF_SIZE = Hierarchy::LEAF_SIZE;
+                const Hierarchy& hierarchy = *points.hierarchy;
+
+                struct Node {
+                    unsigned level;
+                    ptr_diff_type index;
+                    double bound2;
+                };
+
+                const value_type* s1 = points [first];
+                const value_type* s2 = points [last];
+                SegmentBound bound (s1, s2);
+                // the selected intermediate points [selFirst, selLast), and the original
+                // points [origFirst, origLast) they span
+                ptr_diff_type selFirst = first / DIM + 1;
+                ptr_diff_type selLast = last / DIM;
+                ptr_diff_type origFirst = points.Original (selFirst);
+                ptr_diff_type origLast = points.Original (selLast - 1) + 1;
+
+                value_type block [LEAF_SIZE * DIM];
+                Node stack [2 * 8 * sizeof (ptr_diff_type)];   // at most one sibling per level
+                std::size_t size = 0;
+                Node root = { hierarchy.LevelCount () - 1, 0, std::numeric_limits <double>::max () };
+                stack [size++] = root;
+
+                KeyInfo keyInfo;
+                while (size) {
+                    Node node = stack [--size];
+                    if (node.bound2 < keyInfo.dist2) {
+                        continue;
+                    }
+                    ptr_diff_type span = LEAF_SIZE << node.level;   // points
+                    if (node.level == 0) {
+                        // the selected points of the leaf
+                        ptr_diff_type begin = std::max (origFirst, node.index * span);
+                        ptr_diff_type end = std::min (origLast, (node.index + 1) * span);
+                        const value_type* test = points.coords + begin * DIM;
+                        if (points.indices) {
+                            begin = std::lower_bound (points.indices + selFirst, points.indices + selLast,
+                                                      begin) - points.indices;
+                            end = std::lower_bound (points.indices + begin, points.indices + selLast,
+                                                    end) - points.indices;
+                            for (ptr_diff_type p = begin; p < end; ++p) {
+                                const value_type* point = points.coords + points.indices [p] * DIM;
+                                std::copy (point, point + DIM, block + (p - begin) * DIM);
+                            }
+                            test = block;
+                        }
+                        std::ptrdiff_t key = -1;
+                        value_type dist2 = keyInfo.dist2;
+                        math::FarthestPoint <DIM, value_type, key_fraction_type>::Find (
+                            s1, s2, test, end - begin, key, dist2);
+                        if (0 <= key && (keyInfo.dist2 < dist2 || keyInfo.index < (begin + key) * DIM)) {
+                            keyInfo = KeyInfo ((begin + key) * DIM, dist2);
+                        }
+                        continue;
+                    }
+                    // push the children that overlap the sub polyline, the furthest one last
+                    Node children [2];
+                    std::size_t count = 0;
+                    span /= 2;
+                    for (ptr_diff_type c = 2 * node.index; c < 2 * node.index + 2; ++c) {
+                        if (c < hierarchy.NodeCount (node.level - 1) &&
+                            c * span < origLast && origFirst < (c + 1) * span)
+                        {
+                            Node child = { node.level - 1, c, bound.Max2 (hierarchy.Box (node.level - 1, c)) };
+                            children [count++] = child;
+                        }
+                    }
+                    if (count == 2 && children [1].bound2 < children [0].bound2) {
+                        std::swap (children [0], children [1]);
+                    }
+                    for (std::size_t c = 0; c < count; ++c) {
+                        stack [size++] = children [c];
+                    }
+                }
+                return keyInfo;
+            }
+        };
+
+        /*!
+            \brief Visvalingam-Whyatt approximation helper class.
+
+            Operates solely on value_type arrays. The remaining points form a doubly linked list,
+            and the removable points are kept in an indexed binary min-heap ordered by their
+            effective area. Each heap entry knows its position, so that the neighbours of a
+            removed point are reordered in O(log n).
+        */
+        class VWHelper
+        {
+            typedef typename Workspace <value_type>::AreaInfo AreaInfo;
+
+        public:
+            /*!
+                \brief Performs Visvalingam-Whyatt approximation.
+
+                Points are removed while more than count points remain, and the smallest squared
+                effective area is smaller than area2. The end points are never removed.
+
+                \param[in] coords       array of polyline coordinates
+                \param[in] pointCount   number of points in coords []; at least 3
+                \param[in] count        minimum number of points to keep; at least 2
+                \param[in] area2        squared effective area tolerance
+                \param[out] keys        indicates for each polyline point if it is a key
+                \param[in] links        scratch memory for the previous and next point of each point
+                \param[in] queue        scratch memory for the heap of pointCount points
+                \param[in] positions    scratch memory for the heap position of each point
+            */
+            static void Approximate (
+                const value_type* coords,
+                ptr_diff_type pointCount,
+                ptr_diff_type count,
+                double area2,
+                unsigned char* keys,
+                ptr_diff_type* links,
+                AreaInfo* queue,
+                ptr_diff_type* positions)
+            {
+                Heap heap (queue, positions);
+                for (ptr_diff_type p=0; p<pointCount; ++p) {
+                    keys [p] = 1;
+                    links [2*p] = p - 1;
+                    links [2*p+1] = p + 1;
+                }
+                for (ptr_diff_type p=1; p+1<pointCount; ++p) {
+                    heap.Place (heap.size++, AreaInfo (p, Area2 (coords, p - 1, p, p + 1)));
+                }
+                heap.Make ();
+
+                ptr_diff_type remaining = pointCount;
+                while (remaining > count && heap.size && queue [0].area2 < area2) {
+                    AreaInfo removed = heap.Pop ();
+                    ptr_diff_type p = removed.index;
+                    keys [p] = 0;
+                    --remaining;
+
+                    // unlink p, and update the effective areas of its neighbours
+                    ptr_diff_type prev = links [2*p];
+                    ptr_diff_type next = links [2*p+1];
+                    links [2*prev+1] = next;
+                    links [2*next] = prev;
+                    if (prev > 0) {
+                        heap.Update (AreaInfo (prev, std::max (removed.area2,
+                            Area2 (coords, links [2*prev], prev, next))));
+                    }
+                    if (next + 1 < pointCount) {
+                        heap.Update (AreaInfo (next, std::max (removed.area2,
+                            Area2 (coords, prev, next, links [2*next+1]))));
+                    }
+                }
+            }
+
+        private:
+            /*!
+                \brief Indexed binary min-heap of points, ordered by squared effective area.
+
+                The areas are stored in the heap itself, so that comparisons do not need to look
+                up the points.
+            */
+            struct Heap
+            {
+                Heap (AreaInfo* queue, ptr_diff_type* positions) :
+                    queue (queue), positions (positions), size (0) {}
+
+                //! \brief Orders points by area; ties are broken by index, for a stable result.
+                static bool Precedes (const AreaInfo& a, const AreaInfo& b) {
+                    return a.area2 < b.area2 || (a.area2 == b.area2 && a.index < b.index);
+                }
+
+                //! \brief Moves point a up from position hole, until its parent precedes it.
+                void SiftUp (ptr_diff_type hole, const AreaInfo& a) {
+                    while (hole) {
+                        ptr_diff_type parent = (hole - 1) / 2;
+                        if (!Precedes (a, queue [parent])) {
+                            break;
+                        }
+                        Place (hole, queue [parent]);
+                        hole = parent;
+                    }
+                    Place (hole, a);
+                }
+
+                //! \brief Moves point a down from position hole, until it precedes its children.
+                void SiftDown (ptr_diff_type hole, const AreaInfo& a) {
+                    for (ptr_diff_type child = 2 * hole + 1; child < size; child = 2 * hole + 1) {
+                        if (child + 1 < size && Precedes (queue [child + 1], queue [child])) {
+                            ++child;
+                        }
+                        if (!Precedes (queue [child], a)) {
+                            break;
+                        }
+                        Place (hole, queue [child]);
+                        hole = child;
+                    }
+                    Place (hole, a);
+                }
+
+                //! \brief Reorders the points into a heap.
+                void Make () {
+                    for (ptr_diff_type i = size / 2; i-- > 0; ) {
+                        SiftDown (i, AreaInfo (queue [i]));
+                    }
+                }
+
+                //! \brief Removes and returns the first point of the non-empty heap.
+                AreaInfo Pop () {
+                    PSIMPL_COUNT(heapPops, 1);
+                    AreaInfo top = queue [0];
+                    if (--size) {
+                        SiftDown (0, AreaInfo (queue [size]));
+                    }
+                    return top;
+                }
+
+                //! \brief Changes the area of a point in the heap.
+                void Update (const AreaInfo& a) {
+                    PSIMPL_COUNT(heapPushes, 1);
+                    ptr_diff_type hole = positions [a.index];
+                    if (hole && Precedes (a, queue [(hole - 1) / 2])) {
+                        SiftUp (hole, a);
+                    }
+                    else {
+                        SiftDown (hole, a);
+                    }
+                }
+
+                void Place (ptr_diff_type hole, const AreaInfo& a) {
+                    queue [hole] = a;
+                    positions [a.index] = hole;
+                }
+
+                AreaInfo* queue;            //! point and area at each heap position
+                ptr_diff_type* positions;   //! heap position of each point
+                ptr_diff_type size;         //! number of points in the heap
+            };
+
+            /*!
+                \brief Computes the squared area of the triangle formed by three points.
+
+                The area is computed in double precision from the 2x2 minors of the vectors
+                p --> p1 and p --> p2, which avoids integer overflow, and does not suffer from
+                cancellation for thin triangles.
+
+                \param[in] coords   array of polyline coordinates
+                \param[in] p1       point index of the previous point
+                \param[in] p        point index of the triangle apex
+                \param[in] p2       point index of the next point
+                \return             the squared triangle area
+            */
+            static double Area2 (
+                const value_type* coords,
+                ptr_diff_type p1,
+                ptr_diff_type p,
+                ptr_diff_type p2)
+            {
+                double u [DIM], v [DIM];
+                for (unsigned d = 0; d < DIM; ++d) {
+                    u [d] = static_cast <double> (coords [p1 * DIM + d]) - static_cast <double> (coords [p * DIM + d]);
+                    v [d] = static_cast <double> (coords [p2 * DIM + d]) - static_cast <double> (coords [p * DIM + d]);
+                }
+                double sum = 0;
+                for (unsigned i = 0; i < DIM; ++i) {
+                    for (unsigned j = i + 1; j < DIM; ++j) {
+                        double minor = u [i] * v [j] - u [j] * v [i];
+                        sum += minor * minor;
+                    }
+                }
+                return 0.25 * sum;
+            }
+        };
+
+        /*!
+            \brief Bounding box hierarchy over the segments of a polyline, for nearest segment queries.
+
+            Consecutive segments are packed into leaves of NODE_SIZE segments, and consecutive
+            nodes into parents of NODE_SIZE nodes, up to a single root. As the segments of a
+            polyline are spatially coherent, this yields tight axis aligned boxes without any
+            sorting, so the hierarchy is built in O(m) for m segments. The boxes of all levels are
+            stored in a single array, leaves first. The children of node i of some level are the
+            nodes [i * NODE_SIZE, (i+1) * NODE_SIZE) of the level below.
+
+            A nearest segment query descends the hierarchy depth first, visiting the closest
+            child first, and skips each node whose box is not closer than the nearest segment
+            found so far. Each query starts with the distance to a given segment, f.e. the nearest
+            segment of the previous query point, which for consecutive points of a polyline often
+            leaves only a few nodes to visit.
+        */
+        class SegmentTree
+        {
+        public:
+            static const ptr_diff_type NODE_SIZE = 8;
+
+            /*!
+                \brief Builds the hierarchy.
+
+                \param[in] coords       array of polyline coordinates
+                \param[in] pointCount   number of points in coords []; at least 2
+                \param[in] bounds       scratch memory for the boxes
+                \param[in] stack        scratch memory for the traversal of the hierarchy
+            */
+            SegmentTree (
+                const value_type* coords,
+                ptr_diff_type pointCount,
+                std::vector <value_type>& bounds,
+                std::vector <ptr_diff_type>& stack) :
+                coords (coords),
+                segmentCount (pointCount - 1),
+                levelCount (0),
+                stack (stack)
+            {
+                // count the nodes of each level
+                ptr_diff_type nodeCount = 0;
+                ptr_diff_type count = segmentCount;
+                do {
+                    count = (count + NODE_SIZE - 1) / NODE_SIZE;
+                    offsets [levelCount] = nodeCount;
+                    counts [levelCount++] = count;
+                    nodeCount += count;
+                } while (1 < count);
+                boxes = Reserve (bounds, nodeCount * 2 * DIM);
+
+                // leaves: the box of each group of segments
+                for (ptr_diff_type node = 0; node < counts [0]; ++node) {
+                    ptr_diff_type first = node * NODE_SIZE;
+                    ptr_diff_type last = std::min (first + NODE_SIZE, segmentCount);
+                    value_type* box = boxes + node * 2 * DIM;
+                    std::copy (coords + first * DIM, coords + (first + 1) * DIM, box);
+                    std::copy (coords + first * DIM, coords + (first + 1) * DIM, box + DIM);
+                    for (ptr_diff_type p = first + 1; p <= last; ++p) {
+                        Extend (box, coords + p * DIM, coords + p * DIM);
+                    }
+                }
+                // parents: the box of each group of child boxes
+                for (unsigned level = 1; level < levelCount; ++level) {
+                    for (ptr_diff_type node = 0; node < counts [level]; ++node) {
+                        ptr_diff_type first = node * NODE_SIZE;
+                        ptr_diff_type last = std::min (first + NODE_SIZE, counts [level-1]);
+                        value_type* box = Box (level, node);
+                        std::copy (Box (level-1, first), Box (level-1, first) + 2 * DIM, box);
+                        for (ptr_diff_type child = first + 1; child < last; ++child) {
+                            Extend (box, Box (level-1, child), Box (level-1, child) + DIM);
+                        }
+                    }
+                }
+            }
+
+            /*!
+                \brief Finds the segment nearest to the given point.
+
+                \param[in] point        the query point
+                \param[in,out] segment  in: the segment to start with; out: the nearest segment
+                \return                 the squared distance of the point to the nearest segment
+            */
+            value_type Nearest (
+                const value_type* point,
+                ptr_diff_type& segment) const
+            {
+                value_type best = SegmentDistance2 (segment, point);
+                stack.clear ();
+                stack.push_back (levelCount - 1);   // level
+                stack.push_back (0);                // node
+
+                while (!stack.empty () && 0 < best) {
+                    ptr_diff_type node = stack.back ();
+                    stack.pop_back ();
+                    unsigned level = static_cast <unsigned> (stack.back ());
+                    stack.pop_back ();
+                    if (!(BoxDistance2 (Box (level, node), point) < best)) {
+                        continue;
+                    }
+                    ptr_diff_type first = node * NODE_SIZE;
+                    if (level == 0) {
+                        ptr_diff_type last = std::min (first + NODE_SIZE, segmentCount);
+                        for (ptr_diff_type s = first; s < last; ++s) {
+                            value_type dist2 = SegmentDistance2 (s, point);
+                            if (dist2 < best) {
+                                best = dist2;
+                                segment = s;
+                            }
+                        }
+                        continue;
+                    }
+                    // push the children that may be closer, farthest first
+                    ptr_diff_type last = std::min (first + NODE_SIZE, counts [level-1]);
+                    value_type dists [NODE_SIZE];
+                    ptr_diff_type children [NODE_SIZE];
+                    ptr_diff_type count = 0;
+                    for (ptr_diff_type child = first; child < last; ++child) {
+                        value_type dist2 = BoxDistance2 (Box (level-1, child), point);
+                        if (!(dist2 < best)) {
+                            continue;
+                        }
+                        ptr_diff_type c = count++;
+                        for (; 0 < c && dists [c-1] < dist2; --c) {
+                            dists [c] = dists [c-1];
+                            children [c] = children [c-1];
+                        }
+                        dists [c] = dist2;
+                        children [c] = child;
+                    }
+                    PSIMPL_COUNT(stackPushes, count);
+                    for (ptr_diff_type c = 0; c < count; ++c) {
+                        stack.push_back (level - 1);
+                        stack.push_back (children [c]);
+                    }
+                }
+                return best;
+            }
+
+        private:
+            //! \brief Returns the box of a node: DIM minimum followed by DIM maximum coordinates.
+            value_type* Box (unsigned level, ptr_diff_type node) const {
+                return boxes + (offsets [level] + node) * 2 * DIM;
+            }
+
+            //! \brief Grows the box, so that it contains the box [lower, upper].
+            static void Extend (value_type* box, const value_type* lower, const value_type* upper) {
+                for (unsigned d = 0; d < DIM; ++d) {
+                    box [d] = std::min (box [d], lower [d]);
+                    box [DIM + d] = std::max (box [DIM + d], upper [d]);
+                }
+            }
+
+            //! \brief Returns the squared distance of the point to the box.
+            static value_type BoxDistance2 (const value_type* box, const value_type* point) {
+                value_type dist2 = 0;
+                for (unsigned d = 0; d < DIM; ++d) {
+                    value_type diff = 0;
+                    if (point [d] < box [d]) {
+                        diff = box [d] - point [d];
+                    }
+                    else if (box [DIM + d] < point [d]) {
+                        diff = point [d] - box [DIM + d];
+                    }
+                    dist2 += diff * diff;
+                }
+                return dist2;
+            }
+
+            //! \brief Returns the squared distance of the point to a segment.
+            value_type SegmentDistance2 (ptr_diff_type segment, const value_type* point) const {
+                return math::segment_distance2 <DIM, KeyPrecision> (
+                    coords + segment * DIM, coords + (segment + 1) * DIM, point);
+            }
+
+            //! Maximum number of levels; sufficient for any segment count.
+            static const unsigned MAX_LEVELS = 32;
+
+            const value_type* coords;           //! array of polyline coordinates
+            ptr_diff_type segmentCount;         //! number of segments
+            value_type* boxes;                  //! the boxes of all nodes, leaves first
+            ptr_diff_type offsets [MAX_LEVELS]; //! index of the first node of each level
+            ptr_diff_type counts [MAX_LEVELS];  //! number of nodes of each level
+            unsigned levelCount;                //! number of levels; the last level is the root
+            std::vector <ptr_diff_type>& stack; //! pending nodes: level and node pairs
+        };
+
+    private:
+        Workspace <value_type> workspace;       //! scratch memory, kept between calls
+        Workspace <value_type>* external;       //! caller supplied scratch memory, if any
+        SimplificationControl* control;         //! control of the running routine, if any
+    };
+
+    /*!
+        \brief Performs the nth point routine (NP).
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::NthPoint.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] n        specifies 'each nth point'
+        \param[in] result   destination of the simplified polyline
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_nth_point (
+        ForwardIterator first,
+        ForwardIterator last,
+        unsigned n,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.NthPoint (first, last, n, result);
+    }
+
+    /*!
+        \brief Performs the (radial) distance between points routine (RD).
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::RadialDistance.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] tol      radial (point-to-point) distance tolerance
+        \param[in] result   destination of the simplified polyline
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_radial_distance (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.RadialDistance (first, last, tol, result);
+    }
+
+    /*!
+        \brief Repeatedly performs the perpendicular distance routine (PD).
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::PerpendicularDistance.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] tol      perpendicular (segment-to-point) distance tolerance
+        \param[in] repeat   the number of times to successively apply the PD routine.
+        \param[in] result   destination of the simplified polyline
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_perpendicular_distance (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        unsigned repeat,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.PerpendicularDistance (first, last, tol, repeat, result);
+    }
+
+    /*!
+        \brief Repeatedly performs the perpendicular distance routine (PD), using a workspace.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::PerpendicularDistance.
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] last         one beyond the last coordinate of the last polyline point
+        \param[in] tol          perpendicular (segment-to-point) distance tolerance
+        \param[in] repeat       the number of times to successively apply the PD routine.
+        \param[in] result       destination of the simplified polyline
+        \param[in] workspace    scratch memory for the temporary buffers
+        \return                 one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_perpendicular_distance (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        unsigned repeat,
+        OutputIterator result,
+        Workspace <typename std::iterator_traits <ForwardIterator>::value_type>& workspace)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps (workspace);
+        return ps.PerpendicularDistance (first, last, tol, repeat, result);
+    }
+
+    /*!
+        \brief Performs the perpendicular distance routine (PD).
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::PerpendicularDistance.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] tol      perpendicular (segment-to-point) distance tolerance
+        \param[in] result   destination of the simplified polyline
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_perpendicular_distance (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.PerpendicularDistance (first, last, tol, result);
+    }
+
+    /*!
+        \brief Performs Reumann-Witkam polyline simplification (RW).
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::ReumannWitkam.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] tol      perpendicular (point-to-line) distance tolerance
+        \param[in] result   destination of the simplified polyline
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_reumann_witkam (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.ReumannWitkam (first, last, tol, result);
+    }
+
+    /*!
+        \brief Performs Opheim polyline simplification (OP).
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::Opheim.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] min_tol  minimum distance tolerance
+        \param[in] max_tol  maximum distance tolerance
+        \param[in] result   destination of the simplified polyline
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_opheim (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type min_tol,
+        typename std::iterator_traits <ForwardIterator>::value_type max_tol,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.Opheim (first, last, min_tol, max_tol, result);
+    }
+
+    /*!
+        \brief Performs Lang polyline simplification (LA).
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::Lang.
+
+        \param[in] first      the first coordinate of the first polyline point
+        \param[in] last       one beyond the last coordinate of the last polyline point
+        \param[in] tol        perpendicular (point-to-segment) distance tolerance
+        \param[in] look_ahead defines the size of the search region
+        \param[in] result     destination of the simplified polyline
+        \return               one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_lang (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        unsigned look_ahead,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.Lang (first, last, tol, look_ahead, result);
+    }
+
+    /*!
+        \brief Performs Lang polyline simplification (LA), which can be stopped early.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::Lang.
+
+        \param[in] first      the first coordinate of the first polyline point
+        \param[in] last       one beyond the last coordinate of the last polyline point
+        \param[in] tol        perpendicular (point-to-segment) distance tolerance
+        \param[in] look_ahead defines the size of the search region
+        \param[in] result     destination of the simplified polyline
+        \param[in] control    cancels the routine and reports its progress
+        \return               one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_lang (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        unsigned look_ahead,
+        OutputIterator result,
+        SimplificationControl& control)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.Lang (first, last, tol, look_ahead, result, control);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker polyline simplification (DP).
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeucker.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] tol      perpendicular (point-to-segment) distance tolerance
+        \param[in] result   destination of the simplified polyline
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_douglas_peucker (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.DouglasPeucker (first, last, tol, result);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker approximation (DP), using a workspace.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeucker.
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] last         one beyond the last coordinate of the last polyline point
+        \param[in] tol          perpendicular (point-to-segment) distance tolerance
+        \param[in] result       destination of the simplified polyline
+        \param[in] workspace    scratch memory for the temporary buffers
+        \return                 one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_douglas_peucker (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        OutputIterator result,
+        Workspace <typename std::iterator_traits <ForwardIterator>::value_type>& workspace)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps (workspace);
+        return ps.DouglasPeucker (first, last, tol, result);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker approximation (DP), using a bounding box hierarchy.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeucker.
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] last         one beyond the last coordinate of the last polyline point
+        \param[in] tol          perpendicular (point-to-segment) distance tolerance
+        \param[in] hierarchy    the bounding box hierarchy of the polyline [first, last)
+        \param[in] result       destination of the simplified polyline
+        \return                 one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_douglas_peucker (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        const BoundingBoxHierarchy <DIM, typename std::iterator_traits <ForwardIterator>::value_type>& hierarchy,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.DouglasPeucker (first, last, tol, hierarchy, result);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker approximation (DP), which can be stopped early.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeucker.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] tol      perpendicular (point-to-segment) distance tolerance
+        \param[in] result   destination of the simplified polyline
+        \param[in] control  cancels the approximation and reports its progress
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_douglas_peucker (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        OutputIterator result,
+        SimplificationControl& control)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.DouglasPeucker (first, last, tol, result, control);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker polyline simplification (DP) using multiple threads.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerParallel.
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] last         one beyond the last coordinate of the last polyline point
+        \param[in] tol          perpendicular (point-to-segment) distance tolerance
+        \param[in] threadCount  number of threads to use; 0 selects the number of hardware threads
+        \param[in] result       destination of the simplified polyline
+        \return                 one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_douglas_peucker_parallel (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        unsigned threadCount,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.DouglasPeuckerParallel (first, last, tol, threadCount, result);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker polyline simplification (DP) in chunks of bounded size.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerChunked.
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] last         one beyond the last coordinate of the last polyline point
+        \param[in] tol          perpendicular (point-to-segment) distance tolerance
+        \param[in] chunkSize    number of points per chunk, including both anchors
+        \param[in] threadCount  number of threads to use; 0 selects the number of hardware threads
+        \param[in] result       destination of the simplified polyline
+        \return                 one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_douglas_peucker_chunked (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        std::size_t chunkSize,
+        unsigned threadCount,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.DouglasPeuckerChunked (first, last, tol, chunkSize, threadCount, result);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker polyline simplification (DP) using path hulls.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerHull.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] tol      perpendicular (point-to-segment) distance tolerance
+        \param[in] result   destination of the simplified polyline
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_douglas_peucker_hull (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.DouglasPeuckerHull (first, last, tol, result);
+    }
+
+    /*!
+        \brief Performs a variant of Douglas-Peucker polyline simplification (DPn).
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerAlt.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] count    the maximum number of points of the simplified polyline
+        \param[in] result   destination of the simplified polyline
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_douglas_peucker_n (
+        ForwardIterator first,
+        ForwardIterator last,
+        unsigned count,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.DouglasPeuckerN (first, last, count, result);
+    }
+
+    /*!
+        \brief Performs a variant of Douglas-Peucker polyline simplification (DPn), using a workspace.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerN.
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] last         one beyond the last coordinate of the last polyline point
+        \param[in] count        the maximum number of points of the simplified polyline
+        \param[in] result       destination of the simplified polyline
+        \param[in] workspace    scratch memory for the temporary buffers
+        \return                 one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_douglas_peucker_n (
+        ForwardIterator first,
+        ForwardIterator last,
+        unsigned count,
+        OutputIterator result,
+        Workspace <typename std::iterator_traits <ForwardIterator>::value_type>& workspace)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps (workspace);
+        return ps.DouglasPeuckerN (first, last, count, result);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker approximation (DPn), using a bounding box hierarchy.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerN.
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] last         one beyond the last coordinate of the last polyline point
+        \param[in] count        the maximum number of points of the simplified polyline
+        \param[in] hierarchy    the bounding box hierarchy of the polyline [first, last)
+        \param[in] result       destination of the simplified polyline
+        \return                 one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_douglas_peucker_n (
+        ForwardIterator first,
+        ForwardIterator last,
+        unsigned count,
+        const BoundingBoxHierarchy <DIM, typename std::iterator_traits <ForwardIterator>::value_type>& hierarchy,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.DouglasPeuckerN (first, last, count, hierarchy, result);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker approximation (DPn), which can be stopped early.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerN.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] count    the maximum number of points of the simplified polyline
+        \param[in] result   destination of the simplified polyline
+        \param[in] control  cancels the approximation and reports its progress
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_douglas_peucker_n (
+        ForwardIterator first,
+        ForwardIterator last,
+        unsigned count,
+        OutputIterator result,
+        SimplificationControl& control)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.DouglasPeuckerN (first, last, count, result, control);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker polyline simplification (DP), outputting point indices.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerIndices.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] tol      perpendicular (point-to-segment) distance tolerance
+        \param[in] result   destination of the indices of the simplified polyline points
+        \return             one beyond the last index of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class IndexIterator>
+    IndexIterator simplify_douglas_peucker_indices (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        IndexIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, IndexIterator, Precision> ps;
+        return ps.DouglasPeuckerIndices (first, last, tol, result);
+    }
+
+    /*!
+        \brief Performs a variant of Douglas-Peucker polyline simplification (DPn), outputting
+        point indices.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerNIndices.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] count    the maximum number of points of the simplified polyline
+        \param[in] result   destination of the indices of the simplified polyline points
+        \return             one beyond the last index of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class IndexIterator>
+    IndexIterator simplify_douglas_peucker_n_indices (
+        ForwardIterator first,
+        ForwardIterator last,
+        unsigned count,
+        IndexIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, IndexIterator, Precision> ps;
+        return ps.DouglasPeuckerNIndices (first, last, count, result);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker polyline simplification (DP), outputting a key set.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerKeys.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] tol      perpendicular (point-to-segment) distance tolerance
+        \param[out] keys    the key set of the simplified polyline
+        \return             the number of vertices of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision, class ForwardIterator>
+    std::size_t simplify_douglas_peucker_keys (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        KeySet& keys)
+    {
+        PolylineSimplification <DIM, ForwardIterator, util::counting_iterator, Precision> ps;
+        return ps.DouglasPeuckerKeys (first, last, tol, keys);
+    }
+
+    /*!
+        \brief Performs a variant of Douglas-Peucker polyline simplification (DPn), outputting a
+        key set.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerNKeys.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] count    the maximum number of points of the simplified polyline
+        \param[out] keys    the key set of the simplified polyline
+        \return             the number of vertices of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision, class ForwardIterator>
+    std::size_t simplify_douglas_peucker_n_keys (
+        ForwardIterator first,
+        ForwardIterator last,
+        unsigned count,
+        KeySet& keys)
+    {
+        PolylineSimplification <DIM, ForwardIterator, util::counting_iterator, Precision> ps;
+        return ps.DouglasPeuckerNKeys (first, last, count, keys);
+    }
+
+    /*!
+        \brief Performs the first phase of a two-phase Douglas-Peucker approximation (DP).
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::SelectDouglasPeucker. The selection is stored in the workspace,
+        from which copy_selection copies the simplified polyline.
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] last         one beyond the last coordinate of the last polyline point
+        \param[in] tol          perpendicular (point-to-segment) distance tolerance
+        \param[in] workspace    scratch memory for the temporary buffers and the selection
+        \return                 the number of coordinates of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision, class ForwardIterator>
+    std::size_t select_douglas_peucker (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        Workspace <typename std::iterator_traits <ForwardIterator>::value_type>& workspace)
+    {
+        PolylineSimplification <DIM, ForwardIterator, util::counting_iterator, Precision> ps (workspace);
+        return ps.SelectDouglasPeucker (first, last, tol);
+    }
+
+    /*!
+        \brief Performs the first phase of a two-phase Douglas-Peucker approximation (DPn).
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::SelectDouglasPeuckerN. The selection is stored in the workspace,
+        from which copy_selection copies the simplified polyline.
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] last         one beyond the last coordinate of the last polyline point
+        \param[in] count        the maximum number of points of the simplified polyline
+        \param[in] workspace    scratch memory for the temporary buffers and the selection
+        \return                 the number of coordinates of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision, class ForwardIterator>
+    std::size_t select_douglas_peucker_n (
+        ForwardIterator first,
+        ForwardIterator last,
+        unsigned count,
+        Workspace <typename std::iterator_traits <ForwardIterator>::value_type>& workspace)
+    {
+        PolylineSimplification <DIM, ForwardIterator, util::counting_iterator, Precision> ps (workspace);
+        return ps.SelectDouglasPeuckerN (first, last, count);
+    }
+
+    /*!
+        \brief Performs the second phase of a two-phase Douglas-Peucker approximation.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::CopySelection.
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] result       destination of the simplified polyline
+        \param[in] workspace    the workspace that holds the selection
+        \return                 one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class ForwardIterator, class OutputIterator>
+    OutputIterator copy_selection (
+        ForwardIterator first,
+        OutputIterator result,
+        Workspace <typename std::iterator_traits <ForwardIterator>::value_type>& workspace)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator> ps (workspace);
+        return ps.CopySelection (first, result);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker polyline simplification (DP), outputting the error of each
+        segment.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerErrors.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] tol      perpendicular (point-to-segment) distance tolerance
+        \param[in] result   destination of the simplified polyline
+        \param[in] errors   destination of the squared error of each simplified segment
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator, class ErrorIterator>
+    OutputIterator simplify_douglas_peucker_errors (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        OutputIterator result,
+        ErrorIterator errors)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.DouglasPeuckerErrors (first, last, tol, result, errors);
+    }
+
+    /*!
+        \brief Performs a variant of Douglas-Peucker polyline simplification (DPn), outputting the
+        error of each segment.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerNErrors.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] count    the maximum number of points of the simplified polyline
+        \param[in] result   destination of the simplified polyline
+        \param[in] errors   destination of the squared error of each simplified segment
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator, class ErrorIterator>
+    OutputIterator simplify_douglas_peucker_n_errors (
+        ForwardIterator first,
+        ForwardIterator last,
+        unsigned count,
+        OutputIterator result,
+        ErrorIterator errors)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.DouglasPeuckerNErrors (first, last, count, result, errors);
+    }
+
+    /*!
+        \brief Performs Douglas-Peucker polyline simplification (DP) for multiple tolerances at
+        once.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::DouglasPeuckerLevels.
+
+        Note that the RadialDistance (RD) preprocessing step is shared by all tolerances, and
+        uses the smallest one. When RD with a larger tolerance would remove more points, the
+        points whose level exceeds k may therefore differ from the result of
+        simplify_douglas_peucker for tolerance k (zero-based).
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] last         one beyond the last coordinate of the last polyline point
+        \param[in] tol_first    the smallest perpendicular (point-to-segment) distance tolerance
+        \param[in] tol_last     one beyond the largest tolerance
+        \param[in] levels       destination of the level of each point
+        \return                 one beyond the last level
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class ToleranceIterator, class LevelIterator>
+    LevelIterator simplify_douglas_peucker_levels (
+        ForwardIterator first,
+        ForwardIterator last,
+        ToleranceIterator tol_first,
+        ToleranceIterator tol_last,
+        LevelIterator levels)
+    {
+        PolylineSimplification <DIM, ForwardIterator, ForwardIterator, Precision> ps;
+        return ps.DouglasPeuckerLevels (first, last, tol_first, tol_last, levels);
+    }
+
+    /*!
+        \brief Performs Visvalingam-Whyatt polyline simplification (VW).
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::VisvalingamWhyatt.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] tol      effective (triangle) area tolerance
+        \param[in] result   destination of the simplified polyline
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_visvalingam_whyatt (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.VisvalingamWhyatt (first, last, tol, result);
+    }
+
+    /*!
+        \brief Performs Visvalingam-Whyatt polyline simplification (VW), using a workspace.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::VisvalingamWhyatt.
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] last         one beyond the last coordinate of the last polyline point
+        \param[in] tol          effective (triangle) area tolerance
+        \param[in] result       destination of the simplified polyline
+        \param[in] workspace    scratch memory for the temporary buffers
+        \return                 one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_visvalingam_whyatt (
+        ForwardIterator first,
+        ForwardIterator last,
+        typename std::iterator_traits <ForwardIterator>::value_type tol,
+        OutputIterator result,
+        Workspace <typename std::iterator_traits <ForwardIterator>::value_type>& workspace)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps (workspace);
+        return ps.VisvalingamWhyatt (first, last, tol, result);
+    }
+
+    /*!
+        \brief Performs Visvalingam-Whyatt polyline simplification (VW), keeping count points.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::VisvalingamWhyattN.
+
+        \param[in] first    the first coordinate of the first polyline point
+        \param[in] last     one beyond the last coordinate of the last polyline point
+        \param[in] count    the maximum number of points of the simplified polyline
+        \param[in] result   destination of the simplified polyline
+        \return             one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_visvalingam_whyatt_n (
+        ForwardIterator first,
+        ForwardIterator last,
+        unsigned count,
+        OutputIterator result)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.VisvalingamWhyattN (first, last, count, result);
+    }
+
+    /*!
+        \brief Performs Visvalingam-Whyatt polyline simplification (VW), keeping count points,
+        using a workspace.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::VisvalingamWhyattN.
+
+        \param[in] first        the first coordinate of the first polyline point
+        \param[in] last         one beyond the last coordinate of the last polyline point
+        \param[in] count        the maximum number of points of the simplified polyline
+        \param[in] result       destination of the simplified polyline
+        \param[in] workspace    scratch memory for the temporary buffers
+        \return                 one beyond the last coordinate of the simplified polyline
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator simplify_visvalingam_whyatt_n (
+        ForwardIterator first,
+        ForwardIterator last,
+        unsigned count,
+        OutputIterator result,
+        Workspace <typename std::iterator_traits <ForwardIterator>::value_type>& workspace)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps (workspace);
+        return ps.VisvalingamWhyattN (first, last, count, result);
+    }
+
+    /*!
+        \brief Computes the squared positional error between a polyline and its simplification.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::ComputePositionalErrors2.
+
+        \param[in] original_first   the first coordinate of the first polyline point
+        \param[in] original_last    one beyond the last coordinate of the last polyline point
+        \param[in] simplified_first the first coordinate of the first simplified polyline point
+        \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
+        \param[in] result           destination of the squared positional errors
+        \param[out] valid           [optional] indicates if the computed positional errors are valid
+        \return                     one beyond the last computed positional error
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator compute_positional_errors2 (
+        ForwardIterator original_first,
+        ForwardIterator original_last,
+        ForwardIterator simplified_first,
+        ForwardIterator simplified_last,
+        OutputIterator result,
+        bool* valid=0)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.ComputePositionalErrors2 (original_first, original_last, simplified_first, simplified_last, result, valid);
+    }
+
+    /*!
+        \brief Computes the squared positional error between a polyline and its simplification
+        using multiple threads.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::ComputePositionalErrors2Parallel.
+
+        \param[in] original_first   the first coordinate of the first polyline point
+        \param[in] original_last    one beyond the last coordinate of the last polyline point
+        \param[in] simplified_first the first coordinate of the first simplified polyline point
+        \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
+        \param[in] threadCount      number of threads to use; 0 selects the number of hardware threads
+        \param[in] result           destination of the squared positional errors
+        \param[out] valid           [optional] indicates if the computed positional errors are valid
+        \return                     one beyond the last computed positional error
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator compute_positional_errors2_parallel (
+        ForwardIterator original_first,
+        ForwardIterator original_last,
+        ForwardIterator simplified_first,
+        ForwardIterator simplified_last,
+        unsigned threadCount,
+        OutputIterator result,
+        bool* valid=0)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.ComputePositionalErrors2Parallel (original_first, original_last, simplified_first,
+                                                    simplified_last, threadCount, result, valid);
+    }
+
+    /*!
+        \brief Computes statistics for the positional errors between a polyline and its simplification.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::ComputePositionalErrorStatistics.
+
+        \param[in] original_first   the first coordinate of the first polyline point
+        \param[in] original_last    one beyond the last coordinate of the last polyline point
+        \param[in] simplified_first the first coordinate of the first simplified polyline point
+        \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
+        \param[out] valid           [optional] indicates if the computed statistics are valid
+        \return                     the computed statistics
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator>
+    math::Statistics compute_positional_error_statistics (
+        ForwardIterator original_first,
+        ForwardIterator original_last,
+        ForwardIterator simplified_first,
+        ForwardIterator simplified_last,
+        bool* valid=0)
+    {
+        PolylineSimplification <DIM, ForwardIterator, ForwardIterator, Precision> ps;
+        return ps.ComputePositionalErrorStatistics (original_first, original_last, simplified_first, simplified_last, valid);
+    }
+
+    /*!
+        \brief Computes statistics for the positional errors between a polyline and its
+        simplification, using a workspace.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::ComputePositionalErrorStatistics.
+
+        \param[in] original_first   the first coordinate of the first polyline point
+        \param[in] original_last    one beyond the last coordinate of the last polyline point
+        \param[in] simplified_first the first coordinate of the first simplified polyline point
+        \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
+        \param[in] workspace        scratch memory for the temporary buffers
+        \param[out] valid           [optional] indicates if the computed statistics are valid
+        \return                     the computed statistics
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator>
+    math::Statistics compute_positional_error_statistics (
+        ForwardIterator original_first,
+        ForwardIterator original_last,
+        ForwardIterator simplified_first,
+        ForwardIterator simplified_last,
+        Workspace <typename std::iterator_traits <ForwardIterator>::value_type>& workspace,
+        bool* valid=0)
+    {
+        PolylineSimplification <DIM, ForwardIterator, ForwardIterator, Precision> ps (workspace);
+        return ps.ComputePositionalErrorStatistics (original_first, original_last, simplified_first, simplified_last, valid);
+    }
+
+    /*!
+        \brief Computes the squared distance of each point of a polyline to the nearest segment of
+        another polyline.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::ComputeNearestErrors2.
+
+        \param[in] original_first   the first coordinate of the first polyline point
+        \param[in] original_last    one beyond the last coordinate of the last polyline point
+        \param[in] simplified_first the first coordinate of the first simplified polyline point
+        \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
+        \param[in] result           destination of the squared positional errors
+        \param[out] valid           [optional] indicates if the computed positional errors are valid
+        \return                     one beyond the last computed positional error
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator, class OutputIterator>
+    OutputIterator compute_nearest_errors2 (
+        ForwardIterator original_first,
+        ForwardIterator original_last,
+        ForwardIterator simplified_first,
+        ForwardIterator simplified_last,
+        OutputIterator result,
+        bool* valid=0)
+    {
+        PolylineSimplification <DIM, ForwardIterator, OutputIterator, Precision> ps;
+        return ps.ComputeNearestErrors2 (original_first, original_last, simplified_first, simplified_last, result, valid);
+    }
+
+    /*!
+        \brief Computes the Hausdorff distance between a polyline and its simplification.
+
+        This is a convenience function that provides template type deduction for
+        PolylineSimplification::ComputeHausdorffDistance.
+
+        \param[in] original_first   the first coordinate of the first polyline point
+        \param[in] original_last    one beyond the last coordinate of the last polyline point
+        \param[in] simplified_first the first coordinate of the first simplified polyline point
+        \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
+        \param[out] valid           [optional] indicates if the computed distance is valid
+        \return                     the Hausdorff distance
+    */
+    template <unsigned DIM, class Precision = math::float_precision,
+              class ForwardIterator>
+    double compute_hausdorff_distance (
+        ForwardIterator original_first,
+        ForwardIterator original_last,
+        ForwardIterator simplified_first,
+        ForwardIterator simplified_last,
+        bool* valid=0)
+    {
+        PolylineSimplification <DIM, ForwardIterator, ForwardIterator, Precision> ps;
+        return ps.ComputeHausdorffDistance (original_first, original_last, simplified_first, simplified_last, valid);
+    }
+
+    /*!
+        \brief Simplifies many polylines, stored in a single buffer, using multiple threads.
+
+        The polylines are stored consecutively in a single coordinate array, in which polyline
+        i consists of the coordinates [coords + offsets [i], coords + offsets [i+1]). The
+        simplified polylines are stored the same way, in result and resultOffsets. Both offsets
+        arrays contain polylineCount + 1 elements. As a simplification never contains more
+        coordinates than its polyline, the result array needs to be able to hold offsets
+        [polylineCount] coordinates.
+
+        The polylines are distributed dynamically over the threads. Each thread writes the
+        simplification of polyline i to result + offsets [i], after which all simplifications
+        are moved to their final position. Each thread uses its own PolylineSimplification
+        instance, whose scratch memory is reused for all polylines and batches. A
+        BatchSimplification instance must not be used by multiple threads at once.
+
+        Each routine returns the total number of coordinates of all simplified polylines:
+        resultOffsets [polylineCount]. See PolylineSimplification for a description of each
+        routine and its parameters. The routines that are multi-threaded themselves, and those
+        that output indices, errors or levels instead of points, are not provided.
+    */
+    template <unsigned DIM, class T>
+    class BatchSimplification
+    {
+        typedef PolylineSimplification <DIM, const T*, T*> Simplification;
+
+    public:
+        /*!
+            \param[in] threadCount  number of threads to use; 0 selects the number of hardware threads
+        */
+        BatchSimplification (unsigned threadCount = 0) :
+            simplifications (threadCount ? threadCount : std::max (1u, std::thread::hardware_concurrency ()))
+        {}
+
+        //! \sa PolylineSimplification::NthPoint
+        std::size_t NthPoint (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            unsigned n,
+            T* result, std::size_t* resultOffsets)
+        {
+            return Simplify (coords, offsets, polylineCount, result, resultOffsets,
+                [n] (Simplification& ps, const T* first, const T* last, T* out) {
+                    return ps.NthPoint (first, last, n, out);
+                });
+        }
+
+        //! \sa PolylineSimplification::RadialDistance
+        std::size_t RadialDistance (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            T tol,
+            T* result, std::size_t* resultOffsets)
+        {
+            return Simplify (coords, offsets, polylineCount, result, resultOffsets,
+                [tol] (Simplification& ps, const T* first, const T* last, T* out) {
+                    return ps.RadialDistance (first, last, tol, out);
+                });
+        }
+
+        //! \sa PolylineSimplification::PerpendicularDistance
+        std::size_t PerpendicularDistance (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            T tol, unsigned repeat,
+            T* result, std::size_t* resultOffsets)
+        {
+            return Simplify (coords, offsets, polylineCount, result, resultOffsets,
+                [tol, repeat] (Simplification& ps, const T* first, const T* last, T* out) {
+                    return ps.PerpendicularDistance (first, last, tol, repeat, out);
+                });
+        }
+
+        //! \sa PolylineSimplification::PerpendicularDistance
+        std::size_t PerpendicularDistance (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            T tol,
+            T* result, std::size_t* resultOffsets)
+        {
+            return Simplify (coords, offsets, polylineCount, result, resultOffsets,
+                [tol] (Simplification& ps, const T* first, const T* last, T* out) {
+                    return ps.PerpendicularDistance (first, last, tol, out);
+                });
+        }
+
+        //! \sa PolylineSimplification::ReumannWitkam
+        std::size_t ReumannWitkam (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            T tol,
+            T* result, std::size_t* resultOffsets)
+        {
+            return Simplify (coords, offsets, polylineCount, result, resultOffsets,
+                [tol] (Simplification& ps, const T* first, const T* last, T* out) {
+                    return ps.ReumannWitkam (first, last, tol, out);
+                });
+        }
+
+        //! \sa PolylineSimplification::Opheim
+        std::size_t Opheim (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            T min_tol, T max_tol,
+            T* result, std::size_t* resultOffsets)
+        {
+            return Simplify (coords, offsets, polylineCount, result, resultOffsets,
+                [min_tol, max_tol] (Simplification& ps, const T* first, const T* last, T* out) {
+                    return ps.Opheim (first, last, min_tol, max_tol, out);
+                });
+        }
+
+        //! \sa PolylineSimplification::Lang
+        std::size_t Lang (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            T tol, unsigned look_ahead,
+            T* result, std::size_t* resultOffsets)
+        {
+            return Simplify (coords, offsets, polylineCount, result, resultOffsets,
+                [tol, look_ahead] (Simplification& ps, const T* first, const T* last, T* out) {
+                    return ps.Lang (first, last, tol, look_ahead, out);
+                });
+        }
+
+        //! \sa PolylineSimplification::DouglasPeucker
+        std::size_t DouglasPeucker (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            T tol,
+            T* result, std::size_t* resultOffsets)
+        {
+            return Simplify (coords, offsets, polylineCount, result, resultOffsets,
+                [tol] (Simplification& ps, const T* first, const T* last, T* out) {
+                    return ps.DouglasPeucker (first, last, tol, out);
+                });
+        }
+
+        //! \sa PolylineSimplification::DouglasPeuckerHull
+        std::size_t DouglasPeuckerHull (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            T tol,
+            T* result, std::size_t* resultOffsets)
+        {
+            return Simplify (coords, offsets, polylineCount, result, resultOffsets,
+                [tol] (Simplification& ps, const T* first, const T* last, T* out) {
+                    return ps.DouglasPeuckerHull (first, last, tol, out);
+                });
+        }
+
+        //! \sa PolylineSimplification::DouglasPeuckerN
+        std::size_t DouglasPeuckerN (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            unsigned count,
+            T* result, std::size_t* resultOffsets)
+        {
+            return Simplify (coords, offsets, polylineCount, result, resultOffsets,
+                [count] (Simplification& ps, const T* first, const T* last, T* out) {
+                    return ps.DouglasPeuckerN (first, last, count, out);
+                });
+        }
+
+        //! \sa PolylineSimplification::VisvalingamWhyatt
+        std::size_t VisvalingamWhyatt (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            T tol,
+            T* result, std::size_t* resultOffsets)
+        {
+            return Simplify (coords, offsets, polylineCount, result, resultOffsets,
+                [tol] (Simplification& ps, const T* first, const T* last, T* out) {
+                    return ps.VisvalingamWhyatt (first, last, tol, out);
+                });
+        }
+
+        //! \sa PolylineSimplification::VisvalingamWhyattN
+        std::size_t VisvalingamWhyattN (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            unsigned count,
+            T* result, std::size_t* resultOffsets)
+        {
+            return Simplify (coords, offsets, polylineCount, result, resultOffsets,
+                [count] (Simplification& ps, const T* first, const T* last, T* out) {
+                    return ps.VisvalingamWhyattN (first, last, count, out);
+                });
+        }
+
+    private:
+        /*!
+            \brief Applies a simplification routine to each polyline.
+
+            \param[in] routine  calls a PolylineSimplification routine: routine (ps, first, last, result)
+        */
+        template <class Routine>
+        std::size_t Simplify (
+            const T* coords, const std::size_t* offsets, std::size_t polylineCount,
+            T* result, std::size_t* resultOffsets,
+            Routine routine)
+        {
+            unsigned threadCount = static_cast <unsigned> (
+                std::min <std::size_t> (simplifications.size (), polylineCount));
+            // polylines are handed out in chunks, small enough to balance the load
+            std::size_t chunkSize = std::max <std::size_t> (1, polylineCount / (16 * std::max (1u, threadCount)));
+            std::atomic <std::size_t> next (0);
+
+            // each simplification is stored at the offset of its polyline, its size at i+1
+            std::function <void (unsigned)> work = [&] (unsigned thread) {
+                Simplification& ps = simplifications [thread];
+                for (std::size_t i = next.fetch_add (chunkSize); i < polylineCount;
+                     i = next.fetch_add (chunkSize))
+                {
+                    std::size_t end = std::min (polylineCount, i + chunkSize);
+                    for (; i < end; ++i) {
+                        T* out = result + offsets [i];
+                        resultOffsets [i+1] = routine (ps, coords + offsets [i], coords + offsets [i+1], out) - out;
+                    }
+                }
+            };
+            std::vector <std::thread> threads;
+            for (unsigned t = 1; t < threadCount; ++t) {
+                threads.push_back (instrument::make_thread (work, t));
+            }
+            work (0);
+            for (std::size_t t = 0; t < threads.size (); ++t) {
+                threads [t].join ();
+            }
+
+            // move the simplifications to the front, in order
+            resultOffsets [0] = 0;
+            for (std::size_t i = 0; i < polylineCount; ++i) {
+                const T* first = result + offsets [i];
+                T* out = result + resultOffsets [i];
+                if (out != first) {
+                    std::copy (first, first + resultOffsets [i+1], out);
+                }
+                resultOffsets [i+1] += resultOffsets [i];
+            }
+            return resultOffsets [polylineCount];
+        }
+
+    private:
+        std::vector <Simplification> simplifications;   //! one instance per thread
+    };
+
+    /*!
+        \brief Simplifies polylines whose points are stored as DIM separate coordinate columns.
+
+        The input polyline consists of count points: point i has the coordinates columns [0][i],
+        columns [1][i], ..., columns [DIM-1][i]. Simplified polylines are written the same way,
+        to the DIM columns of result, each of which needs to be able to hold count values. Each
+        simplification routine returns the number of points of the simplified polyline.
+
+        The routines operate on the columns directly, through util::column_iterator, so that the
+        points do not have to be interleaved before, nor de-interleaved after simplification.
+        The distance functions are overloaded for column iterators, and read each point from
+        the columns into registers, see math::ColumnPoint. Routines that already copy the points
+        to an intermediate array, like the radial distance preprocessing of Douglas-Peucker,
+        gather the points from the columns.
+
+        All routines share the scratch memory of a single workspace, which is reused for each
+        polyline. A ColumnSimplification instance must not be used by multiple threads at once.
+        See PolylineSimplification for a description of each routine and its parameters.
+    */
+    template <unsigned DIM, class T, class Precision = math::float_precision>
+    class ColumnSimplification
+    {
+    public:
+        typedef util::column_iterator <DIM, const T> InputIterator;
+        typedef util::column_iterator <DIM, T> OutputIterator;
+
+    private:
+        typedef PolylineSimplification <DIM, InputIterator, OutputIterator, Precision> Simplification;
+        typedef PolylineSimplification <DIM, InputIterator, T*, Precision> ErrorComputation;
 
-            // copy all keys
-            const value_type* current = reduced.get ();
-            for (ptr_diff_type p=0; p<reducedPointCount; ++p, current += DIM) {
-                if (keys [p]) {
-                    for (unsigned d = 0; d < DIM; ++d) {
-                        *result = current [d];
-                        ++result;
-                    }
-                }
-            }
-            return result;
+    public:
+        ColumnSimplification () :
+            simplification (workspace),
+            errorComputation (workspace)
+        {}
+
+        //! \sa PolylineSimplification::NthPoint
+        std::size_t NthPoint (
+            const T* const* columns, std::size_t count,
+            unsigned n,
+            T* const* result)
+        {
+            return simplification.NthPoint (First (columns), Last (columns, count), n,
+                                            Result (result)).point ();
         }
 
-        /*!
-            \brief Performs a Douglas-Peucker approximation variant (DPn).
+        //! \sa PolylineSimplification::RadialDistance
+        std::size_t RadialDistance (
+            const T* const* columns, std::size_t count,
+            T tol,
+            T* const* result)
+        {
+            return simplification.RadialDistance (First (columns), Last (columns, count), tol,
+                                                  Result (result)).point ();
+        }
 
-            This algorithm is a variation of the original implementation. Instead of considering
-            one polyline segment at a time, all segments of the current simplified polyline are
-            evaluated at each step. Only the vertex with the maximum distance from its edge is
-            added to the simplification. This process will recurse untill the the simplification
-            contains the desired amount of vertices.
+        //! \sa PolylineSimplification::PerpendicularDistance
+        std::size_t PerpendicularDistance (
+            const T* const* columns, std::size_t count,
+            T tol, unsigned repeat,
+            T* const* result)
+        {
+            return simplification.PerpendicularDistance (First (columns), Last (columns, count), tol,
+                                                         repeat, Result (result)).point ();
+        }
 
-            The algorithm, which does not use the (radial) distance between points routine as a
-            preprocessing step, is O(n2) in worst case and O(n log n) on average.
+        //! \sa PolylineSimplification::PerpendicularDistance
+        std::size_t PerpendicularDistance (
+            const T* const* columns, std::size_t count,
+            T tol,
+            T* const* result)
+        {
+            return simplification.PerpendicularDistance (First (columns), Last (columns, count), tol,
+                                                         Result (result)).point ();
+        }
 
-            Note that this algorithm will create a copy of the input polyline for performance
-            reasons.
+        //! \sa PolylineSimplification::ReumannWitkam
+        std::size_t ReumannWitkam (
+            const T* const* columns, std::size_t count,
+            T tol,
+            T* const* result)
+        {
+            return simplification.ReumannWitkam (First (columns), Last (columns, count), tol,
+                                                 Result (result)).point ();
+        }
 
-            DPn is applied to the range [first, last). The resulting simplified polyline consists
-            of count vertices and is copied to the output range [result, result + count). The
-            return value is the end of the output range: result + count.
+        //! \sa PolylineSimplification::Opheim
+        std::size_t Opheim (
+            const T* const* columns, std::size_t count,
+            T min_tol, T max_tol,
+            T* const* result)
+        {
+            return simplification.Opheim (First (columns), Last (columns, count), min_tol, max_tol,
+                                          Result (result)).point ();
+        }
 
-            Input (Type) requirements:
-            1- DIM is not 0, where DIM represents the dimension of the polyline
-            2- The InputIterator type models the concept of a forward iterator
-            3- The InputIterator value type is convertible to a value type of the output iterator
-            4- The range [first, last) contains vertex coordinates in multiples of DIM, f.e.:
-               x, y, z, x, y, z, x, y, z when DIM = 3
-            5- The range [first, last) contains a minimum of count vertices
-            6- count is at least 2
+        //! \sa PolylineSimplification::Lang
+        std::size_t Lang (
+            const T* const* columns, std::size_t count,
+            T tol, unsigned look_ahead,
+            T* const* result)
+        {
+            return simplification.Lang (First (columns), Last (columns, count), tol, look_ahead,
+                                        Result (result)).point ();
+        }
 
-            In case these requirements are not met, the entire input range [first, last) is copied
-            to the output range [result, result + (last - first)) OR compile errors may occur.
+        //! \sa PolylineSimplification::DouglasPeucker
+        std::size_t DouglasPeucker (
+            const T* const* columns, std::size_t count,
+            T tol,
+            T* const* result)
+        {
+            return simplification.DouglasPeucker (First (columns), Last (columns, count), tol,
+                                                  Result (result)).point ();
+        }
 
-            \sa DouglasPeucker
+        //! \sa PolylineSimplification::DouglasPeuckerParallel
+        std::size_t DouglasPeuckerParallel (
+            const T* const* columns, std::size_t count,
+            T tol, unsigned threadCount,
+            T* const* result)
+        {
+            return simplification.DouglasPeuckerParallel (First (columns), Last (columns, count), tol,
+                                                          threadCount, Result (result)).point ();
+        }
 
-            \param[in] first    the first coordinate of the first polyline point
-            \param[in] last     one beyond the last coordinate of the last polyline point
-            \param[in] count    the maximum number of points of the simplified polyline
-            \param[in] result   destination of the simplified polyline
-            \return             one beyond the last coordinate of the simplified polyline
-        */
-        OutputIterator DouglasPeuckerN (
-            InputIterator first,
-            InputIterator last,
-            unsigned count,
-            OutputIterator result)
+        //! \sa PolylineSimplification::DouglasPeuckerChunked
+        std::size_t DouglasPeuckerChunked (
+            const T* const* columns, std::size_t count,
+            T tol, std::size_t chunkSize, unsigned threadCount,
+            T* const* result)
         {
-            diff_type coordCount = std::distance (first, last);
-            diff_type pointCount = DIM      // protect against zero DIM
-                                   ? coordCount / DIM
-                                   : 0;
-            // validate input and check if simplification required
-            if (coordCount % DIM || pointCount <= static_cast <diff_type> (count) || count < 2) {
-                return std::copy (first, last, result);
-            }
+            return simplification.DouglasPeuckerChunked (First (columns), Last (columns, count), tol,
+                                                         chunkSize, threadCount, Result (result)).point ();
+        }
 
-            // copy coords
-            util::scoped_array <value_type> coords (coordCount);
-            for (ptr_diff_type c=0; c<coordCount; ++c) {
-                coords [c] = *first;
-                ++first;
-            }
+        //! \sa PolylineSimplification::DouglasPeuckerHull
+        std::size_t DouglasPeuckerHull (
+            const T* const* columns, std::size_t count,
+            T tol,
+            T* const* result)
+        {
+            return simplification.DouglasPeuckerHull (First (columns), Last (columns, count), tol,
+                                                      Result (result)).point ();
+        }
 
-            // douglas-peucker approximation
-            util::scoped_array <unsigned char> keys (pointCount);
-            DPHelper::ApproximateN (coords.get (), coordCount, count, keys.get ());
+        //! \sa PolylineSimplification::DouglasPeuckerN
+        std::size_t DouglasPeuckerN (
+            const T* const* columns, std::size_t count,
+            unsigned n,
+            T* const* result)
+        {
+            return simplification.DouglasPeuckerN (First (columns), Last (columns, count), n,
+                                                   Result (result)).point ();
+        }
 
-            // copy keys
-            const value_type* current = coords.get ();
-            for (ptr_diff_type p=0; p<pointCount; ++p, current += DIM) {
-                if (keys [p]) {
-                    for (unsigned d = 0; d < DIM; ++d) {
-                        *result = current [d];
-                        ++result;
-                    }
-                }
-            }
-            return result;
+        //! \sa PolylineSimplification::DouglasPeuckerIndices
+        template <class IndexIterator>
+        IndexIterator DouglasPeuckerIndices (
+            const T* const* columns, std::size_t count,
+            T tol,
+            IndexIterator result)
+        {
+            return simplification.DouglasPeuckerIndices (First (columns), Last (columns, count), tol,
+                                                         result);
         }
 
-        /*!
-            \brief Computes the squared positional error between a polyline and its simplification.
+        //! \sa PolylineSimplification::DouglasPeuckerNIndices
+        template <class IndexIterator>
+        IndexIterator DouglasPeuckerNIndices (
+            const T* const* columns, std::size_t count,
+            unsigned n,
+            IndexIterator result)
+        {
+            return simplification.DouglasPeuckerNIndices (First (columns), Last (columns, count), n,
+                                                          result);
+        }
 
-            For each point in the range [original_first, original_last) the squared distance to the
-            simplification [simplified_first, simplified_last) is calculated. Each positional error
-            is copied to the output range [result, result + count), where count is the number of
-            points in the original polyline. The return value is the end of the output range:
-            result + count.
+        //! \sa PolylineSimplification::DouglasPeuckerErrors
+        template <class ErrorIterator>
+        std::size_t DouglasPeuckerErrors (
+            const T* const* columns, std::size_t count,
+            T tol,
+            T* const* result, ErrorIterator errors)
+        {
+            return simplification.DouglasPeuckerErrors (First (columns), Last (columns, count), tol,
+                                                        Result (result), errors).point ();
+        }
 
-            Note that both the original and simplified polyline must be defined using the same
-            value_type.
+        //! \sa PolylineSimplification::DouglasPeuckerNErrors
+        template <class ErrorIterator>
+        std::size_t DouglasPeuckerNErrors (
+            const T* const* columns, std::size_t count,
+            unsigned n,
+            T* const* result, ErrorIterator errors)
+        {
+            return simplification.DouglasPeuckerNErrors (First (columns), Last (columns, count), n,
+                                                         Result (result), errors).point ();
+        }
 
-            \image html psimpl_pos_error.png
+        //! \sa PolylineSimplification::DouglasPeuckerLevels
+        template <class ToleranceIterator, class LevelIterator>
+        LevelIterator DouglasPeuckerLevels (
+            const T* const* columns, std::size_t count,
+            ToleranceIterator tol_first, ToleranceIterator tol_last,
+            LevelIterator levels)
+        {
+            return simplification.DouglasPeuckerLevels (First (columns), Last (columns, count),
+                                                        tol_first, tol_last, levels);
+        }
 
-            Input (Type) requirements:
-            1- DIM is not 0, where DIM represents the dimension of the polyline
-            2- The InputIterator type models the concept of a forward iterator
-            3- The InputIterator value type is convertible to a value type of the output iterator
-            4- The ranges [original_first, original_last) and [simplified_first, simplified_last)
-               contain vertex coordinates in multiples of DIM, f.e.: x, y, z, x, y, z, x, y, z
-               when DIM = 3
-            5- The ranges [original_first, original_last) and [simplified_first, simplified_last)
-               contain a minimum of 2 vertices
-            6- The range [simplified_first, simplified_last) represents a simplification of the
-               range [original_first, original_last), meaning each point in the simplification
-               has the exact same coordinates as some point from the original polyline
+        //! \sa PolylineSimplification::VisvalingamWhyatt
+        std::size_t VisvalingamWhyatt (
+            const T* const* columns, std::size_t count,
+            T tol,
+            T* const* result)
+        {
+            return simplification.VisvalingamWhyatt (First (columns), Last (columns, count), tol,
+                                                     Result (result)).point ();
+        }
 
-            In case these requirements are not met, the valid flag is set to false OR
-            compile errors may occur.
+        //! \sa PolylineSimplification::VisvalingamWhyattN
+        std::size_t VisvalingamWhyattN (
+            const T* const* columns, std::size_t count,
+            unsigned n,
+            T* const* result)
+        {
+            return simplification.VisvalingamWhyattN (First (columns), Last (columns, count), n,
+                                                      Result (result)).point ();
+        }
 
-            \param[in] original_first   the first coordinate of the first polyline point
-            \param[in] original_last    one beyond the last coordinate of the last polyline point
-            \param[in] simplified_first the first coordinate of the first simplified polyline point
-            \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
-            \param[in] result           destination of the squared positional errors
-            \param[out] valid           [optional] indicates if the computed positional errors are valid
-            \return                     one beyond the last computed positional error
+        /*!
+            \brief Computes the squared positional error of each original point.
+
+            \sa PolylineSimplification::ComputePositionalErrors2
+
+            \param[in] original         the DIM coordinate columns of the original polyline
+            \param[in] count            number of points of the original polyline
+            \param[in] simplified       the DIM coordinate columns of the simplified polyline
+            \param[in] simplifiedCount  number of points of the simplified polyline
+            \param[out] result          destination of the count squared positional errors
+            \param[out] valid           [optional] indicates if the computed errors are valid
+            \return                     one beyond the last computed error
         */
-        OutputIterator ComputePositionalErrors2 (
-            InputIterator original_first,
-            InputIterator original_last,
-            InputIterator simplified_first,
-            InputIterator simplified_last,
-            OutputIterator result,
+        T* ComputePositionalErrors2 (
+            const T* const* original, std::size_t count,
+            const T* const* simplified, std::size_t simplifiedCount,
+            T* result, bool* valid=0)
+        {
+            return errorComputation.ComputePositionalErrors2 (
+                First (original), Last (original, count),
+                First (simplified), Last (simplified, simplifiedCount), result, valid);
+        }
+
+        //! \sa PolylineSimplification::ComputePositionalErrors2Parallel
+        T* ComputePositionalErrors2Parallel (
+            const T* const* original, std::size_t count,
+            const T* const* simplified, std::size_t simplifiedCount,
+            unsigned threadCount,
+            T* result, bool* valid=0)
+        {
+            return errorComputation.ComputePositionalErrors2Parallel (
+                First (original), Last (original, count),
+                First (simplified), Last (simplified, simplifiedCount), threadCount, result, valid);
+        }
+
+        //! \sa PolylineSimplification::ComputePositionalErrorStatistics
+        math::Statistics ComputePositionalErrorStatistics (
+            const T* const* original, std::size_t count,
+            const T* const* simplified, std::size_t simplifiedCount,
             bool* valid=0)
         {
-            diff_type original_coordCount = std::distance (original_first, original_last);
-            diff_type original_pointCount = DIM     // protect against zero DIM
-                                            ? original_coordCount / DIM
-                                            : 0;
+            return errorComputation.ComputePositionalErrorStatistics (
+                First (original), Last (original, count),
+                First (simplified), Last (simplified, simplifiedCount), valid);
+        }
 
-            diff_type simplified_coordCount = std::distance (simplified_first, simplified_last);
-            diff_type simplified_pointCount = DIM   // protect against zero DIM
-                                              ? simplified_coordCount / DIM
-                                              : 0;
+        //! \sa PolylineSimplification::ComputeNearestErrors2
+        T* ComputeNearestErrors2 (
+            const T* const* original, std::size_t count,
+            const T* const* simplified, std::size_t simplifiedCount,
+            T* result, bool* valid=0)
+        {
+            return errorComputation.ComputeNearestErrors2 (
+                First (original), Last (original, count),
+                First (simplified), Last (simplified, simplifiedCount), result, valid);
+        }
 
-            // validate input
-            if (original_coordCount % DIM || original_pointCount < 2 ||
-                simplified_coordCount % DIM || simplified_pointCount < 2 ||
-                original_pointCount < simplified_pointCount ||
-                !math::equal <DIM> (original_first, simplified_first))
-            {
-                if (valid) {
-                    *valid = false;
-                }
-                return result;
-            }
+        //! \sa PolylineSimplification::ComputeHausdorffDistance
+        double ComputeHausdorffDistance (
+            const T* const* original, std::size_t count,
+            const T* const* simplified, std::size_t simplifiedCount,
+            bool* valid=0)
+        {
+            return errorComputation.ComputeHausdorffDistance (
+                First (original), Last (original, count),
+                First (simplified), Last (simplified, simplifiedCount), valid);
+        }
 
-            // define (simplified) line segment S(simplified_prev, simplified_first)
-            InputIterator simplified_prev = simplified_first;
-            std::advance (simplified_first, DIM);
+    private:
+        // non-copyable: both simplifications refer to the workspace of this instance
+        ColumnSimplification (const ColumnSimplification&);
+        ColumnSimplification& operator= (const ColumnSimplification&);
 
-            // process each simplified line segment
-            while (simplified_first != simplified_last) {
-                // process each original point until it equals the end of the line segment
-                while (original_first != original_last &&
-                       !math::equal <DIM> (original_first, simplified_first))
-                {
-                    *result = math::segment_distance2 <DIM> (simplified_prev, simplified_first,
-                                                             original_first);
-                    ++result;
-                    std::advance (original_first, DIM);
-                }
-                // update line segment S
-                simplified_prev = simplified_first;
-                std::advance (simplified_first, DIM);
-            }
-            // check if last original point matched
-            if (original_first != original_last) {
-                *result = 0;
-                ++result;
-            }
+        static InputIterator First (const T* const* columns) {
+            return InputIterator (columns, 0);
+        }
 
-            if (valid) {
-                *valid = original_first != original_last;
-            }
-            return result;
+        static InputIterator Last (const T* const* columns, std::size_t count) {
+            return InputIterator (columns, static_cast <std::ptrdiff_t> (count));
         }
 
-        /*!
-            \brief Computes statistics for the positional errors between a polyline and its simplification.
+        static OutputIterator Result (T* const* columns) {
+            return OutputIterator (columns, 0);
+        }
 
-            Various statistics (mean, max, sum, std) are calculated for the positional errors
-            between the range [original_first, original_last) and its simplification the range
-            [simplified_first, simplified_last).
+    private:
+        Workspace <T> workspace;                //! scratch memory shared by all routines
+        Simplification simplification;         //! writes simplified polylines to columns
+        ErrorComputation errorComputation;      //! writes positional errors to an array
+    };
+
+    /*!
+        \brief Precomputed Douglas-Peucker significance hierarchy for level of detail queries.
+
+        Building the hierarchy performs a single complete DPn run, that records for each point
+        its insertion rank and the largest squared tolerance for which DP keeps it. Afterwards
+        the DP simplification for any tolerance, and the DPn simplification for any point count,
+        are obtained in O(k), where k is the number of points of the simplification. The points
+        are visited in polyline order, so the result is written straight to the output.
+
+        The tolerance queries equal DP applied to the original polyline; unlike DouglasPeucker
+        they do not perform the radial distance preprocessing step. The point count queries
+        equal DouglasPeuckerN.
+
+        The hierarchy does not store any coordinates. The coordinate queries require random
+        access to the polyline the hierarchy was built for. The serialized form stores a rank
+        and a squared tolerance per point in native byte order, and is portable between
+        machines with the same endianness. Polylines of up to 2^32 - 1 points are supported.
+    */
+    template <unsigned DIM, class T>
+    class DouglasPeuckerHierarchy
+    {
+        typedef typename PolylineSimplification <DIM, const T*, T*>::DPHelper DPHelper;
+
+    public:
+        DouglasPeuckerHierarchy () :
+            root (0)
+        {}
+
+        /*!
+            \brief Builds the hierarchy for the polyline [first, last).
 
             Input (Type) requirements:
             1- DIM is not 0, where DIM represents the dimension of the polyline
-            2- The InputIterator type models the concept of a forward iterator
-            3- The InputIterator value type is convertible to double
-            4- The ranges [original_first, original_last) and [simplified_first, simplified_last)
-               contain vertex coordinates in multiples of DIM, f.e.: x, y, z, x, y, z, x, y, z
-               when DIM = 3
-            5- The ranges [original_first, original_last) and [simplified_first, simplified_last)
-               contain a minimum of 2 vertices
-            6- The range [simplified_first, simplified_last) represents a simplification of the
-               range [original_first, original_last), meaning each point in the simplification
-               has the exact same coordinates as some point from the original polyline
-
-            In case these requirements are not met, the valid flag is set to false OR
-            compile errors may occur.
+            2- The ForwardIterator type models the concept of a forward iterator
+            3- The ForwardIterator value type is convertible to T
+            4- The range [first, last) contains vertex coordinates in multiples of DIM
+            5- The range [first, last) contains at least 2 vertices
 
-            \sa ComputePositionalErrors2
+            In case these requirements are not met, the hierarchy is left empty.
 
-            \param[in] original_first   the first coordinate of the first polyline point
-            \param[in] original_last    one beyond the last coordinate of the last polyline point
-            \param[in] simplified_first the first coordinate of the first simplified polyline point
-            \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
-            \param[out] valid           [optional] indicates if the computed statistics are valid
-            \return                     the computed statistics
+            \param[in] first    the first coordinate of the first polyline point
+            \param[in] last     one beyond the last coordinate of the last polyline point
+            \return             true if the hierarchy was built
         */
-        math::Statistics ComputePositionalErrorStatistics (
-            InputIterator original_first,
-            InputIterator original_last,
-            InputIterator simplified_first,
-            InputIterator simplified_last,
-            bool* valid=0)
+        template <class ForwardIterator>
+        bool Build (
+            ForwardIterator first,
+            ForwardIterator last)
         {
-            diff_type pointCount = std::distance (original_first, original_last) / DIM;
-            util::scoped_array <double> errors (pointCount);
-            PolylineSimplification <DIM, InputIterator, double*> ps;
-
-            diff_type errorCount = 
-                std::distance (
-                    errors.get (), 
-                    ps.ComputePositionalErrors2 (original_first, original_last,
-                                                 simplified_first, simplified_last,
-                                                 errors.get (), valid));
+            Clear ();
+            std::vector <T> coords (first, last);
+            std::size_t pointCount = DIM ? coords.size () / DIM : 0;
+            if (!DIM || coords.size () % DIM || pointCount < 2 ||
+                pointCount > std::numeric_limits <unsigned>::max ())
+            {
+                return false;
+            }
+            ranks.resize (pointCount);
+            dist2.resize (pointCount);
+            typename DPHelper::Heap queue;
+            DPHelper::ApproximateRanks (&coords [0], coords.size (), &ranks [0], &dist2 [0], queue);
+            Link ();
+            return true;
+        }
 
-            std::transform (errors.get (), errors.get () + errorCount,
-                            errors.get (),
-                            std::function <double(double)> (std::sqrt));
+        //! \brief Removes all points from the hierarchy.
+        void Clear () {
+            ranks.clear ();
+            dist2.clear ();
+            left.clear ();
+            right.clear ();
+            parent.clear ();
+            root = 0;
+        }
 
-            return math::compute_statistics (errors.get (), errors.get () + errorCount);
+        //! \brief Returns the number of points of the polyline the hierarchy was built for.
+        std::size_t PointCount () const {
+            return ranks.size ();
         }
 
-    private:
         /*!
-            \brief Copies the key to the output destination, and increments the iterator.
+            \brief Copies the indices of the DP simplification for tolerance tol.
 
-            \sa CopyKey
+            The indices are copied in increasing order. In case tol is 0, the indices of all
+            points are copied.
 
-            \param[in,out] key      the first coordinate of the key
-            \param[in,out] result   destination of the copied key
+            \param[in] tol      perpendicular (point-to-segment) distance tolerance
+            \param[in] result   destination of the indices of the simplified polyline points
+            \return             one beyond the last index of the simplified polyline
         */
-        inline void CopyKeyAdvance (
-            InputIterator& key,
-            OutputIterator& result)
+        template <class IndexIterator>
+        IndexIterator DouglasPeuckerIndices (
+            T tol,
+            IndexIterator result) const
         {
-            for (unsigned d = 0; d < DIM; ++d) {
-                *result = *key;
-                ++result;
-                ++key;
+            T tol2 = tol * tol;
+            if (tol2 == 0) {
+                return CopyAll (IndexOutput <IndexIterator> (result)).result;
             }
+            return Traverse (Tolerance (dist2, tol2), IndexOutput <IndexIterator> (result)).result;
         }
 
         /*!
-            \brief Copies the key to the output destination.
+            \brief Copies the indices of the DPn simplification consisting of count points.
 
-            \sa CopyKeyAdvance
+            The indices are copied in increasing order. In case count is smaller than 2, or not
+            smaller than the number of points, the indices of all points are copied.
 
-            \param[in]     key      the first coordinate of the key
-            \param[in,out] result   destination of the copied key
+            \param[in] count    the maximum number of points of the simplified polyline
+            \param[in] result   destination of the indices of the simplified polyline points
+            \return             one beyond the last index of the simplified polyline
         */
-        inline void CopyKey (
-            InputIterator key,
-            OutputIterator& result)
+        template <class IndexIterator>
+        IndexIterator DouglasPeuckerNIndices (
+            unsigned count,
+            IndexIterator result) const
         {
-            CopyKeyAdvance (key, result);
+            if (count < 2 || count >= PointCount ()) {
+                return CopyAll (IndexOutput <IndexIterator> (result)).result;
+            }
+            return Traverse (Rank (ranks, count), IndexOutput <IndexIterator> (result)).result;
         }
 
         /*!
-            \brief Increments the iterator by n points.
+            \brief Copies the DP simplification for tolerance tol.
 
-            \sa AdvanceCopy
+            \sa DouglasPeuckerIndices
 
-            \param[in,out] it  iterator to be advanced
-            \param[in]     n   number of points to advance
+            \param[in] first    the first coordinate of the polyline the hierarchy was built for
+            \param[in] tol      perpendicular (point-to-segment) distance tolerance
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
         */
-        inline void Advance (
-            InputIterator& it,
-            diff_type n = 1)
+        template <class RandomAccessIterator, class OutputIterator>
+        OutputIterator DouglasPeucker (
+            RandomAccessIterator first,
+            T tol,
+            OutputIterator result) const
         {
-            std::advance (it, n * static_cast <diff_type> (DIM));
+            T tol2 = tol * tol;
+            if (tol2 == 0) {
+                return CopyAll (PointOutput <RandomAccessIterator, OutputIterator> (first, result)).result;
+            }
+            return Traverse (Tolerance (dist2, tol2),
+                PointOutput <RandomAccessIterator, OutputIterator> (first, result)).result;
         }
-        
+
         /*!
-            \brief Increments a copy of the iterator by n points.
+            \brief Copies the DPn simplification consisting of count points.
 
-            \sa Advance
+            \sa DouglasPeuckerNIndices
 
-            \param[in] it   iterator to be advanced
-            \param[in] n    number of points to advance
-            \return         an incremented copy of the input iterator
+            \param[in] first    the first coordinate of the polyline the hierarchy was built for
+            \param[in] count    the maximum number of points of the simplified polyline
+            \param[in] result   destination of the simplified polyline
+            \return             one beyond the last coordinate of the simplified polyline
         */
-        inline InputIterator AdvanceCopy (
-            InputIterator it,
-            diff_type n = 1)
+        template <class RandomAccessIterator, class OutputIterator>
+        OutputIterator DouglasPeuckerN (
+            RandomAccessIterator first,
+            unsigned count,
+            OutputIterator result) const
         {
-            Advance (it, n);
-            return it;
+            if (count < 2 || count >= PointCount ()) {
+                return CopyAll (PointOutput <RandomAccessIterator, OutputIterator> (first, result)).result;
+            }
+            return Traverse (Rank (ranks, count),
+                PointOutput <RandomAccessIterator, OutputIterator> (first, result)).result;
         }
 
-        /*!
-            \brief Increments the iterator by n points if possible.
-
-            If there are fewer than n point remaining the iterator will be incremented to the last
-            point.
+        //! \brief Returns the number of bytes written by Serialize.
+        std::size_t SerializedSize () const {
+            return HEADER_SIZE + PointCount () * (sizeof (unsigned) + sizeof (T));
+        }
 
-            \sa Backward
+        /*!
+            \brief Writes the hierarchy as SerializedSize () bytes.
 
-            \param[in,out] it           iterator to be advanced
-            \param[in]     n            number of points to advance
-            \param[in,out] remaining    number of points remaining after it
-            \return                     the actual amount of points that the iterator advanced
+            \param[in] result   destination of the bytes; its value type is unsigned char
+            \return             one beyond the last written byte
         */
-        inline unsigned Forward (
-            InputIterator& it,
-            unsigned n,
-            unsigned& remaining)
+        template <class OutputIterator>
+        OutputIterator Serialize (
+            OutputIterator result) const
         {
-            n = std::min (n, remaining);
-            Advance (it, n);
-            remaining -= n;
-            return n;
+            unsigned char header [HEADER_SIZE] = {'p', 's', 'd', 'h', VERSION, sizeof (T), 0, 0};
+            unsigned pointCount = static_cast <unsigned> (PointCount ());
+            std::memcpy (header + 8, &pointCount, sizeof (unsigned));
+            result = std::copy (header, header + HEADER_SIZE, result);
+            if (pointCount) {
+                const unsigned char* bytes = reinterpret_cast <const unsigned char*> (&ranks [0]);
+                result = std::copy (bytes, bytes + pointCount * sizeof (unsigned), result);
+                bytes = reinterpret_cast <const unsigned char*> (&dist2 [0]);
+                result = std::copy (bytes, bytes + pointCount * sizeof (T), result);
+            }
+            return result;
         }
 
         /*!
-            \brief Decrements the iterator by 1 point.
+            \brief Restores a hierarchy from the bytes [first, last), as written by Serialize.
 
-            \sa Forward
+            In case the bytes do not describe a valid hierarchy for type T, the hierarchy is left
+            empty.
 
-            \param[in,out] it            iterator to be advanced
-            \param[in,out] remaining     number of points remaining after it
+            \param[in] first    the first byte
+            \param[in] last     one beyond the last byte
+            \return             true if the hierarchy was restored
         */
-        inline void Backward (
-            InputIterator& it,
-            unsigned& remaining)
+        bool Deserialize (
+            const unsigned char* first,
+            const unsigned char* last)
         {
-            Advance (it, -1);
-            ++remaining;
+            Clear ();
+            std::size_t size = last - first;
+            if (size < HEADER_SIZE || !std::equal (first, first + 4, "psdh") ||
+                first [4] != VERSION || first [5] != sizeof (T))
+            {
+                return false;
+            }
+            unsigned pointCount = 0;
+            std::memcpy (&pointCount, first + 8, sizeof (unsigned));
+            if (pointCount < 2 || (size - HEADER_SIZE) / (sizeof (unsigned) + sizeof (T)) != pointCount ||
+                (size - HEADER_SIZE) % (sizeof (unsigned) + sizeof (T)))
+            {
+                return false;
+            }
+            first += HEADER_SIZE;
+            ranks.resize (pointCount);
+            std::memcpy (&ranks [0], first, pointCount * sizeof (unsigned));
+            first += pointCount * sizeof (unsigned);
+            dist2.resize (pointCount);
+            std::memcpy (&dist2 [0], first, pointCount * sizeof (T));
+
+            // the end points always rank first, all other ranks are at most pointCount
+            if (ranks [0] != 0 || ranks [pointCount - 1] != 1 ||
+                *std::max_element (ranks.begin (), ranks.end ()) > pointCount)
+            {
+                Clear ();
+                return false;
+            }
+            Link ();
+            return true;
         }
 
     private:
-        /*!
-            \brief Douglas-Peucker approximation helper class.
+        enum { HEADER_SIZE = 12, VERSION = 1 };
 
-            Contains helper implentations for Douglas-Peucker approximation that operate solely on
-            value_type arrays and value_type pointers. Note that the PolylineSimplification
-            class only operates on iterators.
-        */
-        class DPHelper
-        {
-            //! \brief Defines a sub polyline.
-            struct SubPoly {
-                SubPoly (ptr_diff_type first=0, ptr_diff_type last=0) :
-                    first (first), last (last) {}
+        //! \brief Selects the points that DP keeps for a squared tolerance.
+        struct Tolerance {
+            Tolerance (const std::vector <T>& dist2, T tol2) :
+                dist2 (dist2), tol2 (tol2) {}
 
-                ptr_diff_type first;    //! coord index of the first point
-                ptr_diff_type last;     //! coord index of the last point
-            };
+            bool operator () (unsigned p) const {
+                return tol2 < dist2 [p];
+            }
 
-            //! \brief Defines the key of a polyline.
-            struct KeyInfo {
-                KeyInfo (ptr_diff_type index=0, value_type dist2=0) :
-                    index (index), dist2 (dist2) {}
+            const std::vector <T>& dist2;
+            T tol2;
+        };
 
-                ptr_diff_type index;    //! coord index of the key
-                value_type dist2;       //! squared distance of the key to a segment
-            };
+        //! \brief Selects the first count points that DPn adds.
+        struct Rank {
+            Rank (const std::vector <unsigned>& ranks, unsigned count) :
+                ranks (ranks), count (count) {}
+
+            bool operator () (unsigned p) const {
+                return ranks [p] < count;
+            }
 
-            //! \brief Defines a sub polyline including its key.
-            struct SubPolyAlt {
-                SubPolyAlt (ptr_diff_type first=0, ptr_diff_type last=0) :
-                    first (first), last (last) {}
+            const std::vector <unsigned>& ranks;
+            unsigned count;
+        };
+
+        //! \brief Copies point indices to an output iterator.
+        template <class IndexIterator>
+        struct IndexOutput {
+            IndexOutput (IndexIterator result) :
+                result (result) {}
+
+            void operator () (unsigned p) {
+                *result = p;
+                ++result;
+            }
 
-                ptr_diff_type first;    //! coord index of the first point
-                ptr_diff_type last;     //! coord index of the last point
-                KeyInfo keyInfo;        //! key of this sub poly
+            IndexIterator result;
+        };
 
-                bool operator< (const SubPolyAlt& other) const {
-                    return keyInfo.dist2 < other.keyInfo.dist2;
+        //! \brief Copies point coordinates to an output iterator.
+        template <class RandomAccessIterator, class OutputIterator>
+        struct PointOutput {
+            PointOutput (RandomAccessIterator first, OutputIterator result) :
+                first (first), result (result) {}
+
+            void operator () (unsigned p) {
+                RandomAccessIterator coord = first +
+                    static_cast <typename std::iterator_traits <RandomAccessIterator>::difference_type> (p) * DIM;
+                for (unsigned d = 0; d < DIM; ++d, ++coord) {
+                    *result = *coord;
+                    ++result;
                 }
-            };
+            }
 
-        public:
-            /*!
-                \brief Performs Douglas-Peucker approximation.
+            RandomAccessIterator first;
+            OutputIterator result;
+        };
 
-                \param[in] coords       array of polyline coordinates
-                \param[in] coordCount   number of coordinates in coords []
-                \param[in] tol          approximation tolerance
-                \param[out] keys        indicates for each polyline point if it is a key
-            */
-            static void Approximate (
-                const value_type* coords,
-                ptr_diff_type coordCount,
-                value_type tol,
-                unsigned char* keys)
-            {
-                value_type tol2 = tol * tol;    // squared distance tolerance
-                ptr_diff_type pointCount = coordCount / DIM;
-                // zero out keys
-                std::fill_n (keys, pointCount, 0);
-                keys [0] = 1;                   // the first point is always a key
-                keys [pointCount - 1] = 1;      // the last point is always a key
+        //! \brief Passes all points to output.
+        template <class Output>
+        Output CopyAll (
+            Output output) const
+        {
+            for (unsigned p = 0; p < PointCount (); ++p) {
+                output (p);
+            }
+            return output;
+        }
 
-                typedef std::stack <SubPoly> Stack;
-                Stack stack;                    // LIFO job-queue containing sub-polylines
+        /*!
+            \brief Passes all points that are selected by visible to output, in polyline order.
 
-                SubPoly subPoly (0, coordCount-DIM);
-                stack.push (subPoly);           // add complete poly
+            The selected points form a sub tree containing the root, as a point is added after
+            the point that created its sub polyline and has a smaller tolerance. An in-order
+            traversal that does not descend into unselected points visits O(k) points.
 
-                while (!stack.empty ()) {
-                    subPoly = stack.top ();     // take a sub poly
-                    stack.pop ();               // and find its key
-                    KeyInfo keyInfo = FindKey (coords, subPoly.first, subPoly.last);
-                    if (keyInfo.index && tol2 < keyInfo.dist2) {
-                        // store the key if valid
-                        keys [keyInfo.index / DIM] = 1;
-                        // split the polyline at the key and recurse
-                        stack.push (SubPoly (keyInfo.index, subPoly.last));
-                        stack.push (SubPoly (subPoly.first, keyInfo.index));
+            \param[in] visible  selects the points of the simplification: visible (p)
+            \param[in] output   receives each point of the simplification: output (p)
+            \return             the output after receiving all points
+        */
+        template <class Visible, class Output>
+        Output Traverse (
+            Visible visible,
+            Output output) const
+        {
+            unsigned pointCount = static_cast <unsigned> (PointCount ());
+            if (!pointCount) {
+                return output;
+            }
+            output (0);
+            unsigned node = root;
+            if (node && visible (node)) {
+                // descend to the first point
+                while (left [node] && visible (left [node])) {
+                    node = left [node];
+                }
+                for (;;) {
+                    output (node);
+                    if (right [node] && visible (right [node])) {
+                        // descend to the first point after node
+                        node = right [node];
+                        while (left [node] && visible (left [node])) {
+                            node = left [node];
+                        }
+                        continue;
                     }
+                    // ascend to the first point after node
+                    while (node != root && right [parent [node]] == node) {
+                        node = parent [node];
+                    }
+                    if (node == root) {
+                        break;
+                    }
+                    node = parent [node];
                 }
             }
+            output (pointCount - 1);
+            return output;
+        }
 
-            /*!
-                \brief Performs Douglas-Peucker approximation.
-
-                \param[in] coords       array of polyline coordinates
-                \param[in] coordCount   number of coordinates in coords []
-                \param[in] countTol     point count tolerance
-                \param[out] keys        indicates for each polyline point if it is a key
-            */
-            static void ApproximateN (
-                const value_type* coords,
-                ptr_diff_type coordCount,
-                unsigned countTol,
-                unsigned char* keys)
-            {
-                ptr_diff_type pointCount = coordCount / DIM;
-                // zero out keys
-                std::fill_n (keys, pointCount, 0);
-                keys [0] = 1;                   // the first point is always a key
-                keys [pointCount - 1] = 1;      // the last point is always a key
-                unsigned keyCount = 2;
+        /*!
+            \brief Creates the binary tree of interior points from the ranks.
 
-                if (countTol == 2) {
-                    return;
+            The key of each sub polyline has the lowest rank of all its interior points, so the
+            tree is the cartesian tree of the ranks; it is built in O(n) using a stack. Index 0
+            indicates the absence of a child or parent, as the first point is never part of the
+            tree.
+        */
+        void Link () {
+            unsigned pointCount = static_cast <unsigned> (PointCount ());
+            left.assign (pointCount, 0);
+            right.assign (pointCount, 0);
+            parent.assign (pointCount, 0);
+            std::vector <unsigned> stack;
+            for (unsigned p = 1; p + 1 < pointCount; ++p) {
+                unsigned child = 0;
+                while (!stack.empty () && ranks [p] < ranks [stack.back ()]) {
+                    child = stack.back ();
+                    stack.pop_back ();
+                }
+                left [p] = child;
+                if (child) {
+                    parent [child] = p;
                 }
+                if (!stack.empty ()) {
+                    right [stack.back ()] = p;
+                    parent [p] = stack.back ();
+                }
+                stack.push_back (p);
+            }
+            root = stack.empty () ? 0 : stack.front ();
+        }
 
-                typedef std::priority_queue <SubPolyAlt> PriorityQueue;
-                PriorityQueue queue;    // sorted (max dist2) job queue containing sub-polylines
+    private:
+        std::vector <unsigned> ranks;   //! for each point the order in which DPn adds it
+        std::vector <T> dist2;          //! for each point the squared tolerance up to which DP keeps it
+        std::vector <unsigned> left;    //! for each interior point its left child
+        std::vector <unsigned> right;   //! for each interior point its right child
+        std::vector <unsigned> parent;  //! for each interior point its parent
+        unsigned root;                  //! the key of the complete polyline
+    };
 
-                SubPolyAlt subPoly (0, coordCount-DIM);
-                subPoly.keyInfo = FindKey (coords, subPoly.first, subPoly.last);
-                queue.push (subPoly);           // add complete poly
+    /*!
+        \brief Base class of the streaming simplification routines.
+
+        A stream receives a polyline one point at a time using Push, and copies each key to its
+        output iterator as soon as it is known to be part of the simplification. Flush completes
+        the current polyline by copying its last point, after which the stream can be reused for
+        a new polyline. A stream only stores a few points, independent of the polyline length.
+
+        The keys are identical to those of the corresponding PolylineSimplification routine,
+        unless a maximum delay is specified. Reumann-Witkam and Opheim in particular can leave
+        the next key undecided for an arbitrarily long stretch of (nearly) straight input. With
+        a maximum delay of n points, the most recent point is forced out as a key as soon as n
+        points were pushed after the last key; the stream then continues as if a new polyline
+        started at that key. ForceKey does the same on demand, f.e. to bound the delay in time.
+        A forced key is an original point, and all points discarded before it passed the same
+        tolerance tests as without forcing, so the tolerance guarantee of the routine holds.
+    */
+    template <unsigned DIM, class T, class OutputIterator>
+    class StreamSimplification
+    {
+    public:
+        typedef T value_type;
 
-                while (!queue.empty ()) {
-                    subPoly = queue.top ();     // take a sub poly
-                    queue.pop ();
-                    // store the key
-                    keys [subPoly.keyInfo.index / DIM] = 1;
-                    // check point count tolerance
-                    keyCount++;
-                    if (keyCount == countTol) {
-                        break;
-                    }
-                    // split the polyline at the key and recurse
-                    SubPolyAlt left (subPoly.first, subPoly.keyInfo.index);
-                    left.keyInfo = FindKey (coords, left.first, left.last);
-                    if (left.keyInfo.index) {
-                        queue.push (left);
-                    }
-                    SubPolyAlt right (subPoly.keyInfo.index, subPoly.last);
-                    right.keyInfo = FindKey (coords, right.first, right.last);
-                    if (right.keyInfo.index) {
-                        queue.push (right);
-                    }
-                }
+        //! \brief Returns one beyond the last coordinate of the keys copied so far.
+        OutputIterator Result () const {
+            return result;
+        }
+
+        //! \brief Returns the number of points pushed after the last key.
+        unsigned Delay () const {
+            return delay;
+        }
+
+    protected:
+        StreamSimplification (OutputIterator result, unsigned maxDelay) :
+            result (result),
+            pointCount (0),
+            maxDelay (maxDelay),
+            delay (0)
+        {}
+
+        //! \brief Copies the coordinates of a point to point.
+        template <class InputIterator>
+        static void Store (InputIterator first, value_type* point) {
+            for (unsigned d = 0; d < DIM; ++d) {
+                point [d] = *first;
+                ++first;
             }
+        }
 
-        private:
-            /*!
-                \brief Finds the key for the given sub polyline.
+        //! \brief Copies a key to the output iterator; count points were pushed after the key.
+        void CopyKey (const value_type* key, unsigned count) {
+            for (unsigned d = 0; d < DIM; ++d) {
+                *result = key [d];
+                ++result;
+            }
+            delay = count;
+        }
 
-                Finds the point in the range [first, last] that is furthest away from the
-                segment (first, last). This point is called the key.
+        //! \brief Registers a pushed point, and returns how many points preceded it (max 2).
+        unsigned Count () {
+            unsigned count = pointCount;
+            if (pointCount < 2) {
+                ++pointCount;
+            }
+            ++delay;
+            return count;
+        }
 
-                \param[in] coords   array of polyline coordinates
-                \param[in] first    the first coordinate of the first polyline point
-                \param[in] last     the first coordinate of the last polyline point
-                \return             the index of the key and its distance, or last when a key
-                                    could not be found
-            */
-            static KeyInfo FindKey (
-                const value_type* coords,
-                ptr_diff_type first,
-                ptr_diff_type last)
-            {
-                KeyInfo keyInfo;
+        //! \brief Indicates if the maximum delay is reached, and the most recent point must be a key.
+        bool Overdue () const {
+            return maxDelay && maxDelay <= delay;
+        }
 
-                for (ptr_diff_type current = first + DIM; current < last; current += DIM) {
-                    value_type d2 = math::segment_distance2 <DIM> (coords + first, coords + last,
-                                                                   coords + current);
-                    if (d2 < keyInfo.dist2) {
-                        continue;
-                    }
-                    // update maximum squared distance and the point it belongs to
-                    keyInfo.index = current;
-                    keyInfo.dist2 = d2;
+        //! \brief Resets the state of the current polyline.
+        void Reset () {
+            pointCount = 0;
+            delay = 0;
+        }
+
+    protected:
+        OutputIterator result;  //! destination of the keys
+        unsigned pointCount;    //! number of pushed points of the current polyline, saturates at 2
+        unsigned maxDelay;      //! maximum number of points after the last key; 0 for unbounded
+        unsigned delay;         //! number of pushed points after the last key
+    };
+
+    /*!
+        \brief Streaming version of the (radial) distance between points routine (RD).
+
+        \sa PolylineSimplification::RadialDistance, StreamSimplification
+    */
+    template <unsigned DIM, class T, class OutputIterator>
+    class RadialDistanceStream : public StreamSimplification <DIM, T, OutputIterator>
+    {
+        typedef StreamSimplification <DIM, T, OutputIterator> base;
+
+    public:
+        /*!
+            \param[in] tol          radial (point-to-point) distance tolerance
+            \param[in] result       destination of the simplified polylines
+            \param[in] maxDelay     maximum number of points after the last key; 0 for unbounded
+        */
+        RadialDistanceStream (T tol, OutputIterator result, unsigned maxDelay = 0) :
+            base (result, maxDelay),
+            tol2 (tol * tol),
+            pending (false)
+        {}
+
+        //! \brief Adds the point whose first coordinate is first.
+        template <class InputIterator>
+        void Push (InputIterator first) {
+            base::Store (first, last);
+            if (this->Count () && math::point_distance2 <DIM> (key, last) < tol2) {
+                pending = true;
+                if (this->Overdue ()) {
+                    ForceKey ();
                 }
-                return keyInfo;
+                return;
             }
-        };
+            this->CopyKey (last, 0);
+            std::copy (last, last + DIM, key);
+            pending = false;
+        }
+
+        //! \brief Copies the most recent point as a key, unless it already is one.
+        void ForceKey () {
+            if (pending) {
+                this->CopyKey (last, 0);
+                std::copy (last, last + DIM, key);
+            }
+            pending = false;
+        }
+
+        //! \brief Completes the current polyline, and returns the end of the output range.
+        OutputIterator Flush () {
+            if (pending) {
+                this->CopyKey (last, 0);
+            }
+            pending = false;
+            this->Reset ();
+            return this->result;
+        }
+
+    private:
+        T tol2;             //! squared distance tolerance
+        T key [DIM];        //! the current key
+        T last [DIM];       //! the most recent point
+        bool pending;       //! indicates if last is not yet copied
     };
 
     /*!
-        \brief Performs the nth point routine (NP).
-
-        This is a convenience function that provides template type deduction for
-        PolylineSimplification::NthPoint.
+        \brief Streaming version of the perpendicular distance routine (PD).
 
-        \param[in] first    the first coordinate of the first polyline point
-        \param[in] last     one beyond the last coordinate of the last polyline point
-        \param[in] n        specifies 'each nth point'
-        \param[in] result   destination of the simplified polyline
-        \return             one beyond the last coordinate of the simplified polyline
+        \sa PolylineSimplification::PerpendicularDistance, StreamSimplification
     */
-    template <unsigned DIM, class ForwardIterator, class OutputIterator>
-    OutputIterator simplify_nth_point (
-        ForwardIterator first,
-        ForwardIterator last,
-        unsigned n,
-        OutputIterator result)
+    template <unsigned DIM, class T, class OutputIterator>
+    class PerpendicularDistanceStream : public StreamSimplification <DIM, T, OutputIterator>
     {
-        PolylineSimplification <DIM, ForwardIterator, OutputIterator> ps;
-        return ps.NthPoint (first, last, n, result);
-    }
-
-    /*!
-        \brief Performs the (radial) distance between points routine (RD).
+        typedef StreamSimplification <DIM, T, OutputIterator> base;
 
-        This is a convenience function that provides template type deduction for
-        PolylineSimplification::RadialDistance.
+    public:
+        /*!
+            \param[in] tol          perpendicular (segment-to-point) distance tolerance
+            \param[in] result       destination of the simplified polylines
+            \param[in] maxDelay     maximum number of points after the last key; 0 for unbounded
+        */
+        PerpendicularDistanceStream (T tol, OutputIterator result, unsigned maxDelay = 0) :
+            base (result, maxDelay),
+            tol2 (tol * tol),
+            pending (false)
+        {}
 
-        \param[in] first    the first coordinate of the first polyline point
-        \param[in] last     one beyond the last coordinate of the last polyline point
-        \param[in] tol      radial (point-to-point) distance tolerance
-        \param[in] result   destination of the simplified polyline
-        \return             one beyond the last coordinate of the simplified polyline
-    */
-    template <unsigned DIM, class ForwardIterator, class OutputIterator>
-    OutputIterator simplify_radial_distance (
-        ForwardIterator first,
-        ForwardIterator last,
-        typename std::iterator_traits <ForwardIterator>::value_type tol,
-        OutputIterator result)
-    {
-        PolylineSimplification <DIM, ForwardIterator, OutputIterator> ps;
-        return ps.RadialDistance (first, last, tol, result);
-    }
+        //! \brief Adds the point whose first coordinate is first.
+        template <class InputIterator>
+        void Push (InputIterator first) {
+            T p2 [DIM];
+            base::Store (first, p2);
+            if (!this->Count ()) {
+                // the first point is always part of the simplification
+                this->CopyKey (p2, 0);
+                std::copy (p2, p2 + DIM, p0);
+            }
+            else if (!pending) {
+                std::copy (p2, p2 + DIM, p1);
+                pending = true;
+            }
+            // test p1 against line segment S(p0, p2)
+            else if (math::segment_distance2 <DIM> (p0, p2, p1) < tol2) {
+                this->CopyKey (p2, 0);
+                std::copy (p2, p2 + DIM, p0);
+                pending = false;
+            }
+            else {
+                this->CopyKey (p1, 1);
+                std::copy (p1, p1 + DIM, p0);
+                std::copy (p2, p2 + DIM, p1);
+            }
+            if (this->Overdue ()) {
+                ForceKey ();
+            }
+        }
 
-    /*!
-        \brief Repeatedly performs the perpendicular distance routine (PD).
+        //! \brief Copies the most recent point as a key, unless it already is one.
+        void ForceKey () {
+            if (pending) {
+                this->CopyKey (p1, 0);
+                std::copy (p1, p1 + DIM, p0);
+            }
+            pending = false;
+        }
 
-        This is a convenience function that provides template type deduction for
-        PolylineSimplification::PerpendicularDistance.
+        //! \brief Completes the current polyline, and returns the end of the output range.
+        OutputIterator Flush () {
+            if (pending) {
+                this->CopyKey (p1, 0);
+            }
+            pending = false;
+            this->Reset ();
+            return this->result;
+        }
 
-        \param[in] first    the first coordinate of the first polyline point
-        \param[in] last     one beyond the last coordinate of the last polyline point
-        \param[in] tol      perpendicular (segment-to-point) distance tolerance
-        \param[in] repeat   the number of times to successively apply the PD routine.
-        \param[in] result   destination of the simplified polyline
-        \return             one beyond the last coordinate of the simplified polyline
-    */
-    template <unsigned DIM, class ForwardIterator, class OutputIterator>
-    OutputIterator simplify_perpendicular_distance (
-        ForwardIterator first,
-        ForwardIterator last,
-        typename std::iterator_traits <ForwardIterator>::value_type tol,
-        unsigned repeat,
-        OutputIterator result)
-    {
-        PolylineSimplification <DIM, ForwardIterator, OutputIterator> ps;
-        return ps.PerpendicularDistance (first, last, tol, repeat, result);
-    }
+    private:
+        T tol2;             //! squared distance tolerance
+        T p0 [DIM];         //! the current key
+        T p1 [DIM];         //! the point following p0, and the most recent point
+        bool pending;       //! indicates if p1 is defined
+    };
 
     /*!
-        \brief Performs the perpendicular distance routine (PD).
+        \brief Streaming version of Reumann-Witkam approximation (RW).
 
-        This is a convenience function that provides template type deduction for
-        PolylineSimplification::PerpendicularDistance.
-
-        \param[in] first    the first coordinate of the first polyline point
-        \param[in] last     one beyond the last coordinate of the last polyline point
-        \param[in] tol      perpendicular (segment-to-point) distance tolerance
-        \param[in] result   destination of the simplified polyline
-        \return             one beyond the last coordinate of the simplified polyline
+        \sa PolylineSimplification::ReumannWitkam, StreamSimplification
     */
-    template <unsigned DIM, class ForwardIterator, class OutputIterator>
-    OutputIterator simplify_perpendicular_distance (
-        ForwardIterator first,
-        ForwardIterator last,
-        typename std::iterator_traits <ForwardIterator>::value_type tol,
-        OutputIterator result)
+    template <unsigned DIM, class T, class OutputIterator>
+    class ReumannWitkamStream : public StreamSimplification <DIM, T, OutputIterator>
     {
-        PolylineSimplification <DIM, ForwardIterator, OutputIterator> ps;
-        return ps.PerpendicularDistance (first, last, tol, result);
-    }
+        typedef StreamSimplification <DIM, T, OutputIterator> base;
 
-    /*!
-        \brief Performs Reumann-Witkam polyline simplification (RW).
+    public:
+        /*!
+            \param[in] tol          perpendicular (point-to-line) distance tolerance
+            \param[in] result       destination of the simplified polylines
+            \param[in] maxDelay     maximum number of points after the last key; 0 for unbounded
+        */
+        ReumannWitkamStream (T tol, OutputIterator result, unsigned maxDelay = 0) :
+            base (result, maxDelay),
+            tol2 (tol * tol)
+        {}
 
-        This is a convenience function that provides template type deduction for
-        PolylineSimplification::ReumannWitkam.
+        //! \brief Adds the point whose first coordinate is first.
+        template <class InputIterator>
+        void Push (InputIterator first) {
+            T pj [DIM];
+            base::Store (first, pj);
+            switch (this->Count ()) {
+            case 0:
+                // the first point is always part of the simplification
+                this->CopyKey (pj, 0);
+                std::copy (pj, pj + DIM, p0);
+                break;
+            case 1:
+                std::copy (pj, pj + DIM, p1);
+                break;
+            default:
+                if (math::line_distance2 <DIM> (p0, p1, pj) < tol2) {
+                    break;
+                }
+                // found the next key at pi; define new line L(pi, pj)
+                this->CopyKey (pi, 1);
+                std::copy (pi, pi + DIM, p0);
+                std::copy (pj, pj + DIM, p1);
+                break;
+            }
+            std::copy (pj, pj + DIM, pi);
+            if (this->Overdue ()) {
+                ForceKey ();
+            }
+        }
 
-        \param[in] first    the first coordinate of the first polyline point
-        \param[in] last     one beyond the last coordinate of the last polyline point
-        \param[in] tol      perpendicular (point-to-line) distance tolerance
-        \param[in] result   destination of the simplified polyline
-        \return             one beyond the last coordinate of the simplified polyline
-    */
-    template <unsigned DIM, class ForwardIterator, class OutputIterator>
-    OutputIterator simplify_reumann_witkam (
-        ForwardIterator first,
-        ForwardIterator last,
-        typename std::iterator_traits <ForwardIterator>::value_type tol,
-        OutputIterator result)
-    {
-        PolylineSimplification <DIM, ForwardIterator, OutputIterator> ps;
-        return ps.ReumannWitkam (first, last, tol, result);
-    }
+        //! \brief Copies the most recent point as a key, unless it already is one.
+        void ForceKey () {
+            if (!this->delay) {
+                return;
+            }
+            // restart at pi, as if it were the first point
+            this->CopyKey (pi, 0);
+            std::copy (pi, pi + DIM, p0);
+            this->pointCount = 1;
+        }
 
-    /*!
-        \brief Performs Opheim polyline simplification (OP).
+        //! \brief Completes the current polyline, and returns the end of the output range.
+        OutputIterator Flush () {
+            if (this->delay) {
+                // the last point is always part of the simplification
+                this->CopyKey (pi, 0);
+            }
+            this->Reset ();
+            return this->result;
+        }
 
-        This is a convenience function that provides template type deduction for
-        PolylineSimplification::Opheim.
+    private:
+        T tol2;             //! squared distance tolerance
+        T p0 [DIM];         //! the current key, defines L(p0, p1)
+        T p1 [DIM];         //! the point following p0
+        T pi [DIM];         //! the most recent point
+    };
 
-        \param[in] first    the first coordinate of the first polyline point
-        \param[in] last     one beyond the last coordinate of the last polyline point
-        \param[in] min_tol  minimum distance tolerance
-        \param[in] max_tol  maximum distance tolerance
-        \param[in] result   destination of the simplified polyline
-        \return             one beyond the last coordinate of the simplified polyline
+    /*!
+        \brief Streaming version of Opheim approximation (OP).
+
+        \sa PolylineSimplification::Opheim, StreamSimplification
     */
-    template <unsigned DIM, class ForwardIterator, class OutputIterator>
-    OutputIterator simplify_opheim (
-        ForwardIterator first,
-        ForwardIterator last,
-        typename std::iterator_traits <ForwardIterator>::value_type min_tol,
-        typename std::iterator_traits <ForwardIterator>::value_type max_tol,
-        OutputIterator result)
+    template <unsigned DIM, class T, class OutputIterator>
+    class OpheimStream : public StreamSimplification <DIM, T, OutputIterator>
     {
-        PolylineSimplification <DIM, ForwardIterator, OutputIterator> ps;
-        return ps.Opheim (first, last, min_tol, max_tol, result);
-    }
+        typedef StreamSimplification <DIM, T, OutputIterator> base;
 
-    /*!
-        \brief Performs Lang polyline simplification (LA).
+    public:
+        /*!
+            \param[in] min_tol      radial and perpendicular (point-to-ray) distance tolerance
+            \param[in] max_tol      radial distance tolerance
+            \param[in] result       destination of the simplified polylines
+            \param[in] maxDelay     maximum number of points after the last key; 0 for unbounded
+        */
+        OpheimStream (T min_tol, T max_tol, OutputIterator result, unsigned maxDelay = 0) :
+            base (result, maxDelay),
+            min_tol2 (min_tol * min_tol),
+            max_tol2 (max_tol * max_tol),
+            rayDefined (false)
+        {}
+
+        //! \brief Adds the point whose first coordinate is first.
+        template <class InputIterator>
+        void Push (InputIterator first) {
+            T pj [DIM];
+            base::Store (first, pj);
+            switch (this->Count ()) {
+            case 0:
+                // the first point is always part of the simplification
+                this->CopyKey (pj, 0);
+                std::copy (pj, pj + DIM, r0);
+                break;
+            case 1:
+                break;
+            default:
+                if (min_tol2 == 0 || max_tol2 == 0) {
+                    // invalid tolerances: like Opheim, all points are keys
+                    this->CopyKey (pi, 1);
+                    break;
+                }
+                if (!rayDefined) {
+                    // discard each point within minimum tolerance
+                    if (math::point_distance2 <DIM> (r0, pj) < min_tol2) {
+                        break;
+                    }
+                    // the last point within minimum tolerance pi defines the ray R(r0, r1)
+                    std::copy (pi, pi + DIM, r1);
+                    rayDefined = true;
+                }
+                // check each point pj against R(r0, r1)
+                if (math::point_distance2 <DIM> (r0, pj) < max_tol2 &&
+                    math::ray_distance2 <DIM> (r0, r1, pj) < min_tol2)
+                {
+                    break;
+                }
+                // found the next key at pi; define new ray R(pi, pj)
+                this->CopyKey (pi, 1);
+                std::copy (pi, pi + DIM, r0);
+                rayDefined = false;
+                break;
+            }
+            std::copy (pj, pj + DIM, pi);
+            if (this->Overdue ()) {
+                ForceKey ();
+            }
+        }
 
-        This is a convenience function that provides template type deduction for
-        PolylineSimplification::Lang.
+        //! \brief Copies the most recent point as a key, unless it already is one.
+        void ForceKey () {
+            if (!this->delay) {
+                return;
+            }
+            // restart at pi, as if it were the first point
+            this->CopyKey (pi, 0);
+            std::copy (pi, pi + DIM, r0);
+            rayDefined = false;
+            this->pointCount = 1;
+        }
 
-        \param[in] first      the first coordinate of the first polyline point
-        \param[in] last       one beyond the last coordinate of the last polyline point
-        \param[in] tol        perpendicular (point-to-segment) distance tolerance
-        \param[in] look_ahead defines the size of the search region
-        \param[in] result     destination of the simplified polyline
-        \return               one beyond the last coordinate of the simplified polyline
-    */
-    template <unsigned DIM, class BidirectionalIterator, class OutputIterator>
-    OutputIterator simplify_lang (
-        BidirectionalIterator first,
-        BidirectionalIterator last,
-        typename std::iterator_traits <BidirectionalIterator>::value_type tol,
-        unsigned look_ahead,
-        OutputIterator result)
-    {
-        PolylineSimplification <DIM, BidirectionalIterator, OutputIterator> ps;
-        return ps.Lang (first, last, tol, look_ahead, result);
-    }
+        //! \brief Completes the current polyline, and returns the end of the output range.
+        OutputIterator Flush () {
+            if (this->delay) {
+                // the last point is always part of the simplification
+                this->CopyKey (pi, 0);
+            }
+            rayDefined = false;
+            this->Reset ();
+            return this->result;
+        }
+
+    private:
+        T min_tol2;         //! squared minimum distance tolerance
+        T max_tol2;         //! squared maximum distance tolerance
+        T r0 [DIM];         //! the current key, start of the ray R(r0, r1)
+        T r1 [DIM];         //! a point on the ray
+        T pi [DIM];         //! the most recent point
+        bool rayDefined;
+    };
 
     /*!
-        \brief Performs Douglas-Peucker polyline simplification (DP).
+        \brief Creates a stream for the (radial) distance between points routine (RD).
 
         This is a convenience function that provides template type deduction for
-        PolylineSimplification::DouglasPeucker.
+        RadialDistanceStream.
 
-        \param[in] first    the first coordinate of the first polyline point
-        \param[in] last     one beyond the last coordinate of the last polyline point
-        \param[in] tol      perpendicular (point-to-segment) distance tolerance
-        \param[in] result   destination of the simplified polyline
-        \return             one beyond the last coordinate of the simplified polyline
+        \param[in] tol          radial (point-to-point) distance tolerance
+        \param[in] result       destination of the simplified polylines
+        \param[in] maxDelay     maximum number of points after the last key; 0 for unbounded
+        \return                 the stream
     */
-    template <unsigned DIM, class ForwardIterator, class OutputIterator>
-    OutputIterator simplify_douglas_peucker (
-        ForwardIterator first,
-        ForwardIterator last,
-        typename std::iterator_traits <ForwardIterator>::value_type tol,
-        OutputIterator result)
+    template <unsigned DIM, class T, class OutputIterator>
+    RadialDistanceStream <DIM, T, OutputIterator> make_radial_distance_stream (
+        T tol,
+        OutputIterator result,
+        unsigned maxDelay = 0)
     {
-        PolylineSimplification <DIM, ForwardIterator, OutputIterator> ps;
-        return ps.DouglasPeucker (first, last, tol, result);
+        return RadialDistanceStream <DIM, T, OutputIterator> (tol, result, maxDelay);
     }
 
     /*!
-        \brief Performs a variant of Douglas-Peucker polyline simplification (DPn).
+        \brief Creates a stream for the perpendicular distance routine (PD).
 
         This is a convenience function that provides template type deduction for
-        PolylineSimplification::DouglasPeuckerAlt.
+        PerpendicularDistanceStream.
 
-        \param[in] first    the first coordinate of the first polyline point
-        \param[in] last     one beyond the last coordinate of the last polyline point
-        \param[in] count    the maximum number of points of the simplified polyline
-        \param[in] result   destination of the simplified polyline
-        \return             one beyond the last coordinate of the simplified polyline
+        \param[in] tol          perpendicular (segment-to-point) distance tolerance
+        \param[in] result       destination of the simplified polylines
+        \param[in] maxDelay     maximum number of points after the last key; 0 for unbounded
+        \return                 the stream
     */
-    template <unsigned DIM, class ForwardIterator, class OutputIterator>
-    OutputIterator simplify_douglas_peucker_n (
-        ForwardIterator first,
-        ForwardIterator last,
-        unsigned count,
-        OutputIterator result)
+    template <unsigned DIM, class T, class OutputIterator>
+    PerpendicularDistanceStream <DIM, T, OutputIterator> make_perpendicular_distance_stream (
+        T tol,
+        OutputIterator result,
+        unsigned maxDelay = 0)
     {
-        PolylineSimplification <DIM, ForwardIterator, OutputIterator> ps;
-        return ps.DouglasPeuckerN (first, last, count, result);
+        return PerpendicularDistanceStream <DIM, T, OutputIterator> (tol, result, maxDelay);
     }
 
     /*!
-        \brief Computes the squared positional error between a polyline and its simplification.
+        \brief Creates a stream for Reumann-Witkam approximation (RW).
 
         This is a convenience function that provides template type deduction for
-        PolylineSimplification::ComputePositionalErrors2.
+        ReumannWitkamStream.
 
-        \param[in] original_first   the first coordinate of the first polyline point
-        \param[in] original_last    one beyond the last coordinate of the last polyline point
-        \param[in] simplified_first the first coordinate of the first simplified polyline point
-        \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
-        \param[in] result           destination of the squared positional errors
-        \param[out] valid           [optional] indicates if the computed positional errors are valid
-        \return                     one beyond the last computed positional error
+        \param[in] tol          perpendicular (point-to-line) distance tolerance
+        \param[in] result       destination of the simplified polylines
+        \param[in] maxDelay     maximum number of points after the last key; 0 for unbounded
+        \return                 the stream
     */
-    template <unsigned DIM, class ForwardIterator, class OutputIterator>
-    OutputIterator compute_positional_errors2 (
-        ForwardIterator original_first,
-        ForwardIterator original_last,
-        ForwardIterator simplified_first,
-        ForwardIterator simplified_last,
+    template <unsigned DIM, class T, class OutputIterator>
+    ReumannWitkamStream <DIM, T, OutputIterator> make_reumann_witkam_stream (
+        T tol,
         OutputIterator result,
-        bool* valid=0)
+        unsigned maxDelay = 0)
     {
-        PolylineSimplification <DIM, ForwardIterator, OutputIterator> ps;
-        return ps.ComputePositionalErrors2 (original_first, original_last, simplified_first, simplified_last, result, valid);
+        return ReumannWitkamStream <DIM, T, OutputIterator> (tol, result, maxDelay);
     }
 
     /*!
-        \brief Computes statistics for the positional errors between a polyline and its simplification.
+        \brief Creates a stream for Opheim approximation (OP).
 
         This is a convenience function that provides template type deduction for
-        PolylineSimplification::ComputePositionalErrorStatistics.
+        OpheimStream.
 
-        \param[in] original_first   the first coordinate of the first polyline point
-        \param[in] original_last    one beyond the last coordinate of the last polyline point
-        \param[in] simplified_first the first coordinate of the first simplified polyline point
-        \param[in] simplified_last  one beyond the last coordinate of the last simplified polyline point
-        \param[out] valid           [optional] indicates if the computed statistics are valid
-        \return                     the computed statistics
+        \param[in] min_tol      radial and perpendicular (point-to-ray) distance tolerance
+        \param[in] max_tol      radial distance tolerance
+        \param[in] result       destination of the simplified polylines
+        \param[in] maxDelay     maximum number of points after the last key; 0 for unbounded
+        \return                 the stream
     */
-    template <unsigned DIM, class ForwardIterator>
-    math::Statistics compute_positional_error_statistics (
-        ForwardIterator original_first,
-        ForwardIterator original_last,
-        ForwardIterator simplified_first,
-        ForwardIterator simplified_last,
-        bool* valid=0)
+    template <unsigned DIM, class T, class OutputIterator>
+    OpheimStream <DIM, T, OutputIterator> make_opheim_stream (
+        T min_tol,
+        T max_tol,
+        OutputIterator result,
+        unsigned maxDelay = 0)
     {
-        PolylineSimplification <DIM, ForwardIterator, ForwardIterator> ps;
-        return ps.ComputePositionalErrorStatistics (original_first, original_last, simplified_first, simplified_last, valid);
+        return OpheimStream <DIM, T, OutputIterator> (min_tol, max_tol, result, maxDelay);
     }
 }
 
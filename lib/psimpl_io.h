@@ -0,0 +1,507 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#ifndef PSIMPL_IO
+#define PSIMPL_IO
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+namespace psimpl
+{
+    /*!
+        \brief Contains a binary polyline file format, with a memory mapped reader and a writer.
+
+        A polyline file stores any number of polylines of the same dimension and coordinate type.
+        It consists of a FileHeader, followed by the packed coordinates of all polylines, followed
+        by a table of point offsets: entry i is the index of the first point of polyline i, and
+        the last entry is the total number of points. All values are stored in the native byte
+        order, which the reader verifies.
+
+        Because the coordinates are stored exactly like an array, a MappedFile exposes each
+        polyline as a pair of pointers that can be passed to any psimpl routine without copying.
+        The operating system pages the coordinates in and out as needed, so files can be much
+        larger than the available memory.
+    */
+    namespace io
+    {
+        //! \brief Coordinate type codes.
+        enum ScalarType {
+            FLOAT32 = 1,
+            FLOAT64 = 2,
+            INT32 = 3,
+            INT64 = 4
+        };
+
+        //! \brief Maps a coordinate type to its ScalarType.
+        template <class T> struct scalar_type;
+        template <> struct scalar_type <float> { static const ScalarType value = FLOAT32; };
+        template <> struct scalar_type <double> { static const ScalarType value = FLOAT64; };
+        template <> struct scalar_type <std::int32_t> { static const ScalarType value = INT32; };
+        template <> struct scalar_type <std::int64_t> { static const ScalarType value = INT64; };
+
+        //! \brief Returns the size in bytes of a coordinate of the given type; 0 if unknown.
+        inline std::size_t scalar_size (std::uint32_t type) {
+            switch (type) {
+            case FLOAT32:   return 4;
+            case FLOAT64:   return 8;
+            case INT32:     return 4;
+            case INT64:     return 8;
+            }
+            return 0;
+        }
+
+        /*!
+            \brief The first 64 bytes of a polyline file.
+        */
+        struct FileHeader
+        {
+            static const std::uint32_t VERSION = 1;
+            static const std::uint32_t ORDER_MARK = 0x01020304;
+
+            char magic [8];                 //! "PSIMPL\0\0"
+            std::uint32_t version;          //! format version
+            std::uint32_t byteOrder;        //! ORDER_MARK, as written by the creating machine
+            std::uint32_t dim;              //! dimension of all polylines
+            std::uint32_t type;             //! ScalarType of all coordinates
+            std::uint64_t polylineCount;    //! number of polylines
+            std::uint64_t coordsOffset;     //! file offset of the first coordinate
+            std::uint64_t offsetsOffset;    //! file offset of the point offset table
+            std::uint64_t reserved [2];
+
+            FileHeader () {
+                std::memset (this, 0, sizeof (FileHeader));
+                std::memcpy (magic, "PSIMPL\0\0", sizeof (magic));
+                version = VERSION;
+                byteOrder = ORDER_MARK;
+            }
+        };
+
+        /*!
+            \brief Provides read-only access to a memory mapped polyline file.
+        */
+        class MappedFile
+        {
+        public:
+            MappedFile () :
+                data (0),
+                size (0),
+                offsets (0)
+#ifdef _WIN32
+                , file (INVALID_HANDLE_VALUE)
+                , mapping (0)
+#endif
+            {}
+
+            ~MappedFile () {
+                Close ();
+            }
+
+            /*!
+                \brief Maps the file, and validates its header and point offsets.
+
+                \param[in] path     the file to open
+                \return             true when the file is a valid polyline file; false otherwise,
+                                    in which case Error describes the problem
+            */
+            bool Open (const char* path) {
+                Close ();
+                if (!Map (path)) {
+                    return false;
+                }
+                if (size < sizeof (FileHeader)) {
+                    return Fail ("file too small");
+                }
+                std::memcpy (&header, data, sizeof (FileHeader));
+                if (std::memcmp (header.magic, FileHeader ().magic, sizeof (header.magic))) {
+                    return Fail ("not a polyline file");
+                }
+                if (header.version != FileHeader::VERSION) {
+                    return Fail ("unsupported version");
+                }
+                if (header.byteOrder != FileHeader::ORDER_MARK) {
+                    return Fail ("unsupported byte order");
+                }
+                std::size_t scalarSize = scalar_size (header.type);
+                if (!header.dim || !scalarSize) {
+                    return Fail ("invalid dimension or coordinate type");
+                }
+                // sizes are validated by division, as products of header fields may overflow
+                if (header.offsetsOffset % sizeof (std::uint64_t) || header.coordsOffset % scalarSize ||
+                    header.offsetsOffset > size ||
+                    (size - header.offsetsOffset) / sizeof (std::uint64_t) <= header.polylineCount)
+                {
+                    return Fail ("invalid point offset table");
+                }
+                offsets = reinterpret_cast <const std::uint64_t*> (data + header.offsetsOffset);
+                for (std::uint64_t i = 0; i < header.polylineCount; ++i) {
+                    if (offsets [i+1] < offsets [i]) {
+                        return Fail ("invalid point offsets");
+                    }
+                }
+                if (offsets [0] || header.coordsOffset > header.offsetsOffset ||
+                    (header.offsetsOffset - header.coordsOffset) / (header.dim * scalarSize) <
+                        offsets [header.polylineCount])
+                {
+                    return Fail ("invalid point offsets");
+                }
+                return true;
+            }
+
+            //! \brief Unmaps the file.
+            void Close () {
+                if (data) {
+#ifdef _WIN32
+                    UnmapViewOfFile (data);
+#else
+                    munmap (const_cast <char*> (data), size);
+#endif
+                }
+#ifdef _WIN32
+                if (mapping) {
+                    CloseHandle (mapping);
+                }
+                if (file != INVALID_HANDLE_VALUE) {
+                    CloseHandle (file);
+                }
+                file = INVALID_HANDLE_VALUE;
+                mapping = 0;
+#endif
+                data = 0;
+                size = 0;
+                offsets = 0;
+                header = FileHeader ();
+            }
+
+            bool IsOpen () const {
+                return offsets != 0;
+            }
+
+            const std::string& Error () const {
+                return error;
+            }
+
+            unsigned Dim () const {
+                return header.dim;
+            }
+
+            ScalarType Type () const {
+                return static_cast <ScalarType> (header.type);
+            }
+
+            //! \brief Returns the number of polylines.
+            std::size_t PolylineCount () const {
+                return static_cast <std::size_t> (header.polylineCount);
+            }
+
+            //! \brief Returns the number of points of polyline i.
+            std::size_t PointCount (std::size_t i) const {
+                return static_cast <std::size_t> (offsets [i+1] - offsets [i]);
+            }
+
+            /*!
+                \brief Returns the coordinates of polyline i as the range [first, last).
+
+                \return     true on success; false when T does not match the coordinate type
+            */
+            template <class T>
+            bool Polyline (std::size_t i, const T*& first, const T*& last) const {
+                if (!IsOpen () || scalar_type <T>::value != header.type || PolylineCount () <= i) {
+                    return false;
+                }
+                const T* coords = reinterpret_cast <const T*> (data + header.coordsOffset);
+                first = coords + offsets [i] * header.dim;
+                last = coords + offsets [i+1] * header.dim;
+                return true;
+            }
+
+        private:
+            MappedFile (const MappedFile&);
+            MappedFile& operator = (const MappedFile&);
+
+            bool Fail (const char* message) {
+                Close ();
+                error = message;
+                return false;
+            }
+
+            bool Map (const char* path) {
+#ifdef _WIN32
+                file = CreateFileA (path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+                                    FILE_FLAG_SEQUENTIAL_SCAN, 0);
+                LARGE_INTEGER fileSize;
+                if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx (file, &fileSize)) {
+                    return Fail ("cannot open file");
+                }
+                size = static_cast <std::size_t> (fileSize.QuadPart);
+                mapping = size ? CreateFileMappingA (file, 0, PAGE_READONLY, 0, 0, 0) : 0;
+                data = mapping ? static_cast <const char*> (MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0)) : 0;
+#else
+                int fd = open (path, O_RDONLY);
+                struct stat status;
+                if (fd < 0 || fstat (fd, &status)) {
+                    if (0 <= fd) {
+                        close (fd);
+                    }
+                    return Fail ("cannot open file");
+                }
+                size = static_cast <std::size_t> (status.st_size);
+                void* address = size ? mmap (0, size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+                close (fd);
+                if (address != MAP_FAILED) {
+                    data = static_cast <const char*> (address);
+                    madvise (address, size, MADV_SEQUENTIAL);
+                }
+#endif
+                if (!data) {
+                    return Fail ("cannot map file");
+                }
+                return true;
+            }
+
+        private:
+            const char* data;                   //! the mapped file
+            std::size_t size;                   //! size of the mapped file in bytes
+            const std::uint64_t* offsets;       //! the point offset table
+            FileHeader header;
+            std::string error;
+#ifdef _WIN32
+            HANDLE file;
+            HANDLE mapping;
+#endif
+        };
+
+        /*!
+            \brief Writes a polyline file, using a fixed amount of memory per polyline.
+
+            The coordinates of each polyline are written through an output iterator, f.e. as the
+            result of a simplification. Only the point offsets are kept in memory until Close.
+        */
+        class FileWriter
+        {
+        public:
+            /*!
+                \brief Output iterator that appends coordinates of type T to the current polyline.
+            */
+            template <class T>
+            class iterator
+            {
+            public:
+                typedef std::output_iterator_tag iterator_category;
+                typedef void value_type;
+                typedef void difference_type;
+                typedef void pointer;
+                typedef void reference;
+
+                explicit iterator (FileWriter& writer) :
+                    writer (&writer)
+                {}
+
+                iterator& operator * () { return *this; }
+                iterator& operator ++ () { return *this; }
+                iterator& operator ++ (int) { return *this; }
+
+                iterator& operator = (T value) {
+                    writer->Append (&value, sizeof (T));
+                    return *this;
+                }
+
+            private:
+                FileWriter* writer;
+            };
+
+            FileWriter () :
+                file (0),
+                coordCount (0),
+                written (0)
+            {}
+
+            ~FileWriter () {
+                Close ();
+            }
+
+            /*!
+                \brief Creates the file, for polylines of dimension dim and coordinate type type.
+            */
+            bool Open (const char* path, unsigned dim, ScalarType type) {
+                Close ();
+                error.clear ();
+                if (!dim || !scalar_size (type)) {
+                    error = "invalid dimension or coordinate type";
+                    return false;
+                }
+                file = std::fopen (path, "wb");
+                if (!file) {
+                    error = "cannot create file";
+                    return false;
+                }
+                header = FileHeader ();
+                header.dim = dim;
+                header.type = type;
+                header.coordsOffset = sizeof (FileHeader);
+                offsets.assign (1, 0);
+                buffer.reserve (BUFFER_SIZE);
+                coordCount = 0;
+                written = 0;
+                return Write (&header, sizeof (FileHeader));
+            }
+
+            //! \brief Returns an output iterator that appends coordinates of type T.
+            template <class T>
+            iterator <T> Output () {
+                return iterator <T> (*this);
+            }
+
+            /*!
+                \brief Ends the current polyline.
+
+                \return     false when the polyline contains an incomplete point, or when a write
+                            failed
+            */
+            bool EndPolyline () {
+                std::uint64_t pointCount = coordCount / header.dim;
+                if (coordCount % header.dim) {
+                    error = "incomplete point";
+                    return false;
+                }
+                offsets.push_back (pointCount);
+                return error.empty ();
+            }
+
+            /*!
+                \brief Writes the point offset table and the header, and closes the file.
+
+                Coordinates of a polyline that was not ended are discarded.
+            */
+            bool Close () {
+                if (!file) {
+                    return false;
+                }
+                std::size_t scalarSize = scalar_size (header.type);
+                Flush ();
+                // discard unfinished polyline and align the offset table
+                std::uint64_t end = header.coordsOffset + offsets.back () * header.dim * scalarSize;
+                end += (sizeof (std::uint64_t) - end % sizeof (std::uint64_t)) % sizeof (std::uint64_t);
+                bool ok = error.empty () && !std::fseek (file, 0, SEEK_END);
+                while (ok && written < end) {
+                    ok = Write ("", 1);
+                }
+                header.polylineCount = offsets.size () - 1;
+                header.offsetsOffset = end;
+                ok = ok && !Seek (end) && Write (&offsets [0], offsets.size () * sizeof (std::uint64_t));
+                ok = ok && !Seek (0) && Write (&header, sizeof (FileHeader));
+                ok = std::fclose (file) == 0 && ok;
+                file = 0;
+                offsets.clear ();
+                if (!ok && error.empty ()) {
+                    error = "write failed";
+                }
+                return ok;
+            }
+
+            const std::string& Error () const {
+                return error;
+            }
+
+        private:
+            FileWriter (const FileWriter&);
+            FileWriter& operator = (const FileWriter&);
+
+            static const std::size_t BUFFER_SIZE = 1 << 16;
+
+            void Append (const void* value, std::size_t bytes) {
+                const char* p = static_cast <const char*> (value);
+                buffer.insert (buffer.end (), p, p + bytes);
+                coordCount += 1;
+                if (BUFFER_SIZE <= buffer.size ()) {
+                    Flush ();
+                }
+            }
+
+            void Flush () {
+                if (!buffer.empty ()) {
+                    Write (&buffer [0], buffer.size ());
+                    buffer.clear ();
+                }
+            }
+
+            bool Write (const void* bytes, std::size_t count) {
+                if (std::fwrite (bytes, 1, count, file) != count) {
+                    error = "write failed";
+                    return false;
+                }
+                written += count;
+                return true;
+            }
+
+            int Seek (std::uint64_t offset) {
+#ifdef _WIN32
+                return _fseeki64 (file, static_cast <__int64> (offset), SEEK_SET);
+#else
+                return fseeko (file, static_cast <off_t> (offset), SEEK_SET);
+#endif
+            }
+
+        private:
+            std::FILE* file;
+            FileHeader header;
+            std::vector <std::uint64_t> offsets;    //! first point of each polyline, and total
+            std::vector <char> buffer;              //! coordinates not yet written
+            std::uint64_t coordCount;               //! number of coordinates appended
+            std::uint64_t written;                  //! number of bytes written
+            std::string error;
+        };
+    }
+}
+
+
+#endif // PSIMPL_IO
@@ -0,0 +1,225 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#include "TestBatch.h"
+#include "test.h"
+#include "helper.h"
+#include "../lib/psimpl.h"
+#include <vector>
+
+
+namespace psimpl {
+    namespace test
+{
+    // creates a batch of random walks with 0 up to maxPointCount points
+    template <unsigned DIM>
+    void CreateBatch (unsigned polylineCount, unsigned maxPointCount,
+                      std::vector <double>& coords, std::vector <std::size_t>& offsets)
+    {
+        RandomWalkLine <double, DIM> walk (1, 2);
+        offsets.assign (1, 0);
+        for (unsigned i = 0; i < polylineCount; ++i) {
+            unsigned pointCount = (i * 7919) % (maxPointCount + 1);
+            std::generate_n (std::back_inserter (coords), pointCount*DIM, walk);
+            offsets.push_back (coords.size ());
+        }
+    }
+
+    // simplifies each polyline of a batch separately, and compares it with the batch result
+    template <unsigned DIM, class Routine>
+    bool CompareBatch (const std::vector <double>& coords, const std::vector <std::size_t>& offsets,
+                       const std::vector <double>& result, const std::vector <std::size_t>& resultOffsets,
+                       std::size_t resultCount, Routine routine)
+    {
+        std::vector <double> expected;
+        if (resultOffsets [0] != 0) {
+            return false;
+        }
+        for (std::size_t i = 0; i+1 < offsets.size (); ++i) {
+            routine (coords.begin () + offsets [i], coords.begin () + offsets [i+1],
+                     std::back_inserter (expected));
+            if (resultOffsets [i+1] != expected.size ()) {
+                return false;
+            }
+        }
+        return resultCount == expected.size () &&
+               std::equal (expected.begin (), expected.end (), result.begin ());
+    }
+
+    typedef std::vector <double>::const_iterator const_iterator;
+    typedef std::back_insert_iterator <std::vector <double> > back_iterator;
+
+    TestBatch::TestBatch () {
+        TEST_RUN("empty", TestEmpty ());
+        TEST_RUN("invalid polylines", TestInvalidPolylines ());
+        TEST_RUN("routines", TestRoutines ());
+        TEST_RUN("thread count", TestThreadCount ());
+    }
+
+    void TestBatch::TestEmpty () {
+        const unsigned DIM = 2;
+        BatchSimplification <DIM, double> batch (4);
+        double coords [1] = {0};
+        std::size_t offsets [1] = {0};
+        double result [1];
+        std::size_t resultOffsets [1] = {1};
+
+        ASSERT_TRUE(batch.DouglasPeucker (coords, offsets, 0, 1., result, resultOffsets) == 0);
+        VERIFY_TRUE(resultOffsets [0] == 0);
+    }
+
+    // polylines that are too small or contain an incomplete point are copied
+    void TestBatch::TestInvalidPolylines () {
+        const unsigned DIM = 2;
+        double coords [] = {0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6};
+        std::size_t offsets [] = {0, 2, 6, 6, 13};
+        double result [13];
+        std::size_t resultOffsets [5];
+
+        BatchSimplification <DIM, double> batch (2);
+        ASSERT_TRUE(batch.RadialDistance (coords, offsets, 4, 10., result, resultOffsets) == 13);
+        VERIFY_TRUE(std::equal (offsets, offsets + 5, resultOffsets));
+        VERIFY_TRUE(std::equal (coords, coords + 13, result));
+    }
+
+    void TestBatch::TestRoutines () {
+        const unsigned DIM = 2;
+        std::vector <double> coords;
+        std::vector <std::size_t> offsets;
+        CreateBatch <DIM> (500, 200, coords, offsets);
+        std::size_t polylineCount = offsets.size () - 1;
+
+        std::vector <double> result (coords.size ());
+        std::vector <std::size_t> resultOffsets (offsets.size ());
+        BatchSimplification <DIM, double> batch (3);
+        std::size_t count = 0;
+
+        count = batch.NthPoint (&coords [0], &offsets [0], polylineCount, 5, &result [0], &resultOffsets [0]);
+        VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_nth_point <DIM> (first, last, 5, out);
+            }));
+
+        count = batch.RadialDistance (&coords [0], &offsets [0], polylineCount, 2., &result [0], &resultOffsets [0]);
+        VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_radial_distance <DIM> (first, last, 2., out);
+            }));
+
+        count = batch.PerpendicularDistance (&coords [0], &offsets [0], polylineCount, 2., &result [0], &resultOffsets [0]);
+        VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_perpendicular_distance <DIM> (first, last, 2., out);
+            }));
+
+        count = batch.PerpendicularDistance (&coords [0], &offsets [0], polylineCount, 2., 3, &result [0], &resultOffsets [0]);
+        VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_perpendicular_distance <DIM> (first, last, 2., 3, out);
+            }));
+
+        count = batch.ReumannWitkam (&coords [0], &offsets [0], polylineCount, 2., &result [0], &resultOffsets [0]);
+        VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_reumann_witkam <DIM> (first, last, 2., out);
+            }));
+
+        count = batch.Opheim (&coords [0], &offsets [0], polylineCount, 2., 10., &result [0], &resultOffsets [0]);
+        VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_opheim <DIM> (first, last, 2., 10., out);
+            }));
+
+        count = batch.Lang (&coords [0], &offsets [0], polylineCount, 2., 10, &result [0], &resultOffsets [0]);
+        VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_lang <DIM> (first, last, 2., 10, out);
+            }));
+
+        count = batch.DouglasPeucker (&coords [0], &offsets [0], polylineCount, 2., &result [0], &resultOffsets [0]);
+        VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_douglas_peucker <DIM> (first, last, 2., out);
+            }));
+
+        count = batch.DouglasPeuckerHull (&coords [0], &offsets [0], polylineCount, 2., &result [0], &resultOffsets [0]);
+        VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_douglas_peucker_hull <DIM> (first, last, 2., out);
+            }));
+
+        count = batch.DouglasPeuckerN (&coords [0], &offsets [0], polylineCount, 20, &result [0], &resultOffsets [0]);
+        VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_douglas_peucker_n <DIM> (first, last, 20, out);
+            }));
+
+        count = batch.VisvalingamWhyatt (&coords [0], &offsets [0], polylineCount, 4., &result [0], &resultOffsets [0]);
+        VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_visvalingam_whyatt <DIM> (first, last, 4., out);
+            }));
+
+        count = batch.VisvalingamWhyattN (&coords [0], &offsets [0], polylineCount, 20, &result [0], &resultOffsets [0]);
+        VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_visvalingam_whyatt_n <DIM> (first, last, 20, out);
+            }));
+    }
+
+    void TestBatch::TestThreadCount () {
+        const unsigned DIM = 3;
+        std::vector <double> coords;
+        std::vector <std::size_t> offsets;
+        CreateBatch <DIM> (1000, 100, coords, offsets);
+        std::size_t polylineCount = offsets.size () - 1;
+
+        unsigned threads [] = {0, 1, 2, 7, 2000};
+        for (unsigned t = 0; t < 5; ++t) {
+            std::vector <double> result (coords.size ());
+            std::vector <std::size_t> resultOffsets (offsets.size ());
+            BatchSimplification <DIM, double> batch (threads [t]);
+
+            // the same batch instance is reused
+            for (unsigned pass = 0; pass < 2; ++pass) {
+                double tol = 1. + pass;
+                std::size_t count = batch.DouglasPeucker (&coords [0], &offsets [0], polylineCount, tol,
+                                                          &result [0], &resultOffsets [0]);
+                VERIFY_TRUE(CompareBatch <DIM> (coords, offsets, result, resultOffsets, count,
+                    [tol] (const_iterator first, const_iterator last, back_iterator out) {
+                        simplify_douglas_peucker <DIM> (first, last, tol, out);
+                    }));
+            }
+        }
+    }
+}}
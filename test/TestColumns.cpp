@@ -0,0 +1,322 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#include "TestColumns.h"
+#include "test.h"
+#include "helper.h"
+#include "../lib/psimpl.h"
+#include <vector>
+
+
+namespace psimpl {
+    namespace test
+{
+    // stores the points of an interleaved polyline as DIM separate columns
+    template <unsigned DIM>
+    class Columns
+    {
+    public:
+        explicit Columns (std::size_t count) :
+            values (DIM, std::vector <double> (count))
+        {
+            for (unsigned d = 0; d < DIM; ++d) {
+                pointers [d] = &values [d][0];
+            }
+        }
+
+        explicit Columns (const std::vector <double>& coords) :
+            values (DIM, std::vector <double> (coords.size () / DIM))
+        {
+            for (unsigned d = 0; d < DIM; ++d) {
+                pointers [d] = &values [d][0];
+                for (std::size_t p = 0; p < coords.size () / DIM; ++p) {
+                    values [d][p] = coords [p*DIM + d];
+                }
+            }
+        }
+
+        double* const* Get () {
+            return pointers;
+        }
+
+        const double* const* Get () const {
+            return pointers;
+        }
+
+        // returns the first count points, interleaved
+        std::vector <double> Interleave (std::size_t count) const {
+            std::vector <double> coords;
+            for (std::size_t p = 0; p < count; ++p) {
+                for (unsigned d = 0; d < DIM; ++d) {
+                    coords.push_back (values [d][p]);
+                }
+            }
+            return coords;
+        }
+
+    private:
+        std::vector <std::vector <double> > values;
+        double* pointers [DIM];
+    };
+
+    typedef std::vector <double>::const_iterator const_iterator;
+    typedef std::back_insert_iterator <std::vector <double> > back_iterator;
+
+    // simplifies the interleaved polyline, and compares it with the column result
+    template <class Routine>
+    bool CompareColumns (const std::vector <double>& coords, const std::vector <double>& result,
+                         Routine routine)
+    {
+        std::vector <double> expected;
+        routine (coords.begin (), coords.end (), std::back_inserter (expected));
+        return result == expected;
+    }
+
+    TestColumns::TestColumns () {
+        TEST_RUN("invalid input", TestInvalidInput ());
+        TEST_RUN("routines", TestRoutines ());
+        TEST_RUN("outputs", TestOutputs ());
+        TEST_RUN("errors", TestErrors ());
+    }
+
+    // polylines that are too small are copied
+    void TestColumns::TestInvalidInput () {
+        const unsigned DIM = 2;
+        double coords [] = {0, 0, 1, 1};
+        Columns <DIM> input (std::vector <double> (coords, coords + 4));
+        Columns <DIM> result (2);
+
+        ColumnSimplification <DIM, double> cs;
+        ASSERT_TRUE(cs.DouglasPeucker (input.Get (), 0, 1., result.Get ()) == 0);
+        ASSERT_TRUE(cs.DouglasPeucker (input.Get (), 2, 1., result.Get ()) == 2);
+        VERIFY_TRUE(result.Interleave (2) == input.Interleave (2));
+        ASSERT_TRUE(cs.RadialDistance (input.Get (), 2, 0., result.Get ()) == 2);
+        VERIFY_TRUE(result.Interleave (2) == input.Interleave (2));
+    }
+
+    void TestColumns::TestRoutines () {
+        const unsigned DIM = 3;
+        std::vector <double> coords;
+        std::generate_n (std::back_inserter (coords), 5000*DIM, RandomWalkLine <double, DIM> (1, 2));
+        const std::size_t count = coords.size () / DIM;
+        Columns <DIM> input (coords);
+        Columns <DIM> result (count);
+
+        // the same instance is reused for all routines
+        ColumnSimplification <DIM, double> cs;
+        std::size_t n = 0;
+
+        n = cs.NthPoint (input.Get (), count, 5, result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_nth_point <DIM> (first, last, 5, out);
+            }));
+
+        n = cs.RadialDistance (input.Get (), count, 2., result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_radial_distance <DIM> (first, last, 2., out);
+            }));
+
+        n = cs.PerpendicularDistance (input.Get (), count, 2., result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_perpendicular_distance <DIM> (first, last, 2., out);
+            }));
+
+        n = cs.PerpendicularDistance (input.Get (), count, 2., 3, result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_perpendicular_distance <DIM> (first, last, 2., 3, out);
+            }));
+
+        n = cs.ReumannWitkam (input.Get (), count, 2., result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_reumann_witkam <DIM> (first, last, 2., out);
+            }));
+
+        n = cs.Opheim (input.Get (), count, 2., 10., result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_opheim <DIM> (first, last, 2., 10., out);
+            }));
+
+        n = cs.Lang (input.Get (), count, 2., 10, result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_lang <DIM> (first, last, 2., 10, out);
+            }));
+
+        n = cs.DouglasPeucker (input.Get (), count, 2., result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_douglas_peucker <DIM> (first, last, 2., out);
+            }));
+
+        n = cs.DouglasPeuckerParallel (input.Get (), count, 2., 3, result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_douglas_peucker <DIM> (first, last, 2., out);
+            }));
+
+        n = cs.DouglasPeuckerChunked (input.Get (), count, 2., 1000, 3, result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_douglas_peucker_chunked <DIM> (first, last, 2., 1000, 3, out);
+            }));
+
+        n = cs.DouglasPeuckerHull (input.Get (), count, 2., result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_douglas_peucker_hull <DIM> (first, last, 2., out);
+            }));
+
+        n = cs.DouglasPeuckerN (input.Get (), count, 50, result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_douglas_peucker_n <DIM> (first, last, 50, out);
+            }));
+
+        n = cs.VisvalingamWhyatt (input.Get (), count, 4., result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_visvalingam_whyatt <DIM> (first, last, 4., out);
+            }));
+
+        n = cs.VisvalingamWhyattN (input.Get (), count, 50, result.Get ());
+        VERIFY_TRUE(CompareColumns (coords, result.Interleave (n),
+            [] (const_iterator first, const_iterator last, back_iterator out) {
+                simplify_visvalingam_whyatt_n <DIM> (first, last, 50, out);
+            }));
+    }
+
+    // routines that output indices, errors or levels besides, or instead of, the points
+    void TestColumns::TestOutputs () {
+        const unsigned DIM = 2;
+        std::vector <double> coords;
+        std::generate_n (std::back_inserter (coords), 5000*DIM, RandomWalkLine <double, DIM> (1, 2));
+        const std::size_t count = coords.size () / DIM;
+        Columns <DIM> input (coords);
+        Columns <DIM> result (count);
+        ColumnSimplification <DIM, double> cs;
+        {
+            std::vector <unsigned> expected, indices;
+            simplify_douglas_peucker_indices <DIM> (coords.begin (), coords.end (), 2.,
+                                                    std::back_inserter (expected));
+            cs.DouglasPeuckerIndices (input.Get (), count, 2., std::back_inserter (indices));
+            VERIFY_TRUE(indices == expected);
+
+            expected.clear ();
+            indices.clear ();
+            simplify_douglas_peucker_n_indices <DIM> (coords.begin (), coords.end (), 50,
+                                                      std::back_inserter (expected));
+            cs.DouglasPeuckerNIndices (input.Get (), count, 50, std::back_inserter (indices));
+            VERIFY_TRUE(indices == expected);
+        }
+        {
+            std::vector <double> expected, expectedErrors, errors;
+            simplify_douglas_peucker_errors <DIM> (coords.begin (), coords.end (), 2.,
+                std::back_inserter (expected), std::back_inserter (expectedErrors));
+            std::size_t n = cs.DouglasPeuckerErrors (input.Get (), count, 2., result.Get (),
+                                                     std::back_inserter (errors));
+            VERIFY_TRUE(result.Interleave (n) == expected);
+            VERIFY_TRUE(errors == expectedErrors);
+
+            expected.clear ();
+            expectedErrors.clear ();
+            errors.clear ();
+            simplify_douglas_peucker_n_errors <DIM> (coords.begin (), coords.end (), 50,
+                std::back_inserter (expected), std::back_inserter (expectedErrors));
+            n = cs.DouglasPeuckerNErrors (input.Get (), count, 50, result.Get (),
+                                          std::back_inserter (errors));
+            VERIFY_TRUE(result.Interleave (n) == expected);
+            VERIFY_TRUE(errors == expectedErrors);
+        }
+        {
+            const double tols [] = {1., 2., 4.};
+            std::vector <unsigned> expected, levels;
+            simplify_douglas_peucker_levels <DIM> (coords.begin (), coords.end (), tols, tols + 3,
+                                                   std::back_inserter (expected));
+            cs.DouglasPeuckerLevels (input.Get (), count, tols, tols + 3, std::back_inserter (levels));
+            VERIFY_TRUE(levels == expected);
+        }
+    }
+
+    void TestColumns::TestErrors () {
+        const unsigned DIM = 2;
+        std::vector <double> coords, simplified;
+        std::generate_n (std::back_inserter (coords), 5000*DIM, RandomWalkLine <double, DIM> (1, 2));
+        simplify_douglas_peucker <DIM> (coords.begin (), coords.end (), 3., std::back_inserter (simplified));
+        const std::size_t count = coords.size () / DIM;
+        const std::size_t simplifiedCount = simplified.size () / DIM;
+        Columns <DIM> original (coords);
+        Columns <DIM> simplification (simplified);
+        ColumnSimplification <DIM, double> cs;
+
+        std::vector <double> expected;
+        bool expectedValid = false;
+        compute_positional_errors2 <DIM> (coords.begin (), coords.end (), simplified.begin (), simplified.end (),
+                                          std::back_inserter (expected), &expectedValid);
+        ASSERT_TRUE(expectedValid);
+
+        std::vector <double> errors (count);
+        bool valid = false;
+        double* end = cs.ComputePositionalErrors2 (original.Get (), count, simplification.Get (),
+                                                   simplifiedCount, &errors [0], &valid);
+        VERIFY_TRUE(valid);
+        VERIFY_TRUE(end == &errors [0] + count);
+        VERIFY_TRUE(errors == expected);
+
+        std::fill (errors.begin (), errors.end (), 0.);
+        valid = false;
+        end = cs.ComputePositionalErrors2Parallel (original.Get (), count, simplification.Get (),
+                                                   simplifiedCount, 3, &errors [0], &valid);
+        VERIFY_TRUE(valid);
+        VERIFY_TRUE(end == &errors [0] + count);
+        VERIFY_TRUE(errors == expected);
+
+        math::Statistics expectedStatistics = compute_positional_error_statistics <DIM> (
+            coords.begin (), coords.end (), simplified.begin (), simplified.end ());
+        math::Statistics statistics = cs.ComputePositionalErrorStatistics (
+            original.Get (), count, simplification.Get (), simplifiedCount, &valid);
+        VERIFY_TRUE(valid);
+        VERIFY_TRUE(statistics.max == expectedStatistics.max);
+        VERIFY_TRUE(statistics.sum == expectedStatistics.sum);
+
+        // an invalid simplification
+        valid = true;
+        cs.ComputePositionalErrors2 (original.Get (), count, original.Get (), 1, &errors [0], &valid);
+        VERIFY_FALSE(valid);
+    }
+}}
@@ -37,11 +37,60 @@
 #include <vector>
 #include <deque>
 #include <list>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
 
 
 namespace psimpl {
     namespace test
 {
+    // max squared distance of each polyline point to its segment of the simplification
+    template <unsigned DIM, class T>
+    T MaxDistance2 (const std::vector <T>& polyline, const std::vector <T>& simplification) {
+        T maxDist2 = 0;
+        unsigned s = 0;
+        for (unsigned p = 0; p < polyline.size (); p += DIM) {
+            if (s + DIM < simplification.size () - DIM &&
+                ComparePoint <DIM> (polyline.begin () + p, simplification.begin () + s + DIM))
+            {
+                s += DIM;
+            }
+            maxDist2 = std::max (maxDist2, math::segment_distance2 <DIM> (
+                simplification.begin () + s, simplification.begin () + s + DIM,
+                polyline.begin () + p));
+        }
+        return maxDist2;
+    }
+
+    // coordinates of the polyline points with the specified indices
+    template <unsigned DIM, class T>
+    std::vector <T> SelectPoints (const std::vector <T>& polyline, const std::vector <unsigned>& indices) {
+        std::vector <T> points;
+        for (unsigned i = 0; i < indices.size (); ++i) {
+            points.insert (points.end (), polyline.begin () + indices [i] * DIM, polyline.begin () + (indices [i] + 1) * DIM);
+        }
+        return points;
+    }
+
+    // maximum squared positional error of each segment between the specified indices
+    template <unsigned DIM, class T>
+    std::vector <T> SegmentErrors (const std::vector <T>& polyline, const std::vector <unsigned>& indices) {
+        const std::vector <T> simplification = SelectPoints <DIM> (polyline, indices);
+        std::vector <T> errors;
+        psimpl::compute_positional_errors2 <DIM> (
+            polyline.begin (), polyline.end (),
+            simplification.begin (), simplification.end (),
+            std::back_inserter (errors));
+
+        std::vector <T> maxima;
+        for (unsigned i = 1; i < indices.size (); ++i) {
+            maxima.push_back (*std::max_element (errors.begin () + indices [i-1],
+                                                 errors.begin () + indices [i] + 1));
+        }
+        return maxima;
+    }
+
     TestDouglasPeucker::TestDouglasPeucker () {
         TEST_RUN("incomplete point", TestIncompletePoint ());
         TEST_RUN("not enough points", TestNotEnoughPoints ());
@@ -52,6 +101,19 @@ namespace psimpl {
         TEST_RUN("bidirectional iterator", TestBidirectionalIterator ());
         TEST_DISABLED("forward iterator", TestForwardIterator ());
         TEST_RUN("return value", TestReturnValue ());
+        TEST_RUN("parallel", TestParallel ());
+        TEST_RUN("contiguous", TestContiguous ());
+        TEST_RUN("chunked", TestChunked ());
+        TEST_RUN("hull", TestHull ());
+        TEST_RUN("precision", TestPrecision ());
+        TEST_RUN("indices", TestIndices ());
+        TEST_RUN("errors", TestErrors ());
+        TEST_RUN("levels", TestLevels ());
+        TEST_RUN("bounding boxes", TestBoundingBoxes ());
+        TEST_RUN("keys", TestKeys ());
+        TEST_RUN("selection", TestSelection ());
+        TEST_RUN("control", TestControl ());
+        TEST_SCALING("scaling", TestScaling ());
     }
 
     // incomplete point: coord count % DIM > 1
@@ -256,9 +318,24 @@ namespace psimpl {
                     polyline.begin (), polyline.end (), tol,
                     std::back_inserter (result));
 
-            VERIFY_TRUE(result.size () == 7*DIM);
-            int keys [] = {0, 5, 6, 7, 8, 9, 10};
-            VERIFY_TRUE(ComparePoints <DIM> (polyline.begin (), result.begin (), std::vector <int> (keys, keys + 7)));
+            // point 5 lies at exactly tol from segment (0, 6), and is therefore not a key
+            VERIFY_TRUE(result.size () == 6*DIM);
+            int keys [] = {0, 6, 7, 8, 9, 10};
+            VERIFY_TRUE(ComparePoints <DIM> (polyline.begin (), result.begin (), std::vector <int> (keys, keys + 6)));
+        }
+        {
+            // the squared distance of point 1 to segment (0, 2) is 9.8: just beyond tol
+            const unsigned DIM = 2;
+            int polyline [] = {0, 0, 3, 5, 20, 10};
+            std::vector <int> result;
+            int tol = 3;
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                    polyline, polyline + 6, tol,
+                    std::back_inserter (result));
+
+            ASSERT_TRUE(result.size () == 3*DIM);
+            VERIFY_TRUE(std::equal (result.begin (), result.end (), polyline));
         }
     }
 
@@ -315,6 +392,931 @@ namespace psimpl {
 
     // --------------------------------------------------------------------------------------------
 
+    // multi threaded result equals single threaded result
+    void TestDouglasPeucker::TestParallel () {
+        const unsigned count = 100000;
+        {
+            const unsigned DIM = 2;
+            std::vector <double> polyline, expected;
+            std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> (1, 2));
+            double tol = 3;
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (expected));
+
+            unsigned threads [] = {0, 1, 2, 3, 8};
+            for (unsigned t = 0; t < 5; ++t) {
+                std::vector <double> result;
+                psimpl::simplify_douglas_peucker_parallel <DIM> (
+                    polyline.begin (), polyline.end (), tol, threads [t],
+                    std::back_inserter (result));
+
+                VERIFY_TRUE(result == expected);
+            }
+        }
+        {
+            const unsigned DIM = 3;
+            std::vector <float> polyline, expected;
+            std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <float, DIM> (1, 2));
+            float tol = 5;
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (expected));
+
+            std::vector <float> result;
+            psimpl::simplify_douglas_peucker_parallel <DIM> (
+                polyline.begin (), polyline.end (), tol, 4,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == expected);
+        }
+        {
+            const unsigned DIM = 2;
+            std::list <long long> polyline, expected;
+            std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <long long, DIM> (10, 20));
+            long long tol = 30;
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (expected));
+
+            std::list <long long> result;
+            psimpl::simplify_douglas_peucker_parallel <DIM> (
+                polyline.begin (), polyline.end (), tol, 4,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == expected);
+        }
+    }
+
+    // contiguous input, which is not copied, yields the same result as other input
+    void TestDouglasPeucker::TestChunked () {
+        const unsigned DIM = 2;
+        const unsigned count = 10000;
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> (1, 2));
+        double tol = 3;
+
+        // invalid input
+        {
+            std::vector <double> result;
+            psimpl::simplify_douglas_peucker_chunked <DIM> (
+                polyline.begin (), polyline.end (), tol, 1, 1,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == polyline);
+
+            result.clear ();
+            psimpl::simplify_douglas_peucker_chunked <DIM> (
+                polyline.begin (), polyline.end () - 1, tol, 100, 1,
+                std::back_inserter (result));
+            VERIFY_TRUE(result.size () == polyline.size () - 1);
+        }
+        // a single chunk equals DP
+        {
+            std::vector <double> expected, result;
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (expected));
+            psimpl::simplify_douglas_peucker_chunked <DIM> (
+                polyline.begin (), polyline.end (), tol, count, 1,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+        }
+        // each chunk is simplified using DP, and shares its end points with its neighbours
+        const unsigned chunkSizes [] = {2, 3, 999, 1000, 4096};
+        for (unsigned s = 0; s < 5; ++s) {
+            const unsigned chunkSize = chunkSizes [s];
+            std::vector <double> expected;
+            for (unsigned p = 0; p + 1 < count; p += chunkSize - 1) {
+                std::vector <double> simplified;
+                unsigned end = std::min (count, p + chunkSize);
+                psimpl::simplify_douglas_peucker <DIM> (
+                    polyline.begin () + p * DIM, polyline.begin () + end * DIM, tol,
+                    std::back_inserter (simplified));
+                expected.insert (expected.end (), simplified.begin () + (p ? DIM : 0), simplified.end ());
+            }
+            for (unsigned threadCount = 1; threadCount <= 4; ++threadCount) {
+                std::vector <double> result;
+                psimpl::simplify_douglas_peucker_chunked <DIM> (
+                    polyline.begin (), polyline.end (), tol, chunkSize, threadCount,
+                    std::back_inserter (result));
+                VERIFY_TRUE(result == expected);
+            }
+            std::list <double> input (polyline.begin (), polyline.end ());
+            std::vector <double> result;
+            psimpl::simplify_douglas_peucker_chunked <DIM> (
+                input.begin (), input.end (), tol, chunkSize, 0,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+        }
+    }
+
+    void TestDouglasPeucker::TestContiguous () {
+        const unsigned count = 100000;
+        {
+            // radial distance removes points
+            const unsigned DIM = 2;
+            std::vector <double> polyline, expected;
+            std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> (1, 2));
+            std::deque <double> input (polyline.begin (), polyline.end ());
+            double tol = 3;
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                input.begin (), input.end (), tol,
+                std::back_inserter (expected));
+
+            std::vector <double> result;
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+
+            const double* first = &polyline [0];
+            result.clear ();
+            psimpl::simplify_douglas_peucker <DIM> (
+                first, first + polyline.size (), tol,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+
+            result.clear ();
+            psimpl::simplify_douglas_peucker_parallel <DIM> (
+                polyline.begin (), polyline.end (), tol, 4,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+
+            std::vector <unsigned> expectedIndices, indices;
+            psimpl::simplify_douglas_peucker_indices <DIM> (
+                input.begin (), input.end (), tol,
+                std::back_inserter (expectedIndices));
+            psimpl::simplify_douglas_peucker_indices <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (indices));
+            VERIFY_TRUE(indices == expectedIndices);
+        }
+        {
+            // radial distance removes no points
+            const unsigned DIM = 3;
+            std::vector <float> polyline, expected;
+            std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <float, DIM> (1, 2));
+            std::deque <float> input (polyline.begin (), polyline.end ());
+            float tol = 0.9f;
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                input.begin (), input.end (), tol,
+                std::back_inserter (expected));
+
+            std::vector <float> result;
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+
+            std::vector <unsigned> expectedIndices, indices;
+            psimpl::simplify_douglas_peucker_indices <DIM> (
+                input.begin (), input.end (), tol,
+                std::back_inserter (expectedIndices));
+            psimpl::simplify_douglas_peucker_indices <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (indices));
+            VERIFY_TRUE(indices == expectedIndices);
+        }
+        {
+            // integer coordinates: 64 bit, such that the squared distances fit
+            const unsigned DIM = 4;
+            std::vector <long long> polyline, expected;
+            std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <long long, DIM> (10, 20));
+            std::deque <long long> input (polyline.begin (), polyline.end ());
+            long long tol = 25;
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                input.begin (), input.end (), tol,
+                std::back_inserter (expected));
+
+            std::vector <long long> result;
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+        }
+    }
+
+    void TestDouglasPeucker::TestHull () {
+        {
+            // invalid input
+            const unsigned DIM = 2;
+            std::vector <float> polyline;
+            std::generate_n (std::back_inserter (polyline), 2*DIM, StraightLine <float, DIM> ());
+            std::vector <float> result;
+
+            psimpl::simplify_douglas_peucker_hull <DIM> (
+                polyline.begin (), polyline.end (), 2.f,
+                std::back_inserter (result));
+
+            ASSERT_TRUE(polyline == result);
+        }
+        {
+            // zigzag with increasing amplitude: worst case for DouglasPeucker
+            const unsigned DIM = 2;
+            const unsigned count = 2000;
+            std::vector <double> polyline, expected, result;
+            for (unsigned i = 0; i < count; ++i) {
+                polyline.push_back (i);
+                polyline.push_back ((i % 2 ? 1 : -1) * std::pow (1.005, static_cast <int> (i)));
+            }
+            double tol = 0.5;
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (expected));
+            psimpl::simplify_douglas_peucker_hull <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == expected);
+        }
+        {
+            // a point beyond the end points is furthest away from the segment, but not the line
+            const unsigned DIM = 2;
+            double polyline [] = {0, 0, -5, 0.5, 5, 1, 10, 0};
+            std::vector <double> expected, result;
+            double tol = 2;
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline, polyline + 8, tol,
+                std::back_inserter (expected));
+            psimpl::simplify_douglas_peucker_hull <DIM> (
+                polyline, polyline + 8, tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(expected.size () == 3*DIM);
+            VERIFY_TRUE(result == expected);
+        }
+        {
+            // random x-monotone, and thus simple, polylines with a large y range: many points
+            // project beyond the end points of their segment
+            const unsigned DIM = 2;
+            bool equal = true;
+            std::srand (3);
+            for (unsigned n = 0; n < 500; ++n) {
+                std::vector <double> polyline, expected, result;
+                unsigned count = 3 + std::rand () % 60;
+                for (unsigned i = 0; i < count; ++i) {
+                    polyline.push_back (i + std::rand () / (RAND_MAX + 1.));
+                    polyline.push_back (std::rand () / (RAND_MAX + 1.) * 100);
+                }
+                double tol = 1 + std::rand () % 30;
+
+                psimpl::simplify_douglas_peucker <DIM, math::double_precision> (
+                    polyline.begin (), polyline.end (), tol,
+                    std::back_inserter (expected));
+                psimpl::simplify_douglas_peucker_hull <DIM, math::double_precision> (
+                    polyline.begin (), polyline.end (), tol,
+                    std::back_inserter (result));
+                equal = equal && result == expected;
+            }
+            VERIFY_TRUE(equal);
+        }
+        {
+            // closed polyline
+            const unsigned DIM = 2;
+            const unsigned count = 1000;
+            std::vector <double> polyline, result;
+            for (unsigned i = 0; i <= count; ++i) {
+                double angle = 6.283185307179586 * (i % count) / count;
+                polyline.push_back (100 * std::cos (angle));
+                polyline.push_back (50 * std::sin (angle));
+            }
+            double tol = 0.1;
+
+            psimpl::simplify_douglas_peucker_hull <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+
+            // keys may differ from DouglasPeucker for (nearly) equally far away points
+            ASSERT_TRUE(CompareEndPoints <DIM> (polyline.begin (), polyline.end (), result.begin (), result.end ()));
+            VERIFY_TRUE(MaxDistance2 <DIM> (polyline, result) <= tol * tol);
+        }
+        {
+            // x-monotone random walk
+            const unsigned DIM = 2;
+            std::vector <double> polyline, expected, result;
+            std::generate_n (std::back_inserter (polyline), 100000*DIM, RandomWalkLine <double, DIM> (10, 2));
+            double tol = 3;
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (expected));
+            psimpl::simplify_douglas_peucker_hull <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == expected);
+        }
+        {
+            // self-intersecting random walks: the hulls of non-simple sub polylines are invalid
+            const unsigned DIM = 2;
+            bool equal = true;
+            std::srand (5);
+            for (unsigned n = 0; n < 200; ++n) {
+                std::vector <double> polyline, expected, result;
+                unsigned count = 10 + std::rand () % 2000;
+                double x = 0;
+                double y = 0;
+                for (unsigned i = 0; i < count; ++i) {
+                    double angle = 6.283185307179586 * std::rand () / (RAND_MAX + 1.);
+                    x += std::cos (angle);
+                    y += std::sin (angle);
+                    polyline.push_back (x);
+                    polyline.push_back (y);
+                }
+                double tol = 0.5 + std::rand () % 8;
+
+                psimpl::simplify_douglas_peucker <DIM, math::double_precision> (
+                    polyline.begin (), polyline.end (), tol,
+                    std::back_inserter (expected));
+                psimpl::simplify_douglas_peucker_hull <DIM, math::double_precision> (
+                    polyline.begin (), polyline.end (), tol,
+                    std::back_inserter (result));
+                equal = equal && result == expected;
+            }
+            VERIFY_TRUE(equal);
+        }
+        {
+            // other dimensions fall back to DouglasPeucker
+            const unsigned DIM = 3;
+            std::vector <float> polyline, expected, result;
+            std::generate_n (std::back_inserter (polyline), 10000*DIM, RandomWalkLine <float, DIM> (1, 2));
+            float tol = 5;
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (expected));
+            psimpl::simplify_douglas_peucker_hull <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == expected);
+        }
+    }
+
+    // indices select the same points as the simplified coordinates
+    void TestDouglasPeucker::TestPrecision () {
+        const unsigned DIM = 2;
+        // far from the origin, on a 100km segment: the middle point lies 0.0005 from the segment
+        const double x = 500000, y = 5000000;
+        const double polyline [] = {x, y, x + 33333.3, y + 0.0005, x + 100000, y};
+        const double tol = 0.001;
+        {
+            // float fractions overestimate the distance, keeping the middle point
+            std::vector <double> result;
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline, polyline + 6, tol, std::back_inserter (result));
+            VERIFY_TRUE(result.size () == 6);
+        }
+        {
+            std::vector <double> result;
+            psimpl::simplify_douglas_peucker <DIM, psimpl::math::double_precision> (
+                polyline, polyline + 6, tol, std::back_inserter (result));
+            VERIFY_TRUE(result.size () == 4);
+        }
+        {
+            // value_type precision, for input without random access
+            std::list <double> input (polyline, polyline + 6);
+            std::vector <double> result;
+            psimpl::simplify_douglas_peucker <DIM, psimpl::math::value_precision> (
+                input.begin (), input.end (), tol, std::back_inserter (result));
+            VERIFY_TRUE(result.size () == 4);
+        }
+        {
+            std::vector <double> result;
+            typedef std::back_insert_iterator <std::vector <double> > OutputIterator;
+            psimpl::PolylineSimplification <DIM, const double*, OutputIterator,
+                                            psimpl::math::long_double_precision> ps;
+            ps.DouglasPeucker (polyline, polyline + 6, tol, std::back_inserter (result));
+            VERIFY_TRUE(result.size () == 4);
+        }
+    }
+
+    void TestDouglasPeucker::TestIndices () {
+        {
+            const unsigned DIM = 2;
+            std::vector <double> polyline, expected;
+            std::vector <unsigned> indices;
+            std::generate_n (std::back_inserter (polyline), 10000*DIM, RandomWalkLine <double, DIM> (1, 2));
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), 3.,
+                std::back_inserter (expected));
+            psimpl::simplify_douglas_peucker_indices <DIM> (
+                polyline.begin (), polyline.end (), 3.,
+                std::back_inserter (indices));
+
+            ASSERT_TRUE(indices.size () * DIM == expected.size ());
+            VERIFY_TRUE(indices.front () == 0);
+            VERIFY_TRUE(indices.back () == 9999);
+            VERIFY_TRUE(std::adjacent_find (indices.begin (), indices.end (), std::greater_equal <unsigned> ()) == indices.end ());
+            VERIFY_TRUE(SelectPoints <DIM> (polyline, indices) == expected);
+        }
+        {
+            // invalid input yields all point indices
+            const unsigned DIM = 3;
+            std::vector <float> polyline;
+            std::generate_n (std::back_inserter (polyline), 10*DIM, StraightLine <float, DIM> ());
+            std::list <float> input (polyline.begin (), polyline.end ());
+            std::vector <std::size_t> indices;
+
+            psimpl::simplify_douglas_peucker_indices <DIM> (
+                input.begin (), input.end (), 0.f,
+                std::back_inserter (indices));
+            ASSERT_TRUE(indices.size () == 10);
+            for (std::size_t i = 0; i < indices.size (); ++i) {
+                VERIFY_TRUE(indices [i] == i);
+            }
+
+            indices.clear ();
+            psimpl::simplify_douglas_peucker_indices <DIM> (
+                input.begin (), input.end (), 10.f,
+                std::back_inserter (indices));
+            ASSERT_TRUE(indices.size () == 2);
+            VERIFY_TRUE(indices [0] == 0 && indices [1] == 9);
+        }
+    }
+
+    void TestDouglasPeucker::TestErrors () {
+        {
+            // points are further apart than tol, so radial distance removes none of them
+            const unsigned DIM = 2;
+            std::vector <double> polyline, expected, result, errors;
+            std::vector <unsigned> indices;
+            std::generate_n (std::back_inserter (polyline), 10000*DIM, RandomWalkLine <double, DIM> (5, 20));
+
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), 4.,
+                std::back_inserter (expected));
+            psimpl::simplify_douglas_peucker_indices <DIM> (
+                polyline.begin (), polyline.end (), 4.,
+                std::back_inserter (indices));
+            psimpl::simplify_douglas_peucker_errors <DIM> (
+                polyline.begin (), polyline.end (), 4.,
+                std::back_inserter (result), std::back_inserter (errors));
+
+            VERIFY_TRUE(result == expected);
+            ASSERT_TRUE(errors.size () + 1 == indices.size ());
+            VERIFY_TRUE(errors == SegmentErrors <DIM> (polyline, indices));
+            VERIFY_TRUE(*std::max_element (errors.begin (), errors.end ()) <= 16.);
+        }
+        {
+            // invalid input yields a zero error for each segment
+            const unsigned DIM = 3;
+            std::vector <float> polyline, result;
+            std::generate_n (std::back_inserter (polyline), 10*DIM, StraightLine <float, DIM> ());
+            std::list <float> input (polyline.begin (), polyline.end ());
+            std::vector <float> errors;
+
+            psimpl::simplify_douglas_peucker_errors <DIM> (
+                input.begin (), input.end (), 0.f,
+                std::back_inserter (result), std::back_inserter (errors));
+            VERIFY_TRUE(result == polyline);
+            VERIFY_TRUE(errors == std::vector <float> (9, 0.f));
+        }
+    }
+
+    void TestDouglasPeucker::TestLevels () {
+        {
+            // points are further apart than each tol, so radial distance removes none of them
+            const unsigned DIM = 2;
+            std::vector <double> polyline;
+            std::generate_n (std::back_inserter (polyline), 10000*DIM, RandomWalkLine <double, DIM> (5, 20));
+            const double tols [] = {0.5, 1., 2., 4.};
+            std::vector <unsigned> levels;
+
+            psimpl::simplify_douglas_peucker_levels <DIM> (
+                polyline.begin (), polyline.end (), tols, tols + 4,
+                std::back_inserter (levels));
+            ASSERT_TRUE(levels.size () == 10000);
+            VERIFY_TRUE(levels.front () == 4 && levels.back () == 4);
+
+            for (unsigned k = 0; k < 4; ++k) {
+                std::vector <unsigned> expected, indices;
+                psimpl::simplify_douglas_peucker_indices <DIM> (
+                    polyline.begin (), polyline.end (), tols [k],
+                    std::back_inserter (expected));
+                for (unsigned p = 0; p < levels.size (); ++p) {
+                    if (levels [p] > k) {
+                        indices.push_back (p);
+                    }
+                }
+                VERIFY_TRUE(indices == expected);
+            }
+        }
+        {
+            // the smallest tol also determines the radial distance preprocessing
+            const unsigned DIM = 3;
+            std::vector <float> polyline;
+            std::generate_n (std::back_inserter (polyline), 10000*DIM, RandomWalkLine <float, DIM> (1, 2));
+            std::list <float> input (polyline.begin (), polyline.end ());
+            const float tols [] = {3.f, 3.f, 10.f};
+            std::vector <unsigned char> levels;
+            std::vector <unsigned> expected, indices, larger;
+
+            psimpl::simplify_douglas_peucker_levels <DIM> (
+                input.begin (), input.end (), tols, tols + 3,
+                std::back_inserter (levels));
+            psimpl::simplify_douglas_peucker_indices <DIM> (
+                input.begin (), input.end (), 3.f,
+                std::back_inserter (expected));
+            ASSERT_TRUE(levels.size () == 10000);
+            for (unsigned p = 0; p < levels.size (); ++p) {
+                VERIFY_TRUE(levels [p] != 1);
+                if (levels [p]) {
+                    indices.push_back (p);
+                }
+                if (levels [p] > 2) {
+                    larger.push_back (p);
+                }
+            }
+            VERIFY_TRUE(indices == expected);
+            VERIFY_TRUE(larger.size () > 2 && larger.size () < indices.size ());
+        }
+        {
+            // radial distance with the larger tol removes the point at (20, 14), which is 9 away
+            // from (20, 5); the levels keep it, as they share the radial distance of the smaller tol
+            const unsigned DIM = 2;
+            const int polyline [] = {0, 0, 20, 5, 20, 14, 40, 0};
+            const int tols [] = {1, 10};
+            std::vector <unsigned> levels, indices;
+
+            psimpl::simplify_douglas_peucker_levels <DIM> (
+                polyline, polyline + 8, tols, tols + 2, std::back_inserter (levels));
+            const unsigned expectedLevels [] = {2, 1, 2, 2};
+            VERIFY_TRUE(levels == std::vector <unsigned> (expectedLevels, expectedLevels + 4));
+
+            psimpl::simplify_douglas_peucker_indices <DIM> (
+                polyline, polyline + 8, tols [1], std::back_inserter (indices));
+            const unsigned expectedIndices [] = {0, 3};
+            VERIFY_TRUE(indices == std::vector <unsigned> (expectedIndices, expectedIndices + 2));
+        }
+        {
+            // invalid input yields the number of tolerances for each point
+            const unsigned DIM = 2;
+            std::vector <double> polyline;
+            std::generate_n (std::back_inserter (polyline), 10*DIM, StraightLine <double, DIM> ());
+            const double unsorted [] = {1., 4., 2.};
+            const double zero [] = {0., 1.};
+            std::vector <unsigned> levels;
+
+            psimpl::simplify_douglas_peucker_levels <DIM> (
+                polyline.begin (), polyline.end (), unsorted, unsorted + 3,
+                std::back_inserter (levels));
+            VERIFY_TRUE(levels == std::vector <unsigned> (10, 3));
+
+            levels.clear ();
+            psimpl::simplify_douglas_peucker_levels <DIM> (
+                polyline.begin (), polyline.end (), zero, zero + 2,
+                std::back_inserter (levels));
+            VERIFY_TRUE(levels == std::vector <unsigned> (10, 2));
+
+            levels.clear ();
+            psimpl::simplify_douglas_peucker_levels <DIM> (
+                polyline.begin (), polyline.end () - 1, zero + 1, zero + 2,
+                std::back_inserter (levels));
+            VERIFY_TRUE(levels == std::vector <unsigned> (9, 1));
+
+            levels.clear ();
+            psimpl::simplify_douglas_peucker_levels <DIM> (
+                polyline.begin (), polyline.end (), zero + 1, zero + 2,
+                std::back_inserter (levels));
+            ASSERT_TRUE(levels.size () == 10);
+            VERIFY_TRUE(levels.front () == 1 && levels.back () == 1);
+            VERIFY_TRUE(std::count (levels.begin (), levels.end (), 0u) == 8);
+        }
+    }
+
+    // the bounding box hierarchy does not change the result
+    void TestDouglasPeucker::TestBoundingBoxes () {
+        const unsigned DIM = 2;
+        const unsigned count = 100000;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        BoundingBoxHierarchy <DIM, double> hierarchy (polyline.data (), polyline.data () + polyline.size ());
+        ASSERT_TRUE(hierarchy.PointCount () == count);
+
+        // invalid input leaves the hierarchy empty
+        {
+            BoundingBoxHierarchy <DIM, double> invalid;
+            VERIFY_FALSE(invalid.Build (polyline.data (), polyline.data () + 2*DIM - 1));
+            VERIFY_FALSE(invalid.Build (polyline.data (), polyline.data () + DIM));
+            VERIFY_TRUE(invalid.PointCount () == 0);
+            VERIFY_TRUE(invalid.Build (polyline.data (), polyline.data () + 2*DIM));
+            VERIFY_TRUE(invalid.PointCount () == 2);
+        }
+        // any tolerance, including one for which RD does not remove any points
+        {
+            const double tols [] = {0.5, 2, 5, 20, 1000};
+            for (unsigned t = 0; t < 5; ++t) {
+                std::vector <double> expected, result;
+                psimpl::simplify_douglas_peucker <DIM> (
+                    polyline.begin (), polyline.end (), tols [t],
+                    std::back_inserter (expected));
+                psimpl::simplify_douglas_peucker <DIM> (
+                    polyline.begin (), polyline.end (), tols [t], hierarchy,
+                    std::back_inserter (result));
+                VERIFY_TRUE(result == expected);
+            }
+        }
+        // equally distant points
+        {
+            std::vector <double> teeth;
+            for (unsigned p = 0; p < count; ++p) {
+                teeth.push_back (p);
+                teeth.push_back (p % 3 == 0);
+            }
+            BoundingBoxHierarchy <DIM, double> teethHierarchy (teeth.data (), teeth.data () + teeth.size ());
+            std::vector <double> expected, result;
+            psimpl::simplify_douglas_peucker <DIM> (
+                teeth.begin (), teeth.end (), 0.5,
+                std::back_inserter (expected));
+            psimpl::simplify_douglas_peucker <DIM> (
+                teeth.begin (), teeth.end (), 0.5, teethHierarchy,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+        }
+        // float coordinates far from the origin
+        {
+            std::vector <float> far;
+            std::generate_n (std::back_inserter (far), count*DIM, RandomWalkLine <float, DIM> (0.5f, 2.f));
+            for (unsigned c = 0; c < far.size (); ++c) {
+                far [c] += 1e6f;
+            }
+            BoundingBoxHierarchy <DIM, float> farHierarchy (far.data (), far.data () + far.size ());
+            std::vector <float> expected, result;
+            psimpl::simplify_douglas_peucker <DIM> (
+                far.begin (), far.end (), 1.f,
+                std::back_inserter (expected));
+            psimpl::simplify_douglas_peucker <DIM> (
+                far.begin (), far.end (), 1.f, farHierarchy,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+        }
+        // the hierarchy is ignored for any other polyline
+        {
+            std::vector <double> expected;
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), 5.,
+                std::back_inserter (expected));
+
+            std::vector <double> copy (polyline);
+            std::vector <double> result;
+            psimpl::simplify_douglas_peucker <DIM> (
+                copy.begin (), copy.end (), 5., hierarchy,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+
+            std::list <double> list (polyline.begin (), polyline.end ());
+            result.clear ();
+            psimpl::simplify_douglas_peucker <DIM> (
+                list.begin (), list.end (), 5., hierarchy,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+
+            result.clear ();
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end () - DIM, 5., hierarchy,
+                std::back_inserter (result));
+            expected.clear ();
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end () - DIM, 5.,
+                std::back_inserter (expected));
+            VERIFY_TRUE(result == expected);
+
+            result.clear ();
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), 0., hierarchy,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == polyline);
+        }
+    }
+
+    void TestDouglasPeucker::TestKeys () {
+        const unsigned DIM = 2;
+        const unsigned count = 10000;
+
+        // key set
+        {
+            KeySet keys (130);
+            VERIFY_TRUE(keys.Size () == 130 && keys.Count () == 0);
+            keys.Set (0);
+            keys.Set (63);
+            keys.Set (64);
+            keys.Set (129);
+            VERIFY_TRUE(keys.Test (0) && keys.Test (63) && keys.Test (64) && keys.Test (129));
+            VERIFY_FALSE(keys.Test (1) || keys.Test (65) || keys.Test (128));
+            VERIFY_TRUE(keys.Count () == 4);
+
+            std::vector <std::size_t> indices;
+            keys.Indices (std::back_inserter (indices));
+            const std::size_t expected [] = {0, 63, 64, 129};
+            VERIFY_TRUE(indices.size () == 4 && std::equal (indices.begin (), indices.end (), expected));
+
+            keys.Reset (200);
+            VERIFY_TRUE(keys.Size () == 200 && keys.Count () == 0);
+            keys.Reset (10);
+            VERIFY_TRUE(keys.Size () == 10 && keys.Count () == 0);
+        }
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        std::list <double> list (polyline.begin (), polyline.end ());
+        KeySet keys;
+
+        // identical to the indices, also without points removed by RD
+        {
+            const double tols [] = {0.5, 5.};
+            for (unsigned t = 0; t < 2; ++t) {
+                std::vector <std::size_t> expected;
+                psimpl::simplify_douglas_peucker_indices <DIM> (
+                    polyline.begin (), polyline.end (), tols [t],
+                    std::back_inserter (expected));
+
+                VERIFY_TRUE(psimpl::simplify_douglas_peucker_keys <DIM> (
+                    polyline.begin (), polyline.end (), tols [t], keys) == expected.size ());
+                VERIFY_TRUE(keys.Size () == count);
+                std::vector <std::size_t> indices;
+                keys.Indices (std::back_inserter (indices));
+                VERIFY_TRUE(indices == expected);
+
+                VERIFY_TRUE(psimpl::simplify_douglas_peucker_keys <DIM> (
+                    list.begin (), list.end (), tols [t], keys) == expected.size ());
+                indices.clear ();
+                keys.Indices (std::back_inserter (indices));
+                VERIFY_TRUE(indices == expected);
+            }
+        }
+        // invalid input: all complete points are keys
+        {
+            VERIFY_TRUE(psimpl::simplify_douglas_peucker_keys <DIM> (
+                polyline.begin (), polyline.begin () + 2*64*DIM + 1, 5., keys) == 2*64);
+            VERIFY_TRUE(keys.Size () == 2*64 && keys.Count () == 2*64);
+            VERIFY_TRUE(psimpl::simplify_douglas_peucker_keys <DIM> (
+                polyline.begin (), polyline.begin () + 70*DIM, 0., keys) == 70);
+            VERIFY_TRUE(keys.Size () == 70 && keys.Count () == 70 && keys.Test (69));
+        }
+    }
+
+    void TestDouglasPeucker::TestSelection () {
+        const unsigned DIM = 2;
+        const unsigned count = 10000;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        Workspace <double> workspace;
+
+        // the selection is copied into exactly sized storage
+        {
+            const double tols [] = {0., 2., 5., 1000.};
+            for (unsigned t = 0; t < 4; ++t) {
+                std::vector <double> expected;
+                psimpl::simplify_douglas_peucker <DIM> (
+                    polyline.begin (), polyline.end (), tols [t],
+                    std::back_inserter (expected));
+
+                std::size_t size = psimpl::select_douglas_peucker <DIM> (
+                    polyline.begin (), polyline.end (), tols [t], workspace);
+                VERIFY_TRUE(size == expected.size ());
+
+                std::vector <double> result (size);
+                VERIFY_TRUE(psimpl::copy_selection <DIM> (polyline.begin (), result.begin (), workspace) == result.end ());
+                VERIFY_TRUE(result == expected);
+            }
+        }
+        // the selection can be copied more than once, also from a single pass range
+        {
+            std::list <double> list (polyline.begin (), polyline.end ());
+            std::vector <double> expected;
+            psimpl::simplify_douglas_peucker <DIM> (
+                list.begin (), list.end (), 5.,
+                std::back_inserter (expected));
+
+            std::size_t size = psimpl::select_douglas_peucker <DIM> (
+                list.begin (), list.end (), 5., workspace);
+            VERIFY_TRUE(size == expected.size ());
+
+            std::vector <double> result;
+            psimpl::copy_selection <DIM> (list.begin (), std::back_inserter (result), workspace);
+            VERIFY_TRUE(result == expected);
+            result.clear ();
+            psimpl::copy_selection <DIM> (list.begin (), std::back_inserter (result), workspace);
+            VERIFY_TRUE(result == expected);
+        }
+        // invalid input is selected entirely
+        {
+            std::vector <double> result;
+            VERIFY_TRUE(psimpl::select_douglas_peucker <DIM> (
+                polyline.begin (), polyline.begin () + 5, 5., workspace) == 5);
+            psimpl::copy_selection <DIM> (polyline.begin (), std::back_inserter (result), workspace);
+            VERIFY_TRUE(std::equal (result.begin (), result.end (), polyline.begin ()) && result.size () == 5);
+
+            VERIFY_TRUE(psimpl::select_douglas_peucker <DIM> (
+                polyline.begin (), polyline.begin (), 5., workspace) == 0);
+            result.clear ();
+            psimpl::copy_selection <DIM> (polyline.begin (), std::back_inserter (result), workspace);
+            VERIFY_TRUE(result.empty ());
+        }
+        // count only
+        {
+            std::vector <double> expected;
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), 5.,
+                std::back_inserter (expected));
+            VERIFY_TRUE(psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), 5.,
+                util::counting_iterator ()).count () == expected.size ());
+        }
+    }
+
+    void TestDouglasPeucker::TestControl () {
+        const unsigned DIM = 2;
+        const unsigned count = 100000;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        std::list <double> list (polyline.begin (), polyline.end ());
+        const double tols [] = {0.5, 5.};   // without and with points removed by RD
+
+        for (unsigned t = 0; t < 2; ++t) {
+            std::vector <double> expected;
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), tols [t],
+                std::back_inserter (expected));
+
+            // not stopped
+            {
+                SimplificationControl control;
+                std::vector <double> result;
+                psimpl::simplify_douglas_peucker <DIM> (
+                    polyline.begin (), polyline.end (), tols [t],
+                    std::back_inserter (result), control);
+                VERIFY_TRUE(result == expected);
+                VERIFY_FALSE(control.Interrupted ());
+                VERIFY_TRUE(control.Progress () == 1);
+
+                result.clear ();
+                psimpl::simplify_douglas_peucker <DIM> (
+                    list.begin (), list.end (), tols [t],
+                    std::back_inserter (result), control);
+                VERIFY_TRUE(result == expected);
+                VERIFY_FALSE(control.Interrupted ());
+            }
+            // cancelled immediately: only the end points
+            {
+                SimplificationControl control (1);
+                control.Cancel ();
+                std::vector <double> result;
+                psimpl::simplify_douglas_peucker <DIM> (
+                    polyline.begin (), polyline.end (), tols [t],
+                    std::back_inserter (result), control);
+                VERIFY_TRUE(control.Interrupted ());
+                VERIFY_TRUE(control.Progress () == 0);
+                VERIFY_TRUE(result.size () == 2*DIM);
+                VERIFY_TRUE(std::equal (result.begin (), result.begin () + DIM, polyline.begin ()));
+                VERIFY_TRUE(std::equal (result.end () - DIM, result.end (), polyline.end () - DIM));
+            }
+            // deadline: a part of the keys, refined from the first point onwards
+            {
+                SimplificationControl control (100);
+                control.SetDeadline (SimplificationControl::Clock::now ());
+                std::vector <double> result;
+                psimpl::simplify_douglas_peucker <DIM> (
+                    list.begin (), list.end (), tols [t],
+                    std::back_inserter (result), control);
+                VERIFY_TRUE(control.Interrupted ());
+                VERIFY_TRUE(0 < control.Progress () && control.Progress () < 1);
+                VERIFY_TRUE(2*DIM < result.size () && result.size () < expected.size ());
+                VERIFY_TRUE(std::equal (result.begin (), result.begin () + 2*DIM, expected.begin ()));
+                VERIFY_TRUE(std::equal (result.end () - DIM, result.end (), polyline.end () - DIM));
+            }
+        }
+    }
+
+    // scaling: run time is O(n log n) on average
+    void TestDouglasPeucker::TestScaling () {
+        const unsigned DIM = 2;
+        const unsigned count = 1 << 19;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        std::vector <double> result (polyline.size ());
+
+        VERIFY_SCALING(LINEARITHMIC, [&] (std::size_t n) {
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.begin () + n*DIM, 5.,
+                result.begin ());
+        });
+    }
+
     TestDouglasPeuckerN::TestDouglasPeuckerN () {
         TEST_RUN("incomplete point", TestIncompletePoint ());
         TEST_RUN("not enough points", TestNotEnoughPoints ());
@@ -325,6 +1327,13 @@ namespace psimpl {
         TEST_RUN("bidirectional iterator", TestBidirectionalIterator ());
         TEST_DISABLED("forward iterator", TestForwardIterator ());
         TEST_RUN("return value", TestReturnValue ());
+        TEST_RUN("indices", TestIndices ());
+        TEST_RUN("errors", TestErrors ());
+        TEST_RUN("bounding boxes", TestBoundingBoxes ());
+        TEST_RUN("keys", TestKeys ());
+        TEST_RUN("selection", TestSelection ());
+        TEST_RUN("control", TestControl ());
+        TEST_SCALING("scaling", TestScaling ());
     }
 
     // incomplete point: coord count % DIM > 1
@@ -582,6 +1591,33 @@ namespace psimpl {
 
             ASSERT_TRUE(polyline == result);
         }
+        // equally distant keys are added in polyline order
+        {
+            double polyline [] = {0, 0, 2, 0, 4, 0, 6, -1, 8, 1, 10, 1, 12, 1, 14, 0};
+            double expected [] = {0, 0, 4, 0, 6, -1, 8, 1, 14, 0};
+            unsigned tol = 5;
+            std::vector <double> result;
+
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline, polyline + 16, tol,
+                std::back_inserter (result));
+
+            ASSERT_TRUE(result.size () == tol*DIM);
+            VERIFY_TRUE(std::equal (result.begin (), result.end (), expected));
+        }
+        // coinciding points, all keys at distance 0
+        {
+            double coinciding [] = {0, 0, 0, 0, 0, 0, 0, 0, 8, 0};
+            unsigned tol = 4;
+            std::vector <double> result;
+
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                coinciding, coinciding + 10, tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == tol*DIM);
+            VERIFY_TRUE(CompareEndPoints <DIM> (coinciding, coinciding + 10, &result [0], &result [0] + result.size ()));
+        }
     }
 
     // different random access iterators, different value types, different dimensions
@@ -681,4 +1717,276 @@ namespace psimpl {
                     result))
             == 5*DIM);
     }
+
+    // indices select the same points as the simplified coordinates
+    void TestDouglasPeuckerN::TestIndices () {
+        const unsigned DIM = 3;
+        std::vector <float> polyline;
+        std::generate_n (std::back_inserter (polyline), 1000*DIM, RandomWalkLine <float, DIM> (1, 2));
+
+        unsigned counts [] = {2, 3, 100, 999, 1000};
+        for (unsigned c = 0; c < 5; ++c) {
+            std::vector <float> expected;
+            std::vector <unsigned> indices;
+
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), counts [c],
+                std::back_inserter (expected));
+            psimpl::simplify_douglas_peucker_n_indices <DIM> (
+                polyline.begin (), polyline.end (), counts [c],
+                std::back_inserter (indices));
+
+            ASSERT_TRUE(indices.size () == counts [c]);
+            VERIFY_TRUE(std::adjacent_find (indices.begin (), indices.end (), std::greater_equal <unsigned> ()) == indices.end ());
+            VERIFY_TRUE(SelectPoints <DIM> (polyline, indices) == expected);
+        }
+    }
+
+    void TestDouglasPeuckerN::TestErrors () {
+        {
+            const unsigned DIM = 3;
+            std::vector <float> polyline;
+            std::generate_n (std::back_inserter (polyline), 5000*DIM, RandomWalkLine <float, DIM> (1, 2));
+
+            unsigned counts [] = {2, 3, 4, 100, 2500, 4999};
+            for (unsigned c = 0; c < 6; ++c) {
+                std::vector <float> expected, result, errors;
+                std::vector <unsigned> indices;
+
+                psimpl::simplify_douglas_peucker_n <DIM> (
+                    polyline.begin (), polyline.end (), counts [c],
+                    std::back_inserter (expected));
+                psimpl::simplify_douglas_peucker_n_indices <DIM> (
+                    polyline.begin (), polyline.end (), counts [c],
+                    std::back_inserter (indices));
+                psimpl::simplify_douglas_peucker_n_errors <DIM> (
+                    polyline.begin (), polyline.end (), counts [c],
+                    std::back_inserter (result), std::back_inserter (errors));
+
+                VERIFY_TRUE(result == expected);
+                ASSERT_TRUE(errors.size () + 1 == counts [c]);
+                VERIFY_TRUE(errors == SegmentErrors <DIM> (polyline, indices));
+            }
+        }
+        {
+            // invalid input yields a zero error for each segment
+            const unsigned DIM = 2;
+            std::vector <double> polyline, result, errors;
+            std::generate_n (std::back_inserter (polyline), 10*DIM, SawToothLine <double, DIM> ());
+
+            psimpl::simplify_douglas_peucker_n_errors <DIM> (
+                polyline.begin (), polyline.end (), 10,
+                std::back_inserter (result), std::back_inserter (errors));
+            VERIFY_TRUE(result == polyline);
+            VERIFY_TRUE(errors == std::vector <double> (9, 0.));
+        }
+    }
+
+    // the bounding box hierarchy does not change the result
+    void TestDouglasPeuckerN::TestBoundingBoxes () {
+        const unsigned DIM = 3;
+        const unsigned count = 100000;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        BoundingBoxHierarchy <DIM, double> hierarchy (polyline.data (), polyline.data () + polyline.size ());
+
+        // any point count
+        {
+            const unsigned counts [] = {3, 100, 5000, 50000};
+            for (unsigned c = 0; c < 4; ++c) {
+                std::vector <double> expected, result;
+                psimpl::simplify_douglas_peucker_n <DIM> (
+                    polyline.begin (), polyline.end (), counts [c],
+                    std::back_inserter (expected));
+                psimpl::simplify_douglas_peucker_n <DIM> (
+                    polyline.begin (), polyline.end (), counts [c], hierarchy,
+                    std::back_inserter (result));
+                VERIFY_TRUE(result == expected);
+            }
+        }
+        // double precision fractions
+        {
+            std::vector <double> expected, result;
+            psimpl::simplify_douglas_peucker_n <DIM, psimpl::math::double_precision> (
+                polyline.begin (), polyline.end (), 1000,
+                std::back_inserter (expected));
+            psimpl::simplify_douglas_peucker_n <DIM, psimpl::math::double_precision> (
+                polyline.begin (), polyline.end (), 1000, hierarchy,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+        }
+        // the hierarchy is ignored for any other polyline
+        {
+            std::vector <double> expected;
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), 1000,
+                std::back_inserter (expected));
+
+            std::list <double> list (polyline.begin (), polyline.end ());
+            std::vector <double> result;
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                list.begin (), list.end (), 1000, hierarchy,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == expected);
+
+            result.clear ();
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), count, hierarchy,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == polyline);
+        }
+    }
+
+    void TestDouglasPeuckerN::TestKeys () {
+        const unsigned DIM = 3;
+        const unsigned count = 10000;
+
+        std::vector <float> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <float, DIM> ());
+        KeySet keys;
+
+        // identical to the indices
+        {
+            const unsigned counts [] = {2, 3, 100, 5000};
+            for (unsigned c = 0; c < 4; ++c) {
+                std::vector <std::size_t> expected;
+                psimpl::simplify_douglas_peucker_n_indices <DIM> (
+                    polyline.begin (), polyline.end (), counts [c],
+                    std::back_inserter (expected));
+
+                VERIFY_TRUE(psimpl::simplify_douglas_peucker_n_keys <DIM> (
+                    polyline.begin (), polyline.end (), counts [c], keys) == expected.size ());
+                VERIFY_TRUE(keys.Size () == count);
+                std::vector <std::size_t> indices;
+                keys.Indices (std::back_inserter (indices));
+                VERIFY_TRUE(indices == expected);
+            }
+        }
+        // invalid input: all complete points are keys
+        {
+            VERIFY_TRUE(psimpl::simplify_douglas_peucker_n_keys <DIM> (
+                polyline.begin (), polyline.begin () + 100*DIM + 2, 200, keys) == 100);
+            VERIFY_TRUE(keys.Size () == 100 && keys.Count () == 100);
+        }
+    }
+
+    void TestDouglasPeuckerN::TestSelection () {
+        const unsigned DIM = 3;
+        const unsigned count = 10000;
+
+        std::vector <float> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <float, DIM> ());
+        Workspace <float> workspace;
+
+        // the selection is copied into exactly sized storage
+        {
+            const unsigned counts [] = {2, 3, 100, count};
+            for (unsigned c = 0; c < 4; ++c) {
+                std::vector <float> expected;
+                psimpl::simplify_douglas_peucker_n <DIM> (
+                    polyline.begin (), polyline.end (), counts [c],
+                    std::back_inserter (expected));
+
+                std::size_t size = psimpl::select_douglas_peucker_n <DIM> (
+                    polyline.begin (), polyline.end (), counts [c], workspace);
+                VERIFY_TRUE(size == expected.size ());
+
+                std::vector <float> result (size);
+                VERIFY_TRUE(psimpl::copy_selection <DIM> (polyline.begin (), result.begin (), workspace) == result.end ());
+                VERIFY_TRUE(result == expected);
+            }
+        }
+        // the selection does not depend on the workspace of other routines
+        {
+            std::vector <float> expected;
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), 100,
+                std::back_inserter (expected));
+
+            std::size_t size = psimpl::select_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), 100, workspace);
+            std::vector <float> other;
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), 500,
+                std::back_inserter (other), workspace);
+
+            std::vector <float> result (size);
+            psimpl::copy_selection <DIM> (polyline.begin (), result.begin (), workspace);
+            VERIFY_TRUE(result == expected);
+        }
+        // invalid input is selected entirely
+        {
+            VERIFY_TRUE(psimpl::select_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.begin () + 3*DIM + 1, 2, workspace) == 3*DIM + 1);
+            std::vector <float> result;
+            psimpl::copy_selection <DIM> (polyline.begin (), std::back_inserter (result), workspace);
+            VERIFY_TRUE(result.size () == 3*DIM + 1);
+            VERIFY_TRUE(std::equal (result.begin (), result.end (), polyline.begin ()));
+        }
+        // count only
+        {
+            VERIFY_TRUE(psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), 100,
+                util::counting_iterator ()).count () == 100*DIM);
+        }
+    }
+
+    void TestDouglasPeuckerN::TestControl () {
+        const unsigned DIM = 2;
+        const unsigned count = 100000;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+
+        // not stopped
+        {
+            std::vector <double> expected;
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), 1000,
+                std::back_inserter (expected));
+
+            SimplificationControl control;
+            std::vector <double> result;
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), 1000,
+                std::back_inserter (result), control);
+            VERIFY_TRUE(result == expected);
+            VERIFY_FALSE(control.Interrupted ());
+            VERIFY_TRUE(control.Progress () == 1);
+        }
+        // cancelled: the result for the number of keys found so far
+        {
+            std::vector <double> expected;
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), 51,
+                std::back_inserter (expected));
+
+            SimplificationControl control (50);
+            control.Cancel ();
+            std::vector <double> result;
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), 1000,
+                std::back_inserter (result), control);
+            VERIFY_TRUE(control.Interrupted ());
+            VERIFY_TRUE(control.Progress () == 51 / 1000.);
+            VERIFY_TRUE(result == expected);
+        }
+    }
+
+    // scaling: run time is O(n log n) on average
+    void TestDouglasPeuckerN::TestScaling () {
+        const unsigned DIM = 2;
+        const unsigned count = 1 << 19;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        std::vector <double> result (polyline.size ());
+
+        VERIFY_SCALING(LINEARITHMIC, [&] (std::size_t n) {
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.begin () + n*DIM, unsigned (n / 16),
+                result.begin ());
+        });
+    }
 }}
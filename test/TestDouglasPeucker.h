@@ -57,6 +57,19 @@ namespace psimpl {
         void TestBidirectionalIterator ();
         void TestForwardIterator ();
         void TestReturnValue ();
+        void TestParallel ();
+        void TestContiguous ();
+        void TestChunked ();
+        void TestHull ();
+        void TestPrecision ();
+        void TestIndices ();
+        void TestErrors ();
+        void TestLevels ();
+        void TestBoundingBoxes ();
+        void TestKeys ();
+        void TestSelection ();
+        void TestControl ();
+        void TestScaling ();
     };
 
     //! Tests function psimpl::simplify_douglas_peucker_n
@@ -75,6 +88,13 @@ namespace psimpl {
         void TestBidirectionalIterator ();
         void TestForwardIterator ();
         void TestReturnValue ();
+        void TestIndices ();
+        void TestErrors ();
+        void TestBoundingBoxes ();
+        void TestKeys ();
+        void TestSelection ();
+        void TestControl ();
+        void TestScaling ();
     };
 }}
 
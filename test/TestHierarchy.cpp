@@ -0,0 +1,206 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#include "TestHierarchy.h"
+#include "test.h"
+#include "helper.h"
+#include "../lib/psimpl.h"
+#include <vector>
+#include <list>
+
+
+namespace psimpl {
+    namespace test
+{
+    TestHierarchy::TestHierarchy () {
+        TEST_RUN("invalid input", TestInvalidInput ());
+        TEST_RUN("count", TestCount ());
+        TEST_RUN("tolerance", TestTolerance ());
+        TEST_RUN("collinear", TestCollinear ());
+        TEST_RUN("serialize", TestSerialize ());
+    }
+
+    void TestHierarchy::TestInvalidInput () {
+        const unsigned DIM = 2;
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), 10*DIM, RandomWalkLine <double, DIM> (1, 2));
+        DouglasPeuckerHierarchy <DIM, double> hierarchy;
+        std::vector <unsigned> indices;
+
+        // empty hierarchy yields nothing
+        hierarchy.DouglasPeuckerIndices (1., std::back_inserter (indices));
+        hierarchy.DouglasPeuckerNIndices (5, std::back_inserter (indices));
+        VERIFY_TRUE(indices.empty ());
+
+        // incomplete point
+        VERIFY_FALSE(hierarchy.Build (polyline.begin (), polyline.end () - 1));
+        VERIFY_TRUE(hierarchy.PointCount () == 0);
+        // not enough points
+        VERIFY_FALSE(hierarchy.Build (polyline.begin (), polyline.begin () + DIM));
+        VERIFY_TRUE(hierarchy.PointCount () == 0);
+
+        // two points
+        ASSERT_TRUE(hierarchy.Build (polyline.begin (), polyline.begin () + 2*DIM));
+        hierarchy.DouglasPeuckerIndices (1., std::back_inserter (indices));
+        ASSERT_TRUE(indices.size () == 2);
+        VERIFY_TRUE(indices [0] == 0 && indices [1] == 1);
+
+        // invalid tol and count yield all points
+        ASSERT_TRUE(hierarchy.Build (polyline.begin (), polyline.end ()));
+        VERIFY_TRUE(hierarchy.PointCount () == 10);
+        std::vector <double> result;
+        hierarchy.DouglasPeucker (polyline.begin (), 0., std::back_inserter (result));
+        VERIFY_TRUE(result == polyline);
+        result.clear ();
+        hierarchy.DouglasPeuckerN (polyline.begin (), 1, std::back_inserter (result));
+        VERIFY_TRUE(result == polyline);
+        result.clear ();
+        hierarchy.DouglasPeuckerN (polyline.begin (), 10, std::back_inserter (result));
+        VERIFY_TRUE(result == polyline);
+    }
+
+    // point count queries equal DPn
+    void TestHierarchy::TestCount () {
+        const unsigned DIM = 3;
+        std::vector <float> polyline;
+        std::generate_n (std::back_inserter (polyline), 5000*DIM, RandomWalkLine <float, DIM> (1, 2));
+        std::list <float> input (polyline.begin (), polyline.end ());
+        DouglasPeuckerHierarchy <DIM, float> hierarchy;
+        ASSERT_TRUE(hierarchy.Build (input.begin (), input.end ()));
+
+        unsigned counts [] = {2, 3, 4, 50, 1000, 4999};
+        for (unsigned c = 0; c < 6; ++c) {
+            std::vector <float> expected, result;
+            std::vector <unsigned> expectedIndices, indices;
+            simplify_douglas_peucker_n <DIM> (polyline.begin (), polyline.end (), counts [c],
+                                              std::back_inserter (expected));
+            simplify_douglas_peucker_n_indices <DIM> (polyline.begin (), polyline.end (), counts [c],
+                                                      std::back_inserter (expectedIndices));
+
+            hierarchy.DouglasPeuckerN (polyline.begin (), counts [c], std::back_inserter (result));
+            hierarchy.DouglasPeuckerNIndices (counts [c], std::back_inserter (indices));
+            VERIFY_TRUE(result == expected);
+            VERIFY_TRUE(indices == expectedIndices);
+        }
+
+        // equally distant keys
+        std::vector <float> zigzag;
+        for (unsigned p = 0; p < 1001; ++p) {
+            zigzag.push_back (static_cast <float> (p));
+            zigzag.push_back (static_cast <float> (p % 2));
+            zigzag.push_back (0.f);
+        }
+        ASSERT_TRUE(hierarchy.Build (zigzag.begin (), zigzag.end ()));
+        for (unsigned count = 2; count < 1001; count += 37) {
+            std::vector <unsigned> expectedIndices, indices;
+            simplify_douglas_peucker_n_indices <DIM> (zigzag.begin (), zigzag.end (), count,
+                                                      std::back_inserter (expectedIndices));
+            hierarchy.DouglasPeuckerNIndices (count, std::back_inserter (indices));
+            VERIFY_TRUE(indices == expectedIndices);
+        }
+    }
+
+    // tolerance queries equal DP for polylines that are not affected by its radial distance step
+    void TestHierarchy::TestTolerance () {
+        const unsigned DIM = 2;
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), 5000*DIM, RandomWalkLine <double, DIM> (5, 20));
+        DouglasPeuckerHierarchy <DIM, double> hierarchy;
+        ASSERT_TRUE(hierarchy.Build (polyline.begin (), polyline.end ()));
+
+        double tols [] = {0.5, 1., 2.5, 4.9};
+        for (unsigned t = 0; t < 4; ++t) {
+            std::vector <double> expected, result;
+            std::vector <unsigned> expectedIndices, indices;
+            simplify_douglas_peucker <DIM> (polyline.begin (), polyline.end (), tols [t],
+                                            std::back_inserter (expected));
+            simplify_douglas_peucker_indices <DIM> (polyline.begin (), polyline.end (), tols [t],
+                                                    std::back_inserter (expectedIndices));
+
+            hierarchy.DouglasPeucker (polyline.begin (), tols [t], std::back_inserter (result));
+            hierarchy.DouglasPeuckerIndices (tols [t], std::back_inserter (indices));
+            VERIFY_TRUE(result == expected);
+            VERIFY_TRUE(indices == expectedIndices);
+        }
+        // a large tolerance only keeps the end points
+        std::vector <unsigned> indices;
+        hierarchy.DouglasPeuckerIndices (1e9, std::back_inserter (indices));
+        ASSERT_TRUE(indices.size () == 2);
+        VERIFY_TRUE(indices [0] == 0 && indices [1] == 4999);
+    }
+
+    // collinear points are never added
+    void TestHierarchy::TestCollinear () {
+        const unsigned DIM = 2;
+        const unsigned count = 11;
+        std::vector <float> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, StraightLine <float, DIM> ());
+        DouglasPeuckerHierarchy <DIM, float> hierarchy;
+        ASSERT_TRUE(hierarchy.Build (polyline.begin (), polyline.end ()));
+
+        std::vector <unsigned> indices;
+        hierarchy.DouglasPeuckerIndices (0.1f, std::back_inserter (indices));
+        ASSERT_TRUE(indices.size () == 2);
+        VERIFY_TRUE(indices [0] == 0 && indices [1] == count-1);
+    }
+
+    void TestHierarchy::TestSerialize () {
+        const unsigned DIM = 2;
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), 1000*DIM, RandomWalkLine <double, DIM> (1, 2));
+        DouglasPeuckerHierarchy <DIM, double> hierarchy, restored;
+        ASSERT_TRUE(hierarchy.Build (polyline.begin (), polyline.end ()));
+
+        std::vector <unsigned char> bytes;
+        hierarchy.Serialize (std::back_inserter (bytes));
+        ASSERT_TRUE(bytes.size () == hierarchy.SerializedSize ());
+        ASSERT_TRUE(restored.Deserialize (&bytes [0], &bytes [0] + bytes.size ()));
+        VERIFY_TRUE(restored.PointCount () == 1000);
+
+        std::vector <unsigned> expected, indices;
+        hierarchy.DouglasPeuckerIndices (2., std::back_inserter (expected));
+        restored.DouglasPeuckerIndices (2., std::back_inserter (indices));
+        VERIFY_TRUE(indices == expected);
+        expected.clear ();
+        indices.clear ();
+        hierarchy.DouglasPeuckerNIndices (100, std::back_inserter (expected));
+        restored.DouglasPeuckerNIndices (100, std::back_inserter (indices));
+        VERIFY_TRUE(indices == expected);
+
+        // truncated data, and data of another value type
+        VERIFY_FALSE(restored.Deserialize (&bytes [0], &bytes [0] + bytes.size () - 1));
+        VERIFY_TRUE(restored.PointCount () == 0);
+        DouglasPeuckerHierarchy <DIM, float> other;
+        VERIFY_FALSE(other.Deserialize (&bytes [0], &bytes [0] + bytes.size ()));
+    }
+}}
@@ -0,0 +1,191 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#include "TestIo.h"
+#include "test.h"
+#include "../lib/psimpl.h"
+#include "../lib/psimpl_io.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+namespace psimpl {
+    namespace test
+{
+    namespace
+    {
+        const char* PATH = "psimpl-test-io.psl";
+    }
+
+    TestIo::TestIo () {
+        TEST_RUN("round trip", TestRoundTrip ());
+        TEST_RUN("simplify", TestSimplify ());
+        TEST_RUN("invalid", TestInvalid ());
+        std::remove (PATH);
+    }
+
+    void TestIo::TestRoundTrip () {
+        const unsigned DIM = 3;
+        std::vector <float> polylines [3];
+        for (unsigned i = 0; i < 30; ++i) {
+            polylines [0].push_back (i * 0.5f);
+        }
+        for (unsigned i = 0; i < 9; ++i) {
+            polylines [2].push_back (-1.f * i);
+        }
+
+        io::FileWriter writer;
+        ASSERT_TRUE(writer.Open (PATH, DIM, io::FLOAT32));
+        for (unsigned p = 0; p < 3; ++p) {
+            std::copy (polylines [p].begin (), polylines [p].end (), writer.Output <float> ());
+            ASSERT_TRUE(writer.EndPolyline ());
+        }
+        ASSERT_TRUE(writer.Close ());
+
+        io::MappedFile file;
+        ASSERT_TRUE(file.Open (PATH));
+        ASSERT_TRUE(file.IsOpen ());
+        ASSERT_TRUE(file.Dim () == DIM);
+        ASSERT_TRUE(file.Type () == io::FLOAT32);
+        ASSERT_TRUE(file.PolylineCount () == 3);
+        for (unsigned p = 0; p < 3; ++p) {
+            const float* first = 0;
+            const float* last = 0;
+            ASSERT_TRUE(file.PointCount (p) * DIM == polylines [p].size ());
+            ASSERT_TRUE(file.Polyline (p, first, last));
+            ASSERT_TRUE(std::vector <float> (first, last) == polylines [p]);
+        }
+
+        // the coordinate type must match
+        const double* first = 0;
+        const double* last = 0;
+        ASSERT_FALSE(file.Polyline (0, first, last));
+        file.Close ();
+        ASSERT_FALSE(file.IsOpen ());
+    }
+
+    void TestIo::TestSimplify () {
+        const unsigned DIM = 2;
+        const std::int64_t tol = 5;
+        std::vector <std::int64_t> polyline;
+        for (std::int64_t i = 0; i < 1000; ++i) {
+            polyline.push_back (i);
+            polyline.push_back ((i * 7919) % 61);
+        }
+        std::vector <std::int64_t> expected;
+        simplify_douglas_peucker <DIM> (polyline.begin (), polyline.end (), tol,
+                                        std::back_inserter (expected));
+
+        {
+            io::FileWriter writer;
+            ASSERT_TRUE(writer.Open (PATH, DIM, io::INT64));
+            std::copy (polyline.begin (), polyline.end (), writer.Output <std::int64_t> ());
+            ASSERT_TRUE(writer.EndPolyline ());
+            ASSERT_TRUE(writer.Close ());
+        }
+        std::vector <std::int64_t> result;
+        {
+            // simplify the mapped coordinates into a second file
+            io::MappedFile file;
+            ASSERT_TRUE(file.Open (PATH));
+            const std::int64_t* first = 0;
+            const std::int64_t* last = 0;
+            ASSERT_TRUE(file.Polyline (0, first, last));
+            simplify_douglas_peucker <DIM> (first, last, tol, std::back_inserter (result));
+            ASSERT_TRUE(result == expected);
+
+            io::FileWriter writer;
+            std::string path = std::string (PATH) + ".out";
+            ASSERT_TRUE(writer.Open (path.c_str (), DIM, io::INT64));
+            simplify_douglas_peucker <DIM> (first, last, tol, writer.Output <std::int64_t> ());
+            ASSERT_TRUE(writer.EndPolyline ());
+            ASSERT_TRUE(writer.Close ());
+
+            io::MappedFile simplified;
+            ASSERT_TRUE(simplified.Open (path.c_str ()));
+            ASSERT_TRUE(simplified.Polyline (0, first, last));
+            ASSERT_TRUE(std::vector <std::int64_t> (first, last) == expected);
+            simplified.Close ();
+            std::remove (path.c_str ());
+        }
+    }
+
+    void TestIo::TestInvalid () {
+        io::MappedFile file;
+        ASSERT_FALSE(file.Open ("psimpl-test-io.missing"));
+        ASSERT_FALSE(file.Error ().empty ());
+
+        // incomplete point
+        io::FileWriter writer;
+        ASSERT_TRUE(writer.Open (PATH, 2, io::FLOAT64));
+        *writer.Output <double> () = 1.0;
+        ASSERT_FALSE(writer.EndPolyline ());
+        ASSERT_FALSE(writer.Close ());
+
+        // not a polyline file
+        std::FILE* f = std::fopen (PATH, "wb");
+        std::fputs ("1 2\n3 4\n", f);
+        std::fclose (f);
+        ASSERT_FALSE(file.Open (PATH));
+        ASSERT_FALSE(file.IsOpen ());
+
+        // truncated offset table
+        ASSERT_TRUE(writer.Open (PATH, 2, io::FLOAT64));
+        std::vector <double> coords (100, 1.0);
+        std::copy (coords.begin (), coords.end (), writer.Output <double> ());
+        ASSERT_TRUE(writer.EndPolyline ());
+        ASSERT_TRUE(writer.Close ());
+        std::vector <char> bytes;
+        f = std::fopen (PATH, "rb");
+        for (int c; (c = std::fgetc (f)) != EOF; ) {
+            bytes.push_back (static_cast <char> (c));
+        }
+        std::fclose (f);
+        ASSERT_TRUE(bytes.size () == 64 + 800 + 16);
+        f = std::fopen (PATH, "wb");
+        std::fwrite (&bytes [0], 1, bytes.size () - 8, f);
+        std::fclose (f);
+        ASSERT_FALSE(file.Open (PATH));
+
+        // point offset whose coordinate size overflows 64 bits
+        std::uint64_t pointCount = std::uint64_t (1) << 60;
+        std::memcpy (&bytes [bytes.size () - 8], &pointCount, sizeof (pointCount));
+        f = std::fopen (PATH, "wb");
+        std::fwrite (&bytes [0], 1, bytes.size (), f);
+        std::fclose (f);
+        ASSERT_FALSE(file.Open (PATH));
+        ASSERT_FALSE(file.IsOpen ());
+    }
+}}
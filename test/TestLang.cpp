@@ -37,11 +37,37 @@
 #include <vector>
 #include <deque>
 #include <list>
+#include <forward_list>
 
 
 namespace psimpl {
     namespace test
 {
+    // straightforward Lang implementation that rescans each shrunk search region
+    template <unsigned DIM, class T>
+    std::vector <T> ReferenceLang (const std::vector <T>& polyline, T tol, unsigned lookAhead) {
+        std::vector <T> result;
+        unsigned pointCount = static_cast <unsigned> (polyline.size () / DIM);
+        unsigned current = 0;
+        result.insert (result.end (), polyline.begin (), polyline.begin () + DIM);
+        while (current + 1 < pointCount) {
+            unsigned next = std::min (current + lookAhead, pointCount - 1);
+            for (; current + 1 < next; --next) {
+                T d2 = 0;
+                for (unsigned p = current + 1; p < next; ++p) {
+                    d2 = std::max (d2, math::segment_distance2 <DIM> (
+                        &polyline [current*DIM], &polyline [next*DIM], &polyline [p*DIM]));
+                }
+                if (d2 < tol * tol) {
+                    break;
+                }
+            }
+            current = next;
+            result.insert (result.end (), polyline.begin () + current*DIM, polyline.begin () + (current+1)*DIM);
+        }
+        return result;
+    }
+
     TestLang::TestLang () {
         TEST_RUN("incomplete point", TestIncompletePoint ());
         TEST_RUN("not enough points", TestNotEnoughPoints ());
@@ -52,7 +78,11 @@ namespace psimpl {
         TEST_RUN("basic sanity", TestBasicSanity ());
         TEST_RUN("random iterator", TestRandomIterator ());
         TEST_RUN("bidirectional iterator", TestBidirectionalIterator ());
+        TEST_RUN("forward iterator", TestForwardIterator ());
         TEST_RUN("return value", TestReturnValue ());
+        TEST_RUN("reference", TestReference ());
+        TEST_RUN("control", TestControl ());
+        TEST_SCALING("scaling", TestScaling ());
     }
 
     // incomplete point: coord count % DIM > 1
@@ -499,6 +529,26 @@ namespace psimpl {
         }
     }
 
+    // forward iterator
+    void TestLang::TestForwardIterator () {
+        const unsigned count = 13;
+        const unsigned lookAhead = 5;
+        const unsigned DIM = 2;
+        std::vector <float> coords;
+        std::generate_n (std::back_inserter (coords), count*DIM, SquareToothLine <float, DIM> ());
+        std::forward_list <float> polyline (coords.begin (), coords.end ());
+        std::vector <float> result;
+        float tol = 0.9f;
+
+        psimpl::simplify_lang <DIM> (
+            polyline.begin (), polyline.end (), tol, lookAhead,
+            std::back_inserter (result));
+
+        VERIFY_TRUE(result.size () == 5*DIM);
+        int keys [] = {0, 3, 6, 9, 12};
+        VERIFY_TRUE(ComparePoints <DIM> (coords.begin (), result.begin (), std::vector <int> (keys, keys + 5)));
+    }
+
     void TestLang::TestReturnValue () {
         const unsigned DIM = 3;
         const unsigned count = 11;
@@ -525,4 +575,102 @@ namespace psimpl {
                     result))
             == 2*DIM);
     }
-}}
\ No newline at end of file
+
+    // the result equals that of rescanning each search region, also for large look ahead values
+    void TestLang::TestReference () {
+        const unsigned DIM = 2;
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), 2000*DIM, RandomWalkLine <double, DIM> (1, 2));
+        unsigned lookAheads [] = {2, 3, 7, 50, 300, 3000};
+        double tols [] = {0.5, 2., 10.};
+
+        for (unsigned l = 0; l < 6; ++l) {
+            for (unsigned t = 0; t < 3; ++t) {
+                std::vector <double> result;
+                psimpl::simplify_lang <DIM> (
+                    polyline.begin (), polyline.end (), tols [t], lookAheads [l],
+                    std::back_inserter (result));
+                VERIFY_TRUE(result == ReferenceLang <DIM> (polyline, tols [t], lookAheads [l]));
+            }
+        }
+    }
+
+    // scaling: run time is O(n) for a fixed look ahead
+    void TestLang::TestScaling () {
+        const unsigned DIM = 2;
+        const unsigned count = 1 << 19;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        std::vector <double> result (polyline.size ());
+
+        VERIFY_SCALING(LINEAR, [&] (std::size_t n) {
+            psimpl::simplify_lang <DIM> (
+                polyline.begin (), polyline.begin () + n*DIM, 5., 16,
+                result.begin ());
+        });
+    }
+
+    // control: cancellation and progress
+    void TestLang::TestControl () {
+        const unsigned DIM = 2;
+        const unsigned count = 10000;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        std::vector <double> expected;
+        psimpl::simplify_lang <DIM> (
+            polyline.begin (), polyline.end (), 5., 16,
+            std::back_inserter (expected));
+
+        // not stopped
+        {
+            SimplificationControl control;
+            std::vector <double> result;
+            psimpl::simplify_lang <DIM> (
+                polyline.begin (), polyline.end (), 5., 16,
+                std::back_inserter (result), control);
+            VERIFY_TRUE(result == expected);
+            VERIFY_FALSE(control.Interrupted ());
+            VERIFY_TRUE(control.Progress () == 1);
+        }
+        // cancelled: the keys found so far, followed by the last point
+        {
+            SimplificationControl control (10);
+            control.Cancel ();
+            std::list <double> list (polyline.begin (), polyline.end ());
+            std::vector <double> result;
+            psimpl::simplify_lang <DIM> (
+                list.begin (), list.end (), 5., 16,
+                std::back_inserter (result), control);
+            VERIFY_TRUE(control.Interrupted ());
+            VERIFY_TRUE(control.Progress () < 1);
+            VERIFY_TRUE(result.size () == 11*DIM);
+            VERIFY_TRUE(std::equal (result.begin (), result.end () - DIM, expected.begin ()));
+            VERIFY_TRUE(std::equal (result.end () - DIM, result.end (), polyline.end () - DIM));
+
+            // until reset
+            control.Reset ();
+            result.clear ();
+            psimpl::simplify_lang <DIM> (
+                list.begin (), list.end (), 5., 16,
+                std::back_inserter (result), control);
+            VERIFY_TRUE(result == expected);
+            VERIFY_FALSE(control.Interrupted ());
+        }
+        // deadline
+        {
+            SimplificationControl control (1);
+            control.SetDeadline (SimplificationControl::Clock::now ());
+            std::vector <double> result;
+            psimpl::simplify_lang <DIM> (
+                polyline.begin (), polyline.end (), 5., 16,
+                std::back_inserter (result), control);
+            VERIFY_TRUE(control.Interrupted ());
+            VERIFY_TRUE(control.Progress () > 0);
+            VERIFY_TRUE(result.size () == 2*DIM);
+            VERIFY_TRUE(std::equal (result.begin (), result.begin () + DIM, polyline.begin ()));
+            VERIFY_TRUE(std::equal (result.end () - DIM, result.end (), polyline.end () - DIM));
+        }
+    }
+}}
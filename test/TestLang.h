@@ -57,7 +57,11 @@ namespace psimpl {
         void TestBasicSanity ();
         void TestRandomIterator ();
         void TestBidirectionalIterator ();
+        void TestForwardIterator ();
         void TestReturnValue ();
+        void TestReference ();
+        void TestControl ();
+        void TestScaling ();
     };
 }}
 
@@ -40,6 +40,7 @@
 #include <list>
 #include <set>
 #include <limits>
+#include <cstring>
 
 
 namespace psimpl {
@@ -83,6 +84,16 @@ namespace psimpl {
         TEST_RUN("ray_distance2 | random iterator", TestRayDistance_RandomIterator ());
         TEST_RUN("ray_distance2 | bidirectional iterator", TestRayDistance_BidirectionalIterator ());
         TEST_DISABLED("ray_distance2 | forward iterator", TestRayDistance_ForwardIterator ());
+
+        TEST_RUN("exact integer distances", TestExactIntegerDistance ());
+
+        TEST_RUN("fused distances", TestFusedDistance ());
+
+        TEST_RUN("precision policies", TestPrecision ());
+
+        TEST_RUN("FarthestPoint", TestFarthestPoint ());
+
+        TEST_RUN("compute_statistics", TestComputeStatistics ());
     }
 
     void TestMath::TestEqual_RandomIterator () {
@@ -823,4 +834,287 @@ namespace psimpl {
         FAIL("TODO");
     }
 
+    //! \brief compares FarthestPoint::Find against a plain segment_distance2 loop
+    template <unsigned DIM, typename T, typename F>
+    bool CompareFarthestPoint (const std::vector <T>& coords, std::ptrdiff_t first, std::ptrdiff_t last) {
+        const T* s1 = &coords [first*DIM];
+        const T* s2 = &coords [last*DIM];
+        std::ptrdiff_t count = last - first - 1;
+
+        std::ptrdiff_t expectedKey = -1;
+        T expectedDist2 = 0;
+        for (std::ptrdiff_t p = 0; p < count; ++p) {
+            T d2 = psimpl::math::segment_distance2 <DIM, psimpl::math::fixed_precision <F> > (
+                s1, s2, s1 + (p + 1) * DIM);
+            if (!(d2 < expectedDist2)) {
+                expectedKey = p;
+                expectedDist2 = d2;
+            }
+        }
+        std::ptrdiff_t key = -1;
+        T dist2 = 0;
+        psimpl::math::FarthestPoint <DIM, T, F>::Find (s1, s2, s1 + DIM, count, key, dist2);
+        return key == expectedKey && dist2 == expectedDist2;
+    }
+
+    template <unsigned DIM, typename T, typename F>
+    bool CompareFarthestPoint (T step, T noise) {
+        std::vector <T> coords;
+        std::generate_n (std::back_inserter (coords), 1000*DIM, RandomWalkLine <T, DIM> (step, noise));
+        // duplicate points to create equal distances
+        std::copy (coords.begin () + 100*DIM, coords.begin () + 110*DIM, coords.begin () + 200*DIM);
+        std::copy (coords.begin () + 100*DIM, coords.begin () + 110*DIM, coords.begin () + 900*DIM);
+        // all point counts up and until 20, including points beyond both segment end points
+        for (std::ptrdiff_t last = 1; last <= 20; ++last) {
+            if (!CompareFarthestPoint <DIM, T, F> (coords, 0, last) ||
+                !CompareFarthestPoint <DIM, T, F> (coords, last, 0))
+            {
+                return false;
+            }
+        }
+        return CompareFarthestPoint <DIM, T, F> (coords, 0, 999) &&
+               CompareFarthestPoint <DIM, T, F> (coords, 150, 950) &&
+               CompareFarthestPoint <DIM, T, F> (coords, 500, 501);
+    }
+
+    void TestMath::TestExactIntegerDistance () {
+        const unsigned dim = 2;
+        // rounded down
+        {
+            int l1 [] = {0, 0};
+            int l2 [] = {2, 1};
+            int p [] = {0, 3};          // exact squared distance 7.2
+            VERIFY_TRUE(CompareValue(7, psimpl::math::line_distance2 <dim> (l1, l2, p)));
+            VERIFY_TRUE(CompareValue(7, psimpl::math::segment_distance2 <dim> (l1, l2, p)));
+            VERIFY_TRUE(CompareValue(7, psimpl::math::ray_distance2 <dim> (l1, l2, p)));
+        }
+        // rounded up
+        {
+            typedef psimpl::math::round_up_precision <psimpl::math::float_precision> Precision;
+            int l1 [] = {0, 0};
+            int l2 [] = {2, 1};
+            int p [] = {0, 3};          // exact squared distance 7.2
+            int q [] = {1, 3};          // exact squared distance 5
+            VERIFY_TRUE(CompareValue(8, psimpl::math::line_distance2 <dim, Precision> (l1, l2, p)));
+            VERIFY_TRUE(CompareValue(8, psimpl::math::segment_distance2 <dim, Precision> (l1, l2, p)));
+            VERIFY_TRUE(CompareValue(8, psimpl::math::ray_distance2 <dim, Precision> (l1, l2, p)));
+            VERIFY_TRUE(CompareValue(5, psimpl::math::line_distance2 <dim, Precision> (l1, l2, q)));
+            // floating point types are not affected
+            double d1 [] = {0, 0};
+            double d2 [] = {2, 1};
+            double dp [] = {0, 3};
+            VERIFY_TRUE(CompareValue(psimpl::math::line_distance2 <dim> (d1, d2, dp),
+                                     psimpl::math::line_distance2 <dim, Precision> (d1, d2, dp)));
+        }
+        // coinciding line points
+        {
+            int l1 [] = {2, 1};
+            int p [] = {5, 5};
+            VERIFY_TRUE(CompareValue(25, psimpl::math::line_distance2 <dim> (l1, l1, p)));
+        }
+        // 32 bit coordinates, far from the origin
+        {
+            int l1 [] = {1000000, -2000000};
+            int l2 [] = {1003000, -1996000};
+            int p [] = {1001110 + 4*5, -1998520 - 3*5};
+            VERIFY_TRUE(CompareValue(625, psimpl::math::line_distance2 <dim> (l1, l2, p)));
+            VERIFY_TRUE(CompareValue(625, psimpl::math::segment_distance2 <dim> (l1, l2, p)));
+            VERIFY_TRUE(CompareValue(625, psimpl::math::ray_distance2 <dim> (l1, l2, p)));
+        }
+        // unsigned types interpolate the projection instead
+        {
+            typedef psimpl::math::round_up_precision <psimpl::math::float_precision> Precision;
+            VERIFY_TRUE(psimpl::math::exact_projection <int>::value);
+            VERIFY_TRUE(!psimpl::math::exact_projection <unsigned>::value);
+            unsigned l1 [] = {0, 0};
+            unsigned l2 [] = {4, 0};
+            unsigned p [] = {2, 3};
+            VERIFY_TRUE(CompareValue(9u, psimpl::math::line_distance2 <dim> (l1, l2, p)));
+            VERIFY_TRUE(CompareValue(9u, psimpl::math::segment_distance2 <dim, Precision> (l1, l2, p)));
+        }
+#ifdef PSIMPL_INT128
+        // fixed-point 64 bit coordinates (1e-7 degrees)
+        {
+            long long l1 [] = {1200000000LL, 450000000LL};
+            long long l2 [] = {1500000000LL, 850000000LL};
+            long long p [] = {1311000003LL + 28, 598000004LL - 21};
+            VERIFY_TRUE(CompareValue(1225LL, psimpl::math::line_distance2 <dim> (l1, l2, p)));
+            VERIFY_TRUE(CompareValue(1225LL, psimpl::math::segment_distance2 <dim> (l1, l2, p)));
+            VERIFY_TRUE(CompareValue(1225LL, psimpl::math::ray_distance2 <dim> (l1, l2, p)));
+        }
+#endif
+    }
+
+    //! \brief true when a and b have the exact same bit pattern
+    template <typename T>
+    bool BitwiseEqual (T a, T b) {
+        return std::memcmp (&a, &b, sizeof (T)) == 0;
+    }
+
+    //! \brief compares the fused distance functions of Distance against GenericDistance
+    template <unsigned DIM, typename T, class InputIterator>
+    bool CompareFusedDistance (InputIterator p1, InputIterator p2, InputIterator p) {
+        typedef psimpl::math::Distance <DIM> fused;
+        typedef psimpl::math::GenericDistance <DIM> generic;
+        return BitwiseEqual <T> (fused::LineDistance2 (p1, p2, p), generic::LineDistance2 (p1, p2, p)) &&
+               BitwiseEqual <T> (fused::SegmentDistance2 (p1, p2, p), generic::SegmentDistance2 (p1, p2, p)) &&
+               BitwiseEqual <T> (fused::RayDistance2 (p1, p2, p), generic::RayDistance2 (p1, p2, p)) &&
+               BitwiseEqual <T> (fused::PointDistance2 (p1, p), generic::PointDistance2 (p1, p));
+    }
+
+    template <unsigned DIM, typename T>
+    bool CompareFusedDistance (T step, T noise) {
+        std::vector <T> coords;
+        std::generate_n (std::back_inserter (coords), 100*DIM, RandomWalkLine <T, DIM> (step, noise));
+        std::list <T> list (coords.begin (), coords.end ());
+        const T* points = &coords [0];
+        // all combinations of points, including coinciding points and points beyond the ends
+        for (unsigned i = 0; i < 100; i += 3) {
+            for (unsigned j = 0; j < 100; j += 7) {
+                typename std::list <T>::const_iterator p1 = list.begin ();
+                typename std::list <T>::const_iterator p2 = list.begin ();
+                std::advance (p1, i*DIM);
+                std::advance (p2, j*DIM);
+                for (unsigned k = 0; k < 100; ++k) {
+                    typename std::list <T>::const_iterator it = list.begin ();
+                    std::advance (it, k*DIM);
+                    if (!CompareFusedDistance <DIM, T> (points + i*DIM, points + j*DIM, points + k*DIM) ||
+                        !CompareFusedDistance <DIM, T> (p1, p2, it))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    void TestMath::TestFusedDistance () {
+        VERIFY_TRUE((CompareFusedDistance <2, float> (1.f, 5.f)));
+        VERIFY_TRUE((CompareFusedDistance <3, float> (1.f, 5.f)));
+        VERIFY_TRUE((CompareFusedDistance <4, float> (1.f, 5.f)));
+        VERIFY_TRUE((CompareFusedDistance <2, double> (1.0, 5.0)));
+        VERIFY_TRUE((CompareFusedDistance <3, double> (0.1, 0.3)));
+        VERIFY_TRUE((CompareFusedDistance <4, double> (1.0, 5.0)));
+        VERIFY_TRUE((CompareFusedDistance <2, int> (10, 50)));
+        VERIFY_TRUE((CompareFusedDistance <3, int> (10, 50)));
+        VERIFY_TRUE((CompareFusedDistance <3, long long> (10, 50)));
+        VERIFY_TRUE((CompareFusedDistance <4, long long> (10, 50)));
+    }
+
+    void TestMath::TestPrecision () {
+        using namespace psimpl::math;
+        const unsigned dim = 2;
+        // far from the origin, on a 100km segment: p lies 0.0005 from the segment
+        const double x = 500000, y = 5000000;
+        const double s1 [] = {x, y};
+        const double s2 [] = {x + 100000, y};
+        const double p [] = {x + 33333.3, y + 0.0005};
+        {
+            // float fractions are the default
+            VERIFY_TRUE((BitwiseEqual (line_distance2 <dim> (s1, s2, p),
+                                      line_distance2 <dim, float_precision> (s1, s2, p))));
+            VERIFY_TRUE((BitwiseEqual (segment_distance2 <dim> (s1, s2, p),
+                                      segment_distance2 <dim, float_precision> (s1, s2, p))));
+            VERIFY_TRUE((BitwiseEqual (ray_distance2 <dim> (s1, s2, p),
+                                      ray_distance2 <dim, float_precision> (s1, s2, p))));
+        }
+        {
+            // float fractions are off by a millimeter, double fractions are not
+            VERIFY_TRUE((1e-6 < segment_distance2 <dim, float_precision> (s1, s2, p)));
+            VERIFY_TRUE((std::fabs (segment_distance2 <dim, double_precision> (s1, s2, p) - 2.5e-7) < 1e-12));
+            VERIFY_TRUE((std::fabs (line_distance2 <dim, double_precision> (s1, s2, p) - 2.5e-7) < 1e-12));
+            VERIFY_TRUE((std::fabs (ray_distance2 <dim, double_precision> (s1, s2, p) - 2.5e-7) < 1e-12));
+            VERIFY_TRUE((std::fabs (segment_distance2 <dim, long_double_precision> (s1, s2, p) - 2.5e-7) < 1e-12));
+        }
+        {
+            // value_type precision
+            VERIFY_TRUE((BitwiseEqual (segment_distance2 <dim, value_precision> (s1, s2, p),
+                                      segment_distance2 <dim, double_precision> (s1, s2, p))));
+            const float f1 [] = {0, 0};
+            const float f2 [] = {10, 3};
+            const float f3 [] = {3, 7};
+            VERIFY_TRUE((BitwiseEqual (segment_distance2 <dim, value_precision> (f1, f2, f3),
+                                      segment_distance2 <dim, float_precision> (f1, f2, f3))));
+        }
+        {
+            // exact integer distances do not depend on the precision
+            int l1 [] = {0, 0};
+            int l2 [] = {2, 1};
+            int q [] = {0, 3};
+            VERIFY_TRUE((CompareValue(7, line_distance2 <dim, float_precision> (l1, l2, q))));
+            VERIFY_TRUE((CompareValue(7, line_distance2 <dim, double_precision> (l1, l2, q))));
+            VERIFY_TRUE((CompareValue(7, line_distance2 <dim, value_precision> (l1, l2, q))));
+        }
+    }
+
+    void TestMath::TestFarthestPoint () {
+        // vectorized implementations
+        VERIFY_TRUE((CompareFarthestPoint <2, float, float> (1.f, 5.f)));
+        VERIFY_TRUE((CompareFarthestPoint <3, float, float> (1.f, 5.f)));
+        VERIFY_TRUE((CompareFarthestPoint <2, double, float> (1.0, 5.0)));
+        VERIFY_TRUE((CompareFarthestPoint <3, double, float> (1.0, 5.0)));
+        VERIFY_TRUE((CompareFarthestPoint <2, double, float> (0.0, 5.0)));
+        VERIFY_TRUE((CompareFarthestPoint <2, double, double> (1.0, 5.0)));
+        VERIFY_TRUE((CompareFarthestPoint <3, double, double> (1.0, 5.0)));
+        // generic implementation
+        VERIFY_TRUE((CompareFarthestPoint <2, int, float> (1, 5)));
+        VERIFY_TRUE((CompareFarthestPoint <4, double, float> (1.0, 5.0)));
+        VERIFY_TRUE((CompareFarthestPoint <2, float, double> (1.f, 5.f)));
+        VERIFY_TRUE((CompareFarthestPoint <2, double, long double> (1.0, 5.0)));
+    }
+
+    void TestMath::TestComputeStatistics () {
+        {
+            // no values
+            std::vector <double> values;
+            math::Statistics stats = math::compute_statistics (values.begin (), values.end ());
+            VERIFY_TRUE(stats.max == 0 && stats.sum == 0 && stats.mean == 0 && stats.std == 0);
+        }
+        {
+            // the range is not modified
+            const int values [] = {2, 4, 4, 4, 5, 5, 7, 9};
+            std::list <int> input (values, values + 8);
+            math::Statistics stats = math::compute_statistics (input.begin (), input.end ());
+            VERIFY_TRUE(std::equal (input.begin (), input.end (), values));
+            VERIFY_TRUE(stats.max == 9);
+            VERIFY_TRUE(stats.sum == 40);
+            VERIFY_TRUE(stats.mean == 5);
+            VERIFY_TRUE(stats.std == 2);
+        }
+        {
+            // negative values, and a large offset that defeats summing squares
+            const double offset = 1e9;
+            const double values [] = {-offset - 3, -offset - 1, -offset - 1, -offset + 1};
+            math::Statistics stats = math::compute_statistics (values, values + 4);
+            VERIFY_TRUE(stats.max == -offset + 1);
+            VERIFY_TRUE(stats.sum == -4*offset - 4);
+            VERIFY_TRUE(stats.mean == -offset - 1);
+            VERIFY_TRUE(std::fabs (stats.std - std::sqrt (2.0)) < 1e-6);
+        }
+        {
+            // the accumulator matches a two pass computation
+            std::vector <double> values;
+            std::generate_n (std::back_inserter (values), 1000, RandomWalkLine <double, 1> (1, 2));
+            math::StatisticsAccumulator accumulator;
+            double max = values [0], sum = 0, squares = 0;
+            for (std::size_t v = 0; v < values.size (); ++v) {
+                accumulator.Add (values [v]);
+                max = std::max (max, values [v]);
+                sum += values [v];
+            }
+            double mean = sum / values.size ();
+            for (std::size_t v = 0; v < values.size (); ++v) {
+                squares += (values [v] - mean) * (values [v] - mean);
+            }
+            double std = std::sqrt (squares / values.size ());
+
+            math::Statistics stats = accumulator.Result ();
+            VERIFY_TRUE(stats.max == max);
+            VERIFY_TRUE(stats.sum == sum);
+            VERIFY_TRUE(stats.mean == mean);
+            VERIFY_TRUE(std::fabs (stats.std - std) <= 1e-12 * std);
+        }
+    }
+
 }}
@@ -80,6 +80,16 @@ namespace psimpl {
         void TestRayDistance_RandomIterator ();
         void TestRayDistance_BidirectionalIterator ();
         void TestRayDistance_ForwardIterator ();
+
+        void TestExactIntegerDistance ();
+
+        void TestFusedDistance ();
+
+        void TestPrecision ();
+
+        void TestFarthestPoint ();
+
+        void TestComputeStatistics ();
     };
 }}
 
@@ -37,6 +37,7 @@
 #include <vector>
 #include <deque>
 #include <list>
+#include <forward_list>
 
 
 namespace psimpl {
@@ -49,8 +50,9 @@ namespace psimpl {
         TEST_RUN("valid n", TestValidN ());
         TEST_RUN("random iterator", TestRandomIterator ());
         TEST_RUN("bidirectional iterator", TestBidirectionalIterator ());
-        TEST_DISABLED("forward iterator", TestForwardIterator ());
+        TEST_RUN("forward iterator", TestForwardIterator ());
         TEST_RUN("return value", TestReturnValue ());
+        TEST_SCALING("scaling", TestScaling ());
     }
 
     // incomplete point: coord count % DIM > 1
@@ -289,7 +291,53 @@ namespace psimpl {
 
     // forward iterator, different value types, different dimensions
     void TestNthPoint::TestForwardIterator () {
-        FAIL("TODO");
+        const unsigned n = 4;
+        const unsigned count = 10;
+        {
+            const unsigned DIM = 2;
+            std::vector <float> coords;
+            std::generate_n (std::back_inserter (coords), count*DIM, StraightLine <float, DIM> ());
+            std::forward_list <float> polyline (coords.begin (), coords.end ());
+            std::vector <float> result;
+
+            psimpl::simplify_nth_point <DIM> (
+                polyline.begin (), polyline.end (), n,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == 4*DIM);
+            int keys [] = {0, 4, 8, 9};
+            VERIFY_TRUE(ComparePoints <DIM> (coords.begin (), result.begin (), std::vector <int> (keys, keys + 4)));
+        }
+        {
+            // incomplete last point, detected after simplifying the preceding points
+            const unsigned DIM = 2;
+            std::vector <double> coords;
+            std::generate_n (std::back_inserter (coords), count*DIM-1, StraightLine <double, DIM> ());
+            std::forward_list <double> polyline (coords.begin (), coords.end ());
+            std::vector <double> result;
+
+            psimpl::simplify_nth_point <DIM> (
+                polyline.begin (), polyline.end (), n,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == coords);
+        }
+        {
+            // identical to random access input
+            const unsigned DIM = 2;
+            std::vector <int> coords, expected, result;
+            std::generate_n (std::back_inserter (coords), 10000*DIM, RandomWalkLine <int, DIM> (10, 20));
+            std::forward_list <int> polyline (coords.begin (), coords.end ());
+
+            psimpl::simplify_nth_point <DIM> (
+                coords.begin (), coords.end (), n,
+                std::back_inserter (expected));
+            psimpl::simplify_nth_point <DIM> (
+                polyline.begin (), polyline.end (), n,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == expected);
+        }
     }
 
     void TestNthPoint::TestReturnValue () {
@@ -318,5 +366,21 @@ namespace psimpl {
                     result))
             == 8*DIM);
     }
+
+    // scaling: run time is O(n)
+    void TestNthPoint::TestScaling () {
+        const unsigned DIM = 2;
+        const unsigned count = 1 << 19;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        std::vector <double> result (polyline.size ());
+
+        VERIFY_SCALING(LINEAR, [&] (std::size_t n) {
+            psimpl::simplify_nth_point <DIM> (
+                polyline.begin (), polyline.begin () + n*DIM, 10,
+                result.begin ());
+        });
+    }
 }}
 
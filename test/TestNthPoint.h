@@ -56,6 +56,7 @@ namespace psimpl {
         void TestBidirectionalIterator ();
         void TestForwardIterator ();
         void TestReturnValue ();
+        void TestScaling ();
     };
 }}
 
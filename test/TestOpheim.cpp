@@ -37,6 +37,7 @@
 #include <vector>
 #include <deque>
 #include <list>
+#include <forward_list>
 
 
 namespace psimpl {
@@ -50,8 +51,11 @@ namespace psimpl {
         TEST_RUN("basic sanity", TestBasicSanity ());
         TEST_RUN("random iterator", TestRandomIterator ());
         TEST_RUN("bidirectional iterator", TestBidirectionalIterator ());
-        TEST_DISABLED("forward iterator", TestForwardIterator ());
+        TEST_RUN("forward iterator", TestForwardIterator ());
         TEST_RUN("return value", TestReturnValue ());
+        TEST_RUN("stream", TestStream ());
+        TEST_RUN("stream | max delay", TestStreamMaxDelay ());
+        TEST_SCALING("scaling", TestScaling ());
     }
     
     // incomplete point: coord count % DIM > 1
@@ -372,9 +376,10 @@ namespace psimpl {
                     polyline.begin (), polyline.end (), minTol, maxTol,
                     std::back_inserter (result));
 
-            VERIFY_TRUE(result.size () == 3*DIM);
-            int keys [] = {0, 17, 24};
-            VERIFY_TRUE(ComparePoints <DIM> (polyline.begin (), result.begin (), std::vector <int> (keys, keys + 3)));
+            // the squared distance of point 24 to ray (17, 20) is 9.8, beyond minTol
+            VERIFY_TRUE(result.size () == 4*DIM);
+            int keys [] = {0, 17, 23, 24};
+            VERIFY_TRUE(ComparePoints <DIM> (polyline.begin (), result.begin (), std::vector <int> (keys, keys + 4)));
         }
     }
 
@@ -400,7 +405,58 @@ namespace psimpl {
 
     // forward iterator, different value types, different dimensions
     void TestOpheim::TestForwardIterator () {
-        FAIL("TODO");
+        const unsigned count = 25;
+        {
+            const unsigned DIM = 3;
+            std::vector <float> coords;
+            std::generate_n (std::back_inserter (coords), count*DIM, SquareToothLine <float, DIM> ());
+            std::forward_list <float> polyline (coords.begin (), coords.end ());
+            std::vector <float> result;
+            float minTol = 2.5;
+            float maxTol = 6.5;
+
+            psimpl::simplify_opheim <DIM> (
+                polyline.begin (), polyline.end (), minTol, maxTol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == 5*DIM);
+            int keys [] = {0, 12, 17, 23, 24};
+            VERIFY_TRUE(ComparePoints <DIM> (coords.begin (), result.begin (), std::vector <int> (keys, keys + 5)));
+        }
+        {
+            // incomplete last point, detected after simplifying the preceding points
+            const unsigned DIM = 3;
+            std::vector <double> coords;
+            std::generate_n (std::back_inserter (coords), count*DIM-1, SquareToothLine <double, DIM> ());
+            std::forward_list <double> polyline (coords.begin (), coords.end ());
+            std::vector <double> result;
+            double minTol = 2.5;
+            double maxTol = 6.5;
+
+            psimpl::simplify_opheim <DIM> (
+                polyline.begin (), polyline.end (), minTol, maxTol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == coords);
+        }
+        {
+            // identical to random access input
+            const unsigned DIM = 2;
+            std::vector <int> coords, expected, result;
+            std::generate_n (std::back_inserter (coords), 10000*DIM, RandomWalkLine <int, DIM> (10, 20));
+            std::forward_list <int> polyline (coords.begin (), coords.end ());
+            int minTol = 25;
+            int maxTol = 60;
+
+            psimpl::simplify_opheim <DIM> (
+                coords.begin (), coords.end (), minTol, maxTol,
+                std::back_inserter (expected));
+            psimpl::simplify_opheim <DIM> (
+                polyline.begin (), polyline.end (), minTol, maxTol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == expected);
+        }
     }
 
     void TestOpheim::TestReturnValue () {
@@ -430,4 +486,146 @@ namespace psimpl {
             == 2*DIM);
     }
 
+    // stream: same keys as the batch routine, for any number of pushed points and any tolerances
+    void TestOpheim::TestStream () {
+        {
+            const unsigned DIM = 2;
+            std::vector <double> polyline;
+            std::generate_n (std::back_inserter (polyline), 1000*DIM, RandomWalkLine <double, DIM> (1, 2));
+            double min_tols [] = {2, 2, 0, 0};
+            double max_tols [] = {5, 0, 5, 0};
+
+            for (unsigned t = 0; t < 4; ++t) {
+                std::vector <double> result;
+                OpheimStream <DIM, double, std::back_insert_iterator <std::vector <double> > > stream =
+                    make_opheim_stream <DIM> (min_tols [t], max_tols [t], std::back_inserter (result));
+
+                unsigned counts [] = {0, 1, 2, 3, 4, 5, 10, 1000};
+                for (unsigned c = 0; c < 8; ++c) {
+                    std::vector <double> expected;
+                    psimpl::simplify_opheim <DIM> (
+                        polyline.begin (), polyline.begin () + counts [c]*DIM, min_tols [t], max_tols [t],
+                        std::back_inserter (expected));
+
+                    // each Flush completes a polyline, after which the stream is reused
+                    result.clear ();
+                    for (unsigned p = 0; p < counts [c]; ++p) {
+                        stream.Push (polyline.begin () + p*DIM);
+                    }
+                    stream.Flush ();
+
+                    VERIFY_TRUE(result == expected);
+                }
+            }
+        }
+        {
+            // invalid min_tol: all points are keys
+            const unsigned DIM = 3;
+            std::list <float> polyline;
+            std::generate_n (std::back_inserter (polyline), 10*DIM, RandomWalkLine <float, DIM> (1, 2));
+            float min_tol = 0;
+            float max_tol = 5;
+
+            float result [10*DIM];
+            OpheimStream <DIM, float, float*> stream (min_tol, max_tol, result);
+            for (std::list <float>::iterator it = polyline.begin (); it != polyline.end (); std::advance (it, DIM)) {
+                stream.Push (it);
+            }
+            VERIFY_TRUE(stream.Result () == result + 9*DIM);
+            ASSERT_TRUE(stream.Flush () == result + 10*DIM);
+            VERIFY_TRUE(std::equal (polyline.begin (), polyline.end (), result));
+        }
+    }
+
+    void TestOpheim::TestStreamMaxDelay () {
+        const unsigned DIM = 2;
+        typedef std::back_insert_iterator <std::vector <double> > OutputIterator;
+        {
+            // a straight line: without a maximum delay only the end points are keys
+            std::vector <double> polyline;
+            for (unsigned p = 0; p < 100; ++p) {
+                polyline.push_back (p);
+                polyline.push_back (0);
+            }
+            std::vector <double> result;
+            OpheimStream <DIM, double, OutputIterator> stream =
+                make_opheim_stream <DIM> (2.0, 60.0, std::back_inserter (result), 10);
+            for (unsigned p = 0; p < 100; ++p) {
+                stream.Push (polyline.begin () + p*DIM);
+                VERIFY_TRUE(stream.Delay () < 10);
+            }
+            stream.Flush ();
+            std::vector <int> keys = KeyIndices <DIM> (polyline, result);
+            ASSERT_TRUE(keys.size () == 11);
+            for (unsigned k = 0; k < 10; ++k) {
+                VERIFY_TRUE(keys [k] == static_cast <int> (k * 10));
+            }
+            VERIFY_TRUE(keys [10] == 99);
+        }
+        {
+            std::vector <double> polyline;
+            std::generate_n (std::back_inserter (polyline), 1000*DIM, RandomWalkLine <double, DIM> (1, 2));
+
+            unsigned delays [] = {1, 2, 3, 5, 20};
+            for (unsigned d = 0; d < 5; ++d) {
+                std::vector <double> result;
+                OpheimStream <DIM, double, OutputIterator> stream (2.0, 60.0, std::back_inserter (result), delays [d]);
+                for (unsigned p = 0; p < 1000; ++p) {
+                    stream.Push (polyline.begin () + p*DIM);
+                    VERIFY_TRUE(stream.Delay () < delays [d]);
+                }
+                stream.Flush ();
+
+                std::vector <int> keys = KeyIndices <DIM> (polyline, result);
+                ASSERT_TRUE(2 <= keys.size () && keys.front () == 0 && keys.back () == 999);
+                for (unsigned k = 1; k < keys.size (); ++k) {
+                    VERIFY_TRUE(keys [k-1] < keys [k] && keys [k] - keys [k-1] <= static_cast <int> (delays [d]));
+
+                    // the tolerance holds between successive keys
+                    std::vector <double> expected;
+                    psimpl::simplify_opheim <DIM> (
+                        polyline.begin () + keys [k-1]*DIM, polyline.begin () + (keys [k] + 1)*DIM, 2.0, 60.0,
+                        std::back_inserter (expected));
+                    VERIFY_TRUE(expected.size () == 2*DIM);
+                }
+            }
+        }
+        {
+            // ForceKey
+            std::vector <double> polyline;
+            std::generate_n (std::back_inserter (polyline), 100*DIM, RandomWalkLine <double, DIM> (1, 0));
+            std::vector <double> result;
+            OpheimStream <DIM, double, OutputIterator> stream (2.0, 60.0, std::back_inserter (result));
+            for (unsigned p = 0; p < 50; ++p) {
+                stream.Push (polyline.begin () + p*DIM);
+            }
+            VERIFY_TRUE(stream.Delay () == 49);
+            stream.ForceKey ();
+            VERIFY_TRUE(stream.Delay () == 0);
+            stream.ForceKey ();
+            for (unsigned p = 50; p < 100; ++p) {
+                stream.Push (polyline.begin () + p*DIM);
+            }
+            stream.Flush ();
+            std::vector <int> keys = KeyIndices <DIM> (polyline, result);
+            ASSERT_TRUE(keys.size () == 3);
+            VERIFY_TRUE(keys [0] == 0 && keys [1] == 49 && keys [2] == 99);
+        }
+    }
+
+    // scaling: run time is O(n)
+    void TestOpheim::TestScaling () {
+        const unsigned DIM = 2;
+        const unsigned count = 1 << 19;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        std::vector <double> result (polyline.size ());
+
+        VERIFY_SCALING(LINEAR, [&] (std::size_t n) {
+            psimpl::simplify_opheim <DIM> (
+                polyline.begin (), polyline.begin () + n*DIM, 5., 50.,
+                result.begin ());
+        });
+    }
 }}
@@ -37,6 +37,7 @@
 #include <vector>
 #include <deque>
 #include <list>
+#include <forward_list>
 
 
 namespace psimpl {
@@ -50,7 +51,7 @@ namespace psimpl {
         TEST_RUN("single pass | basic sanity", TestBasicSanity ());
         TEST_RUN("single pass | random iterator", TestRandomIterator_sp ());
         TEST_RUN("single pass | bidirectional iterator", TestBidirectionalIterator_sp ());
-        TEST_DISABLED("single pass | forward iterator", TestForwardIterator_sp ());
+        TEST_RUN("single pass | forward iterator", TestForwardIterator_sp ());
         TEST_RUN("return value", TestReturnValue_sp ());
 
         TEST_RUN("multi pass | incomplete point", TestIncompletePoint_mp ());
@@ -59,7 +60,11 @@ namespace psimpl {
         TEST_RUN("multi pass | valid tol", TestValidTol_mp ());
         TEST_RUN("multi pass | invalid repeat", TestInvalidRepeat_mp ());
         TEST_RUN("multi pass | valid repeat", TestValidRepeat_mp ());
+        TEST_RUN("multi pass | successive passes", TestSuccessivePasses_mp ());
         TEST_RUN("return value", TestReturnValue_mp ());
+
+        TEST_RUN("stream", TestStream ());
+        TEST_SCALING("scaling", TestScaling ());
     }
 
     // incomplete point: coord count % DIM > 1
@@ -300,7 +305,55 @@ namespace psimpl {
     }
 
     void TestPerpendicularDistance::TestForwardIterator_sp () {
-        FAIL("TODO");
+        const unsigned count = 10;
+        {
+            const unsigned DIM = 2;
+            std::vector <float> coords;
+            std::generate_n (std::back_inserter (coords), count*DIM, SawToothLine <float, DIM> ());
+            std::forward_list <float> polyline (coords.begin (), coords.end ());
+            std::vector <float> result;
+            float tol = 3.5f;
+
+            psimpl::simplify_perpendicular_distance <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == 7*DIM);
+            int keys [] = {0, 2, 4, 6, 7, 8, 9};
+            VERIFY_TRUE(ComparePoints <DIM> (coords.begin (), result.begin (), std::vector <int> (keys, keys + 7)));
+        }
+        {
+            // incomplete last point, detected after simplifying the preceding points
+            const unsigned DIM = 2;
+            std::vector <double> coords;
+            std::generate_n (std::back_inserter (coords), count*DIM-1, SawToothLine <double, DIM> ());
+            std::forward_list <double> polyline (coords.begin (), coords.end ());
+            std::vector <double> result;
+            double tol = 3.5;
+
+            psimpl::simplify_perpendicular_distance <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == coords);
+        }
+        {
+            // identical to random access input
+            const unsigned DIM = 2;
+            std::vector <int> coords, expected, result;
+            std::generate_n (std::back_inserter (coords), 10000*DIM, RandomWalkLine <int, DIM> (10, 20));
+            std::forward_list <int> polyline (coords.begin (), coords.end ());
+            int tol = 15;
+
+            psimpl::simplify_perpendicular_distance <DIM> (
+                coords.begin (), coords.end (), tol,
+                std::back_inserter (expected));
+            psimpl::simplify_perpendicular_distance <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == expected);
+        }
     }
 
     void TestPerpendicularDistance::TestReturnValue_sp () {
@@ -612,4 +665,95 @@ namespace psimpl {
                 == (((count/2+1)/2+1)/2+1)*DIM);
         }
     }
+
+    // multiple passes: same result as successive single passes, that each copy their input
+    void TestPerpendicularDistance::TestSuccessivePasses_mp () {
+        const unsigned DIM = 2;
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), 10000*DIM, RandomWalkLine <double, DIM> (1, 2));
+        std::list <double> input (polyline.begin (), polyline.end ());
+        const double tol = 2.;
+
+        std::vector <double> expected = polyline;
+        for (unsigned repeat = 1; repeat <= 20; ++repeat) {
+            std::vector <double> pass;
+            psimpl::simplify_perpendicular_distance <DIM> (
+                expected.begin (), expected.end (), tol,
+                std::back_inserter (pass));
+            expected.swap (pass);
+
+            std::vector <double> result, listResult;
+            psimpl::simplify_perpendicular_distance <DIM> (
+                polyline.begin (), polyline.end (), tol, repeat,
+                std::back_inserter (result));
+            psimpl::simplify_perpendicular_distance <DIM> (
+                input.begin (), input.end (), tol, repeat,
+                std::back_inserter (listResult));
+            VERIFY_TRUE(result == expected);
+            VERIFY_TRUE(listResult == expected);
+        }
+    }
+
+    // stream: same keys as the batch routine, for any number of pushed points
+    void TestPerpendicularDistance::TestStream () {
+        {
+            const unsigned DIM = 2;
+            std::vector <double> polyline;
+            std::generate_n (std::back_inserter (polyline), 1000*DIM, RandomWalkLine <double, DIM> (1, 2));
+            double tol = 3;
+
+            std::vector <double> result;
+            PerpendicularDistanceStream <DIM, double, std::back_insert_iterator <std::vector <double> > > stream =
+                make_perpendicular_distance_stream <DIM> (tol, std::back_inserter (result));
+
+            unsigned counts [] = {0, 1, 2, 3, 4, 5, 10, 1000};
+            for (unsigned c = 0; c < 8; ++c) {
+                std::vector <double> expected;
+                psimpl::simplify_perpendicular_distance <DIM> (
+                    polyline.begin (), polyline.begin () + counts [c]*DIM, tol,
+                    std::back_inserter (expected));
+
+                // each Flush completes a polyline, after which the stream is reused
+                result.clear ();
+                for (unsigned p = 0; p < counts [c]; ++p) {
+                    stream.Push (polyline.begin () + p*DIM);
+                }
+                stream.Flush ();
+
+                VERIFY_TRUE(result == expected);
+            }
+        }
+        {
+            // invalid tol: all points are keys
+            const unsigned DIM = 3;
+            std::list <float> polyline;
+            std::generate_n (std::back_inserter (polyline), 10*DIM, RandomWalkLine <float, DIM> (1, 2));
+            float tol = 0;
+
+            float result [10*DIM];
+            PerpendicularDistanceStream <DIM, float, float*> stream (tol, result);
+            for (std::list <float>::iterator it = polyline.begin (); it != polyline.end (); std::advance (it, DIM)) {
+                stream.Push (it);
+            }
+            VERIFY_TRUE(stream.Result () == result + 9*DIM);
+            ASSERT_TRUE(stream.Flush () == result + 10*DIM);
+            VERIFY_TRUE(std::equal (polyline.begin (), polyline.end (), result));
+        }
+    }
+
+    // scaling: run time is O(n)
+    void TestPerpendicularDistance::TestScaling () {
+        const unsigned DIM = 2;
+        const unsigned count = 1 << 19;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        std::vector <double> result (polyline.size ());
+
+        VERIFY_SCALING(LINEAR, [&] (std::size_t n) {
+            psimpl::simplify_perpendicular_distance <DIM> (
+                polyline.begin (), polyline.begin () + n*DIM, 5.,
+                result.begin ());
+        });
+    }
 }}
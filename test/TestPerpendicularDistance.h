@@ -64,7 +64,11 @@ namespace psimpl {
         void TestValidTol_mp ();
         void TestInvalidRepeat_mp ();
         void TestValidRepeat_mp ();
+        void TestSuccessivePasses_mp ();
         void TestReturnValue_mp ();
+
+        void TestStream ();
+        void TestScaling ();
     };
 }}
 
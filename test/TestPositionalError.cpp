@@ -37,6 +37,7 @@
 #include <vector>
 #include <deque>
 #include <list>
+#include <limits>
 
 
 namespace psimpl {
@@ -51,6 +52,84 @@ namespace psimpl {
         TEST_RUN("bidirectional iterator", TestBidirectionalIterator ());
         TEST_DISABLED("forward iterator", TestForwardIterator ());
         TEST_RUN("return value", TestReturnValue ());
+        TEST_RUN("parallel", TestParallel ());
+        TEST_RUN("nearest", TestNearest ());
+        TEST_SCALING("scaling", TestScaling ());
+    }
+
+    // the errors of the parallel implementation equal those of the serial one
+    template <unsigned DIM, class T>
+    void VerifyParallel (const std::vector <T>& polyline, const std::vector <T>& simplification) {
+        bool valid = false;
+        std::vector <T> expected;
+        psimpl::compute_positional_errors2 <DIM> (
+            polyline.begin (), polyline.end (),
+            simplification.begin (), simplification.end (),
+            std::back_inserter (expected), &valid);
+
+        unsigned threadCounts [] = {1, 2, 3, 0};
+        for (unsigned t = 0; t < 4; ++t) {
+            bool parallelValid = !valid;
+            std::vector <T> result;
+            psimpl::compute_positional_errors2_parallel <DIM> (
+                polyline.begin (), polyline.end (),
+                simplification.begin (), simplification.end (),
+                threadCounts [t], std::back_inserter (result), &parallelValid);
+
+            VERIFY_TRUE(parallelValid == valid);
+            VERIFY_TRUE(result == expected);
+        }
+    }
+
+    void TestPositionalError::TestParallel () {
+        {
+            const unsigned DIM = 2;
+            std::vector <double> polyline, simplification;
+            std::generate_n (std::back_inserter (polyline), 50000*DIM, RandomWalkLine <double, DIM> (1, 2));
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), 3.,
+                std::back_inserter (simplification));
+            VerifyParallel <DIM> (polyline, simplification);
+
+            // duplicate simplified point
+            simplification.insert (simplification.begin () + 4*DIM,
+                                   simplification.begin () + 4*DIM, simplification.begin () + 5*DIM);
+            VerifyParallel <DIM> (polyline, simplification);
+
+            // last point does not match
+            simplification.back () += 1.;
+            VerifyParallel <DIM> (polyline, simplification);
+
+            // intermediate point does not match
+            simplification [simplification.size () / 2] += 1.;
+            VerifyParallel <DIM> (polyline, simplification);
+
+            // first point does not match
+            simplification [0] += 1.;
+            VerifyParallel <DIM> (polyline, simplification);
+        }
+        {
+            const unsigned DIM = 3;
+            std::vector <float> polyline, simplification;
+            std::generate_n (std::back_inserter (polyline), 20000*DIM, RandomWalkLine <float, DIM> (1, 2));
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), 1000,
+                std::back_inserter (simplification));
+            VerifyParallel <DIM> (polyline, simplification);
+
+            // extra points at the end of the polyline are ignored
+            std::generate_n (std::back_inserter (polyline), 10*DIM, StraightLine <float, DIM> ());
+            VerifyParallel <DIM> (polyline, simplification);
+        }
+        {
+            const unsigned DIM = 4;
+            std::vector <int> polyline, simplification;
+            std::generate_n (std::back_inserter (polyline), 10000*DIM, SquareToothLine <int, DIM> ());
+            psimpl::simplify_nth_point <DIM> (
+                polyline.begin (), polyline.end (), 7,
+                std::back_inserter (simplification));
+            VerifyParallel <DIM> (polyline, simplification);
+        }
     }
 
     // incomplete point: coord count % DIM > 1
@@ -319,6 +398,20 @@ namespace psimpl {
         VERIFY_TRUE(valid);
         VERIFY_TRUE(stats.max == 5.0);
         VERIFY_TRUE(stats.sum == 15.0);
+
+        // integer errors are rounded up: the squared distance of point 1 is 9.8
+        {
+            int polyline [] = {0, 0, 3, 5, 20, 10};
+            int simplification [] = {0, 0, 20, 10};
+            int errors [3];
+
+            VERIFY_TRUE(psimpl::compute_positional_errors2 <2> (
+                polyline, polyline + 6, simplification, simplification + 4, errors, &valid) == errors + 3);
+            VERIFY_TRUE(valid);
+            VERIFY_TRUE(errors [0] == 0);
+            VERIFY_TRUE(errors [1] == 10);
+            VERIFY_TRUE(errors [2] == 0);
+        }
     }
 
     // different random access iterators, different value types, different dimensions
@@ -565,4 +658,161 @@ namespace psimpl {
         ASSERT_TRUE(valid);
     }
 
+    // the squared distance of each point to the nearest segment, by comparing it with all segments;
+    // like all errors, integer distances are rounded up
+    template <unsigned DIM, class T>
+    std::vector <T> NearestErrors2 (const std::vector <T>& polyline, const std::vector <T>& other) {
+        typedef psimpl::math::round_up_precision <psimpl::math::float_precision> Precision;
+        std::vector <T> errors;
+        for (std::size_t p = 0; p < polyline.size (); p += DIM) {
+            T min2 = std::numeric_limits <T>::max ();
+            for (std::size_t s = 0; s + DIM < other.size (); s += DIM) {
+                min2 = std::min (min2, psimpl::math::segment_distance2 <DIM, Precision> (
+                    &other [s], &other [s + DIM], &polyline [p]));
+            }
+            errors.push_back (min2);
+        }
+        return errors;
+    }
+
+    // the nearest errors and hausdorff distance equal those of comparing each point with all segments
+    template <unsigned DIM, class T>
+    void VerifyNearest (const std::vector <T>& polyline, const std::vector <T>& simplification) {
+        std::vector <T> expected = NearestErrors2 <DIM> (polyline, simplification);
+        std::vector <T> reverse = NearestErrors2 <DIM> (simplification, polyline);
+        double hausdorff = std::sqrt (static_cast <double> (std::max (
+            *std::max_element (expected.begin (), expected.end ()),
+            *std::max_element (reverse.begin (), reverse.end ()))));
+
+        bool valid = false;
+        std::vector <T> result;
+        psimpl::compute_nearest_errors2 <DIM> (
+            polyline.begin (), polyline.end (),
+            simplification.begin (), simplification.end (),
+            std::back_inserter (result), &valid);
+        VERIFY_TRUE(valid);
+        VERIFY_TRUE(result == expected);
+
+        // input without random access is copied
+        std::list <T> input (polyline.begin (), polyline.end ());
+        std::list <T> simplified (simplification.begin (), simplification.end ());
+        valid = false;
+        result.clear ();
+        psimpl::compute_nearest_errors2 <DIM> (
+            input.begin (), input.end (),
+            simplified.begin (), simplified.end (),
+            std::back_inserter (result), &valid);
+        VERIFY_TRUE(valid);
+        VERIFY_TRUE(result == expected);
+
+        valid = false;
+        VERIFY_TRUE(psimpl::compute_hausdorff_distance <DIM> (
+            polyline.begin (), polyline.end (),
+            simplification.begin (), simplification.end (), &valid) == hausdorff);
+        VERIFY_TRUE(valid);
+        valid = false;
+        VERIFY_TRUE(psimpl::compute_hausdorff_distance <DIM> (
+            input.begin (), input.end (),
+            simplified.begin (), simplified.end (), &valid) == hausdorff);
+        VERIFY_TRUE(valid);
+    }
+
+    void TestPositionalError::TestNearest () {
+        {
+            // a simplification consisting of original points
+            const unsigned DIM = 2;
+            std::vector <double> polyline, simplification, errors, nearest;
+            std::generate_n (std::back_inserter (polyline), 5000*DIM, RandomWalkLine <double, DIM> (1, 2));
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), 3.,
+                std::back_inserter (simplification));
+            VerifyNearest <DIM> (polyline, simplification);
+
+            // never larger than the error to the matching segment
+            psimpl::compute_positional_errors2 <DIM> (
+                polyline.begin (), polyline.end (),
+                simplification.begin (), simplification.end (),
+                std::back_inserter (errors));
+            psimpl::compute_nearest_errors2 <DIM> (
+                polyline.begin (), polyline.end (),
+                simplification.begin (), simplification.end (),
+                std::back_inserter (nearest));
+            ASSERT_TRUE(errors.size () == nearest.size ());
+            for (std::size_t i = 0; i < errors.size (); ++i) {
+                VERIFY_TRUE(nearest [i] <= errors [i]);
+            }
+        }
+        {
+            // a quantized simplification, that does not consist of original points
+            const unsigned DIM = 3;
+            std::vector <float> polyline, simplification;
+            std::generate_n (std::back_inserter (polyline), 5000*DIM, RandomWalkLine <float, DIM> (1, 2));
+            psimpl::simplify_douglas_peucker_n <DIM> (
+                polyline.begin (), polyline.end (), 200,
+                std::back_inserter (simplification));
+            for (std::size_t c = 0; c < simplification.size (); ++c) {
+                simplification [c] = std::floor (simplification [c] * 0.25f + 0.5f) * 4.f;
+            }
+            bool valid = true;
+            std::vector <float> errors;
+            psimpl::compute_positional_errors2 <DIM> (
+                polyline.begin (), polyline.end (),
+                simplification.begin (), simplification.end (),
+                std::back_inserter (errors), &valid);
+            VERIFY_FALSE(valid);
+            VerifyNearest <DIM> (polyline, simplification);
+        }
+        {
+            // integer coordinates, and a simplification of only two points
+            const unsigned DIM = 2;
+            std::vector <int> polyline, simplification;
+            std::generate_n (std::back_inserter (polyline), 1000*DIM, SquareToothLine <int, DIM> ());
+            simplification.push_back (0);
+            simplification.push_back (3);
+            simplification.push_back (700);
+            simplification.push_back (-2);
+            VerifyNearest <DIM> (polyline, simplification);
+        }
+        {
+            // invalid input
+            const unsigned DIM = 2;
+            double polyline [] = {0, 0, 1, 1, 2, 2};
+            std::vector <double> result;
+            bool valid = true;
+            psimpl::compute_nearest_errors2 <DIM> (
+                polyline, polyline + 5, polyline, polyline + 6, std::back_inserter (result), &valid);
+            VERIFY_FALSE(valid);
+            valid = true;
+            psimpl::compute_nearest_errors2 <DIM> (
+                polyline, polyline + 6, polyline, polyline + 2, std::back_inserter (result), &valid);
+            VERIFY_FALSE(valid);
+            VERIFY_TRUE(result.empty ());
+            valid = true;
+            VERIFY_TRUE(psimpl::compute_hausdorff_distance <DIM> (
+                polyline, polyline + 2, polyline, polyline + 6, &valid) == 0);
+            VERIFY_FALSE(valid);
+        }
+    }
+
+    // scaling: run time is O(n), including the O(n) simplification
+    void TestPositionalError::TestScaling () {
+        const unsigned DIM = 2;
+        const unsigned count = 1 << 19;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        std::vector <double> simplified (polyline.size ());
+        std::vector <double> errors (count);
+
+        VERIFY_SCALING(LINEAR, [&] (std::size_t n) {
+            std::vector <double>::iterator last = psimpl::simplify_nth_point <DIM> (
+                polyline.begin (), polyline.begin () + n*DIM, 10,
+                simplified.begin ());
+            psimpl::compute_positional_errors2 <DIM> (
+                polyline.begin (), polyline.begin () + n*DIM,
+                simplified.begin (), last,
+                errors.begin ());
+        });
+    }
+
 }}
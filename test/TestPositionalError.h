@@ -41,7 +41,8 @@
 namespace psimpl {
     namespace test
 {
-    //! Tests function psimpl::compute_positional_errors2 and psimpl::compute_positional_error_statistics
+    //! Tests function psimpl::compute_positional_errors2, psimpl::compute_positional_error_statistics,
+    //! psimpl::compute_nearest_errors2 and psimpl::compute_hausdorff_distance
     class TestPositionalError
     {
     public:
@@ -56,6 +57,9 @@ namespace psimpl {
         void TestBidirectionalIterator ();
         void TestForwardIterator ();
         void TestReturnValue ();
+        void TestParallel ();
+        void TestNearest ();
+        void TestScaling ();
     };
 
 }}
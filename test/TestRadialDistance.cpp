@@ -37,6 +37,7 @@
 #include <vector>
 #include <deque>
 #include <list>
+#include <forward_list>
 
 
 namespace psimpl {
@@ -49,8 +50,10 @@ namespace psimpl {
         TEST_RUN("valid tol", TestValidTol ());
         TEST_RUN("random iterator", TestRandomIterator ());
         TEST_RUN("bidirectional iterator", TestBidirectionalIterator ());
-        TEST_DISABLED("forward iterator", TestForwardIterator ());
+        TEST_RUN("forward iterator", TestForwardIterator ());
         TEST_RUN("return value", TestReturnValue ());
+        TEST_RUN("stream", TestStream ());
+        TEST_SCALING("scaling", TestScaling ());
     }
 
     // incomplete point: coord count % DIM > 1
@@ -265,7 +268,55 @@ namespace psimpl {
 
     // forward iterator, different value types, different dimensions
     void TestRadialDistance::TestForwardIterator () {
-        FAIL("TODO");
+        const unsigned count = 10;
+        {
+            const unsigned DIM = 2;
+            std::vector <float> coords;
+            std::generate_n (std::back_inserter (coords), count*DIM, StraightLine <float, DIM> ());
+            std::forward_list <float> polyline (coords.begin (), coords.end ());
+            std::vector <float> result;
+            float tol = 7.5f;
+
+            psimpl::simplify_radial_distance <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == 3*DIM);
+            int keys [] = {0, 8, 9};
+            VERIFY_TRUE(ComparePoints <DIM> (coords.begin (), result.begin (), std::vector <int> (keys, keys + 3)));
+        }
+        {
+            // incomplete last point, detected after simplifying the preceding points
+            const unsigned DIM = 2;
+            std::vector <double> coords;
+            std::generate_n (std::back_inserter (coords), count*DIM-1, StraightLine <double, DIM> ());
+            std::forward_list <double> polyline (coords.begin (), coords.end ());
+            std::vector <double> result;
+            double tol = 7.5;
+
+            psimpl::simplify_radial_distance <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == coords);
+        }
+        {
+            // identical to random access input
+            const unsigned DIM = 2;
+            std::vector <int> coords, expected, result;
+            std::generate_n (std::back_inserter (coords), 10000*DIM, RandomWalkLine <int, DIM> (10, 20));
+            std::forward_list <int> polyline (coords.begin (), coords.end ());
+            int tol = 25;
+
+            psimpl::simplify_radial_distance <DIM> (
+                coords.begin (), coords.end (), tol,
+                std::back_inserter (expected));
+            psimpl::simplify_radial_distance <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result == expected);
+        }
     }
 
     void TestRadialDistance::TestReturnValue () {
@@ -295,4 +346,67 @@ namespace psimpl {
             == 8*DIM);
     }
 
+    // stream: same keys as the batch routine, for any number of pushed points
+    void TestRadialDistance::TestStream () {
+        {
+            const unsigned DIM = 2;
+            std::vector <double> polyline;
+            std::generate_n (std::back_inserter (polyline), 1000*DIM, RandomWalkLine <double, DIM> (1, 2));
+            double tol = 3;
+
+            std::vector <double> result;
+            RadialDistanceStream <DIM, double, std::back_insert_iterator <std::vector <double> > > stream =
+                make_radial_distance_stream <DIM> (tol, std::back_inserter (result));
+
+            unsigned counts [] = {0, 1, 2, 3, 4, 5, 10, 1000};
+            for (unsigned c = 0; c < 8; ++c) {
+                std::vector <double> expected;
+                psimpl::simplify_radial_distance <DIM> (
+                    polyline.begin (), polyline.begin () + counts [c]*DIM, tol,
+                    std::back_inserter (expected));
+
+                // each Flush completes a polyline, after which the stream is reused
+                result.clear ();
+                for (unsigned p = 0; p < counts [c]; ++p) {
+                    stream.Push (polyline.begin () + p*DIM);
+                }
+                stream.Flush ();
+
+                VERIFY_TRUE(result == expected);
+            }
+        }
+        {
+            // invalid tol: all points are keys
+            const unsigned DIM = 3;
+            std::list <float> polyline;
+            std::generate_n (std::back_inserter (polyline), 10*DIM, RandomWalkLine <float, DIM> (1, 2));
+            float tol = 0;
+
+            float result [10*DIM];
+            RadialDistanceStream <DIM, float, float*> stream (tol, result);
+            for (std::list <float>::iterator it = polyline.begin (); it != polyline.end (); std::advance (it, DIM)) {
+                stream.Push (it);
+            }
+            // keys are copied as soon as they are pushed
+            VERIFY_TRUE(stream.Result () == result + 10*DIM);
+            ASSERT_TRUE(stream.Flush () == result + 10*DIM);
+            VERIFY_TRUE(std::equal (polyline.begin (), polyline.end (), result));
+        }
+    }
+
+    // scaling: run time is O(n)
+    void TestRadialDistance::TestScaling () {
+        const unsigned DIM = 2;
+        const unsigned count = 1 << 19;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        std::vector <double> result (polyline.size ());
+
+        VERIFY_SCALING(LINEAR, [&] (std::size_t n) {
+            psimpl::simplify_radial_distance <DIM> (
+                polyline.begin (), polyline.begin () + n*DIM, 5.,
+                result.begin ());
+        });
+    }
 }}
@@ -56,6 +56,8 @@ namespace psimpl {
         void TestBidirectionalIterator ();
         void TestForwardIterator ();
         void TestReturnValue ();
+        void TestStream ();
+        void TestScaling ();
     };
 }}
 
@@ -57,6 +57,9 @@ namespace psimpl {
         void TestBidirectionalIterator ();
         void TestForwardIterator ();
         void TestReturnValue ();
+        void TestStream ();
+        void TestStreamMaxDelay ();
+        void TestScaling ();
     };
 }}
 
@@ -43,6 +43,11 @@
 #include "TestOpheim.h"
 #include "TestLang.h"
 #include "TestDouglasPeucker.h"
+#include "TestVisvalingamWhyatt.h"
+#include "TestBatch.h"
+#include "TestColumns.h"
+#include "TestWorkspace.h"
+#include "TestHierarchy.h"
 
 
 namespace psimpl {
@@ -60,6 +65,11 @@ namespace psimpl {
             TEST_RUN("lang", TestLang ());
             TEST_RUN("douglas peucker", TestDouglasPeucker ());
             TEST_RUN("douglas peucker n", TestDouglasPeuckerN ());
+            TEST_RUN("visvalingam whyatt", TestVisvalingamWhyatt ());
+            TEST_RUN("batch", TestBatch ());
+            TEST_RUN("columns", TestColumns ());
+            TEST_RUN("workspace", TestWorkspace ());
+            TEST_RUN("hierarchy", TestHierarchy ());
         }
     };
 }}
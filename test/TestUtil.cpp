@@ -34,6 +34,37 @@
 #include "TestUtil.h"
 #include "test.h"
 #include "../lib/psimpl.h"
+#include <list>
+#include <vector>
+
+
+namespace
+{
+    struct Sample
+    {
+        double x, y;
+        long long t;
+    };
+}
+
+
+namespace psimpl {
+    namespace util
+{
+    template <>
+    struct point_traits <Sample>
+    {
+        typedef double value_type;
+
+        static double get (const Sample& p, unsigned d) {
+            return d == 0 ? p.x : p.y;
+        }
+
+        static void set (Sample& p, unsigned d, double v) {
+            (d == 0 ? p.x : p.y) = v;
+        }
+    };
+}}
 
 
 namespace psimpl {
@@ -41,6 +72,11 @@ namespace psimpl {
 {
     TestUtil::TestUtil () {
         TEST_RUN("scoped_array", TestScopedArray ());
+        TEST_RUN("point_coord_iterator", TestPointIterator ());
+        TEST_RUN("column_iterator", TestColumnIterator ());
+        TEST_RUN("counting_iterator", TestCountingIterator ());
+        TEST_RUN("varint_iterator", TestVarintIterator ());
+        TEST_RUN("instrumentation", TestInstrumentation ());
     }
 
     void TestUtil::TestScopedArray () {
@@ -86,5 +122,356 @@ namespace psimpl {
         ASSERT_TRUE(a3 [0] == 321.f);
         ASSERT_TRUE(a3 [1] == 654.f);
     }
-}}
 
+    void TestUtil::TestPointIterator () {
+        const unsigned DIM = 2;
+        const unsigned count = 1000;
+        std::vector <Sample> samples (count);
+        std::vector <double> polyline;
+        for (unsigned i = 0; i < count; ++i) {
+            samples [i].x = i;
+            samples [i].y = (i * 7919) % 61;
+            samples [i].t = i * 10;
+            polyline.push_back (samples [i].x);
+            polyline.push_back (samples [i].y);
+        }
+
+        typedef psimpl::util::point_coord_iterator <DIM, std::vector <Sample>::const_iterator> coord_iterator;
+        coord_iterator first (samples.begin ());
+        coord_iterator last (samples.end ());
+
+        // iterator arithmetic
+        ASSERT_TRUE(last - first == static_cast <std::ptrdiff_t> (polyline.size ()));
+        ASSERT_TRUE(*first == 0.0);
+        ASSERT_TRUE(first [3] == polyline [3]);
+        ASSERT_TRUE(*(first + 5) == polyline [5]);
+        ASSERT_TRUE(*(last - 1) == polyline.back ());
+        ASSERT_TRUE((first + 7) - 3 == first + 4);
+        ASSERT_TRUE((first + 7).base () == samples.begin () + 3);
+        coord_iterator it = first + 3;
+        ASSERT_TRUE(*--it == polyline [2]);
+        ASSERT_TRUE(*it++ == polyline [2]);
+        ASSERT_TRUE(*it == polyline [3]);
+        ASSERT_TRUE(first < it && it <= last && last > it && it >= first);
+
+        // simplification of the samples equals that of the flat polyline
+        std::vector <double> expected;
+        std::vector <Sample> result;
+        psimpl::simplify_douglas_peucker <DIM> (polyline.begin (), polyline.end (), 5.0,
+            std::back_inserter (expected));
+        psimpl::simplify_douglas_peucker <DIM> (first, last, 5.0,
+            psimpl::util::make_point_output_iterator <DIM, Sample> (std::back_inserter (result)));
+        ASSERT_TRUE(result.size () * DIM == expected.size ());
+        for (unsigned i = 0; i < result.size (); ++i) {
+            ASSERT_TRUE(result [i].x == expected [i*DIM]);
+            ASSERT_TRUE(result [i].y == expected [i*DIM+1]);
+            ASSERT_TRUE(result [i].t == 0);
+        }
+
+        expected.clear ();
+        result.clear ();
+        psimpl::simplify_radial_distance <DIM> (polyline.begin (), polyline.end (), 3.0,
+            std::back_inserter (expected));
+        psimpl::simplify_radial_distance <DIM> (first, last, 3.0,
+            psimpl::util::make_point_output_iterator <DIM, Sample> (std::back_inserter (result)));
+        ASSERT_TRUE(result.size () * DIM == expected.size ());
+        for (unsigned i = 0; i < result.size (); ++i) {
+            ASSERT_TRUE(result [i].x == expected [i*DIM]);
+            ASSERT_TRUE(result [i].y == expected [i*DIM+1]);
+        }
+
+        // bidirectional points
+        std::list <Sample> list (samples.begin (), samples.end ());
+        expected.clear ();
+        result.clear ();
+        psimpl::simplify_opheim <DIM> (polyline.begin (), polyline.end (), 4.0, 20.0,
+            std::back_inserter (expected));
+        psimpl::simplify_opheim <DIM> (
+            psimpl::util::make_point_coord_iterator <DIM> (list.begin ()),
+            psimpl::util::make_point_coord_iterator <DIM> (list.end ()), 4.0, 20.0,
+            psimpl::util::make_point_output_iterator <DIM, Sample> (std::back_inserter (result)));
+        ASSERT_TRUE(result.size () * DIM == expected.size ());
+        for (unsigned i = 0; i < result.size (); ++i) {
+            ASSERT_TRUE(result [i].x == expected [i*DIM]);
+            ASSERT_TRUE(result [i].y == expected [i*DIM+1]);
+        }
+
+        // arrays of coordinates use the default traits
+        typedef double point [3];
+        point points [] = {{0, 0, 0}, {1, 1, 1}, {2, 2, 2}, {3, 3, 3}};
+        typedef psimpl::util::point_coord_iterator <3, const point*> array_iterator;
+        std::vector <double> coords (array_iterator (points), array_iterator (points + 4));
+        ASSERT_TRUE(coords.size () == 12);
+        ASSERT_TRUE(coords [4] == 1.0 && coords [11] == 3.0);
+    }
+
+    void TestUtil::TestColumnIterator () {
+        const unsigned DIM = 3;
+        const unsigned count = 1000;
+        std::vector <float> x (count), y (count), z (count);
+        std::vector <float> polyline;
+        for (unsigned i = 0; i < count; ++i) {
+            x [i] = static_cast <float> (i);
+            y [i] = static_cast <float> ((i * 7919) % 61);
+            z [i] = static_cast <float> ((i * 104729) % 17);
+            polyline.push_back (x [i]);
+            polyline.push_back (y [i]);
+            polyline.push_back (z [i]);
+        }
+
+        const float* columns [DIM] = {&x [0], &y [0], &z [0]};
+        psimpl::util::column_iterator <DIM, const float> first =
+            psimpl::util::make_column_iterator <DIM> (columns, 0);
+        psimpl::util::column_iterator <DIM, const float> last =
+            psimpl::util::make_column_iterator <DIM> (columns, count);
+
+        // iterator arithmetic
+        ASSERT_TRUE(last - first == static_cast <std::ptrdiff_t> (polyline.size ()));
+        ASSERT_TRUE(first [4] == polyline [4]);
+        ASSERT_TRUE(*(first + 8) == polyline [8]);
+        ASSERT_TRUE(*(last - 1) == polyline.back ());
+        ASSERT_TRUE((first + 7).point () == 2);
+        ASSERT_TRUE((first + 6).at (2) == polyline [8]);
+        ASSERT_TRUE((last - 4) + 4 == last);
+        ASSERT_TRUE(first < last);
+
+        // the distance functions read whole points from the columns
+        const float* p = &polyline [0];
+        ASSERT_TRUE(psimpl::math::segment_distance2 <DIM> (first, first + 9, first + 6) ==
+                    psimpl::math::segment_distance2 <DIM> (p, p + 9, p + 6));
+        ASSERT_TRUE(psimpl::math::ray_distance2 <DIM> (first + 3, first, first + 12) ==
+                    psimpl::math::ray_distance2 <DIM> (p + 3, p, p + 12));
+
+        // simplification of the columns equals that of the flat polyline
+        std::vector <float> expected;
+        std::vector <float> rx (count), ry (count), rz (count);
+        float* result [DIM] = {&rx [0], &ry [0], &rz [0]};
+        psimpl::simplify_douglas_peucker <DIM> (polyline.begin (), polyline.end (), 5.f,
+            std::back_inserter (expected));
+        psimpl::util::column_iterator <DIM, float> end = psimpl::simplify_douglas_peucker <DIM> (
+            first, last, 5.f, psimpl::util::make_column_iterator <DIM> (result, 0));
+        ASSERT_TRUE(end.point () * DIM == static_cast <std::ptrdiff_t> (expected.size ()));
+        for (std::ptrdiff_t i = 0; i < end.point (); ++i) {
+            ASSERT_TRUE(rx [i] == expected [i*DIM]);
+            ASSERT_TRUE(ry [i] == expected [i*DIM+1]);
+            ASSERT_TRUE(rz [i] == expected [i*DIM+2]);
+        }
+
+        // positional errors
+        std::vector <double> errors, columnErrors;
+        const float* simplified [DIM] = {&rx [0], &ry [0], &rz [0]};
+        psimpl::compute_positional_errors2 <DIM> (polyline.begin (), polyline.end (),
+            expected.begin (), expected.end (), std::back_inserter (errors));
+        psimpl::compute_positional_errors2 <DIM> (first, last,
+            psimpl::util::make_column_iterator <DIM> (simplified, 0),
+            psimpl::util::make_column_iterator <DIM> (simplified, end.point ()),
+            std::back_inserter (columnErrors));
+        ASSERT_TRUE(errors == columnErrors);
+    
+    }
+
+    void TestUtil::TestCountingIterator () {
+        const unsigned DIM = 2;
+        const unsigned count = 1000;
+        std::vector <double> polyline;
+        for (unsigned i = 0; i < count; ++i) {
+            polyline.push_back (i);
+            polyline.push_back ((i * 7919) % 61);
+        }
+
+        // counting
+        psimpl::util::counting_iterator it;
+        ASSERT_TRUE(it.count () == 0);
+        *it = 1.f; ++it;
+        *it = 2.0; it++;
+        ASSERT_TRUE(it.count () == 2);
+        ASSERT_TRUE(std::copy (polyline.begin (), polyline.end (), it).count () == 2 + polyline.size ());
+
+        // count only mode of the simplification routines
+        std::vector <double> result;
+        psimpl::simplify_nth_point <DIM> (polyline.begin (), polyline.end (), 7, std::back_inserter (result));
+        VERIFY_TRUE(psimpl::simplify_nth_point <DIM> (
+            polyline.begin (), polyline.end (), 7, psimpl::util::counting_iterator ()).count () == result.size ());
+
+        result.clear ();
+        psimpl::simplify_radial_distance <DIM> (polyline.begin (), polyline.end (), 10., std::back_inserter (result));
+        VERIFY_TRUE(psimpl::simplify_radial_distance <DIM> (
+            polyline.begin (), polyline.end (), 10., psimpl::util::counting_iterator ()).count () == result.size ());
+
+        result.clear ();
+        psimpl::simplify_perpendicular_distance <DIM> (polyline.begin (), polyline.end (), 10., 3, std::back_inserter (result));
+        VERIFY_TRUE(psimpl::simplify_perpendicular_distance <DIM> (
+            polyline.begin (), polyline.end (), 10., 3, psimpl::util::counting_iterator ()).count () == result.size ());
+
+        result.clear ();
+        psimpl::simplify_reumann_witkam <DIM> (polyline.begin (), polyline.end (), 10., std::back_inserter (result));
+        VERIFY_TRUE(psimpl::simplify_reumann_witkam <DIM> (
+            polyline.begin (), polyline.end (), 10., psimpl::util::counting_iterator ()).count () == result.size ());
+
+        result.clear ();
+        psimpl::simplify_opheim <DIM> (polyline.begin (), polyline.end (), 10., 50., std::back_inserter (result));
+        VERIFY_TRUE(psimpl::simplify_opheim <DIM> (
+            polyline.begin (), polyline.end (), 10., 50., psimpl::util::counting_iterator ()).count () == result.size ());
+
+        result.clear ();
+        psimpl::simplify_lang <DIM> (polyline.begin (), polyline.end (), 10., 8, std::back_inserter (result));
+        VERIFY_TRUE(psimpl::simplify_lang <DIM> (
+            polyline.begin (), polyline.end (), 10., 8, psimpl::util::counting_iterator ()).count () == result.size ());
+
+        result.clear ();
+        psimpl::simplify_douglas_peucker <DIM> (polyline.begin (), polyline.end (), 10., std::back_inserter (result));
+        VERIFY_TRUE(psimpl::simplify_douglas_peucker <DIM> (
+            polyline.begin (), polyline.end (), 10., psimpl::util::counting_iterator ()).count () == result.size ());
+
+        result.clear ();
+        psimpl::simplify_douglas_peucker_n <DIM> (polyline.begin (), polyline.end (), 50, std::back_inserter (result));
+        VERIFY_TRUE(psimpl::simplify_douglas_peucker_n <DIM> (
+            polyline.begin (), polyline.end (), 50, psimpl::util::counting_iterator ()).count () == result.size ());
+
+        result.clear ();
+        psimpl::simplify_visvalingam_whyatt <DIM> (polyline.begin (), polyline.end (), 10., std::back_inserter (result));
+        VERIFY_TRUE(psimpl::simplify_visvalingam_whyatt <DIM> (
+            polyline.begin (), polyline.end (), 10., psimpl::util::counting_iterator ()).count () == result.size ());
+
+        // invalid input is counted entirely
+        VERIFY_TRUE(psimpl::simplify_douglas_peucker <DIM> (
+            polyline.begin (), polyline.begin () + 5, 10., psimpl::util::counting_iterator ()).count () == 5);
+    }
+
+    void TestUtil::TestVarintIterator () {
+        const unsigned DIM = 2;
+        const unsigned count = 1000;
+        const double precision = 1e-3;
+        std::vector <double> polyline;
+        for (unsigned i = 0; i < count; ++i) {
+            polyline.push_back (i * 0.1 - 25.0);
+            polyline.push_back (((i * 7919) % 61) * -0.0123);
+        }
+        typedef std::vector <unsigned char>::const_iterator ByteIterator;
+        typedef psimpl::util::varint_input_iterator <DIM, double, ByteIterator> Decoder;
+
+        // round trip within half the precision
+        std::vector <unsigned char> bytes;
+        std::copy (polyline.begin (), polyline.end (),
+            psimpl::util::make_varint_output_iterator <DIM> (std::back_inserter (bytes), precision));
+        VERIFY_TRUE(bytes.size () < 2 * polyline.size () + 8);
+
+        std::vector <double> decoded (
+            Decoder (bytes.begin (), bytes.end (), precision),
+            Decoder (bytes.end (), bytes.end (), precision));
+        VERIFY_TRUE(decoded.size () == polyline.size ());
+        bool close = decoded.size () == polyline.size ();
+        for (unsigned c = 0; close && c < polyline.size (); ++c) {
+            close = std::abs (decoded [c] - polyline [c]) <= precision / 2 * 1.0001;
+        }
+        VERIFY_TRUE(close);
+
+        // empty stream
+        std::vector <unsigned char> empty;
+        VERIFY_TRUE(Decoder (empty.begin (), empty.end (), precision) == Decoder (empty.end (), empty.end (), precision));
+        VERIFY_TRUE(Decoder (empty.begin (), empty.end (), precision) == Decoder ());
+
+        // integer coordinates are exact, including large deltas
+        {
+            const long long values [] = {0, -1, 1, 63, -64, 64, 1LL << 40, -(1LL << 40), 123456789, -7};
+            std::vector <unsigned char> stream;
+            std::copy (values, values + 10,
+                psimpl::util::make_varint_output_iterator <DIM> (std::back_inserter (stream), 1));
+            VERIFY_TRUE(stream [0] == 0 && stream [1] == 1 && stream [2] == 2);
+            std::vector <long long> result (
+                psimpl::util::make_varint_input_iterator <DIM, long long> (stream.begin (), stream.end (), 1),
+                psimpl::util::make_varint_input_iterator <DIM, long long> (stream.end (), stream.end (), 1));
+            VERIFY_TRUE(std::equal (values, values + 10, result.begin ()) && result.size () == 10);
+        }
+        // simplification and encoding in a single pass
+        {
+            std::vector <double> simplified;
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), 0.5,
+                std::back_inserter (simplified));
+
+            std::vector <unsigned char> expected;
+            std::copy (simplified.begin (), simplified.end (),
+                psimpl::util::make_varint_output_iterator <DIM> (std::back_inserter (expected), precision));
+
+            std::vector <unsigned char> stream;
+            psimpl::simplify_douglas_peucker <DIM> (
+                polyline.begin (), polyline.end (), 0.5,
+                psimpl::util::make_varint_output_iterator <DIM> (std::back_inserter (stream), precision));
+            VERIFY_TRUE(stream == expected);
+
+            // the decoded stream is a valid simplification input
+            std::vector <double> result;
+            psimpl::simplify_douglas_peucker <DIM> (
+                Decoder (bytes.begin (), bytes.end (), precision),
+                Decoder (bytes.end (), bytes.end (), precision), 0.5,
+                std::back_inserter (result));
+            std::vector <double> reference;
+            psimpl::simplify_douglas_peucker <DIM> (
+                decoded.begin (), decoded.end (), 0.5,
+                std::back_inserter (reference));
+            VERIFY_TRUE(result == reference);
+        }
+    }
+
+    void TestUtil::TestInstrumentation () {
+        const unsigned DIM = 2;
+        const unsigned count = 10000;
+        std::vector <double> polyline;
+        for (unsigned i = 0; i < count; ++i) {
+            polyline.push_back (i);
+            polyline.push_back ((i * 7919) % 61);
+        }
+        std::vector <double> result, parallelResult, dpnResult, langResult;
+
+        psimpl::instrument::reset_counters ();
+        psimpl::simplify_douglas_peucker <DIM> (polyline.begin (), polyline.end (), 5.0,
+            std::back_inserter (result));
+        psimpl::instrument::Counters dp = psimpl::instrument::get_counters ();
+
+        psimpl::instrument::reset_counters ();
+        psimpl::simplify_douglas_peucker_parallel <DIM> (polyline.begin (), polyline.end (), 5.0, 4,
+            std::back_inserter (parallelResult));
+        psimpl::instrument::Counters parallel = psimpl::instrument::get_counters ();
+
+        psimpl::instrument::reset_counters ();
+        psimpl::simplify_douglas_peucker_n <DIM> (polyline.begin (), polyline.end (), 100,
+            std::back_inserter (dpnResult));
+        psimpl::instrument::Counters dpn = psimpl::instrument::get_counters ();
+
+        psimpl::instrument::reset_counters ();
+        psimpl::simplify_lang <DIM> (polyline.begin (), polyline.end (), 5.0, 16,
+            std::back_inserter (langResult));
+        psimpl::instrument::Counters lang = psimpl::instrument::get_counters ();
+
+        psimpl::instrument::reset_counters ();
+        psimpl::instrument::Counters none = psimpl::instrument::get_counters ();
+        ASSERT_TRUE(none.segmentDistances == 0 && none.keys == 0 && none.scratchBytes == 0);
+
+#ifdef PSIMPL_INSTRUMENTATION
+        // the first and last point are keys that are not searched for
+        ASSERT_TRUE(dp.keys == result.size () / DIM - 2);
+        ASSERT_TRUE(dp.segmentDistances >= count / 2);
+        ASSERT_TRUE(dp.pointDistances >= count - 1);
+        ASSERT_TRUE(dp.stackPushes == 2 * dp.keys + 1);
+        ASSERT_TRUE(dp.stackDepth >= 2);
+        ASSERT_TRUE(dp.scratchBytes > 0);
+        ASSERT_TRUE(dp.reduceTime >= 0 && dp.approximateTime > 0 && dp.copyTime >= 0);
+
+        // work done by worker threads is included
+        ASSERT_TRUE(parallel.keys == dp.keys);
+        ASSERT_TRUE(parallel.segmentDistances >= dp.segmentDistances / 2);
+
+        ASSERT_TRUE(dpn.keys == 100 - 2);
+        ASSERT_TRUE(dpn.heapPushes > 0 && dpn.heapPops > 0 && dpn.heapPops <= dpn.heapPushes);
+
+        ASSERT_TRUE(lang.backwardSteps > 0);
+        ASSERT_TRUE(lang.segmentDistances > 0);
+#else
+        ASSERT_TRUE(dp.segmentDistances == 0 && dp.keys == 0 && dp.reduceTime == 0);
+        ASSERT_TRUE(parallel.keys == 0);
+        ASSERT_TRUE(dpn.heapPushes == 0);
+        ASSERT_TRUE(lang.backwardSteps == 0);
+#endif
+    }
+}}
@@ -45,6 +45,11 @@ namespace psimpl {
 
     private:
         void TestScopedArray ();
+        void TestPointIterator ();
+        void TestColumnIterator ();
+        void TestCountingIterator ();
+        void TestVarintIterator ();
+        void TestInstrumentation ();
     };
 }}
 
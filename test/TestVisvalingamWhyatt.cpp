@@ -0,0 +1,525 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#include "TestVisvalingamWhyatt.h"
+#include "helper.h"
+#include "../lib/psimpl.h"
+#include <cmath>
+#include <deque>
+#include <forward_list>
+#include <limits>
+#include <list>
+#include <vector>
+
+
+namespace psimpl {
+    namespace test
+{
+    // squared area of the triangle (p1, p, p2)
+    template <unsigned DIM, class T>
+    double TriangleArea2 (const std::vector <T>& polyline, unsigned p1, unsigned p, unsigned p2) {
+        double sum = 0;
+        for (unsigned i = 0; i < DIM; ++i) {
+            for (unsigned j = i + 1; j < DIM; ++j) {
+                double ui = static_cast <double> (polyline [p1*DIM+i]) - static_cast <double> (polyline [p*DIM+i]);
+                double uj = static_cast <double> (polyline [p1*DIM+j]) - static_cast <double> (polyline [p*DIM+j]);
+                double vi = static_cast <double> (polyline [p2*DIM+i]) - static_cast <double> (polyline [p*DIM+i]);
+                double vj = static_cast <double> (polyline [p2*DIM+j]) - static_cast <double> (polyline [p*DIM+j]);
+                double minor = ui * vj - uj * vi;
+                sum += minor * minor;
+            }
+        }
+        return 0.25 * sum;
+    }
+
+    // straightforward Visvalingam-Whyatt implementation that rescans all points for each removal
+    template <unsigned DIM, class T>
+    std::vector <T> ReferenceVisvalingamWhyatt (const std::vector <T>& polyline, double tol, unsigned count) {
+        unsigned pointCount = static_cast <unsigned> (polyline.size () / DIM);
+        std::vector <unsigned> points;      // indices of the remaining points
+        std::vector <double> areas (pointCount, 0);
+        for (unsigned p = 0; p < pointCount; ++p) {
+            points.push_back (p);
+        }
+        for (unsigned p = 1; p + 1 < pointCount; ++p) {
+            areas [p] = TriangleArea2 <DIM> (polyline, p - 1, p, p + 1);
+        }
+        while (points.size () > count) {
+            unsigned min = 0;
+            for (unsigned i = 1; i + 1 < points.size (); ++i) {
+                if (!min || areas [points [i]] < areas [points [min]]) {
+                    min = i;
+                }
+            }
+            if (!min || !(areas [points [min]] < tol * tol)) {
+                break;
+            }
+            double removed = areas [points [min]];
+            points.erase (points.begin () + min);
+            if (min > 1) {
+                areas [points [min-1]] = std::max (removed,
+                    TriangleArea2 <DIM> (polyline, points [min-2], points [min-1], points [min]));
+            }
+            if (min + 1 < points.size ()) {
+                areas [points [min]] = std::max (removed,
+                    TriangleArea2 <DIM> (polyline, points [min-1], points [min], points [min+1]));
+            }
+        }
+        std::vector <T> result;
+        for (unsigned i = 0; i < points.size (); ++i) {
+            result.insert (result.end (), polyline.begin () + points [i]*DIM, polyline.begin () + (points [i]+1)*DIM);
+        }
+        return result;
+    }
+
+    TestVisvalingamWhyatt::TestVisvalingamWhyatt () {
+        TEST_RUN("incomplete point", TestIncompletePoint ());
+        TEST_RUN("not enough points", TestNotEnoughPoints ());
+        TEST_RUN("invalid tol", TestInvalidTol ());
+        TEST_RUN("valid tol", TestValidTol ());
+        TEST_RUN("invalid count", TestInvalidCount ());
+        TEST_RUN("valid count", TestValidCount ());
+        TEST_RUN("random iterator", TestRandomIterator ());
+        TEST_RUN("bidirectional iterator", TestBidirectionalIterator ());
+        TEST_RUN("forward iterator", TestForwardIterator ());
+        TEST_RUN("return value", TestReturnValue ());
+        TEST_RUN("nested", TestNested ());
+        TEST_RUN("reference", TestReference ());
+        TEST_SCALING("scaling", TestScaling ());
+    }
+
+    // incomplete point: coord count % DIM > 1
+    void TestVisvalingamWhyatt::TestIncompletePoint () {
+        const unsigned DIM = 2;
+        const float tol = 2.f;
+
+        // 4th point incomplete
+        std::vector <float> polyline;
+        std::generate_n (std::back_inserter (polyline), 4*DIM-1, StraightLine <float, DIM> ());
+        std::vector <float> result;
+
+        psimpl::simplify_visvalingam_whyatt <DIM> (
+            polyline.begin (), polyline.end (), tol,
+            std::back_inserter (result));
+
+        ASSERT_TRUE(polyline == result);
+
+        result.clear ();
+        psimpl::simplify_visvalingam_whyatt_n <DIM> (
+            polyline.begin (), polyline.end (), 2,
+            std::back_inserter (result));
+
+        ASSERT_TRUE(polyline == result);
+
+        // 4th point complete
+        polyline.push_back (4.f);
+        result.clear ();
+
+        psimpl::simplify_visvalingam_whyatt <DIM> (
+            polyline.begin (), polyline.end (), tol,
+            std::back_inserter (result));
+
+        ASSERT_FALSE(polyline == result);
+
+        result.clear ();
+        psimpl::simplify_visvalingam_whyatt_n <DIM> (
+            polyline.begin (), polyline.end (), 2,
+            std::back_inserter (result));
+
+        ASSERT_FALSE(polyline == result);
+    }
+
+    // not enough points: point count < 3
+    void TestVisvalingamWhyatt::TestNotEnoughPoints () {
+        const unsigned DIM = 2;
+        const float tol = 2.f;
+
+        // 0 points
+        std::vector <float> polyline;
+        std::vector <float> result;
+
+        psimpl::simplify_visvalingam_whyatt <DIM> (
+            polyline.begin (), polyline.end (), tol,
+            std::back_inserter (result));
+
+        ASSERT_TRUE(polyline == result);
+
+        // 1 point
+        polyline.push_back(1.f);
+        polyline.push_back(1.f);
+        result.clear ();
+
+        psimpl::simplify_visvalingam_whyatt <DIM> (
+            polyline.begin (), polyline.end (), tol,
+            std::back_inserter (result));
+
+        ASSERT_TRUE(polyline == result);
+
+        // 2 points
+        polyline.push_back(2.f);
+        polyline.push_back(2.f);
+        result.clear ();
+
+        psimpl::simplify_visvalingam_whyatt <DIM> (
+            polyline.begin (), polyline.end (), tol,
+            std::back_inserter (result));
+
+        ASSERT_TRUE(polyline == result);
+
+        result.clear ();
+        psimpl::simplify_visvalingam_whyatt_n <DIM> (
+            polyline.begin (), polyline.end (), 2,
+            std::back_inserter (result));
+
+        ASSERT_TRUE(polyline == result);
+    }
+
+    // invalid: tol == 0
+    void TestVisvalingamWhyatt::TestInvalidTol () {
+        const unsigned DIM = 3;
+        const unsigned count = 10;
+        float tol = 0;
+
+        std::vector <float> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, StraightLine <float, DIM> ());
+        std::vector <float> result;
+
+        psimpl::simplify_visvalingam_whyatt <DIM> (
+            polyline.begin (), polyline.end (), tol,
+            std::back_inserter (result));
+
+        ASSERT_TRUE(polyline == result);
+    }
+
+    // valid: tol != 0
+    void TestVisvalingamWhyatt::TestValidTol () {
+        const unsigned DIM = 2;
+        const unsigned count = 9;
+
+        std::vector <float> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, StraightLine <float, DIM> ());
+        // add a spike at the 5th point
+        polyline [4*DIM+1] = 2.f;
+        {
+            // all collinear points are removed, the points next to the spike are kept
+            float tol = 0.5f;
+            std::vector <float> result;
+
+            psimpl::simplify_visvalingam_whyatt <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == 5*DIM);
+            int keys [] = {0, 3, 4, 5, 8};
+            VERIFY_TRUE(ComparePoints <DIM> (polyline.begin (), result.begin (), std::vector <int> (keys, keys + 5)));
+        }
+        {
+            // the spike has an area of 2; once it is removed its neighbours are collinear, and
+            // their effective area of 2 is below tol as well
+            float tol = 2.5f;
+            std::vector <float> result;
+
+            psimpl::simplify_visvalingam_whyatt <DIM> (
+                polyline.begin (), polyline.end (), tol,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == 2*DIM);
+            VERIFY_TRUE(CompareEndPoints <DIM> (polyline.begin (), polyline.end (), result.begin (), result.end ()));
+        }
+    }
+
+    // invalid: count < 2 or count >= point count
+    void TestVisvalingamWhyatt::TestInvalidCount () {
+        const unsigned DIM = 3;
+        const unsigned count = 10;
+
+        std::vector <float> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, StraightLine <float, DIM> ());
+        unsigned counts [] = {0, 1, count, count + 1};
+
+        for (unsigned c = 0; c < 4; ++c) {
+            std::vector <float> result;
+
+            psimpl::simplify_visvalingam_whyatt_n <DIM> (
+                polyline.begin (), polyline.end (), counts [c],
+                std::back_inserter (result));
+
+            VERIFY_TRUE(polyline == result);
+        }
+    }
+
+    // valid: 2 <= count < point count
+    void TestVisvalingamWhyatt::TestValidCount () {
+        const unsigned DIM = 2;
+        const unsigned count = 9;
+
+        std::vector <float> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, StraightLine <float, DIM> ());
+        // add a spike at the 5th point
+        polyline [4*DIM+1] = 2.f;
+        {
+            std::vector <float> result;
+
+            psimpl::simplify_visvalingam_whyatt_n <DIM> (
+                polyline.begin (), polyline.end (), 5,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == 5*DIM);
+            int keys [] = {0, 3, 4, 5, 8};
+            VERIFY_TRUE(ComparePoints <DIM> (polyline.begin (), result.begin (), std::vector <int> (keys, keys + 5)));
+        }
+        {
+            // the spike has the smallest area
+            std::vector <float> result;
+
+            psimpl::simplify_visvalingam_whyatt_n <DIM> (
+                polyline.begin (), polyline.end (), 4,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == 4*DIM);
+            int keys [] = {0, 3, 5, 8};
+            VERIFY_TRUE(ComparePoints <DIM> (polyline.begin (), result.begin (), std::vector <int> (keys, keys + 4)));
+        }
+        {
+            // equal areas are removed in polyline order
+            std::vector <float> result;
+
+            psimpl::simplify_visvalingam_whyatt_n <DIM> (
+                polyline.begin (), polyline.end (), 3,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == 3*DIM);
+            int keys [] = {0, 5, 8};
+            VERIFY_TRUE(ComparePoints <DIM> (polyline.begin (), result.begin (), std::vector <int> (keys, keys + 3)));
+        }
+        {
+            std::vector <float> result;
+
+            psimpl::simplify_visvalingam_whyatt_n <DIM> (
+                polyline.begin (), polyline.end (), 2,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == 2*DIM);
+            VERIFY_TRUE(CompareEndPoints <DIM> (polyline.begin (), polyline.end (), result.begin (), result.end ()));
+        }
+    }
+
+    // random access iterator, different value types, different dimensions
+    void TestVisvalingamWhyatt::TestRandomIterator () {
+        const unsigned count = 9;
+        int keys [] = {0, 3, 4, 5, 8};
+        {
+            const unsigned DIM = 3;
+            std::vector <double> polyline, result;
+            std::generate_n (std::back_inserter (polyline), count*DIM, StraightLine <double, DIM> ());
+            polyline [4*DIM+1] = 2.;
+
+            psimpl::simplify_visvalingam_whyatt <DIM> (
+                polyline.begin (), polyline.end (), 0.5,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == 5*DIM);
+            VERIFY_TRUE(ComparePoints <DIM> (polyline.begin (), result.begin (), std::vector <int> (keys, keys + 5)));
+        }
+        {
+            const unsigned DIM = 4;
+            std::deque <int> polyline, result;
+            std::generate_n (std::back_inserter (polyline), count*DIM, StraightLine <int, DIM> ());
+            polyline [4*DIM+1] = 2;
+
+            psimpl::simplify_visvalingam_whyatt_n <DIM> (
+                polyline.begin (), polyline.end (), 5,
+                std::back_inserter (result));
+
+            VERIFY_TRUE(result.size () == 5*DIM);
+            VERIFY_TRUE(ComparePoints <DIM> (polyline.begin (), result.begin (), std::vector <int> (keys, keys + 5)));
+        }
+    }
+
+    // bidirectional iterator
+    void TestVisvalingamWhyatt::TestBidirectionalIterator () {
+        const unsigned count = 9;
+        const unsigned DIM = 2;
+        std::vector <float> coords;
+        std::generate_n (std::back_inserter (coords), count*DIM, StraightLine <float, DIM> ());
+        coords [4*DIM+1] = 2.f;
+        std::list <float> polyline (coords.begin (), coords.end ());
+        std::list <float> result;
+
+        psimpl::simplify_visvalingam_whyatt <DIM> (
+            polyline.begin (), polyline.end (), 0.5f,
+            std::inserter (result, result.begin ()));
+
+        VERIFY_TRUE(result.size () == 5*DIM);
+        int keys [] = {0, 3, 4, 5, 8};
+        VERIFY_TRUE(ComparePoints <DIM> (coords.begin (), result.begin (), std::vector <int> (keys, keys + 5)));
+    }
+
+    // forward iterator
+    void TestVisvalingamWhyatt::TestForwardIterator () {
+        const unsigned count = 9;
+        const unsigned DIM = 2;
+        std::vector <float> coords;
+        std::generate_n (std::back_inserter (coords), count*DIM, StraightLine <float, DIM> ());
+        coords [4*DIM+1] = 2.f;
+        std::forward_list <float> polyline (coords.begin (), coords.end ());
+        std::vector <float> result;
+
+        psimpl::simplify_visvalingam_whyatt_n <DIM> (
+            polyline.begin (), polyline.end (), 5,
+            std::back_inserter (result));
+
+        VERIFY_TRUE(result.size () == 5*DIM);
+        int keys [] = {0, 3, 4, 5, 8};
+        VERIFY_TRUE(ComparePoints <DIM> (coords.begin (), result.begin (), std::vector <int> (keys, keys + 5)));
+    }
+
+    void TestVisvalingamWhyatt::TestReturnValue () {
+        const unsigned DIM = 3;
+        const unsigned count = 11;
+
+        float polyline [count*DIM];
+        std::generate_n (polyline, count*DIM, StraightLine <float, DIM> ());
+        float result [count*DIM];
+
+        // invalid input
+        ASSERT_TRUE(
+            std::distance (
+                result,
+                psimpl::simplify_visvalingam_whyatt <DIM> (
+                    polyline, polyline + count*DIM, 0,
+                    result))
+            == count*DIM);
+
+        ASSERT_TRUE(
+            std::distance (
+                result,
+                psimpl::simplify_visvalingam_whyatt_n <DIM> (
+                    polyline, polyline + count*DIM, 1,
+                    result))
+            == count*DIM);
+
+        // valid input
+        ASSERT_TRUE(
+            std::distance (
+                result,
+                psimpl::simplify_visvalingam_whyatt <DIM> (
+                    polyline, polyline + count*DIM, 10.f,
+                    result))
+            == 2*DIM);
+
+        ASSERT_TRUE(
+            std::distance (
+                result,
+                psimpl::simplify_visvalingam_whyatt_n <DIM> (
+                    polyline, polyline + count*DIM, 4,
+                    result))
+            == 4*DIM);
+    }
+
+    // the points are removed in the same order for any tolerance or count
+    void TestVisvalingamWhyatt::TestNested () {
+        const unsigned DIM = 2;
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), 5000*DIM, RandomWalkLine <double, DIM> (1, 2));
+        double tols [] = {0.1, 1., 10., 100.};
+        psimpl::Workspace <double> workspace;
+
+        for (unsigned t = 0; t < 4; ++t) {
+            std::vector <double> result;
+            psimpl::simplify_visvalingam_whyatt <DIM> (
+                polyline.begin (), polyline.end (), tols [t],
+                std::back_inserter (result), workspace);
+
+            std::vector <double> resultN;
+            psimpl::simplify_visvalingam_whyatt_n <DIM> (
+                polyline.begin (), polyline.end (), static_cast <unsigned> (result.size () / DIM),
+                std::back_inserter (resultN), workspace);
+            VERIFY_TRUE(result == resultN);
+        }
+    }
+
+    // the result equals that of rescanning all points for each removal
+    void TestVisvalingamWhyatt::TestReference () {
+        {
+            const unsigned DIM = 2;
+            std::vector <double> polyline;
+            std::generate_n (std::back_inserter (polyline), 2000*DIM, RandomWalkLine <double, DIM> (1, 2));
+            double tols [] = {0.5, 2., 10.};
+            unsigned counts [] = {2, 3, 100, 1999};
+
+            for (unsigned t = 0; t < 3; ++t) {
+                std::vector <double> result;
+                psimpl::simplify_visvalingam_whyatt <DIM> (
+                    polyline.begin (), polyline.end (), tols [t],
+                    std::back_inserter (result));
+                VERIFY_TRUE(result == ReferenceVisvalingamWhyatt <DIM> (polyline, tols [t], 2));
+            }
+            for (unsigned c = 0; c < 4; ++c) {
+                std::vector <double> result;
+                psimpl::simplify_visvalingam_whyatt_n <DIM> (
+                    polyline.begin (), polyline.end (), counts [c],
+                    std::back_inserter (result));
+                VERIFY_TRUE(result == ReferenceVisvalingamWhyatt <DIM> (
+                    polyline, std::numeric_limits <double>::infinity (), counts [c]));
+            }
+        }
+        {
+            const unsigned DIM = 3;
+            std::vector <int> polyline;
+            std::generate_n (std::back_inserter (polyline), 1000*DIM, RandomWalkLine <int, DIM> (1, 5));
+            std::list <int> input (polyline.begin (), polyline.end ());
+            std::vector <int> result;
+            psimpl::simplify_visvalingam_whyatt <DIM> (
+                input.begin (), input.end (), 7,
+                std::back_inserter (result));
+            VERIFY_TRUE(result == ReferenceVisvalingamWhyatt <DIM> (polyline, 7, 2));
+        }
+    }
+
+    // scaling: run time is O(n log n)
+    void TestVisvalingamWhyatt::TestScaling () {
+        const unsigned DIM = 2;
+        const unsigned count = 1 << 19;
+
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), count*DIM, RandomWalkLine <double, DIM> ());
+        std::vector <double> result (polyline.size ());
+
+        VERIFY_SCALING(LINEARITHMIC, [&] (std::size_t n) {
+            psimpl::simplify_visvalingam_whyatt <DIM> (
+                polyline.begin (), polyline.begin () + n*DIM, 5.,
+                result.begin ());
+        });
+    }
+}}
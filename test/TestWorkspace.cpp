@@ -0,0 +1,174 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#include "TestWorkspace.h"
+#include "test.h"
+#include "helper.h"
+#include "../lib/psimpl.h"
+#include <vector>
+
+
+namespace psimpl {
+    namespace test
+{
+    TestWorkspace::TestWorkspace () {
+        TEST_RUN("douglas peucker", TestDouglasPeucker ());
+        TEST_RUN("douglas peucker n", TestDouglasPeuckerN ());
+        TEST_RUN("perpendicular distance", TestPerpendicularDistance ());
+        TEST_RUN("positional error statistics", TestPositionalErrorStatistics ());
+        TEST_RUN("shared workspace", TestSharedWorkspace ());
+    }
+
+    // once the workspace fits the largest polyline, no heap allocations are done
+    void TestWorkspace::TestDouglasPeucker () {
+        const unsigned DIM = 2;
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), 10000*DIM, RandomWalkLine <double, DIM> (1, 2));
+        std::vector <double> expected, result (polyline.size ());
+        Workspace <double> workspace;
+
+        simplify_douglas_peucker <DIM> (&polyline [0], &polyline [0] + polyline.size (), 3.,
+                                        &result [0], workspace);
+
+        unsigned counts [] = {10000, 5000, 3, 10000};
+        for (unsigned c = 0; c < 4; ++c) {
+            const double* first = &polyline [0];
+            const double* last = first + counts [c]*DIM;
+            expected.clear ();
+            simplify_douglas_peucker <DIM> (first, last, 3., std::back_inserter (expected));
+
+            unsigned allocations = AllocationCount ();
+            double* end = simplify_douglas_peucker <DIM> (first, last, 3., &result [0], workspace);
+            VERIFY_TRUE(AllocationCount () == allocations);
+            VERIFY_TRUE(std::equal (expected.begin (), expected.end (), &result [0]));
+            VERIFY_TRUE(end - &result [0] == static_cast <std::ptrdiff_t> (expected.size ()));
+        }
+    }
+
+    void TestWorkspace::TestDouglasPeuckerN () {
+        const unsigned DIM = 3;
+        std::vector <float> polyline;
+        std::generate_n (std::back_inserter (polyline), 10000*DIM, RandomWalkLine <float, DIM> (1, 2));
+        std::vector <float> expected, result (polyline.size ());
+        Workspace <float> workspace;
+
+        simplify_douglas_peucker_n <DIM> (&polyline [0], &polyline [0] + polyline.size (), 1000,
+                                          &result [0], workspace);
+
+        unsigned counts [] = {10000, 500, 10, 2};
+        for (unsigned c = 0; c < 4; ++c) {
+            expected.clear ();
+            simplify_douglas_peucker_n <DIM> (polyline.begin (), polyline.end (), counts [c],
+                                              std::back_inserter (expected));
+
+            unsigned allocations = AllocationCount ();
+            float* end = simplify_douglas_peucker_n <DIM> (&polyline [0], &polyline [0] + polyline.size (),
+                                                           counts [c], &result [0], workspace);
+            VERIFY_TRUE(AllocationCount () == allocations);
+            VERIFY_TRUE(std::equal (expected.begin (), expected.end (), &result [0]));
+            VERIFY_TRUE(end - &result [0] == static_cast <std::ptrdiff_t> (expected.size ()));
+        }
+    }
+
+    void TestWorkspace::TestPerpendicularDistance () {
+        const unsigned DIM = 2;
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), 10000*DIM, RandomWalkLine <double, DIM> (1, 2));
+        std::vector <double> expected, result (polyline.size ());
+        Workspace <double> workspace;
+
+        simplify_perpendicular_distance <DIM> (&polyline [0], &polyline [0] + polyline.size (), 2., 3,
+                                               &result [0], workspace);
+
+        unsigned repeats [] = {2, 3, 10};
+        for (unsigned r = 0; r < 3; ++r) {
+            expected.clear ();
+            simplify_perpendicular_distance <DIM> (polyline.begin (), polyline.end (), 2., repeats [r],
+                                                   std::back_inserter (expected));
+
+            unsigned allocations = AllocationCount ();
+            double* end = simplify_perpendicular_distance <DIM> (&polyline [0], &polyline [0] + polyline.size (),
+                                                                 2., repeats [r], &result [0], workspace);
+            VERIFY_TRUE(AllocationCount () == allocations);
+            VERIFY_TRUE(std::equal (expected.begin (), expected.end (), &result [0]));
+            VERIFY_TRUE(end - &result [0] == static_cast <std::ptrdiff_t> (expected.size ()));
+        }
+    }
+
+    void TestWorkspace::TestPositionalErrorStatistics () {
+        const unsigned DIM = 2;
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), 10000*DIM, RandomWalkLine <double, DIM> (1, 2));
+        std::vector <double> simplification;
+        simplify_douglas_peucker <DIM> (polyline.begin (), polyline.end (), 3., std::back_inserter (simplification));
+        Workspace <double> workspace;
+
+        math::Statistics expected = compute_positional_error_statistics <DIM> (
+            polyline.begin (), polyline.end (), simplification.begin (), simplification.end ());
+        compute_positional_error_statistics <DIM> (
+            polyline.begin (), polyline.end (), simplification.begin (), simplification.end (), workspace);
+
+        unsigned allocations = AllocationCount ();
+        bool valid = false;
+        math::Statistics stats = compute_positional_error_statistics <DIM> (
+            polyline.begin (), polyline.end (), simplification.begin (), simplification.end (),
+            workspace, &valid);
+        VERIFY_TRUE(AllocationCount () == allocations);
+        VERIFY_TRUE(valid);
+        VERIFY_TRUE(stats.max == expected.max);
+        VERIFY_TRUE(stats.sum == expected.sum);
+        VERIFY_TRUE(stats.mean == expected.mean);
+        VERIFY_TRUE(stats.std == expected.std);
+    }
+
+    // a workspace can be used by instances for different iterator types
+    void TestWorkspace::TestSharedWorkspace () {
+        const unsigned DIM = 2;
+        std::vector <double> polyline;
+        std::generate_n (std::back_inserter (polyline), 1000*DIM, RandomWalkLine <double, DIM> (1, 2));
+        std::vector <double> expected, result;
+        simplify_douglas_peucker <DIM> (polyline.begin (), polyline.end (), 3., std::back_inserter (expected));
+
+        Workspace <double> workspace;
+        PolylineSimplification <DIM, std::vector <double>::const_iterator, std::back_insert_iterator <std::vector <double> > > ps1 (workspace);
+        PolylineSimplification <DIM, const double*, double*> ps2 (workspace);
+
+        ps1.DouglasPeucker (polyline.begin (), polyline.end (), 3., std::back_inserter (result));
+        VERIFY_TRUE(result == expected);
+
+        result.assign (polyline.size (), 0.);
+        double* end = ps2.DouglasPeucker (&polyline [0], &polyline [0] + polyline.size (), 3., &result [0]);
+        result.resize (end - &result [0]);
+        VERIFY_TRUE(result == expected);
+    }
+}}
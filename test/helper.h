@@ -36,6 +36,7 @@
 
 
 #include <vector>
+#include <algorithm>
 #include <cmath>
 
 
@@ -181,6 +182,51 @@ namespace psimpl {
         unsigned mDirection;    //!< direction of the current tooth (0,2=forward, 1=up, 3=down)
     };
 
+    /*!
+        \brief Generates a noisy random walk, one coordinate at a time
+
+        Each point is one step further along the x-axis; all other coordinates are offset by a
+        pseudo random value in the range [-noise, noise] relative to the previous point. The
+        same sequence is generated on each platform.
+    */
+    template <typename T, unsigned DIM>
+    class RandomWalkLine {
+    public:
+        RandomWalkLine (T stepSize = 1, T noise = 1) :
+            mStepSize (stepSize),
+            mNoise (noise),
+            mSeed (12345),
+            mDimension (0)
+        {
+            for (unsigned d=0; d<DIM; ++d) {
+                mPosition [d] = 0;
+            }
+        }
+
+        T operator () () {
+            mDimension = mDimension % DIM;
+            T value = mPosition [mDimension];
+            if (mDimension == 0) {
+                mPosition [mDimension] += mStepSize;
+            }
+            else {
+                // linear congruential generator, see Numerical Recipes
+                mSeed = mSeed * 1664525u + 1013904223u;
+                double r = (mSeed >> 8) / double (1 << 24);     // [0, 1)
+                mPosition [mDimension] += static_cast <T> ((2 * r - 1) * mNoise);
+            }
+            ++mDimension;
+            return value;
+        }
+
+    private:
+        T mPosition [DIM];      //!< coordinates of the current point
+        T mStepSize;            //!< distance between points along x-axis
+        T mNoise;               //!< maximum offset between successive points for all but the x-axis
+        unsigned mSeed;         //!< state of the pseudo random generator
+        unsigned mDimension;    //!< dimension of the current point (x-axis = 0)
+    };
+
     //! \brief exact compare of two values of the same type
     template <class T>
     inline bool CompareValue (T a, T b) {
@@ -239,6 +285,20 @@ namespace psimpl {
         return true;
     }
 
+    //! \brief determines the index of each point of a simplification in its polyline; -1 if absent
+    template <unsigned DIM, class T>
+    std::vector <int> KeyIndices (const std::vector <T>& polyline, const std::vector <T>& simplification) {
+        std::vector <int> keys;
+        size_t p = 0;
+        for (size_t s = 0; s < simplification.size (); s += DIM) {
+            while (p < polyline.size () && !std::equal (&simplification [s], &simplification [s] + DIM, &polyline [p])) {
+                p += DIM;
+            }
+            keys.push_back (p < polyline.size () ? static_cast <int> (p / DIM) : -1);
+        }
+        return keys;
+    }
+
 }}
 
 #endif // PSIMPL_HELPER
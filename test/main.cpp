@@ -36,6 +36,7 @@
 #include "TestMath.h"
 #include "TestSimplification.h"
 #include "TestError.h"
+#include "TestIo.h"
 
 
 int main (int /*argc*/, char * /*argv*/ [])
@@ -46,6 +47,7 @@ int main (int /*argc*/, char * /*argv*/ [])
     TEST_RUN("math namspace", psimpl::test::TestMath ());
     TEST_RUN("simplification algorithms", psimpl::test::TestSimplification ());
     TEST_RUN("error algorithms", psimpl::test::TestError ());
+    TEST_RUN("io namespace", psimpl::test::TestIo ());
 
     return TEST_RESULT();
 }
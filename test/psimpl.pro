@@ -20,7 +20,14 @@ HEADERS += \
     TestOpheim.h \
     TestLang.h \
     TestDouglasPeucker.h \
-    TestReumannWitkam.h
+    TestReumannWitkam.h \
+    TestBatch.h \
+    TestColumns.h \
+    TestWorkspace.h \
+    TestHierarchy.h \
+    TestIo.h \
+    TestVisvalingamWhyatt.h \
+    ../lib/psimpl_io.h
 
 SOURCES += \
     TestRadialDistance.cpp \
@@ -34,4 +41,10 @@ SOURCES += \
     TestPerpendicularDistance.cpp \
     TestOpheim.cpp \
     TestLang.cpp \
-    TestDouglasPeucker.cpp
+    TestDouglasPeucker.cpp \
+    TestBatch.cpp \
+    TestColumns.cpp \
+    TestWorkspace.cpp \
+    TestHierarchy.cpp \
+    TestIo.cpp \
+    TestVisvalingamWhyatt.cpp
@@ -32,29 +32,131 @@
 */
 
 #include "test.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <sstream>
+
+
+// counts all heap allocations of the test program, including those of worker threads
+static std::atomic <unsigned> sAllocations (0);
+
+void* operator new (std::size_t size) {
+    ++sAllocations;
+    void* p = std::malloc (size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc ();
+    }
+    return p;
+}
+
+void operator delete (void* p) throw () {
+    std::free (p);
+}
 
 
 namespace psimpl {
     namespace test
 {
+    unsigned AllocationCount () {
+        return sAllocations;
+    }
+
+    typedef std::chrono::steady_clock Clock;
+
+    //! \brief returns the elapsed time since start in milliseconds
+    static double ElapsedMs (Clock::time_point start) {
+        return std::chrono::duration <double, std::milli> (Clock::now () - start).count ();
+    }
+
+    //! \brief returns the fastest time of several routine (n) calls in milliseconds
+    static double FastestMs (const std::function <void (std::size_t)>& routine, std::size_t n) {
+        double fastest = std::numeric_limits <double>::max ();
+        double total = 0;
+        for (unsigned runs = 0; runs < 3 || (runs < 1000 && total < 50); ++runs) {
+            Clock::time_point start = Clock::now ();
+            routine (n);
+            double elapsed = ElapsedMs (start);
+            fastest = std::min (fastest, elapsed);
+            total += elapsed;
+        }
+        return fastest;
+    }
+
+    //! \brief returns the run time predicted by complexity for n, up to a constant factor
+    static double Predicted (Complexity complexity, std::size_t n) {
+        double x = static_cast <double> (n);
+        switch (complexity) {
+        case LINEAR:
+            return x;
+        case LINEARITHMIC:
+            return x * std::log (x);
+        case QUADRATIC:
+        default:
+            return x * x;
+        }
+    }
+
+    bool VerifyScaling (Complexity complexity, const std::function <void (std::size_t)>& routine,
+                        std::size_t minSize, std::size_t maxSize)
+    {
+        double minMs = FastestMs (routine, minSize);
+        double maxMs = FastestMs (routine, maxSize);
+        // guard against timer resolution
+        minMs = std::max (minMs, 1e-3);
+
+        double observed = maxMs / minMs;
+        double predicted = Predicted (complexity, maxSize) / Predicted (complexity, minSize);
+
+        std::ostringstream msg;
+        msg << "scaling " << minSize << " -> " << maxSize << ": " << minMs << " -> " << maxMs
+            << " ms, growth " << observed << " (predicted " << predicted << ")";
+        TestRun::Message (msg.str ());
+
+        return observed <= predicted * SCALING_TOLERANCE;
+    }
+
+    bool ScalingEnabled () {
+        const char* value = std::getenv ("PSIMPL_TEST_SCALING");
+        return value && *value && std::string (value) != "0";
+    }
+
     int TestRun::sDepth = 0;
     int TestRun::sTestsPassed = 0;
     int TestRun::sTestsFailed = 0;
     int TestRun::sErrors = 0;
     int TestRun::sExceptions = 0;
     int TestRun::sTestsDisabled = 0;
+    bool TestRun::sLinePending = false;
+    Clock::time_point TestRun::sStart;
 
     TestRun::TestRun (const std::string& name) :
         mCount (sErrors + sExceptions),
         mDisabled (false)
     {
-        std::cout << Offset () << "- " << name << std::endl;
+        EndLine ();
+        std::cout << Offset () << "- " << name;
+        sLinePending = true;
         ++sDepth;
+        mStart = Clock::now ();
     }
     
     TestRun::~TestRun () {
+        double elapsed = ElapsedMs (mStart);
         --sDepth;
 
+        // report the elapsed time, on the same line as the name if nothing was reported since
+        if (sLinePending) {
+            std::cout << " (" << elapsed << " ms)" << std::endl;
+            sLinePending = false;
+        }
+        else {
+            std::cout << Offset () << "  (" << elapsed << " ms)" << std::endl;
+        }
+
         // update counters
         if (mDisabled)
             ++sTestsDisabled;
@@ -65,6 +167,7 @@ namespace psimpl {
     }
 
     void TestRun::Disable () {
+        EndLine ();
         std::cout << Offset () << "- DISABLED!!!" << std::endl;
         mDisabled = true;
     }
@@ -74,20 +177,36 @@ namespace psimpl {
         return std::string (sDepth * 2, ' ');
     }
 
+    //! \brief terminates the line with the name of the current test run, if still pending
+    void TestRun::EndLine () {
+        if (sLinePending) {
+            std::cout << std::endl;
+            sLinePending = false;
+        }
+    }
+
     void TestRun::Error (const char* file, int line, const char* condition) {
+        EndLine ();
         std::cout << Offset () << file << "(" << line << ") error in: " << condition << std::endl;
         ++sErrors;
     }
 
     void TestRun::Exception (const std::string& msg) {
+        EndLine ();
         std::cout << Offset () << "unhandeled exception: " << msg << std::endl;
         ++sExceptions;
     }
 
+    void TestRun::Message (const std::string& msg) {
+        EndLine ();
+        std::cout << Offset () << msg << std::endl;
+    }
+
     void TestRun::Init () {
         std::cout << "starting unit tests" << std::endl;
         std::cout << std::string(80, '_') << std::endl;
         sTestsPassed = sTestsFailed = sErrors = sExceptions = 0;
+        sStart = Clock::now ();
     }
 
     int TestRun::Result () {
@@ -98,6 +217,7 @@ namespace psimpl {
         std::cout << "disabled = " << sTestsDisabled << std::endl;
         std::cout << "total errors = " << sErrors << std::endl;
         std::cout << "total unhandeled exceptions = " << sExceptions << std::endl;
+        std::cout << "total time = " << ElapsedMs (sStart) << " ms" << std::endl;
         return sTestsFailed;
     }
 }}
@@ -37,6 +37,8 @@
 
 #include <string>
 #include <iostream>
+#include <functional>
+#include <chrono>
 
 //! \brief initializes the root level test run
 #define TEST_INIT() psimpl::test::TestRun::Init()
@@ -58,6 +60,13 @@
         run.Disable ();                                 \
     }
 
+//! \brief defines a timing based test run, that is disabled unless PSIMPL_TEST_SCALING is set
+#define TEST_SCALING(name, function)                    \
+    if (psimpl::test::ScalingEnabled ()) {              \
+        TEST_RUN(name, function)                        \
+    }                                                   \
+    else TEST_DISABLED(name, function)
+
 //! \brief outputs the results of the root level test run
 #define TEST_RESULT() psimpl::test::TestRun::Result()
 
@@ -71,10 +80,49 @@
 #define ASSERT_TRUE(condition)  if (condition) { PASS() } else { ABORT(#condition) }
 #define ASSERT_FALSE(condition) if (condition) { ABORT(#condition) } else { PASS() }
 
+//! \brief verifies that the run time of routine (n) grows no faster than complexity (LINEAR, ...)
+#define VERIFY_SCALING(complexity, ...)                                             \
+    if (psimpl::test::VerifyScaling (psimpl::test::complexity, __VA_ARGS__)) { PASS() } \
+    else { FAIL("VERIFY_SCALING(" #complexity ")") }
+
 
 namespace psimpl {
     namespace test
 {
+    //! \brief returns the number of heap allocations performed by the test program so far
+    unsigned AllocationCount ();
+
+    //! \brief complexity classes that can be verified with VERIFY_SCALING
+    enum Complexity {
+        LINEAR,         //!< O(n)
+        LINEARITHMIC,   //!< O(n log n)
+        QUADRATIC       //!< O(n^2)
+    };
+
+    /*!
+        \brief Verifies that the run time of routine grows no faster than the given complexity.
+
+        The routine is called with n = minSize and n = maxSize, and is timed for each n, taking
+        the fastest of several calls. The routine fails when the run time grows more than
+        SCALING_TOLERANCE times as much as the complexity predicts, which is generous enough to
+        absorb noise and cache effects, but catches f.e. an O(n log n) routine that turned O(n^2).
+        The routine should only perform the work to be measured, f.e. simplify the first n
+        points of a polyline that was generated beforehand.
+    */
+    bool VerifyScaling (Complexity complexity, const std::function <void (std::size_t)>& routine,
+                        std::size_t minSize = 1 << 13, std::size_t maxSize = 1 << 19);
+
+    /*!
+        \brief Indicates if the environment variable PSIMPL_TEST_SCALING is set, and not 0.
+
+        Wall clock measurements are unreliable on loaded or virtualized machines. Test runs that
+        use VERIFY_SCALING are therefore registered with TEST_SCALING, and only run on request.
+    */
+    bool ScalingEnabled ();
+
+    //! \brief the maximum factor between the observed and predicted growth of VERIFY_SCALING
+    const double SCALING_TOLERANCE = 4;
+
     //! \ brief represents a single, possibly nested, test run
     class TestRun
     {
@@ -86,11 +134,13 @@ namespace psimpl {
 
         static void Error (const char* file, int line, const char* condition);
         static void Exception (const std::string& msg);
+        static void Message (const std::string& msg);
         static void Init ();
         static int Result ();
 
     private:
         static std::string Offset ();
+        static void EndLine ();
 
     private:
         static int sDepth;          //!< nesting depth of the current executing test run
@@ -99,9 +149,12 @@ namespace psimpl {
         static int sTestsDisabled;  //!< total number of disabled test runs
         static int sErrors;         //!< total number of test run errors
         static int sExceptions;     //!< total number of test run exceptions
+        static bool sLinePending;   //!< indicates if the name of the current test run awaits its time
+        static std::chrono::steady_clock::time_point sStart;  //!< start of the root level test run
 
         int mCount;                 //!< total number of test run errors/exceptions that occurred before this test run started
         bool mDisabled;             //!< indicates if this test run is disabled
+        std::chrono::steady_clock::time_point mStart;  //!< start of this test run
     };
 }}
 
@@ -0,0 +1,355 @@
+/* ***** BEGIN LICENSE BLOCK *****
+ * Version: MPL 1.1
+ *
+ * The contents of this file are subject to the Mozilla Public License Version
+ * 1.1 (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ * http://www.mozilla.org/MPL/
+ *
+ * Software distributed under the License is distributed on an "AS IS" basis,
+ * WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+ * for the specific language governing rights and limitations under the
+ * License.
+ *
+ * The Original Code is
+ * 'psimpl - generic n-dimensional polyline simplification'.
+ *
+ * The Initial Developer of the Original Code is
+ * Elmar de Koning.
+ * Portions created by the Initial Developer are Copyright (C) 2010-2011
+ * the Initial Developer. All Rights Reserved.
+ *
+ * Contributor(s):
+ *
+ * ***** END LICENSE BLOCK ***** */
+
+/*
+    psimpl - generic n-dimensional polyline simplification
+    Copyright (C) 2010-2011 Elmar de Koning, edekoning@gmail.com
+
+    This file is part of psimpl, and is hosted at SourceForge:
+    http://sourceforge.net/projects/psimpl/
+*/
+
+#include "../lib/psimpl.h"
+#include "../lib/psimpl_io.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+
+namespace psimpl {
+    namespace tool
+{
+    /*!
+        \brief Simplification settings, as given on the command line.
+    */
+    struct Options
+    {
+        std::string algorithm;
+        double tol;
+        double maxTol;
+        unsigned n;             //! nth point, or the point count for DPn
+        unsigned repeat;
+        unsigned lookAhead;
+        unsigned threads;
+        unsigned chunkSize;
+
+        Options () :
+            algorithm ("dp"),
+            tol (1.0),
+            maxTol (5.0),
+            n (10),
+            repeat (1),
+            lookAhead (8),
+            threads (0),
+            chunkSize (65536)
+        {}
+    };
+
+    void Usage () {
+        std::cerr <<
+            "usage: psimpl-tool convert <dim> <type> <text file> <polyline file>\n"
+            "       psimpl-tool dump <polyline file>\n"
+            "       psimpl-tool info <polyline file>\n"
+            "       psimpl-tool simplify [options] <polyline file> <polyline file>\n"
+            "\n"
+            "types: float, double, int32, int64\n"
+            "text files contain one point per line, polylines are separated by empty lines\n"
+            "\n"
+            "simplify options:\n"
+            "  --algorithm a    np, rd, pd, rw, op, la, dp, dp_parallel, dp_chunked,\n"
+            "                   dp_hull, dpn (default dp)\n"
+            "  --tol t          distance tolerance, or minimum tolerance for op (default 1)\n"
+            "  --max-tol t      maximum tolerance for op (default 5)\n"
+            "  --n n            nth point for np, or the point count for dpn (default 10)\n"
+            "  --repeat n       repeat count for pd (default 1)\n"
+            "  --look-ahead n   look ahead for la (default 8)\n"
+            "  --threads n      thread count for dp_parallel and dp_chunked (default all cores)\n"
+            "  --chunk-size n   points per chunk for dp_chunked (default 65536)\n";
+    }
+
+    bool ParseType (const std::string& name, io::ScalarType& type) {
+        if      (name == "float")   type = io::FLOAT32;
+        else if (name == "double")  type = io::FLOAT64;
+        else if (name == "int32")   type = io::INT32;
+        else if (name == "int64")   type = io::INT64;
+        else return false;
+        return true;
+    }
+
+    const char* TypeName (io::ScalarType type) {
+        switch (type) {
+        case io::FLOAT32:   return "float";
+        case io::FLOAT64:   return "double";
+        case io::INT32:     return "int32";
+        case io::INT64:     return "int64";
+        }
+        return "unknown";
+    }
+
+    /*!
+        \brief Simplifies each polyline of in, and writes the result to out.
+
+        The input coordinates are read directly from the mapped file, and the output
+        coordinates are written directly to the output file.
+    */
+    template <unsigned DIM, class T>
+    bool Simplify (const Options& options, const io::MappedFile& in, io::FileWriter& out) {
+        T tol = static_cast <T> (options.tol);
+        T maxTol = static_cast <T> (options.maxTol);
+        Workspace <T> workspace;
+
+        for (std::size_t i = 0; i < in.PolylineCount (); ++i) {
+            const T* first = 0;
+            const T* last = 0;
+            in.Polyline (i, first, last);
+            io::FileWriter::iterator <T> result = out.Output <T> ();
+            const std::string& a = options.algorithm;
+            if (a == "np") {
+                simplify_nth_point <DIM> (first, last, options.n, result);
+            }
+            else if (a == "rd") {
+                simplify_radial_distance <DIM> (first, last, tol, result);
+            }
+            else if (a == "pd") {
+                simplify_perpendicular_distance <DIM> (first, last, tol, options.repeat, result, workspace);
+            }
+            else if (a == "rw") {
+                simplify_reumann_witkam <DIM> (first, last, tol, result);
+            }
+            else if (a == "op") {
+                simplify_opheim <DIM> (first, last, tol, maxTol, result);
+            }
+            else if (a == "la") {
+                simplify_lang <DIM> (first, last, tol, options.lookAhead, result);
+            }
+            else if (a == "dp") {
+                simplify_douglas_peucker <DIM> (first, last, tol, result, workspace);
+            }
+            else if (a == "dp_parallel") {
+                simplify_douglas_peucker_parallel <DIM> (first, last, tol, options.threads, result);
+            }
+            else if (a == "dp_chunked") {
+                simplify_douglas_peucker_chunked <DIM> (first, last, tol, options.chunkSize, options.threads, result);
+            }
+            else if (a == "dp_hull") {
+                simplify_douglas_peucker_hull <DIM> (first, last, tol, result);
+            }
+            else if (a == "dpn") {
+                simplify_douglas_peucker_n <DIM> (first, last, options.n, result, workspace);
+            }
+            else {
+                std::cerr << "unknown algorithm: " << a << std::endl;
+                return false;
+            }
+            if (!out.EndPolyline ()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <unsigned DIM>
+    bool Simplify (const Options& options, const io::MappedFile& in, io::FileWriter& out) {
+        switch (in.Type ()) {
+        case io::FLOAT32:   return Simplify <DIM, float> (options, in, out);
+        case io::FLOAT64:   return Simplify <DIM, double> (options, in, out);
+        case io::INT32:     return Simplify <DIM, std::int32_t> (options, in, out);
+        case io::INT64:     return Simplify <DIM, std::int64_t> (options, in, out);
+        }
+        return false;
+    }
+
+    int Simplify (int argc, char* argv []) {
+        Options options;
+        int i = 2;
+        for (; i + 2 < argc; i += 2) {
+            std::string arg = argv [i];
+            const char* value = argv [i+1];
+            if      (arg == "--algorithm")    options.algorithm = value;
+            else if (arg == "--tol")          options.tol = std::atof (value);
+            else if (arg == "--max-tol")      options.maxTol = std::atof (value);
+            else if (arg == "--n")            options.n = std::atoi (value);
+            else if (arg == "--repeat")       options.repeat = std::atoi (value);
+            else if (arg == "--look-ahead")   options.lookAhead = std::atoi (value);
+            else if (arg == "--threads")      options.threads = std::atoi (value);
+            else if (arg == "--chunk-size")   options.chunkSize = std::atoi (value);
+            else break;
+        }
+        if (i + 2 != argc) {
+            Usage ();
+            return 1;
+        }
+
+        io::MappedFile in;
+        if (!in.Open (argv [i])) {
+            std::cerr << argv [i] << ": " << in.Error () << std::endl;
+            return 1;
+        }
+        io::FileWriter out;
+        if (!out.Open (argv [i+1], in.Dim (), in.Type ())) {
+            std::cerr << argv [i+1] << ": " << out.Error () << std::endl;
+            return 1;
+        }
+        bool ok = false;
+        switch (in.Dim ()) {
+        case 2:     ok = Simplify <2> (options, in, out); break;
+        case 3:     ok = Simplify <3> (options, in, out); break;
+        case 4:     ok = Simplify <4> (options, in, out); break;
+        default:    std::cerr << "unsupported dimension: " << in.Dim () << std::endl; break;
+        }
+        if (!out.Close () || !ok) {
+            std::cerr << argv [i+1] << ": " << (out.Error ().empty () ? "simplification failed" : out.Error ()) << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    //! \brief Converts a text file one line at a time.
+    template <class T>
+    bool Convert (std::istream& is, unsigned dim, io::FileWriter& out) {
+        io::FileWriter::iterator <T> result = out.Output <T> ();
+        std::string line;
+        bool empty = true;      // the current polyline has no points yet
+        while (std::getline (is, line)) {
+            std::istringstream ls (line);
+            T value;
+            unsigned count = 0;
+            for (; count < dim && ls >> value; ++count) {
+                *result++ = value;
+            }
+            if (count == 0 && ls.eof ()) {
+                if (!empty && !out.EndPolyline ()) {
+                    return false;
+                }
+                empty = true;
+                continue;
+            }
+            // reject missing, partially read and superfluous values
+            if (count != dim || !(ls >> std::ws).eof ()) {
+                return false;
+            }
+            empty = false;
+        }
+        return empty || out.EndPolyline ();
+    }
+
+    int Convert (int argc, char* argv []) {
+        io::ScalarType type;
+        unsigned dim = argc == 6 ? std::atoi (argv [2]) : 0;
+        if (!dim || !ParseType (argv [3], type)) {
+            Usage ();
+            return 1;
+        }
+        std::ifstream is (argv [4]);
+        if (!is) {
+            std::cerr << argv [4] << ": cannot open file" << std::endl;
+            return 1;
+        }
+        io::FileWriter out;
+        if (!out.Open (argv [5], dim, type)) {
+            std::cerr << argv [5] << ": " << out.Error () << std::endl;
+            return 1;
+        }
+        bool ok = false;
+        switch (type) {
+        case io::FLOAT32:   ok = Convert <float> (is, dim, out); break;
+        case io::FLOAT64:   ok = Convert <double> (is, dim, out); break;
+        case io::INT32:     ok = Convert <std::int32_t> (is, dim, out); break;
+        case io::INT64:     ok = Convert <std::int64_t> (is, dim, out); break;
+        }
+        if (!ok) {
+            std::cerr << argv [4] << ": invalid point" << std::endl;
+        }
+        if (!out.Close () || !ok) {
+            return 1;
+        }
+        return 0;
+    }
+
+    template <class T>
+    void Dump (const io::MappedFile& in) {
+        for (std::size_t i = 0; i < in.PolylineCount (); ++i) {
+            const T* first = 0;
+            const T* last = 0;
+            in.Polyline (i, first, last);
+            if (i) {
+                std::cout << "\n";
+            }
+            for (std::size_t c = 0; first != last; ++first, ++c) {
+                std::cout << *first << ((c + 1) % in.Dim () ? " " : "\n");
+            }
+        }
+    }
+
+    int Dump (int argc, char* argv [], bool info) {
+        io::MappedFile in;
+        if (argc != 3) {
+            Usage ();
+            return 1;
+        }
+        if (!in.Open (argv [2])) {
+            std::cerr << argv [2] << ": " << in.Error () << std::endl;
+            return 1;
+        }
+        if (info) {
+            std::size_t pointCount = 0;
+            for (std::size_t i = 0; i < in.PolylineCount (); ++i) {
+                pointCount += in.PointCount (i);
+            }
+            std::cout << "dim: " << in.Dim () << "\n"
+                      << "type: " << TypeName (in.Type ()) << "\n"
+                      << "polylines: " << in.PolylineCount () << "\n"
+                      << "points: " << pointCount << "\n";
+            return 0;
+        }
+        std::cout.precision (17);
+        switch (in.Type ()) {
+        case io::FLOAT32:   Dump <float> (in); break;
+        case io::FLOAT64:   Dump <double> (in); break;
+        case io::INT32:     Dump <std::int32_t> (in); break;
+        case io::INT64:     Dump <std::int64_t> (in); break;
+        }
+        return 0;
+    }
+}}
+
+
+int main (int argc, char* argv [])
+{
+    std::string command = argc > 1 ? argv [1] : "";
+    if (command == "convert") {
+        return psimpl::tool::Convert (argc, argv);
+    }
+    if (command == "simplify") {
+        return psimpl::tool::Simplify (argc, argv);
+    }
+    if (command == "dump" || command == "info") {
+        return psimpl::tool::Dump (argc, argv, command == "info");
+    }
+    psimpl::tool::Usage ();
+    return 1;
+}
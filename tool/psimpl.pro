@@ -0,0 +1,16 @@
+# -------------------------------------------------
+# Simplification of memory mapped polyline files
+# -------------------------------------------------
+TARGET = psimpl-tool
+TEMPLATE = app
+CONFIG += console release
+CONFIG -= qt
+
+HEADERS += \
+    ../lib/psimpl.h \
+    ../lib/psimpl_io.h
+
+SOURCES += \
+    main.cpp
+
+unix:LIBS += -pthread